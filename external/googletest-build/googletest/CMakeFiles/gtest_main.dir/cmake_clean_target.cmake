@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "/tmp/asan/lib/libgtest_main.a"
+)
@@ -1,9 +1,283 @@
 #include "containers/hash_types.h"
+#include "hal/platform_math.h"
+#include "hal/platform_memory.h"
+
+#if PLATFORM_CPU_X86_SSE2
+#	include <immintrin.h>
+#endif
 
 namespace Korin
 {
 	namespace
 	{
+		/* Random constants of wyhash. */
+		constexpr uint64 wySecret[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+		/* Length of a stripe of the long hash, in Bytes. */
+		constexpr sizet stripeSize = 64;
+
+		/* Number of stripes between two scrambles of the accumulators. */
+		constexpr sizet stripesPerBlock = 16;
+
+		/* Inputs longer than this use the long hash. */
+		constexpr sizet longLength = 2048;
+
+		/**
+		 * @brief Returns the 8 Bytes at the given
+		 * address, which may be unaligned.
+		 * @{
+		 */
+		FORCE_INLINE uint64 read64(ubyte const* src)
+		{
+			uint64 x;
+			PlatformMemory::memcpy(&x, src, sizeof(x));
+			return x;
+		}
+
+		FORCE_INLINE uint64 read32(ubyte const* src)
+		{
+			uint32 x;
+			PlatformMemory::memcpy(&x, src, sizeof(x));
+			return x;
+		}
+		/** @} */
+
+		/**
+		 * @brief Multiplies two integers and
+		 * returns the xor of the high and low
+		 * halves of the 128 bits product.
+		 */
+		FORCE_INLINE uint64 mix(uint64 a, uint64 b)
+		{
+			uint64 low;
+			uint64 const high = PlatformMath::mulHigh(a, b, low);
+			return high ^ low;
+		}
+
+		/**
+		 * @brief Returns the words of the secret
+		 * of the long hash, generated with
+		 * splitmix64.
+		 */
+		constexpr auto makeLongSecret()
+		{
+			struct { uint64 words[stripesPerBlock + 16]; } secret{};
+
+			uint64 state = 0x9e3779b97f4a7c15ull;
+			for (uint64& word : secret.words)
+			{
+				uint64 z = state += 0x9e3779b97f4a7c15ull;
+				z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+				z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+				word = z ^ (z >> 31);
+			}
+
+			return secret;
+		}
+
+		/* Secret of the long hash. Stripe i of a block uses the words [i, i + 8). */
+		constexpr auto longSecret = makeLongSecret();
+
+		/* Word of the secret of the last stripe. */
+		constexpr sizet lastStripeSecret = stripesPerBlock + 1;
+
+		/* Word of the secret of the scrambles. */
+		constexpr sizet scrambleSecret = stripesPerBlock + 8;
+
+		/**
+		 * @brief Hash of wyhash, final version 4.
+		 * Inputs up to 16 Bytes are read with
+		 * two overlapping loads, longer inputs
+		 * with three independent lanes of 16
+		 * Bytes.
+		 */
+		FORCE_INLINE HashKey wyhash(ubyte const* src, sizet len, uint64 seed)
+		{
+			seed ^= mix(seed ^ wySecret[0], wySecret[1]);
+
+			uint64 a, b;
+			if (len <= 16)
+			{
+				if (len >= 4)
+				{
+					sizet const offset = (len >> 3) << 2;
+					a = read32(src) << 32 | read32(src + offset);
+					b = read32(src + len - 4) << 32 | read32(src + len - 4 - offset);
+				}
+				else if (len > 0)
+				{
+					a = uint64(src[0]) << 16 | uint64(src[len >> 1]) << 8 | src[len - 1];
+					b = 0;
+				}
+				else
+				{
+					a = b = 0;
+				}
+			}
+			else
+			{
+				ubyte const* it = src;
+				sizet i = len;
+				if (i > 48)
+				{
+					uint64 seed1 = seed, seed2 = seed;
+					do
+					{
+						seed = mix(read64(it) ^ wySecret[1], read64(it + 8) ^ seed);
+						seed1 = mix(read64(it + 16) ^ wySecret[2], read64(it + 24) ^ seed1);
+						seed2 = mix(read64(it + 32) ^ wySecret[3], read64(it + 40) ^ seed2);
+						it += 48;
+						i -= 48;
+					}
+					while (i > 48);
+
+					seed ^= seed1 ^ seed2;
+				}
+
+				for (; i > 16; it += 16, i -= 16)
+				{
+					seed = mix(read64(it) ^ wySecret[1], read64(it + 8) ^ seed);
+				}
+
+				a = read64(it + i - 16);
+				b = read64(it + i - 8);
+			}
+
+			a ^= wySecret[1];
+			b ^= seed;
+			b = PlatformMath::mulHigh(a, b, a);
+			return static_cast<HashKey>(mix(a ^ wySecret[0] ^ len, b ^ wySecret[1]));
+		}
+
+		/* Primes of XXH3. */
+		constexpr uint32 prime32 = 0x9e3779b1u;
+		constexpr uint64 prime64 = 0x9e3779b185ebca87ull;
+
+		/**
+		 * @brief Writes the initial values of
+		 * the accumulators of the long hash.
+		 */
+		FORCE_INLINE void initLongHash(uint64 (&acc)[8], uint64 seed)
+		{
+			acc[0] = 0xc2b2ae3dull ^ seed;
+			acc[1] = prime64 - seed;
+			acc[2] = 0xc2b2ae3d27d4eb4full ^ seed;
+			acc[3] = 0x165667b19e3779f9ull - seed;
+			acc[4] = 0x85ebca77c2b2ae63ull ^ seed;
+			acc[5] = 0x85ebca77ull - seed;
+			acc[6] = 0x27d4eb2f165667c5ull ^ seed;
+			acc[7] = prime32 - seed;
+		}
+
+		/**
+		 * @brief Returns the hash of the final
+		 * accumulators of the long hash.
+		 */
+		FORCE_INLINE HashKey mergeLongHash(uint64 const (&acc)[8], sizet len)
+		{
+			uint64 h = len * prime64;
+			for (sizet i = 0; i < 4; ++i)
+			{
+				h += mix(acc[2 * i] ^ longSecret.words[2 * i + 3], acc[2 * i + 1] ^ longSecret.words[2 * i + 4]);
+			}
+
+			h ^= h >> 37;
+			h *= 0x165667919e3779f9ull;
+			h ^= h >> 32;
+
+			return static_cast<HashKey>(h);
+		}
+
+#if PLATFORM_CPU_X86_SSE2
+		namespace Sse2
+		{
+			using Vec = __m128i;
+
+			FORCE_INLINE Vec load(void const* src) { return _mm_loadu_si128(reinterpret_cast<Vec const*>(src)); }
+			FORCE_INLINE void store(void* dst, Vec v) { _mm_storeu_si128(reinterpret_cast<Vec*>(dst), v); }
+			FORCE_INLINE Vec splat(uint32 x) { return _mm_set1_epi32(x); }
+			FORCE_INLINE Vec xorBits(Vec a, Vec b) { return _mm_xor_si128(a, b); }
+			FORCE_INLINE Vec add(Vec a, Vec b) { return _mm_add_epi64(a, b); }
+			FORCE_INLINE Vec mulLow32(Vec a, Vec b) { return _mm_mul_epu32(a, b); }
+			FORCE_INLINE Vec pairedWords(Vec const* v, sizet i) { return _mm_shuffle_epi32(v[i], _MM_SHUFFLE(1, 0, 3, 2)); }
+			template<int32 N> FORCE_INLINE Vec shiftRight(Vec v) { return _mm_srli_epi64(v, N); }
+			template<int32 N> FORCE_INLINE Vec shiftLeft(Vec v) { return _mm_slli_epi64(v, N); }
+
+#			include "hash_types_long.inl"
+		} // namespace Sse2
+
+#ifdef __clang__
+#	pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#else
+#	pragma GCC push_options
+#	pragma GCC target("avx2")
+#endif
+
+		namespace Avx2
+		{
+			using Vec = __m256i;
+
+			FORCE_INLINE Vec load(void const* src) { return _mm256_loadu_si256(reinterpret_cast<Vec const*>(src)); }
+			FORCE_INLINE void store(void* dst, Vec v) { _mm256_storeu_si256(reinterpret_cast<Vec*>(dst), v); }
+			FORCE_INLINE Vec splat(uint32 x) { return _mm256_set1_epi32(x); }
+			FORCE_INLINE Vec xorBits(Vec a, Vec b) { return _mm256_xor_si256(a, b); }
+			FORCE_INLINE Vec add(Vec a, Vec b) { return _mm256_add_epi64(a, b); }
+			FORCE_INLINE Vec mulLow32(Vec a, Vec b) { return _mm256_mul_epu32(a, b); }
+			FORCE_INLINE Vec pairedWords(Vec const* v, sizet i) { return _mm256_shuffle_epi32(v[i], _MM_SHUFFLE(1, 0, 3, 2)); }
+			template<int32 N> FORCE_INLINE Vec shiftRight(Vec v) { return _mm256_srli_epi64(v, N); }
+			template<int32 N> FORCE_INLINE Vec shiftLeft(Vec v) { return _mm256_slli_epi64(v, N); }
+
+#			include "hash_types_long.inl"
+		} // namespace Avx2
+
+#ifdef __clang__
+#	pragma clang attribute pop
+#else
+#	pragma GCC pop_options
+#endif
+
+		/**
+		 * @brief Hash of long inputs, with the
+		 * widest vectors the CPU supports. All
+		 * the instruction sets compute the same
+		 * hash. Not inlined, so that short
+		 * inputs don't pay for its registers.
+		 */
+		__attribute__((noinline)) HashKey longHash(ubyte const* src, sizet len, uint64 seed)
+		{
+			static auto const hash = []() {
+
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("avx2") ? &Avx2::longHash : &Sse2::longHash;
+			}();
+
+			return hash(src, len, seed);
+		}
+#else
+		namespace Scalar
+		{
+			/* A vector of one word. */
+			using Vec = uint64;
+
+			FORCE_INLINE Vec load(void const* src) { return read64(static_cast<ubyte const*>(src)); }
+			FORCE_INLINE void store(void* dst, Vec v) { PlatformMemory::memcpy(dst, &v, sizeof(v)); }
+			FORCE_INLINE Vec splat(uint32 x) { return x; }
+			FORCE_INLINE Vec xorBits(Vec a, Vec b) { return a ^ b; }
+			FORCE_INLINE Vec add(Vec a, Vec b) { return a + b; }
+			FORCE_INLINE Vec mulLow32(Vec a, Vec b) { return (a & 0xffffffffull) * (b & 0xffffffffull); }
+			FORCE_INLINE Vec pairedWords(Vec const* v, sizet i) { return v[i ^ 1]; }
+			template<int32 N> FORCE_INLINE Vec shiftRight(Vec v) { return v >> N; }
+			template<int32 N> FORCE_INLINE Vec shiftLeft(Vec v) { return v << N; }
+
+#			include "hash_types_long.inl"
+		} // namespace Scalar
+
+		FORCE_INLINE HashKey longHash(ubyte const* src, sizet len, uint64 seed)
+		{
+			return Scalar::longHash(src, len, seed);
+		}
+#endif
+
 		/**
 		 * @brief 64-bit key implementation of the
 		 * general-purpose murmur hash.
@@ -59,4 +333,15 @@ namespace Korin
 	{
 		return murmur64(key, len, seed);
 	}
+
+	HashKey hashBytes(void const* key, sizet len, HashKey seed)
+	{
+		ubyte const* const src = static_cast<ubyte const*>(key);
+		if (LIKELY(len <= longLength))
+		{
+			return wyhash(src, len, seed);
+		}
+
+		return longHash(src, len, seed);
+	}
 } // namespace Korin
@@ -0,0 +1,104 @@
+/**
+ * Long hash, with the stripe accumulation of
+ * XXH3. This file is included once per
+ * instruction set, in a namespace that
+ * defines the vector type Vec and the load,
+ * store, splat, xorBits, add, mulLow32
+ * (product of the low halves of the words),
+ * pairedWords (the words paired with those
+ * of a vector), shiftRight and shiftLeft
+ * primitives. Each 64 Bytes stripe is added
+ * to eight accumulators, which are scrambled
+ * once per block of 16 stripes. The words of
+ * a stripe are independent, hence they are
+ * processed with vectors, and all the
+ * instruction sets compute the same hash.
+ */
+
+/* Number of vectors of a stripe. */
+constexpr sizet numVecs = stripeSize / sizeof(Vec);
+
+/* Number of words of a vector. */
+constexpr sizet vecWords = sizeof(Vec) / sizeof(uint64);
+
+/**
+ * @brief Adds a stripe to the accumulators.
+ * Each word is added to the accumulator of
+ * the other word of its pair, and the
+ * product of the halves of the word, xored
+ * with the secret, to its own.
+ */
+FORCE_INLINE void accumulate(Vec (&acc)[numVecs], ubyte const* src, uint64 const* secret)
+{
+	Vec data[numVecs];
+	for (sizet i = 0; i < numVecs; ++i)
+	{
+		data[i] = load(src + i * sizeof(Vec));
+	}
+
+	for (sizet i = 0; i < numVecs; ++i)
+	{
+		Vec const key = xorBits(data[i], load(secret + i * vecWords));
+		acc[i] = add(acc[i], add(pairedWords(data, i), mulLow32(key, shiftRight<32>(key))));
+	}
+}
+
+/**
+ * @brief Scrambles the bits of the
+ * accumulators, so that the high bits don't
+ * saturate.
+ */
+FORCE_INLINE void scramble(Vec (&acc)[numVecs], uint64 const* secret)
+{
+	Vec const prime = splat(prime32);
+	for (sizet i = 0; i < numVecs; ++i)
+	{
+		Vec const x = xorBits(xorBits(acc[i], shiftRight<47>(acc[i])), load(secret + i * vecWords));
+
+		// 64 bits by 32 bits multiply
+		acc[i] = add(mulLow32(x, prime), shiftLeft<32>(mulLow32(shiftRight<32>(x), prime)));
+	}
+}
+
+/**
+ * @brief Returns the hash of more than 64
+ * Bytes. The last stripe overlaps with the
+ * previous ones.
+ */
+HashKey longHash(ubyte const* src, sizet len, uint64 seed)
+{
+	uint64 words[8];
+	initLongHash(words, seed);
+
+	Vec acc[numVecs];
+	for (sizet i = 0; i < numVecs; ++i)
+	{
+		acc[i] = load(words + i * vecWords);
+	}
+
+	sizet const numStripes = (len - 1) / stripeSize;
+	sizet stripe = 0;
+	for (; stripe + stripesPerBlock <= numStripes; stripe += stripesPerBlock)
+	{
+		for (sizet i = 0; i < stripesPerBlock; ++i)
+		{
+			accumulate(acc, src + (stripe + i) * stripeSize, longSecret.words + i);
+		}
+
+		scramble(acc, longSecret.words + scrambleSecret);
+	}
+
+	for (sizet i = 0; stripe + i < numStripes; ++i)
+	{
+		accumulate(acc, src + (stripe + i) * stripeSize, longSecret.words + i);
+	}
+
+	accumulate(acc, src + len - stripeSize, longSecret.words + lastStripeSecret);
+
+	for (sizet i = 0; i < numVecs; ++i)
+	{
+		store(words + i * vecWords, acc[i]);
+	}
+
+	return mergeLongHash(words, len);
+}
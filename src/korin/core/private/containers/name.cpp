@@ -0,0 +1,305 @@
+#include "containers/name.h"
+#include "containers/hash_map.h"
+#include "hal/atomic.h"
+#include "hal/platform_memory.h"
+#include "hal/malloc.h"
+
+namespace Korin
+{
+	namespace
+	{
+		using Name_Impl::Entry;
+
+		/* Number of entries in a chunk, as a power of two. */
+		constexpr uint32 chunkShift = 12;
+		constexpr uint32 chunkSize = 1 << chunkShift;
+		constexpr uint32 chunkMask = chunkSize - 1;
+
+		/* Max number of chunks, limits the number of names. */
+		constexpr uint32 maxChunks = 1 << 12;
+
+		/* Size of the blocks that store the characters. */
+		constexpr sizet blockSize = 64 << 10;
+
+		/**
+		 * @brief The empty name, it has id zero
+		 * and exists before the table is
+		 * created.
+		 */
+		struct
+		{
+			Entry entry;
+			ansichar chars[1];
+		} const emptyEntry{{0, 0}, {0}};
+
+		/* First chunk of entries, it holds the empty name. */
+		Entry const* firstChunk[chunkSize]{&emptyEntry.entry};
+
+		/* Chunks of entries, indexed by the high bits of the id. Chunks are never moved or freed. */
+		Entry const** chunks[maxChunks]{firstChunk};
+
+		/**
+		 * @brief Returns the lower case version
+		 * of an ASCII character.
+		 */
+		constexpr FORCE_INLINE ansichar toLower(ansichar c)
+		{
+			return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+		}
+
+		/**
+		 * @brief Hash policy that ignores the case
+		 * of the characters.
+		 */
+		struct HashNoCase
+		{
+			HashKey operator()(StringView key) const
+			{
+				// Hash lower case characters, a block
+				// at a time
+				ansichar buffer[64];
+				HashKey hkey = 0;
+				for (sizet offset = 0; offset < key.getLength(); offset += sizeof(buffer))
+				{
+					sizet const len = PlatformMath::min(key.getLength() - offset, sizet(sizeof(buffer)));
+					for (sizet i = 0; i < len; ++i)
+					{
+						buffer[i] = toLower(key[offset + i]);
+					}
+
+					hkey = hashBytes(buffer, len, hkey);
+				}
+
+				return hkey;
+			}
+		};
+
+		/**
+		 * @brief A lock that parks the waiting
+		 * threads.
+		 */
+		class Lock
+		{
+		public:
+			/**
+			 * @brief Acquire the lock, blocks the
+			 * thread if another thread owns it.
+			 */
+			void lock()
+			{
+				uint32 expected = 0;
+				if (state.compareExchange(expected, 1, MemoryOrder::Acquire, MemoryOrder::Relaxed))
+				{
+					return;
+				}
+
+				// Mark lock as contended and wait
+				while (state.exchange(2, MemoryOrder::Acquire) != 0)
+				{
+					state.wait(2);
+				}
+			}
+
+			/**
+			 * @brief Release the lock, wakes a
+			 * waiting thread if any.
+			 */
+			void unlock()
+			{
+				if (state.exchange(0, MemoryOrder::Release) == 2)
+				{
+					state.wakeOne();
+				}
+			}
+
+		protected:
+			/* 0 if unlocked, 1 if locked, 2 if locked and other threads may be waiting. */
+			Atomic<uint32> state;
+		};
+
+		/**
+		 * @brief The global table of names.
+		 *
+		 * The lookup tables are guarded by a lock,
+		 * the entries are immutable once added
+		 * and can be read without locking.
+		 */
+		class NameTable
+		{
+		public:
+			/**
+			 * @brief Construct a table with just the
+			 * empty name.
+			 */
+			NameTable()
+				: numEntries{1}
+				, block{nullptr}
+				, blockSpace{0}
+			{
+				ids.emplace(StringView{}, 0u);
+				noCaseIds.emplace(StringView{}, 0u);
+			}
+
+			/**
+			 * @brief Returns the id of the string,
+			 * adds a new entry if necessary.
+			 */
+			uint32 intern(StringView str)
+			{
+				lock.lock();
+
+				uint32 id;
+				if (auto it = ids.find(str); it != ids.end())
+				{
+					id = it->second;
+				}
+				else
+				{
+					id = addEntry(str);
+				}
+
+				lock.unlock();
+				return id;
+			}
+
+			/**
+			 * @brief Returns the id of the string,
+			 * or -1 if not found.
+			 */
+			int64 find(StringView str, bool ignoreCase)
+			{
+				lock.lock();
+
+				int64 id = -1;
+				if (ignoreCase)
+				{
+					if (auto it = noCaseIds.find(str); it != noCaseIds.end())
+					{
+						id = it->second;
+					}
+				}
+				else if (auto it = ids.find(str); it != ids.end())
+				{
+					id = it->second;
+				}
+
+				lock.unlock();
+				return id;
+			}
+
+		protected:
+			/**
+			 * @brief Add a new entry for the given
+			 * string. Must be called with the lock
+			 * held.
+			 */
+			uint32 addEntry(StringView str)
+			{
+				uint32 const id = numEntries++;
+				uint32 const chunkIdx = id >> chunkShift;
+				KORIN_ASSERTF(chunkIdx < maxChunks, "Name table is full")
+
+				if (!chunks[chunkIdx])
+				{
+					chunks[chunkIdx] = reinterpret_cast<Entry const**>(gMalloc->malloc(chunkSize * sizeof(Entry const*)));
+				}
+
+				// Copy characters after the entry
+				sizet const len = str.getLength();
+				Entry* entry = allocateEntry(len);
+				ansichar* chars = reinterpret_cast<ansichar*>(entry + 1);
+				PlatformMemory::memcpy(chars, *str, len);
+				chars[len] = '\0';
+				entry->length = len;
+
+				// The first entry of a case-insensitive
+				// group is the one used by all the others
+				StringView const key{chars, len};
+				if (auto it = noCaseIds.find(key); it != noCaseIds.end())
+				{
+					entry->noCaseId = it->second;
+				}
+				else
+				{
+					entry->noCaseId = id;
+					noCaseIds.emplace(key, id);
+				}
+
+				ids.emplace(key, id);
+				chunks[chunkIdx][id & chunkMask] = entry;
+
+				return id;
+			}
+
+			/**
+			 * @brief Allocate space for an entry with
+			 * the given length.
+			 */
+			Entry* allocateEntry(sizet len)
+			{
+				// Keep entries aligned
+				sizet const size = (sizeof(Entry) + len + 1 + alignof(Entry) - 1) & ~(alignof(Entry) - 1);
+				if (size > blockSpace)
+				{
+					// Blocks are never freed
+					blockSpace = PlatformMath::max(size, blockSize);
+					block = reinterpret_cast<ubyte*>(gMalloc->malloc(blockSpace));
+				}
+
+				Entry* entry = reinterpret_cast<Entry*>(block);
+				block += size;
+				blockSpace -= size;
+
+				return entry;
+			}
+
+			/* Lock that guards the lookup tables and the allocation of entries. */
+			Lock lock;
+
+			/* Map of strings to ids. */
+			HashMap<StringView, uint32> ids;
+
+			/* Map of strings to the id of the first entry equal regardless of case. */
+			HashMap<StringView, uint32, HashNoCase> noCaseIds;
+
+			/* Number of entries in the table. */
+			uint32 numEntries;
+
+			/* Current block of characters. */
+			ubyte* block;
+
+			/* Space left in the current block. */
+			sizet blockSpace;
+		};
+
+		/**
+		 * @brief Returns the global table. The table
+		 * is created on first use and never
+		 * destroyed, so that names can be used
+		 * during static destruction.
+		 */
+		NameTable& getTable()
+		{
+			static NameTable* table = new (gMalloc->malloc(sizeof(NameTable), alignof(NameTable))) NameTable{};
+			return *table;
+		}
+	} // namespace
+
+	namespace Name_Impl
+	{
+		Entry const& getEntry(uint32 id)
+		{
+			return *chunks[id >> chunkShift][id & chunkMask];
+		}
+
+		uint32 intern(StringView str)
+		{
+			return getTable().intern(str);
+		}
+
+		int64 find(StringView str, bool ignoreCase)
+		{
+			return getTable().find(str, ignoreCase);
+		}
+	} // namespace Name_Impl
+} // namespace Korin
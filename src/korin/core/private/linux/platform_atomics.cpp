@@ -0,0 +1,24 @@
+#include "hal/platform_atomics.h"
+
+#if PLATFORM_LINUX
+#	include <linux/futex.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#	include <limits.h>
+
+void LinuxPlatformAtomics::wait(uint32 const* addr, uint32 expected)
+{
+	// Returns immediately if the value has already changed
+	::syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+void LinuxPlatformAtomics::wakeOne(uint32 const* addr)
+{
+	::syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+void LinuxPlatformAtomics::wakeAll(uint32 const* addr)
+{
+	::syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+#endif
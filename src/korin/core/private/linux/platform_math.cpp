@@ -0,0 +1,212 @@
+#include "hal/platform_math.h"
+
+#if PLATFORM_LINUX && PLATFORM_CPU_X86_SSE2
+#	include <immintrin.h>
+
+#define KERNEL inline
+
+namespace
+{
+	/**
+	 * @brief Table of the kernels of an
+	 * instruction set.
+	 */
+	struct Kernels
+	{
+		sizet (*countBits)(uint64 const*, sizet);
+		void (*andBits)(uint64*, uint64 const*, sizet);
+		void (*orBits)(uint64*, uint64 const*, sizet);
+		void (*xorBits)(uint64*, uint64 const*, sizet);
+		void (*andNotBits)(uint64*, uint64 const*, sizet);
+	};
+
+	/**
+	 * @brief Bitwise operations of the
+	 * kernels.
+	 */
+	enum class BitOp
+	{
+		And,
+		Or,
+		Xor,
+		AndNot
+	};
+
+	/**
+	 * @brief Applies a bitwise operation to
+	 * two words.
+	 */
+	template<BitOp op>
+	KERNEL uint64 applyWord(uint64 a, uint64 b)
+	{
+		if constexpr (op == BitOp::And) return a & b;
+		else if constexpr (op == BitOp::Or) return a | b;
+		else if constexpr (op == BitOp::Xor) return a ^ b;
+		else return a & ~b;
+	}
+
+	namespace Sse2
+	{
+		using Vec = __m128i;
+
+		KERNEL Vec load(uint64 const* src) { return _mm_loadu_si128(reinterpret_cast<Vec const*>(src)); }
+		KERNEL void store(uint64* dst, Vec v) { _mm_storeu_si128(reinterpret_cast<Vec*>(dst), v); }
+
+		template<BitOp op>
+		KERNEL Vec apply(Vec a, Vec b)
+		{
+			if constexpr (op == BitOp::And) return _mm_and_si128(a, b);
+			else if constexpr (op == BitOp::Or) return _mm_or_si128(a, b);
+			else if constexpr (op == BitOp::Xor) return _mm_xor_si128(a, b);
+			else return _mm_andnot_si128(b, a);
+		}
+
+		/**
+		 * @brief SSE2 lacks a Byte shuffle and
+		 * a population count, words are counted
+		 * one at a time with the generic
+		 * implementation.
+		 */
+		KERNEL sizet countBits(uint64 const* src, sizet n)
+		{
+			return GenericPlatformMath::countBits(src, n);
+		}
+
+#		include "platform_math_simd.inl"
+	} // namespace Sse2
+
+	namespace Popcnt
+	{
+		/**
+		 * @brief Counts the bits of each word
+		 * with the popcnt instruction, for CPUs
+		 * without AVX2.
+		 */
+		__attribute__((target("popcnt"))) sizet countBits(uint64 const* src, sizet n)
+		{
+			sizet count = 0;
+			for (sizet i = 0; i < n; ++i)
+			{
+				count += __builtin_popcountll(src[i]);
+			}
+
+			return count;
+		}
+	} // namespace Popcnt
+
+#ifdef __clang__
+#	pragma clang attribute push(__attribute__((target("avx2,popcnt"))), apply_to = function)
+#else
+#	pragma GCC push_options
+#	pragma GCC target("avx2,popcnt")
+#endif
+
+	namespace Avx2
+	{
+		using Vec = __m256i;
+
+		KERNEL Vec load(uint64 const* src) { return _mm256_loadu_si256(reinterpret_cast<Vec const*>(src)); }
+		KERNEL void store(uint64* dst, Vec v) { _mm256_storeu_si256(reinterpret_cast<Vec*>(dst), v); }
+
+		template<BitOp op>
+		KERNEL Vec apply(Vec a, Vec b)
+		{
+			if constexpr (op == BitOp::And) return _mm256_and_si256(a, b);
+			else if constexpr (op == BitOp::Or) return _mm256_or_si256(a, b);
+			else if constexpr (op == BitOp::Xor) return _mm256_xor_si256(a, b);
+			else return _mm256_andnot_si256(b, a);
+		}
+
+		/**
+		 * @brief Counts the bits of each nibble
+		 * with a Byte shuffle, and sums the
+		 * Bytes of each word with sad, as in
+		 * Muła et al. The tail is counted with
+		 * popcnt.
+		 */
+		KERNEL sizet countBits(uint64 const* src, sizet n)
+		{
+			Vec const table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+			Vec const lowMask = _mm256_set1_epi8(0x0f);
+			Vec const zero = _mm256_setzero_si256();
+
+			Vec sums = zero;
+			sizet i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				Vec const v = load(src + i);
+				Vec const low = _mm256_shuffle_epi8(table, _mm256_and_si256(v, lowMask));
+				Vec const high = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask));
+				sums = _mm256_add_epi64(sums, _mm256_sad_epu8(_mm256_add_epi8(low, high), zero));
+			}
+
+			sizet count = _mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) + _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3);
+			for (; i < n; ++i)
+			{
+				count += __builtin_popcountll(src[i]);
+			}
+
+			return count;
+		}
+
+#		include "platform_math_simd.inl"
+	} // namespace Avx2
+
+#ifdef __clang__
+#	pragma clang attribute pop
+#else
+#	pragma GCC pop_options
+#endif
+
+	/**
+	 * @brief Returns the kernels for the
+	 * instruction set supported by the CPU.
+	 */
+	Kernels const& getKernels()
+	{
+		static Kernels const kernels = []() {
+
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx2"))
+			{
+				return Avx2::kernels;
+			}
+
+			Kernels table = Sse2::kernels;
+			if (__builtin_cpu_supports("popcnt"))
+			{
+				table.countBits = &Popcnt::countBits;
+			}
+
+			return table;
+		}();
+
+		return kernels;
+	}
+} // namespace
+
+sizet LinuxPlatformMath::countBitsWords(uint64 const* src, sizet n)
+{
+	return getKernels().countBits(src, n);
+}
+
+void LinuxPlatformMath::andBitsWords(uint64* dst, uint64 const* src, sizet n)
+{
+	getKernels().andBits(dst, src, n);
+}
+
+void LinuxPlatformMath::orBitsWords(uint64* dst, uint64 const* src, sizet n)
+{
+	getKernels().orBits(dst, src, n);
+}
+
+void LinuxPlatformMath::xorBitsWords(uint64* dst, uint64 const* src, sizet n)
+{
+	getKernels().xorBits(dst, src, n);
+}
+
+void LinuxPlatformMath::andNotBitsWords(uint64* dst, uint64 const* src, sizet n)
+{
+	getKernels().andNotBits(dst, src, n);
+}
+#endif
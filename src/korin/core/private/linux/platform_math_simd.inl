@@ -0,0 +1,37 @@
+/**
+ * Vectorized bit array kernels. This file is
+ * included once per instruction set, in a
+ * namespace that defines the vector type
+ * Vec, the load, store and apply primitives,
+ * and the countBits kernel, which depends on
+ * the instruction set.
+ */
+
+/* Number of words in a vector. */
+constexpr sizet wordsPerVec = sizeof(Vec) / sizeof(uint64);
+
+/**
+ * @brief Applies a bitwise operation to n
+ * words, one vector at a time. The tail is
+ * processed one word at a time.
+ */
+template<BitOp op>
+KERNEL void applyBits(uint64* RESTRICT dst, uint64 const* RESTRICT src, sizet n)
+{
+	sizet i = 0;
+	for (; i + 2 * wordsPerVec <= n; i += 2 * wordsPerVec)
+	{
+		Vec const a = apply<op>(load(dst + i), load(src + i));
+		Vec const b = apply<op>(load(dst + i + wordsPerVec), load(src + i + wordsPerVec));
+		store(dst + i, a);
+		store(dst + i + wordsPerVec, b);
+	}
+
+	for (; i < n; ++i)
+	{
+		dst[i] = applyWord<op>(dst[i], src[i]);
+	}
+}
+
+/* Table of the kernels for this instruction set. */
+constexpr Kernels kernels{&countBits, &applyBits<BitOp::And>, &applyBits<BitOp::Or>, &applyBits<BitOp::Xor>, &applyBits<BitOp::AndNot>};
@@ -0,0 +1,750 @@
+#include "hal/platform_string.h"
+
+#if PLATFORM_LINUX && PLATFORM_CPU_X86_SSE2
+#	include <immintrin.h>
+
+#define KERNEL __attribute__((no_sanitize_address)) inline
+
+namespace
+{
+	/* Size of the smallest page, loads must not cross page boundaries. */
+	constexpr uintp pageSize = 4096;
+
+	/* Max size of a set that is matched with vectors. */
+	constexpr sizet maxSetLen = 16;
+
+	/* Max length of the needles found with the vectorized filter alone. */
+	constexpr sizet maxFilterLen = 32;
+
+	/**
+	 * @brief Table of the kernels of an
+	 * instruction set.
+	 */
+	struct Kernels
+	{
+		sizet (*len)(ansichar const*);
+		sizet (*mismatch)(ansichar const*, ansichar const*, sizet);
+		sizet (*imismatch)(ansichar const*, ansichar const*, sizet);
+		sizet (*chr)(ansichar const*, ansichar);
+		sizet (*chrn)(ansichar const*, sizet, ansichar);
+		sizet (*rchrn)(ansichar const*, sizet, ansichar);
+		sizet (*spn)(ansichar const*, sizet, ansichar const*, sizet, bool);
+		uint64 (*setMask)(ansichar const*, sizet, ansichar const*, sizet);
+		sizet (*find)(ansichar const*, sizet, ansichar const*, sizet, sizet*);
+		sizet (*rfind)(ansichar const*, sizet, ansichar const*, sizet, sizet*);
+		sizet (*validateUtf8)(ansichar const*, sizet);
+		void (*encodeHex)(ubyte const*, sizet, ansichar*, bool);
+		sizet (*decodeHex)(ansichar const*, sizet, ubyte*);
+		void (*encodeBase64)(ubyte const*, sizet, ansichar*, bool);
+		sizet (*decodeBase64)(ansichar const*, sizet, ubyte*, bool);
+	};
+
+	namespace Sse2
+	{
+		using Vec = __m128i;
+		constexpr uint32 width = sizeof(Vec);
+
+		KERNEL Vec load(void const* src) { return _mm_loadu_si128(reinterpret_cast<Vec const*>(src)); }
+		KERNEL Vec loadAligned(void const* src) { return _mm_load_si128(reinterpret_cast<Vec const*>(src)); }
+		KERNEL Vec splat(ansichar c) { return _mm_set1_epi8(c); }
+		KERNEL Vec eq(Vec a, Vec b) { return _mm_cmpeq_epi8(a, b); }
+		KERNEL Vec either(Vec a, Vec b) { return _mm_or_si128(a, b); }
+		KERNEL Vec both(Vec a, Vec b) { return _mm_and_si128(a, b); }
+		KERNEL uint32 toMask(Vec v) { return _mm_movemask_epi8(v); }
+
+		KERNEL Vec lower(Vec v)
+		{
+			// Characters in [A, Z] map to [0, 25]
+			Vec const offset = _mm_sub_epi8(v, splat('A'));
+			Vec const upper = eq(_mm_min_epu8(offset, splat(25)), offset);
+			return _mm_or_si128(v, _mm_and_si128(upper, splat(0x20)));
+		}
+
+		/**
+		 * @brief Skips vectors of ASCII
+		 * characters and validates the others
+		 * one character at a time, because SSE2
+		 * lacks the Byte shuffles of the lookup
+		 * algorithm.
+		 */
+		KERNEL sizet validateUtf8(ansichar const* src, sizet n)
+		{
+			sizet i = 0;
+			while (i + width <= n)
+			{
+				if (toMask(load(src + i)) == 0)
+				{
+					i += width;
+					continue;
+				}
+
+				uint32 codePoint = 0;
+				for (sizet const end = i + width; i < end;)
+				{
+					int32 const len = GenericPlatformString::decodeUtf8(src + i, n - i, codePoint);
+					if (len < 0) return i;
+					i += len;
+				}
+			}
+
+			return i + GenericPlatformString::validateUtf8(src + i, n - i);
+		}
+
+		/* Returns the hex digits of a vector of nibbles. */
+		KERNEL Vec hexDigits(Vec nibbles, Vec letterOffset)
+		{
+			Vec const digits = _mm_add_epi8(nibbles, splat('0'));
+			return _mm_add_epi8(digits, both(_mm_cmpgt_epi8(nibbles, splat(9)), letterOffset));
+		}
+
+		/**
+		 * @brief Returns the values of a vector
+		 * of hex digits, and sets the lanes of
+		 * the valid digits.
+		 */
+		KERNEL Vec hexValues(Vec input, Vec& valid)
+		{
+			Vec const digit = _mm_sub_epi8(input, splat('0'));
+			Vec const letter = _mm_sub_epi8(either(input, splat(0x20)), splat('a'));
+			Vec const isDigit = eq(_mm_min_epu8(digit, splat(9)), digit);
+			Vec const isLetter = eq(_mm_min_epu8(letter, splat(5)), letter);
+			valid = either(isDigit, isLetter);
+			return either(both(isDigit, digit), both(isLetter, _mm_add_epi8(letter, splat(10))));
+		}
+
+		/**
+		 * @brief Writes the hex digits of 16
+		 * Bytes at a time. Digits above 9 are
+		 * offset by the distance between '9' + 1
+		 * and the first letter.
+		 */
+		KERNEL void encodeHex(ubyte const* src, sizet n, ansichar* dst, bool upperCase)
+		{
+			Vec const nibble = splat(0x0f);
+			Vec const letterOffset = splat(upperCase ? 'A' - '9' - 1 : 'a' - '9' - 1);
+
+			sizet i = 0;
+			for (; i + width <= n; i += width)
+			{
+				Vec const input = load(src + i);
+				Vec const high = hexDigits(both(_mm_srli_epi16(input, 4), nibble), letterOffset);
+				Vec const low = hexDigits(both(input, nibble), letterOffset);
+				_mm_storeu_si128(reinterpret_cast<Vec*>(dst + 2 * i), _mm_unpacklo_epi8(high, low));
+				_mm_storeu_si128(reinterpret_cast<Vec*>(dst + 2 * i + width), _mm_unpackhi_epi8(high, low));
+			}
+
+			GenericPlatformString::encodeHex(src + i, n - i, dst + 2 * i, upperCase);
+		}
+
+		/**
+		 * @brief Reads 32 hex digits at a time.
+		 * The vector with the first invalid
+		 * digit and the tail are read one digit
+		 * at a time.
+		 */
+		KERNEL sizet decodeHex(ansichar const* src, sizet n, ubyte* dst)
+		{
+			Vec const lowByte = _mm_set1_epi16(0x00ff);
+
+			sizet i = 0;
+			for (; i + 2 * width <= n; i += 2 * width)
+			{
+				Vec valid0, valid1;
+				Vec const values0 = hexValues(load(src + i), valid0);
+				Vec const values1 = hexValues(load(src + i + width), valid1);
+				if (toMask(both(valid0, valid1)) != 0xffff) break;
+
+				// Each pair of digits is a 16 bits
+				// word, with the high digit first
+				Vec const bytes0 = both(either(_mm_slli_epi16(values0, 4), _mm_srli_epi16(values0, 8)), lowByte);
+				Vec const bytes1 = both(either(_mm_slli_epi16(values1, 4), _mm_srli_epi16(values1, 8)), lowByte);
+				_mm_storeu_si128(reinterpret_cast<Vec*>(dst + i / 2), _mm_packus_epi16(bytes0, bytes1));
+			}
+
+			return i + GenericPlatformString::decodeHex(src + i, n - i, dst + i / 2);
+		}
+
+		/* Base64 needs Byte shuffles, which SSE2 lacks. */
+		KERNEL void encodeBase64(ubyte const* src, sizet n, ansichar* dst, bool urlSafe)
+		{
+			GenericPlatformString::encodeBase64(src, n, dst, urlSafe);
+		}
+
+		KERNEL sizet decodeBase64(ansichar const* src, sizet n, ubyte* dst, bool urlSafe)
+		{
+			return GenericPlatformString::decodeBase64(src, n, dst, urlSafe);
+		}
+
+#		include "platform_string_simd.inl"
+	} // namespace Sse2
+
+#ifdef __clang__
+#	pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#else
+#	pragma GCC push_options
+#	pragma GCC target("avx2")
+#endif
+
+	namespace Avx2
+	{
+		using Vec = __m256i;
+		constexpr uint32 width = sizeof(Vec);
+
+		KERNEL Vec load(void const* src) { return _mm256_loadu_si256(reinterpret_cast<Vec const*>(src)); }
+		KERNEL Vec loadAligned(void const* src) { return _mm256_load_si256(reinterpret_cast<Vec const*>(src)); }
+		KERNEL Vec splat(ansichar c) { return _mm256_set1_epi8(c); }
+		KERNEL Vec eq(Vec a, Vec b) { return _mm256_cmpeq_epi8(a, b); }
+		KERNEL Vec either(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+		KERNEL Vec both(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+		KERNEL uint32 toMask(Vec v) { return _mm256_movemask_epi8(v); }
+
+		KERNEL Vec lower(Vec v)
+		{
+			Vec const offset = _mm256_sub_epi8(v, splat('A'));
+			Vec const upper = eq(_mm256_min_epu8(offset, splat(25)), offset);
+			return _mm256_or_si256(v, _mm256_and_si256(upper, splat(0x20)));
+		}
+
+		/* Returns the Bytes of the previous vector followed by the first 32 - N Bytes of a vector. */
+		template<int32 N>
+		KERNEL Vec prev(Vec input, Vec prevInput)
+		{
+			return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prevInput, input, 0x21), 16 - N);
+		}
+
+		/* Returns the 16 entries of a table in both lanes, to be indexed by nibble with shuffle. */
+		KERNEL Vec table(uint8 const (&entries)[16])
+		{
+			return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(entries)));
+		}
+
+		/**
+		 * @brief Validates UTF-8 with the lookup
+		 * algorithm of Keiser and Lemire.
+		 *
+		 * Errors in a pair of consecutive Bytes
+		 * are found by looking up the nibbles of
+		 * the two Bytes in three tables, each
+		 * mapping them to the set of errors they
+		 * can be part of; the pair is invalid if
+		 * the sets intersect. Third and fourth
+		 * Bytes of a sequence are checked
+		 * separately. Vectors of ASCII
+		 * characters are skipped.
+		 *
+		 * The vectors only tell whether there is
+		 * an error, so the vector with the error
+		 * and the tail are validated one
+		 * character at a time.
+		 */
+		KERNEL sizet validateUtf8(ansichar const* src, sizet n)
+		{
+			// Errors of a pair of Bytes
+			constexpr uint8 tooShort = 1 << 0;     // 11______ 0_______, 11______ 11______
+			constexpr uint8 tooLong = 1 << 1;      // 0_______ 10______
+			constexpr uint8 overlong3 = 1 << 2;    // 11100000 100_____
+			constexpr uint8 tooLarge = 1 << 3;     // 11110100 1001____, 11110100 101_____, 11110101+ 1001____, 11110101+ 101_____
+			constexpr uint8 surrogate = 1 << 4;    // 11101101 101_____
+			constexpr uint8 overlong2 = 1 << 5;    // 1100000_ 10______
+			constexpr uint8 tooLarge1000 = 1 << 6; // 11110101+ 1000____
+			constexpr uint8 overlong4 = 1 << 6;    // 11110000 1000____
+			constexpr uint8 twoConts = 1 << 7;     // 10______ 10______
+			constexpr uint8 carry = tooShort | tooLong | twoConts;
+
+			constexpr uint8 byte1HighEntries[16]{
+				tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong,
+				twoConts, twoConts, twoConts, twoConts,
+				tooShort | overlong2,
+				tooShort,
+				tooShort | overlong3 | surrogate,
+				tooShort | tooLarge | tooLarge1000 | overlong4,
+			};
+
+			constexpr uint8 byte1LowEntries[16]{
+				carry | overlong3 | overlong2 | overlong4,
+				carry | overlong2,
+				carry,
+				carry,
+				carry | tooLarge,
+				carry | tooLarge | tooLarge1000,
+				carry | tooLarge | tooLarge1000,
+				carry | tooLarge | tooLarge1000,
+				carry | tooLarge | tooLarge1000,
+				carry | tooLarge | tooLarge1000,
+				carry | tooLarge | tooLarge1000,
+				carry | tooLarge | tooLarge1000,
+				carry | tooLarge | tooLarge1000,
+				carry | tooLarge | tooLarge1000 | surrogate,
+				carry | tooLarge | tooLarge1000,
+				carry | tooLarge | tooLarge1000,
+			};
+
+			constexpr uint8 byte2HighEntries[16]{
+				tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort,
+				tooLong | overlong2 | twoConts | overlong3 | tooLarge1000 | overlong4,
+				tooLong | overlong2 | twoConts | overlong3 | tooLarge,
+				tooLong | overlong2 | twoConts | surrogate | tooLarge,
+				tooLong | overlong2 | twoConts | surrogate | tooLarge,
+				tooShort, tooShort, tooShort, tooShort,
+			};
+
+			Vec const byte1High = table(byte1HighEntries);
+			Vec const byte1Low = table(byte1LowEntries);
+			Vec const byte2High = table(byte2HighEntries);
+			Vec const nibble = splat(0x0f);
+
+			// Last Bytes that start a sequence
+			// longer than the rest of the vector
+			Vec const incompleteMax = _mm256_setr_epi8(
+				-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+				-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0xef - 0x100, 0xdf - 0x100, 0xbf - 0x100
+			);
+
+			Vec prevInput = _mm256_setzero_si256();
+			Vec prevIncomplete = _mm256_setzero_si256();
+
+			sizet i = 0;
+			for (; i + width <= n; i += width)
+			{
+				Vec const input = load(src + i);
+				if (toMask(input) == 0)
+				{
+					// Error if the previous vector ends
+					// with an incomplete sequence
+					if (!_mm256_testz_si256(prevIncomplete, prevIncomplete)) break;
+					prevInput = input;
+					continue;
+				}
+
+				Vec const prev1 = prev<1>(input, prevInput);
+				Vec const special = both(
+					both(
+						_mm256_shuffle_epi8(byte1High, both(_mm256_srli_epi16(prev1, 4), nibble)),
+						_mm256_shuffle_epi8(byte1Low, both(prev1, nibble))
+					),
+					_mm256_shuffle_epi8(byte2High, both(_mm256_srli_epi16(input, 4), nibble))
+				);
+
+				// Bytes after the second of a three or
+				// four Bytes sequence must be 10______,
+				// which the lookup tables let through
+				Vec const must23 = either(
+					_mm256_subs_epu8(prev<2>(input, prevInput), splat(0xe0 - 0x80)),
+					_mm256_subs_epu8(prev<3>(input, prevInput), splat(0xf0 - 0x80))
+				);
+				Vec const error = _mm256_xor_si256(both(must23, splat(0x80)), special);
+				if (!_mm256_testz_si256(error, error)) break;
+
+				prevInput = input;
+				prevIncomplete = _mm256_subs_epu8(input, incompleteMax);
+			}
+
+			// Resume from the start of the first
+			// character that is not validated yet,
+			// at most 3 Bytes back
+			sizet j = i > 3 ? i - 3 : 0;
+			for (; j < i && (static_cast<ubyte>(src[j]) & 0xc0) == 0x80; ++j);
+			return j + GenericPlatformString::validateUtf8(src + j, n - j);
+		}
+
+		/**
+		 * @brief Returns the values of a vector
+		 * of hex digits, and sets the lanes of
+		 * the valid digits.
+		 */
+		KERNEL Vec hexValues(Vec input, Vec& valid)
+		{
+			Vec const digit = _mm256_sub_epi8(input, splat('0'));
+			Vec const letter = _mm256_sub_epi8(either(input, splat(0x20)), splat('a'));
+			Vec const isDigit = eq(_mm256_min_epu8(digit, splat(9)), digit);
+			Vec const isLetter = eq(_mm256_min_epu8(letter, splat(5)), letter);
+			valid = either(isDigit, isLetter);
+			return either(both(isDigit, digit), both(isLetter, _mm256_add_epi8(letter, splat(10))));
+		}
+
+		/**
+		 * @brief Writes the hex digits of 32
+		 * Bytes at a time, looking up the
+		 * nibbles in a table of digits.
+		 */
+		KERNEL void encodeHex(ubyte const* src, sizet n, ansichar* dst, bool upperCase)
+		{
+			constexpr uint8 lowerEntries[16]{'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+			constexpr uint8 upperEntries[16]{'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+
+			Vec const digits = table(upperCase ? upperEntries : lowerEntries);
+			Vec const nibble = splat(0x0f);
+
+			sizet i = 0;
+			for (; i + width <= n; i += width)
+			{
+				Vec const input = load(src + i);
+				Vec const high = _mm256_shuffle_epi8(digits, both(_mm256_srli_epi16(input, 4), nibble));
+				Vec const low = _mm256_shuffle_epi8(digits, both(input, nibble));
+
+				// Unpacking interleaves each lane on
+				// its own, the permutes restore the
+				// order of the Bytes
+				Vec const first = _mm256_unpacklo_epi8(high, low);
+				Vec const second = _mm256_unpackhi_epi8(high, low);
+				_mm256_storeu_si256(reinterpret_cast<Vec*>(dst + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+				_mm256_storeu_si256(reinterpret_cast<Vec*>(dst + 2 * i + width), _mm256_permute2x128_si256(first, second, 0x31));
+			}
+
+			GenericPlatformString::encodeHex(src + i, n - i, dst + 2 * i, upperCase);
+		}
+
+		/**
+		 * @brief Reads 64 hex digits at a time.
+		 * The vector with the first invalid
+		 * digit and the tail are read one digit
+		 * at a time.
+		 */
+		KERNEL sizet decodeHex(ansichar const* src, sizet n, ubyte* dst)
+		{
+			// Multiplies the high digit by 16 and
+			// adds the low digit
+			Vec const weights = _mm256_set1_epi16(0x0110);
+
+			sizet i = 0;
+			for (; i + 2 * width <= n; i += 2 * width)
+			{
+				Vec valid0, valid1;
+				Vec const values0 = hexValues(load(src + i), valid0);
+				Vec const values1 = hexValues(load(src + i + width), valid1);
+				if (toMask(both(valid0, valid1)) != ~0u) break;
+
+				Vec const bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(values0, weights), _mm256_maddubs_epi16(values1, weights));
+				_mm256_storeu_si256(reinterpret_cast<Vec*>(dst + i / 2), _mm256_permute4x64_epi64(bytes, _MM_SHUFFLE(3, 1, 2, 0)));
+			}
+
+			return i + GenericPlatformString::decodeHex(src + i, n - i, dst + i / 2);
+		}
+
+		/**
+		 * @brief Encodes 24 Bytes at a time with
+		 * the algorithm of Muła and Lemire.
+		 *
+		 * Each lane loads 12 Bytes and shuffles
+		 * them so that each group of 3 Bytes
+		 * fills a 32 bits word; two multiplies
+		 * then move the four 6 bits values of a
+		 * group to the low bits of four Bytes.
+		 * The values are translated to
+		 * characters by adding an offset, looked
+		 * up by the range of the value.
+		 */
+		KERNEL void encodeBase64(ubyte const* src, sizet n, ansichar* dst, bool urlSafe)
+		{
+			Vec const shuffle = _mm256_setr_epi8(
+				1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+				1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10
+			);
+
+			// Offsets of the ranges of values:
+			// [26, 51], [52, 61] (one per value),
+			// 62, 63 and [0, 25]
+			constexpr uint8 digitOffset = uint8('0' - 52);
+			uint8 const offsetEntries[16]{
+				'a' - 26,
+				digitOffset, digitOffset, digitOffset, digitOffset, digitOffset,
+				digitOffset, digitOffset, digitOffset, digitOffset, digitOffset,
+				uint8((urlSafe ? '-' : '+') - 62),
+				uint8((urlSafe ? '_' : '/') - 63),
+				'A', 0, 0,
+			};
+
+			Vec const offsets = table(offsetEntries);
+
+			sizet i = 0;
+			for (; i + 28 <= n; i += 24)
+			{
+				Vec input = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i)));
+				input = _mm256_inserti128_si256(input, _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i + 12)), 1);
+				input = _mm256_shuffle_epi8(input, shuffle);
+
+				Vec const values = either(
+					_mm256_mulhi_epu16(both(input, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040)),
+					_mm256_mullo_epi16(both(input, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010))
+				);
+
+				Vec index = _mm256_subs_epu8(values, splat(51));
+				index = either(index, both(_mm256_cmpgt_epi8(splat(26), values), splat(13)));
+				_mm256_storeu_si256(reinterpret_cast<Vec*>(dst + i / 3 * 4), _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, index)));
+			}
+
+			GenericPlatformString::encodeBase64(src + i, n - i, dst + i / 3 * 4, urlSafe);
+		}
+
+		/**
+		 * @brief Lookup tables of the base64
+		 * decoder, indexed by nibble.
+		 */
+		struct Base64Tables
+		{
+			/* Bit h - 2 set for the high nibbles h in [2, 7], bit 6 for the others. */
+			uint8 high[16];
+
+			/* Bit 6, and bit h - 2 if the character with high nibble h is invalid. */
+			uint8 low[16];
+
+			/* Value minus character, by high nibble, with the last character at index 8 + high nibble. */
+			uint8 roll[16];
+
+			/* Last character of the alphabet, which shares its high nibble with a different roll. */
+			ansichar last;
+		};
+
+		constexpr Base64Tables makeBase64Tables(bool urlSafe)
+		{
+			Base64Tables tables{};
+			tables.last = GenericPlatformString::getBase64Alphabet(urlSafe)[63];
+
+			for (uint32 h = 0; h < 16; ++h)
+			{
+				tables.high[h] = h >= 2 && h <= 7 ? 1 << (h - 2) : 1 << 6;
+				tables.low[h] = 1 << 6;
+			}
+
+			for (uint32 c = 0x20; c < 0x80; ++c)
+			{
+				int32 const value = GenericPlatformString::decodeBase64Char(ansichar(c), urlSafe);
+				if (value < 0)
+				{
+					tables.low[c & 0x0f] |= 1 << ((c >> 4) - 2);
+				}
+				else
+				{
+					tables.roll[(c >> 4) + (ansichar(c) == tables.last ? 8 : 0)] = uint8(value - int32(c));
+				}
+			}
+
+			return tables;
+		}
+
+		constexpr Base64Tables base64Tables[2]{makeBase64Tables(false), makeBase64Tables(true)};
+
+		/* Returns true if the tables decode all the characters like the scalar decoder. */
+		constexpr bool checkBase64Tables(bool urlSafe)
+		{
+			Base64Tables const& tables = base64Tables[urlSafe];
+			for (uint32 c = 0; c < 256; ++c)
+			{
+				int32 const value = GenericPlatformString::decodeBase64Char(ansichar(c), urlSafe);
+				bool const invalid = (tables.high[c >> 4] & tables.low[c & 0x0f]) != 0;
+				uint8 const roll = tables.roll[(c >> 4) + (ansichar(c) == tables.last ? 8 : 0)];
+				if (invalid != (value < 0) || (value >= 0 && uint8(c + roll) != value)) return false;
+			}
+
+			return true;
+		}
+
+		static_assert(checkBase64Tables(false) && checkBase64Tables(true), "Invalid base64 lookup tables");
+
+		/**
+		 * @brief Decodes 32 characters at a time
+		 * with the algorithm of Muła and Lemire.
+		 *
+		 * A character is invalid if the sets of
+		 * errors of its nibbles intersect; the
+		 * value is the character plus an offset
+		 * looked up by high nibble. Two multiply
+		 * and add pack the four 6 bits values of
+		 * a group in a 32 bits word, then two
+		 * shuffles pack the 3 Bytes of the words.
+		 *
+		 * The vector with the first invalid
+		 * character and the tail are read one
+		 * character at a time.
+		 */
+		KERNEL sizet decodeBase64(ansichar const* src, sizet n, ubyte* dst, bool urlSafe)
+		{
+			Base64Tables const& tables = base64Tables[urlSafe];
+			Vec const high = table(tables.high);
+			Vec const low = table(tables.low);
+			Vec const roll = table(tables.roll);
+			Vec const last = splat(tables.last);
+			Vec const nibble = splat(0x0f);
+
+			Vec const pack = _mm256_setr_epi8(
+				2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+				2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+			);
+			Vec const packLanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1);
+
+			sizet i = 0;
+			for (; i + width <= n; i += width)
+			{
+				Vec const input = load(src + i);
+				Vec const highNibbles = both(_mm256_srli_epi16(input, 4), nibble);
+				Vec const invalid = both(_mm256_shuffle_epi8(high, highNibbles), _mm256_shuffle_epi8(low, both(input, nibble)));
+				if (!_mm256_testz_si256(invalid, invalid)) break;
+
+				Vec const rollIndex = _mm256_add_epi8(highNibbles, both(eq(input, last), splat(8)));
+				Vec values = _mm256_add_epi8(input, _mm256_shuffle_epi8(roll, rollIndex));
+				values = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+				values = _mm256_madd_epi16(values, _mm256_set1_epi32(0x00011000));
+				values = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(values, pack), packLanes);
+
+				// Write exactly 24 Bytes
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i / 4 * 3), _mm256_castsi256_si128(values));
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i / 4 * 3 + 16), _mm256_extracti128_si256(values, 1));
+			}
+
+			return i + GenericPlatformString::decodeBase64(src + i, n - i, dst + i / 4 * 3, urlSafe);
+		}
+
+#		include "platform_string_simd.inl"
+	} // namespace Avx2
+
+#ifdef __clang__
+#	pragma clang attribute pop
+#else
+#	pragma GCC pop_options
+#endif
+
+	/**
+	 * @brief Returns the kernels for the
+	 * instruction set supported by the CPU.
+	 */
+	Kernels const& getKernels()
+	{
+		static Kernels const kernels = []() {
+
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2") ? Avx2::kernels : Sse2::kernels;
+		}();
+
+		return kernels;
+	}
+} // namespace
+
+sizet LinuxPlatformString::lenAnsi(ansichar const* cstr)
+{
+	ASSERT(cstr != nullptr)
+	return getKernels().len(cstr);
+}
+
+sizet LinuxPlatformString::mismatchAnsi(ansichar const* lhs, ansichar const* rhs, sizet n)
+{
+	ASSERT(lhs != nullptr)
+	ASSERT(rhs != nullptr)
+	return getKernels().mismatch(lhs, rhs, n);
+}
+
+sizet LinuxPlatformString::imismatchAnsi(ansichar const* lhs, ansichar const* rhs, sizet n)
+{
+	ASSERT(lhs != nullptr)
+	ASSERT(rhs != nullptr)
+	return getKernels().imismatch(lhs, rhs, n);
+}
+
+sizet LinuxPlatformString::chrAnsi(ansichar const* cstr, ansichar c)
+{
+	ASSERT(cstr != nullptr)
+	return getKernels().chr(cstr, c);
+}
+
+sizet LinuxPlatformString::chrnAnsi(ansichar const* src, sizet n, ansichar c)
+{
+	return getKernels().chrn(src, n, c);
+}
+
+sizet LinuxPlatformString::rchrnAnsi(ansichar const* src, sizet n, ansichar c)
+{
+	return getKernels().rchrn(src, n, c);
+}
+
+sizet LinuxPlatformString::findAnsi(ansichar const* src, sizet n, ansichar const* needle, sizet m)
+{
+	ASSERT(m >= 2 && m <= n)
+	if (m <= maxFilterLen)
+	{
+		return getKernels().find(src, n, needle, m, nullptr);
+	}
+
+	// Long needles switch to Two-Way if the
+	// filter lets through too many positions
+	sizet resume = n;
+	if (sizet const idx = getKernels().find(src, n, needle, m, &resume); idx < n || n - resume < m)
+	{
+		return idx;
+	}
+
+	return resume + twoWay<false>(src + resume, n - resume, needle, m);
+}
+
+sizet LinuxPlatformString::rfindAnsi(ansichar const* src, sizet n, ansichar const* needle, sizet m)
+{
+	ASSERT(m >= 2 && m <= n)
+	if (m <= maxFilterLen)
+	{
+		return getKernels().rfind(src, n, needle, m, nullptr);
+	}
+
+	sizet resume = 0;
+	if (sizet const idx = getKernels().rfind(src, n, needle, m, &resume); idx < n || resume == 0)
+	{
+		return idx;
+	}
+
+	sizet const len = resume - 1 + m;
+	sizet const idx = twoWay<true>(src, len, needle, m);
+	return idx < len ? idx : n;
+}
+
+sizet LinuxPlatformString::spnAnsi(ansichar const* src, sizet n, ansichar const* set, sizet setLen, bool invert)
+{
+	if (setLen > maxSetLen)
+	{
+		// Large sets use a lookup table
+		bool table[256]{};
+		for (sizet k = 0; k < setLen; ++k)
+		{
+			table[static_cast<ubyte>(set[k])] = true;
+		}
+
+		sizet i = 0; for (; i < n && table[static_cast<ubyte>(src[i])] != invert; ++i);
+		return i;
+	}
+
+	return getKernels().spn(src, n, set, setLen, invert);
+}
+
+uint64 LinuxPlatformString::setMaskAnsi(ansichar const* src, sizet n, ansichar const* set, sizet setLen)
+{
+	if (setLen > maxSetLen)
+	{
+		return UnixPlatformString::setMask(src, n, set, setLen);
+	}
+
+	return getKernels().setMask(src, n, set, setLen);
+}
+
+sizet LinuxPlatformString::validateUtf8Ansi(ansichar const* src, sizet n)
+{
+	return getKernels().validateUtf8(src, n);
+}
+
+void LinuxPlatformString::encodeHexAnsi(ubyte const* src, sizet n, ansichar* dst, bool upperCase)
+{
+	getKernels().encodeHex(src, n, dst, upperCase);
+}
+
+sizet LinuxPlatformString::decodeHexAnsi(ansichar const* src, sizet n, ubyte* dst)
+{
+	KORIN_ASSERTF(n % 2 == 0, "Odd number of hex digits (%llu)", n)
+	return getKernels().decodeHex(src, n, dst);
+}
+
+void LinuxPlatformString::encodeBase64Ansi(ubyte const* src, sizet n, ansichar* dst, bool urlSafe)
+{
+	getKernels().encodeBase64(src, n, dst, urlSafe);
+}
+
+sizet LinuxPlatformString::decodeBase64Ansi(ansichar const* src, sizet n, ubyte* dst, bool urlSafe)
+{
+	KORIN_ASSERTF(n % 4 != 1, "Invalid length of unpadded base64 (%llu)", n)
+	return getKernels().decodeBase64(src, n, dst, urlSafe);
+}
+#endif
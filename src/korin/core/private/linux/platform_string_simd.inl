@@ -0,0 +1,543 @@
+/**
+ * Vectorized string kernels. This file is
+ * included once per instruction set, in a
+ * namespace that defines the vector type
+ * Vec, its width in Bytes and the
+ * load, splat, eq, either, both, lower
+ * and toMask primitives, and the
+ * validateUtf8, hex and base64 kernels,
+ * which depend on the instruction set.
+ *
+ * Null-terminated strings are scanned with
+ * aligned loads, which never cross a page
+ * boundary. Other loads are unaligned and
+ * may read past the end of the characters,
+ * but only if they don't cross a page
+ * boundary; otherwise the kernels fall back
+ * to one character at a time. Reads past the
+ * end are harmless but invisible to the
+ * address sanitizer, hence KERNEL disables
+ * it.
+ */
+
+/* Mask with all the lanes set. */
+constexpr uint32 allMask = width == 32 ? ~0u : (1u << width) - 1;
+
+/**
+ * @brief Returns true if a vector can be
+ * loaded at the given address without
+ * crossing a page boundary.
+ */
+KERNEL bool canLoad(void const* src)
+{
+	return (reinterpret_cast<uintp>(src) & (pageSize - 1)) <= pageSize - width;
+}
+
+/**
+ * @brief Returns the mask of the first n
+ * lanes, with n < width.
+ */
+KERNEL uint32 lowMask(sizet n)
+{
+	return (1u << n) - 1;
+}
+
+/**
+ * @brief Returns the lower case version of
+ * an ASCII character.
+ */
+KERNEL ansichar lowerChar(ansichar c)
+{
+	return c >= 'A' && c <= 'Z' ? c | 0x20 : c;
+}
+
+/**
+ * @brief Returns the index of the first lane
+ * of the stop mask in a group of four
+ * vectors. At least one lane must be set.
+ */
+KERNEL sizet firstLane(Vec m0, Vec m1, Vec m2, Vec m3)
+{
+	uint64 const lo = toMask(m0) | uint64(toMask(m1)) << width;
+	if (lo)
+	{
+		return __builtin_ctzll(lo);
+	}
+
+	uint64 const hi = toMask(m2) | uint64(toMask(m3)) << width;
+	return 2 * width + __builtin_ctzll(hi);
+}
+
+/**
+ * @brief Returns the index of the first
+ * stop lane returned by @c match, scanning
+ * null-terminated characters.
+ */
+template<typename MatchT>
+KERNEL sizet scanTerminated(ansichar const* cstr, MatchT const& match)
+{
+	constexpr uintp blockSize = 4 * width;
+	ansichar const* block = reinterpret_cast<ansichar const*>(reinterpret_cast<uintp>(cstr) & ~uintp(width - 1));
+	sizet const offset = cstr - block;
+
+	// Discard lanes before the first character
+	if (uint32 const mask = toMask(match(loadAligned(block))) >> offset)
+	{
+		return __builtin_ctz(mask);
+	}
+
+	// Single vectors up to a block boundary
+	for (block += width; reinterpret_cast<uintp>(block) & (blockSize - 1); block += width)
+	{
+		if (uint32 const mask = toMask(match(loadAligned(block))))
+		{
+			return block - cstr + __builtin_ctz(mask);
+		}
+	}
+
+	// Aligned blocks never cross a page boundary
+	for (;; block += blockSize)
+	{
+		Vec const m0 = match(loadAligned(block));
+		Vec const m1 = match(loadAligned(block + width));
+		Vec const m2 = match(loadAligned(block + 2 * width));
+		Vec const m3 = match(loadAligned(block + 3 * width));
+		if (toMask(either(either(m0, m1), either(m2, m3))))
+		{
+			return block - cstr + firstLane(m0, m1, m2, m3);
+		}
+	}
+}
+
+/**
+ * @brief Returns the index of the first
+ * stop lane returned by @c match, or n if
+ * there is none in the first n characters.
+ */
+template<typename MatchT>
+KERNEL sizet scan(ansichar const* src, sizet n, MatchT const& match)
+{
+	sizet i = 0;
+	for (; i + 4 * width <= n; i += 4 * width)
+	{
+		Vec const m0 = match(load(src + i));
+		Vec const m1 = match(load(src + i + width));
+		Vec const m2 = match(load(src + i + 2 * width));
+		Vec const m3 = match(load(src + i + 3 * width));
+		if (toMask(either(either(m0, m1), either(m2, m3))))
+		{
+			return i + firstLane(m0, m1, m2, m3);
+		}
+	}
+
+	for (; i + width <= n; i += width)
+	{
+		if (uint32 const mask = toMask(match(load(src + i))))
+		{
+			return i + __builtin_ctz(mask);
+		}
+	}
+
+	if (i == n)
+	{
+		return n;
+	}
+
+	if (n >= width)
+	{
+		// Last vector overlaps with the previous one
+		if (uint32 const mask = toMask(match(load(src + n - width))) >> (width - (n - i)))
+		{
+			return i + __builtin_ctz(mask);
+		}
+
+		return n;
+	}
+
+	if (canLoad(src))
+	{
+		uint32 const mask = toMask(match(load(src))) & lowMask(n);
+		return mask ? __builtin_ctz(mask) : n;
+	}
+
+	for (; i < n && !match(src[i]); ++i);
+	return i;
+}
+
+/**
+ * @brief Like @c scan but returns the index
+ * of the last stop lane.
+ */
+template<typename MatchT>
+KERNEL sizet rscan(ansichar const* src, sizet n, MatchT const& match)
+{
+	sizet i = n;
+	for (; i >= width; i -= width)
+	{
+		if (uint32 const mask = toMask(match(load(src + i - width))))
+		{
+			return i - 1 - __builtin_clz(mask) + (32 - width);
+		}
+	}
+
+	if (i == 0)
+	{
+		return n;
+	}
+
+	if (n >= width || canLoad(src))
+	{
+		// First vector overlaps with the next one
+		uint32 const mask = toMask(match(load(src))) & lowMask(i);
+		return mask ? 31 - __builtin_clz(mask) : n;
+	}
+
+	for (; i > 0; --i) if (match(src[i - 1])) return i - 1;
+	return n;
+}
+
+/**
+ * @brief Stops at the null character.
+ */
+struct MatchNull
+{
+	KERNEL Vec operator()(Vec v) const
+	{
+		return eq(v, splat(0));
+	}
+};
+
+/**
+ * @brief Stops at a character, or at the
+ * null character if @c orNull is true.
+ */
+struct MatchChar
+{
+	Vec vec;
+	ansichar c;
+	bool orNull;
+
+	KERNEL Vec operator()(Vec v) const
+	{
+		return orNull ? either(eq(v, vec), eq(v, splat(0))) : eq(v, vec);
+	}
+
+	KERNEL bool operator()(ansichar x) const
+	{
+		return x == c || (orNull && x == '\0');
+	}
+};
+
+/**
+ * @brief Stops at the first character not
+ * in the set, or in the set if @c invert is
+ * true.
+ */
+struct MatchSet
+{
+	Vec vecs[maxSetLen];
+	ansichar const* set;
+	sizet setLen;
+	bool invert;
+
+	KERNEL MatchSet(ansichar const* inSet, sizet inSetLen, bool inInvert)
+		: set{inSet}
+		, setLen{inSetLen}
+		, invert{inInvert}
+	{
+		for (sizet k = 0; k < setLen; ++k)
+		{
+			vecs[k] = splat(set[k]);
+		}
+	}
+
+	KERNEL Vec operator()(Vec v) const
+	{
+		Vec any = splat(0);
+		for (sizet k = 0; k < setLen; ++k)
+		{
+			any = either(any, eq(v, vecs[k]));
+		}
+
+		return invert ? any : eq(any, splat(0));
+	}
+
+	KERNEL bool operator()(ansichar x) const
+	{
+		sizet k = 0; for (; k < setLen && set[k] != x; ++k);
+		return (k < setLen) == invert;
+	}
+};
+
+KERNEL sizet len(ansichar const* cstr)
+{
+	return scanTerminated(cstr, MatchNull{});
+}
+
+KERNEL sizet chr(ansichar const* cstr, ansichar c)
+{
+	return scanTerminated(cstr, MatchChar{splat(c), c, true});
+}
+
+KERNEL sizet chrn(ansichar const* src, sizet n, ansichar c)
+{
+	return scan(src, n, MatchChar{splat(c), c, false});
+}
+
+KERNEL sizet spn(ansichar const* src, sizet n, ansichar const* set, sizet setLen, bool invert)
+{
+	return scan(src, n, MatchSet{set, setLen, invert});
+}
+
+KERNEL uint64 setMask(ansichar const* src, sizet n, ansichar const* set, sizet setLen)
+{
+	MatchSet const match{set, setLen, true};
+	if (n < 64 && (reinterpret_cast<uintp>(src) & (pageSize - 1)) > pageSize - 64)
+	{
+		uint64 mask = 0;
+		for (sizet i = 0; i < n; ++i)
+		{
+			mask |= uint64(match(src[i])) << i;
+		}
+
+		return mask;
+	}
+
+	uint64 mask = 0;
+	for (uint32 k = 0; k < 64; k += width)
+	{
+		mask |= uint64(toMask(match(load(src + k)))) << k;
+	}
+
+	return n < 64 ? mask & ((1ull << n) - 1) : mask;
+}
+
+KERNEL sizet rchrn(ansichar const* src, sizet n, ansichar c)
+{
+	return rscan(src, n, MatchChar{splat(c), c, false});
+}
+
+/**
+ * @brief Returns the mask of the positions
+ * in [p, p + width) where the first and the
+ * last characters of the needle match.
+ */
+KERNEL uint32 candidates(ansichar const* src, sizet p, sizet m, Vec first, Vec last)
+{
+	return toMask(both(eq(load(src + p), first), eq(load(src + p + m - 1), last)));
+}
+
+/**
+ * @brief Returns true if the inner
+ * characters of the needle match at p.
+ */
+KERNEL bool verify(ansichar const* src, sizet p, ansichar const* needle, sizet m)
+{
+	ansichar const* lhs = src + p + 1;
+	ansichar const* rhs = needle + 1;
+	sizet const len = m - 2;
+	for (sizet k = 0; k < len; k += width)
+	{
+		sizet const left = len - k;
+		if (left < width && !(canLoad(lhs + k) && canLoad(rhs + k)))
+		{
+			return ::memcmp(lhs + k, rhs + k, left) == 0;
+		}
+
+		uint32 mask = ~toMask(eq(load(lhs + k), load(rhs + k))) & allMask;
+		if (left < width)
+		{
+			mask &= lowMask(left);
+		}
+
+		if (mask)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Returns the index of the first
+ * occurrence of a needle of at least two
+ * characters, or n if not found.
+ *
+ * Candidate positions are those where both
+ * the first and the last characters of the
+ * needle match, and only those are compared
+ * in full. Loads never go past the end of
+ * the buffer.
+ *
+ * If @c resume is not null, the kernel gives
+ * up when the full compares cost much more
+ * than the scan, and sets it to the first
+ * position that was not ruled out (the end
+ * of the unchecked positions if reverse).
+ *
+ * @tparam reverse whether to find the last
+ * occurrence
+ */
+template<bool reverse>
+KERNEL sizet find(ansichar const* src, sizet n, ansichar const* needle, sizet m, sizet* resume)
+{
+	// Number of candidate positions
+	sizet const numPos = n - m + 1;
+
+	// Number of characters compared in full
+	sizet spent = 0;
+	Vec const first = splat(needle[0]);
+	Vec const last = splat(needle[m - 1]);
+
+	if constexpr (!reverse)
+	{
+		sizet p = 0;
+		for (; p + width <= numPos; p += width)
+		{
+			for (uint32 mask = candidates(src, p, m, first, last); mask; mask &= mask - 1)
+			{
+				if (sizet const q = p + __builtin_ctz(mask); verify(src, q, needle, m))
+				{
+					return q;
+				}
+
+				if (resume && (spent += m) > 4 * p + 4096)
+				{
+					*resume = p;
+					return n;
+				}
+			}
+		}
+
+		if (p < numPos && numPos >= width)
+		{
+			// Last vector overlaps with the previous one
+			sizet const base = numPos - width;
+			for (uint32 mask = candidates(src, base, m, first, last) >> (p - base); mask; mask &= mask - 1)
+			{
+				if (sizet const q = p + __builtin_ctz(mask); verify(src, q, needle, m))
+				{
+					return q;
+				}
+			}
+
+			return n;
+		}
+
+		for (; p < numPos; ++p)
+		{
+			if (src[p] == needle[0] && src[p + m - 1] == needle[m - 1] && verify(src, p, needle, m))
+			{
+				return p;
+			}
+		}
+	}
+	else
+	{
+		sizet p = numPos;
+		for (; p >= width; p -= width)
+		{
+			for (uint32 mask = candidates(src, p - width, m, first, last); mask; mask &= ~(1u << (31 - __builtin_clz(mask))))
+			{
+				if (sizet const q = p - width + 31 - __builtin_clz(mask); verify(src, q, needle, m))
+				{
+					return q;
+				}
+
+				if (resume && (spent += m) > 4 * (numPos - p) + 4096)
+				{
+					*resume = p;
+					return n;
+				}
+			}
+		}
+
+		if (p > 0 && numPos >= width)
+		{
+			// First vector overlaps with the next one
+			for (uint32 mask = candidates(src, 0, m, first, last) & lowMask(p); mask; mask &= ~(1u << (31 - __builtin_clz(mask))))
+			{
+				if (sizet const q = 31 - __builtin_clz(mask); verify(src, q, needle, m))
+				{
+					return q;
+				}
+			}
+
+			return n;
+		}
+
+		for (; p > 0; --p)
+		{
+			if (src[p - 1] == needle[0] && src[p + m - 2] == needle[m - 1] && verify(src, p - 1, needle, m))
+			{
+				return p - 1;
+			}
+		}
+	}
+
+	return n;
+}
+
+/**
+ * @brief Returns the index of the first
+ * different or null character in the first
+ * n characters, or n if there is none.
+ *
+ * @tparam ignoreCase whether to compare
+ * lower case characters
+ */
+template<bool ignoreCase>
+KERNEL sizet mismatch(ansichar const* lhs, ansichar const* rhs, sizet n)
+{
+	sizet i = 0;
+	while (i < n)
+	{
+		if (canLoad(lhs + i) && canLoad(rhs + i))
+		{
+			Vec a = load(lhs + i);
+			Vec b = load(rhs + i);
+			if constexpr (ignoreCase)
+			{
+				a = lower(a);
+				b = lower(b);
+			}
+
+			uint32 mask = (~toMask(eq(a, b)) | toMask(eq(a, splat(0)))) & allMask;
+			if (n - i < width)
+			{
+				mask &= lowMask(n - i);
+			}
+
+			if (mask)
+			{
+				return i + __builtin_ctz(mask);
+			}
+
+			i += width;
+		}
+		else
+		{
+			// Step over the page boundary
+			ansichar a = lhs[i];
+			ansichar b = rhs[i];
+			if constexpr (ignoreCase)
+			{
+				a = lowerChar(a);
+				b = lowerChar(b);
+			}
+
+			if (a != b || a == '\0')
+			{
+				return i;
+			}
+
+			++i;
+		}
+	}
+
+	return n;
+}
+
+/* Table of the kernels for this instruction set. */
+constexpr Kernels kernels{&len, &mismatch<false>, &mismatch<true>, &chr, &chrn, &rchrn, &spn, &setMask, &find<false>, &find<true>, &validateUtf8, &encodeHex, &decodeHex, &encodeBase64, &decodeBase64};
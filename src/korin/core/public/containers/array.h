@@ -1,8 +1,10 @@
 #pragma once
 
 #include "containers_types.h"
+#include "span.h"
 #include "templates/utility.h"
 #include "hal/platform_memory.h"
+#include "hal/platform_math.h"
 
 // TODO: Replace with platform math
 template<typename T>
@@ -27,8 +29,6 @@ namespace Korin
 	template<typename T>
 	class Array
 	{
-		template<typename> friend class StringBase;
-
 		using Iterator = T*;
 		using ConstIterator = T const*;
 
@@ -155,6 +155,23 @@ namespace Korin
 			}
 		}
 
+		/**
+		 * @brief Copy construct the items of the
+		 * given range starting at the given
+		 * index.
+		 *
+		 * @param idx index of the first item
+		 * @param first,last begin and end iterators
+		 */
+		template<typename ItT>
+		FORCE_INLINE void constructRange(uint64 idx, ItT first, ItT last)
+		{
+			for (T* dst = data + idx; first != last; ++first, ++dst)
+			{
+				new (dst) T{*first};
+			}
+		}
+
 		/**
 		 * @brief Implementation for @c concat.
 		 *
@@ -402,6 +419,33 @@ namespace Korin
 			return *this;
 		}
 
+		/**
+		 * @brief Returns an array with the given
+		 * number of items, which are written by a
+		 * callable. The items are not initialized
+		 * before.
+		 *
+		 * ```
+		 * Array<ubyte> bytes = Array<ubyte>::create(n, [&](ubyte* dst) { readBytes(dst, n); });
+		 * ```
+		 *
+		 * @param numItems number of items
+		 * @param write callable that receives a
+		 * ptr to the items and writes all of them
+		 * @return new array
+		 */
+		template<typename WriteT>
+		static FORCE_INLINE Array create(sizet numItems, WriteT&& write)
+		{
+			static_assert(IsTriviallyConstructible<T>::value, "Items written in place must be trivially constructible");
+
+			Array array{numItems};
+			write(array.data);
+			array.count = numItems;
+
+			return array;
+		}
+
 		/**
 		 * @brief Destructor, destroys the
 		 * array and all the items.
@@ -619,6 +663,122 @@ namespace Korin
 			return *this;
 		}
 
+		/**
+		 * @brief Append a copy of all the items in
+		 * the given range. The buffer is resized at
+		 * most once.
+		 *
+		 * The range must not point into this
+		 * array.
+		 *
+		 * @tparam ItT the type of the iterator
+		 * @param first,last begin and end iterators
+		 */
+		template<typename ItT>
+		void appendRange(ItT first, ItT last)
+		{
+			sizet const numItems = Korin::distance(first, last);
+			growToFit(count + numItems);
+			constructRange(count, first, last);
+			count += numItems;
+		}
+
+		/**
+		 * @brief Insert a copy of all the items in
+		 * the given range at a precise position.
+		 *
+		 * The buffer is resized at most once and
+		 * the items that follow the position are
+		 * shifted only once. The range must not
+		 * point into this array.
+		 *
+		 * @tparam ItT the type of the iterator
+		 * @param idx index of the first item
+		 * inserted
+		 * @param first,last begin and end iterators
+		 */
+		template<typename ItT>
+		void insertRange(uint64 idx, ItT first, ItT last)
+		{
+			CHECK(idx <= count)
+
+			sizet const numItems = Korin::distance(first, last);
+			if (numItems == 0)
+				// Nothing to insert
+				return;
+
+			growToFit(count + numItems);
+
+			if (idx < count)
+			{
+				// Items shifted past the current end land on
+				// uninitialized slots, the others are moved
+				sizet const numShifted = count - idx;
+				sizet const numUninit = PlatformMath::min(numItems, numShifted);
+				moveConstructItems(data + count + numItems - numUninit, data + count - numUninit, numUninit);
+
+				if (numShifted > numUninit)
+				{
+					moveItems(data + idx + numItems, data + idx, numShifted - numUninit);
+				}
+
+				// Destroy moved-from items before constructing
+				// the new items in their place
+				destroyItems(data + idx, numUninit);
+			}
+
+			constructRange(idx, first, last);
+			count += numItems;
+		}
+
+		/**
+		 * @brief Replace all the items of the array
+		 * with a copy of the items in the given
+		 * range. The buffer is reused if it is large
+		 * enough.
+		 *
+		 * The range must not point into this
+		 * array.
+		 *
+		 * @tparam ItT the type of the iterator
+		 * @param first,last begin and end iterators
+		 */
+		template<typename ItT>
+		void assign(ItT first, ItT last)
+		{
+			if (count > 0)
+			{
+				destroyItems(data, count);
+				count = 0;
+			}
+
+			appendRange(first, last);
+		}
+
+		/**
+		 * @brief Change the number of items. New
+		 * items are copies of the given item. The
+		 * buffer is resized at most once.
+		 *
+		 * @param numItems new number of items
+		 * @param item value of the new items
+		 */
+		void setNumItems(sizet numItems, T const& item = T{})
+		{
+			if (numItems > count)
+			{
+				growToFit(numItems);
+				constructItems(data + count, item, numItems - count);
+				count = numItems;
+			}
+			else if (numItems < count)
+			{
+				destroyItems(data + numItems, count - numItems);
+				count = numItems;
+				shrinkToFit(count);
+			}
+		}
+
 		/**
 		 * @brief Remove the last item of the
 		 * array.
@@ -688,6 +848,9 @@ namespace Korin
 		 * @brief Returns a slice of the array
 		 * as a copy.
 		 *
+		 * If a copy is not needed, prefer
+		 * @c view() which costs nothing.
+		 *
 		 * @param beginIdx index of the beginning
 		 * of the slice
 		 * @param endIdx index of the end of the
@@ -721,6 +884,61 @@ namespace Korin
 		}
 		/** @} */
 
+		/**
+		 * @brief Returns a span that views a
+		 * slice of the array, without copying
+		 * the items.
+		 *
+		 * The span is invalidated if the array
+		 * buffer is resized or destroyed.
+		 *
+		 * @param beginIdx index of the beginning
+		 * of the slice
+		 * @param endIdx index of the end of the
+		 * slice (excluded); if omitted assume
+		 * end of array.
+		 * @return span over the slice
+		 * @{
+		 */
+		FORCE_INLINE Span<T> view(uint64 beginIdx, uint64 endIdx)
+		{
+			CHECK(endIdx <= count)
+			CHECK(beginIdx <= endIdx)
+			return {data + beginIdx, endIdx - beginIdx};
+		}
+
+		FORCE_INLINE Span<T const> view(uint64 beginIdx, uint64 endIdx) const
+		{
+			return const_cast<Array&>(*this).view(beginIdx, endIdx);
+		}
+
+		FORCE_INLINE Span<T> view(uint64 beginIdx = 0)
+		{
+			return view(beginIdx, count);
+		}
+
+		FORCE_INLINE Span<T const> view(uint64 beginIdx = 0) const
+		{
+			return view(beginIdx, count);
+		}
+		/** @} */
+
+		/**
+		 * @brief Converts the array to a span
+		 * over all its items.
+		 * @{
+		 */
+		FORCE_INLINE operator Span<T>()
+		{
+			return {data, count};
+		}
+
+		FORCE_INLINE operator Span<T const>() const
+		{
+			return {data, count};
+		}
+		/** @} */
+
 	protected:
 		/* Pointer to the data buffer. */
 		T* data;
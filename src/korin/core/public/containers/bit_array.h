@@ -0,0 +1,509 @@
+#pragma once
+
+#include "containers_types.h"
+#include "hal/platform_math.h"
+#include "array.h"
+#include "span.h"
+
+namespace Korin
+{
+	/**
+	 * @brief A growing array of bits packed in
+	 * 64-bit words.
+	 *
+	 * Bulk operations (and, or, xor, and-not,
+	 * count) use the word array kernels of
+	 * PlatformMath, which are vectorized where
+	 * the CPU supports it, and set bits are
+	 * found with bit-scan instructions.
+	 *
+	 * Compared to Array<bool> or a hash set of
+	 * ids, a dense set of ids takes one bit per
+	 * id.
+	 *
+	 * Bits past the end of the array in the last
+	 * word are always zero.
+	 */
+	class BitArray
+	{
+		/* Number of bits in a word. */
+		static constexpr sizet bitsPerWord = 64;
+
+		/**
+		 * @brief Returns the number of words
+		 * required to store the given number of
+		 * bits.
+		 */
+		static constexpr FORCE_INLINE sizet getNumWordsFor(sizet numBits)
+		{
+			return (numBits + bitsPerWord - 1) / bitsPerWord;
+		}
+
+		/**
+		 * @brief Returns a mask with the bits in
+		 * the range [begin, end) of a word set.
+		 * Requires begin < end <= 64.
+		 */
+		static constexpr FORCE_INLINE uint64 getRangeMask(sizet begin, sizet end)
+		{
+			return (~0ull >> (bitsPerWord - (end - begin))) << begin;
+		}
+
+		/**
+		 * @brief Clear the unused bits of the last
+		 * word.
+		 */
+		FORCE_INLINE void clearTrailingBits()
+		{
+			if (sizet const numTrailingBits = numBits % bitsPerWord)
+			{
+				words[words.getNumItems() - 1] &= getRangeMask(0, numTrailingBits);
+			}
+		}
+
+		/**
+		 * @brief Set or clear all bits in the range
+		 * [beginIdx, endIdx).
+		 */
+		void fillRange(sizet beginIdx, sizet endIdx, bool value)
+		{
+			CHECK(beginIdx <= endIdx)
+			CHECK(endIdx <= numBits)
+
+			if (beginIdx == endIdx)
+			{
+				return;
+			}
+
+			sizet const beginWord = beginIdx / bitsPerWord;
+			sizet const lastWord = (endIdx - 1) / bitsPerWord;
+			uint64* data = *words;
+
+			if (beginWord == lastWord)
+			{
+				uint64 const mask = getRangeMask(beginIdx % bitsPerWord, (endIdx - 1) % bitsPerWord + 1);
+				data[beginWord] = value ? data[beginWord] | mask : data[beginWord] & ~mask;
+				return;
+			}
+
+			// Partial first and last words, full words in between
+			uint64 const firstMask = getRangeMask(beginIdx % bitsPerWord, bitsPerWord);
+			uint64 const lastMask = getRangeMask(0, (endIdx - 1) % bitsPerWord + 1);
+			uint64 const fill = value ? ~0ull : 0ull;
+
+			data[beginWord] = value ? data[beginWord] | firstMask : data[beginWord] & ~firstMask;
+			for (sizet i = beginWord + 1; i < lastWord; ++i)
+			{
+				data[i] = fill;
+			}
+			data[lastWord] = value ? data[lastWord] | lastMask : data[lastWord] & ~lastMask;
+		}
+
+	public:
+		/**
+		 * @brief Construct an empty bit array.
+		 */
+		FORCE_INLINE BitArray()
+			: words{}
+			, numBits{0}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a bit array with the
+		 * given number of bits.
+		 *
+		 * @param inNumBits number of bits
+		 * @param value initial value of all bits
+		 */
+		FORCE_INLINE explicit BitArray(sizet inNumBits, bool value = false)
+			: words{getNumWordsFor(inNumBits), value ? ~0ull : 0ull}
+			, numBits{inNumBits}
+		{
+			clearTrailingBits();
+		}
+
+		/**
+		 * @brief Returns the number of bits.
+		 */
+		FORCE_INLINE sizet getNumBits() const
+		{
+			return numBits;
+		}
+
+		/**
+		 * @brief Returns the number of words used
+		 * to store the bits.
+		 */
+		FORCE_INLINE sizet getNumWords() const
+		{
+			return words.getNumItems();
+		}
+
+		/**
+		 * @brief Returns a span over the words
+		 * that store the bits.
+		 */
+		FORCE_INLINE Span<uint64 const> getWords() const
+		{
+			return words.view();
+		}
+
+		/**
+		 * @brief Returns true if the array has no
+		 * bits.
+		 */
+		FORCE_INLINE bool isEmpty() const
+		{
+			return numBits == 0;
+		}
+
+		/**
+		 * @brief Change the number of bits. New
+		 * bits are initialized to the given value.
+		 *
+		 * @param newNumBits new number of bits
+		 * @param value value of the new bits
+		 */
+		void resize(sizet newNumBits, bool value = false)
+		{
+			sizet const oldNumBits = numBits;
+			sizet const numWords = getNumWordsFor(newNumBits);
+
+			words.setNumItems(numWords, 0ull);
+
+			numBits = newNumBits;
+			if (newNumBits > oldNumBits)
+			{
+				fillRange(oldNumBits, newNumBits, value);
+			}
+
+			clearTrailingBits();
+		}
+
+		/**
+		 * @brief Append a bit at the end of the
+		 * array.
+		 *
+		 * @param value value of the bit
+		 */
+		FORCE_INLINE void append(bool value)
+		{
+			if (numBits % bitsPerWord == 0)
+			{
+				words.append(0ull);
+			}
+
+			numBits++;
+			set(numBits - 1, value);
+		}
+
+		/**
+		 * @brief Returns the value of the i-th bit.
+		 *
+		 * @param idx index of the bit
+		 * @return value of the bit
+		 * @{
+		 */
+		FORCE_INLINE bool get(sizet idx) const
+		{
+			CHECK(idx < numBits)
+			return (words[idx / bitsPerWord] >> (idx % bitsPerWord)) & 1;
+		}
+
+		FORCE_INLINE bool operator[](sizet idx) const
+		{
+			return get(idx);
+		}
+		/** @} */
+
+		/**
+		 * @brief Set the i-th bit to the given
+		 * value.
+		 *
+		 * @param idx index of the bit
+		 * @param value value of the bit
+		 */
+		FORCE_INLINE void set(sizet idx, bool value = true)
+		{
+			CHECK(idx < numBits)
+
+			uint64 const mask = 1ull << (idx % bitsPerWord);
+			uint64& word = words[idx / bitsPerWord];
+			word = value ? word | mask : word & ~mask;
+		}
+
+		/**
+		 * @brief Clear the i-th bit.
+		 *
+		 * @param idx index of the bit
+		 */
+		FORCE_INLINE void clear(sizet idx)
+		{
+			set(idx, false);
+		}
+
+		/**
+		 * @brief Flip the i-th bit.
+		 *
+		 * @param idx index of the bit
+		 */
+		FORCE_INLINE void toggle(sizet idx)
+		{
+			CHECK(idx < numBits)
+			words[idx / bitsPerWord] ^= 1ull << (idx % bitsPerWord);
+		}
+
+		/**
+		 * @brief Set all bits in the range
+		 * [beginIdx, endIdx).
+		 *
+		 * @param beginIdx index of the first bit
+		 * @param endIdx index past the last bit
+		 */
+		FORCE_INLINE void setRange(sizet beginIdx, sizet endIdx)
+		{
+			fillRange(beginIdx, endIdx, true);
+		}
+
+		/**
+		 * @brief Clear all bits in the range
+		 * [beginIdx, endIdx).
+		 *
+		 * @param beginIdx index of the first bit
+		 * @param endIdx index past the last bit
+		 */
+		FORCE_INLINE void clearRange(sizet beginIdx, sizet endIdx)
+		{
+			fillRange(beginIdx, endIdx, false);
+		}
+
+		/**
+		 * @brief Set or clear all bits.
+		 *
+		 * @param value value of the bits
+		 */
+		void fill(bool value)
+		{
+			uint64 const fillWord = value ? ~0ull : 0ull;
+			for (uint64& word : words)
+			{
+				word = fillWord;
+			}
+
+			clearTrailingBits();
+		}
+
+		/**
+		 * @brief Returns the number of set bits.
+		 */
+		sizet count() const
+		{
+			return PlatformMath::countBits(*words, words.getNumItems());
+		}
+
+		/**
+		 * @brief Returns true if at least one bit
+		 * is set.
+		 */
+		bool any() const
+		{
+			for (uint64 word : words)
+			{
+				if (word)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		/**
+		 * @brief Returns the index of the first set
+		 * bit at or after the given index, or -1 if
+		 * there is none.
+		 *
+		 * @param idx index of the first bit to test
+		 * @return index of the set bit or -1
+		 */
+		ssizet findNextSet(sizet idx) const
+		{
+			if (idx >= numBits)
+			{
+				return -1;
+			}
+
+			sizet wordIdx = idx / bitsPerWord;
+			uint64 word = words[wordIdx] & (~0ull << (idx % bitsPerWord));
+
+			for (;;)
+			{
+				if (word)
+				{
+					return wordIdx * bitsPerWord + PlatformMath::countTrailingZeros(word);
+				}
+
+				if (++wordIdx == words.getNumItems())
+				{
+					return -1;
+				}
+
+				word = words[wordIdx];
+			}
+		}
+
+		/**
+		 * @brief Returns the index of the first set
+		 * bit, or -1 if there is none.
+		 */
+		FORCE_INLINE ssizet findFirstSet() const
+		{
+			return findNextSet(0);
+		}
+
+		/**
+		 * @brief Call the given function with the
+		 * index of each set bit, in order.
+		 *
+		 * @param callback function that receives
+		 * the index of a set bit
+		 */
+		template<typename CallbackT>
+		void forEachSetBit(CallbackT&& callback) const
+		{
+			for (sizet wordIdx = 0; wordIdx < words.getNumItems(); ++wordIdx)
+			{
+				// Pop the lowest set bit until the word is empty
+				for (uint64 word = words[wordIdx]; word; word &= word - 1)
+				{
+					callback(wordIdx * bitsPerWord + PlatformMath::countTrailingZeros(word));
+				}
+			}
+		}
+
+		/**
+		 * @brief Bitwise operations with another
+		 * bit array of the same size.
+		 *
+		 * @param other another bit array
+		 * @return ref to self
+		 * @{
+		 */
+		BitArray& operator&=(BitArray const& other)
+		{
+			CHECK(numBits == other.numBits)
+
+			PlatformMath::andBits(*words, *other.words, words.getNumItems());
+
+			return *this;
+		}
+
+		BitArray& operator|=(BitArray const& other)
+		{
+			CHECK(numBits == other.numBits)
+
+			PlatformMath::orBits(*words, *other.words, words.getNumItems());
+
+			return *this;
+		}
+
+		BitArray& operator^=(BitArray const& other)
+		{
+			CHECK(numBits == other.numBits)
+
+			PlatformMath::xorBits(*words, *other.words, words.getNumItems());
+
+			return *this;
+		}
+
+		BitArray& andNot(BitArray const& other)
+		{
+			CHECK(numBits == other.numBits)
+
+			PlatformMath::andNotBits(*words, *other.words, words.getNumItems());
+
+			return *this;
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns a new bit array equal to
+		 * the bitwise operation of two bit arrays.
+		 *
+		 * @param other another bit array
+		 * @return new bit array
+		 * @{
+		 */
+		FORCE_INLINE BitArray operator&(BitArray const& other) const
+		{
+			return BitArray{*this} &= other;
+		}
+
+		FORCE_INLINE BitArray operator|(BitArray const& other) const
+		{
+			return BitArray{*this} |= other;
+		}
+
+		FORCE_INLINE BitArray operator^(BitArray const& other) const
+		{
+			return BitArray{*this} ^= other;
+		}
+		/** @} */
+
+		/**
+		 * @brief Flip all bits.
+		 *
+		 * @return ref to self
+		 */
+		BitArray& flip()
+		{
+			for (uint64& word : words)
+			{
+				word = ~word;
+			}
+
+			clearTrailingBits();
+			return *this;
+		}
+
+		/**
+		 * @brief Returns true if both arrays have
+		 * the same bits.
+		 *
+		 * @param other another bit array
+		 * @{
+		 */
+		bool operator==(BitArray const& other) const
+		{
+			if (numBits != other.numBits)
+			{
+				return false;
+			}
+
+			for (sizet i = 0, n = words.getNumItems(); i < n; ++i)
+			{
+				if (words[i] != other.words[i])
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		FORCE_INLINE bool operator!=(BitArray const& other) const
+		{
+			return !(*this == other);
+		}
+		/** @} */
+
+	protected:
+		/* Words that store the bits. */
+		Array<uint64> words;
+
+		/* Number of bits in the array. */
+		sizet numBits;
+	};
+} // namespace Korin
@@ -3,11 +3,28 @@
 #include "pair.h"
 #include "optional.h"
 #include "tuple.h"
+#include "span.h"
 #include "array.h"
+#include "shared_array.h"
+#include "segmented_array.h"
+#include "soa_array.h"
+#include "bit_array.h"
 #include "list.h"
+#include "deque.h"
+#include "queue.h"
+#include "spsc_queue.h"
+#include "mpmc_queue.h"
+#include "work_stealing_deque.h"
 #include "tree.h"
 #include "set.h"
 #include "map.h"
 #include "hash_set.h"
 #include "hash_map.h"
+#include "string_view.h"
 #include "string.h"
+#include "string_format.h"
+#include "shared_string.h"
+#include "hashed_string.h"
+#include "rope.h"
+#include "data_encoding.h"
+#include "name.h"
@@ -11,21 +11,72 @@ namespace Korin
 	template<typename>           struct Optional;
 
 	template<typename...>                  class Tuple;
+	template<typename...>                  class SoAArray;
 	template<typename>                     class Stack;
 	template<typename>                     class Queue;
+	template<typename>                     class SpscQueue;
+	template<typename>                     class MpmcQueue;
+	template<typename>                     class WorkStealingDeque;
 	template<typename>                     class List;
+	template<typename>                     class Deque;
 	template<typename>                     class Array;
+	template<typename>                     class Span;
 	template<typename, typename>           class Tree;
 	template<typename, typename>           class Set;
 	template<typename, typename, typename> class Map;
 	template<typename, typename, typename> class HashMap;
 	template<typename, typename>           class HashSet;
 	template<typename>                     class StringBase;
+	template<typename>                     class StringViewBase;
+	template<typename>                     class SharedStringBase;
+	template<typename>                     class HashedStringBase;
+	template<typename, typename, typename> class StringConcat;
+	template<typename>                     class RopeBase;
+	template<typename>                     class SharedArray;
+	class                                  BitArray;
+	class                                  Name;
+	class                                  NameNoCase;
 
 	/**
 	 * @brief String type with 8-bit wide characters.
 	 */
 	using String = StringBase<ansichar>;
+
+	/**
+	 * @brief Non-owning view over 8-bit wide
+	 * characters.
+	 */
+	using StringView = StringViewBase<ansichar>;
+
+	/**
+	 * @brief String type with platform wide
+	 * characters, which hold UTF-16 or UTF-32
+	 * code units.
+	 */
+	using WideString = StringBase<widechar>;
+
+	/**
+	 * @brief Non-owning view over platform
+	 * wide characters.
+	 */
+	using WideStringView = StringViewBase<widechar>;
+
+	/**
+	 * @brief String type with 8-bit wide characters
+	 * shared between copies.
+	 */
+	using SharedString = SharedStringBase<ansichar>;
+
+	/**
+	 * @brief String type with 8-bit wide characters
+	 * that caches its hash key.
+	 */
+	using HashedString = HashedStringBase<ansichar>;
+
+	/**
+	 * @brief Rope with 8-bit wide characters.
+	 */
+	using Rope = RopeBase<ansichar>;
 } // namespace Korin
 
 #include "hash_types.h"
@@ -65,6 +116,12 @@ namespace Korin
 	template<typename T, typename HashPolicyT = typename ChooseHashPolicy<T>::Type>                      class HashSet;
 	template<typename KeyT, typename ValT, typename HashPolicyT = typename ChooseHashPolicy<KeyT>::Type> class HashMap;
 
+#ifndef KORIN_SEGMENTED_ARRAY_CHUNK_SIZE
+# define KORIN_SEGMENTED_ARRAY_CHUNK_SIZE 64
+#endif
+
+	template<typename T, sizet chunkSize = KORIN_SEGMENTED_ARRAY_CHUNK_SIZE> class SegmentedArray;
+
 	/**
 	 * @brief Returns true if the type is a tuple.
 	 *
@@ -127,6 +184,24 @@ namespace Korin
 	 */
 	template<typename ItT, typename PolicyT>
 	constexpr ItT findIf(ItT begin, ItT end, PolicyT&& policy);
+
+	/**
+	 * @brief Returns the number of items in
+	 * the given range.
+	 *
+	 * Iterators that support subtraction (e.g.
+	 * pointers) take constant time, other
+	 * iterators are walked from begin to end.
+	 *
+	 * @tparam ItT the type of the iterator
+	 * @param begin iter pointing to the first
+	 * item of the range
+	 * @param end iter pointing past the last
+	 * item of the range
+	 * @return number of items in the range
+	 */
+	template<typename ItT>
+	constexpr sizet distance(ItT begin, ItT end);
 } // namespace Korin
 
 // TODO: Definition for iseqFor does not live
@@ -12,6 +12,30 @@ namespace Korin
 		return arr.getNumItems();
 	}
 
+	template<typename T>
+	constexpr sizet len(Span<T> const& span)
+	{
+		return span.getNumItems();
+	}
+
+	template<typename T, sizet chunkSize>
+	constexpr sizet len(SegmentedArray<T, chunkSize> const& arr)
+	{
+		return arr.getNumItems();
+	}
+
+	template<typename ...ItemsT>
+	constexpr sizet len(SoAArray<ItemsT...> const& arr)
+	{
+		return arr.getNumItems();
+	}
+
+	template<typename T>
+	constexpr sizet len(Deque<T> const& deque)
+	{
+		return deque.getNumItems();
+	}
+
 	template<typename T, typename PolicyT>
 	constexpr sizet len(Set<T, PolicyT> const& set)
 	{
@@ -57,6 +81,21 @@ namespace Korin
 
 		return end;
 	}
+
+	template<typename ItT>
+	constexpr sizet distance(ItT begin, ItT end)
+	{
+		if constexpr (requires { end - begin; })
+		{
+			return static_cast<sizet>(end - begin);
+		}
+		else
+		{
+			sizet numItems = 0;
+			for (; begin != end; ++begin, ++numItems);
+			return numItems;
+		}
+	}
 }
 
 template<typename ...ItemsT>
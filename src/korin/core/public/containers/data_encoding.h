@@ -0,0 +1,273 @@
+#pragma once
+
+#include "core_types.h"
+#include "hal/platform_string.h"
+#include "string_view.h"
+#include "string.h"
+#include "array.h"
+#include "optional.h"
+
+namespace Korin
+{
+	/**
+	 * @brief Options of the base64 encoding.
+	 */
+	struct Base64Options
+	{
+		/* Whether to use - and _ instead of + and /, as in RFC 4648 §5. */
+		bool urlSafe = false;
+
+		/* Whether to pad the encoding with = to a multiple of 4 characters. Decoding accepts both. */
+		bool padding = true;
+	};
+
+	namespace DataEncoding_Impl
+	{
+		/**
+		 * @brief Writes the error position and
+		 * returns an empty optional.
+		 */
+		FORCE_INLINE Optional<ubyte*> decodeError(sizet* errorPos, sizet pos)
+		{
+			if (errorPos)
+			{
+				*errorPos = pos;
+			}
+
+			return {};
+		}
+
+		/**
+		 * @brief Returns the number of base64
+		 * characters before the padding. Padding
+		 * is only stripped from encodings whose
+		 * length is a multiple of 4.
+		 */
+		constexpr FORCE_INLINE sizet getUnpaddedLength(StringView src)
+		{
+			sizet len = src.getLength();
+			if (len % 4 == 0 && len > 0 && src[len - 1] == '=')
+			{
+				len -= 1 + (src[len - 2] == '=');
+			}
+
+			return len;
+		}
+	} // namespace DataEncoding_Impl
+
+	/**
+	 * @brief Returns the number of characters
+	 * of the hex encoding of n Bytes.
+	 */
+	constexpr FORCE_INLINE sizet hexEncodedLength(sizet n)
+	{
+		return 2 * n;
+	}
+
+	/**
+	 * @brief Returns the number of characters
+	 * of the base64 encoding of n Bytes.
+	 */
+	constexpr FORCE_INLINE sizet base64EncodedLength(sizet n, Base64Options const& options = {})
+	{
+		return options.padding ? (n + 2) / 3 * 4 : (4 * n + 2) / 3;
+	}
+
+	/**
+	 * @brief Returns the number of Bytes
+	 * encoded by a valid base64 encoding,
+	 * with or without padding.
+	 */
+	constexpr FORCE_INLINE sizet base64DecodedLength(StringView src)
+	{
+		return DataEncoding_Impl::getUnpaddedLength(src) * 3 / 4;
+	}
+
+	/**
+	 * @brief Writes the hex encoding of a
+	 * buffer, two digits per Byte.
+	 *
+	 * ```
+	 * ansichar digits[hexEncodedLength(sizeof(hash))];
+	 * encodeHex(&hash, sizeof(hash), digits);
+	 * ```
+	 *
+	 * @param src ptr to the Bytes
+	 * @param n number of Bytes
+	 * @param dst ptr to a buffer with room for
+	 * hexEncodedLength(n) characters
+	 * @param upperCase whether to write the
+	 * letters in upper case
+	 * @return ptr past the last character
+	 */
+	FORCE_INLINE ansichar* encodeHex(void const* src, sizet n, ansichar* dst, bool upperCase = false)
+	{
+		PlatformString::encodeHex(static_cast<ubyte const*>(src), n, dst, upperCase);
+		return dst + hexEncodedLength(n);
+	}
+
+	/**
+	 * @brief Reads the Bytes of a hex
+	 * encoding, in either case.
+	 *
+	 * @param src the hex digits
+	 * @param dst ptr to a buffer with room for
+	 * half the digits
+	 * @param errorPos if not null, on error
+	 * receives the index of the first invalid
+	 * digit, or the length of the view if it
+	 * is odd
+	 * @return ptr past the last Byte
+	 * @return empty optional on error
+	 */
+	FORCE_INLINE Optional<ubyte*> decodeHex(StringView src, void* dst, sizet* errorPos = nullptr)
+	{
+		sizet const len = src.getLength();
+		if (len % 2 != 0)
+		{
+			return DataEncoding_Impl::decodeError(errorPos, len);
+		}
+
+		ubyte* const bytes = static_cast<ubyte*>(dst);
+		if (sizet const pos = PlatformString::decodeHex(*src, len, bytes); pos < len)
+		{
+			return DataEncoding_Impl::decodeError(errorPos, pos);
+		}
+
+		return bytes + len / 2;
+	}
+
+	/**
+	 * @brief Writes the base64 encoding of a
+	 * buffer, as in RFC 4648.
+	 *
+	 * @param src ptr to the Bytes
+	 * @param n number of Bytes
+	 * @param dst ptr to a buffer with room for
+	 * base64EncodedLength(n, options)
+	 * characters
+	 * @param options alphabet and padding
+	 * @return ptr past the last character
+	 */
+	FORCE_INLINE ansichar* encodeBase64(void const* src, sizet n, ansichar* dst, Base64Options const& options = {})
+	{
+		PlatformString::encodeBase64(static_cast<ubyte const*>(src), n, dst, options.urlSafe);
+
+		ansichar* it = dst + (4 * n + 2) / 3;
+		if (options.padding)
+		{
+			for (; (it - dst) % 4 != 0; *it++ = '=');
+		}
+
+		return it;
+	}
+
+	/**
+	 * @brief Reads the Bytes of a base64
+	 * encoding, with or without padding. The
+	 * unused bits of the last character must
+	 * be zero.
+	 *
+	 * @param src the characters
+	 * @param dst ptr to a buffer with room for
+	 * base64DecodedLength(src) Bytes
+	 * @param options alphabet, the padding
+	 * option is ignored
+	 * @param errorPos if not null, on error
+	 * receives the index of the first invalid
+	 * character, or the length of the view if
+	 * it has the wrong length
+	 * @return ptr past the last Byte
+	 * @return empty optional on error
+	 */
+	FORCE_INLINE Optional<ubyte*> decodeBase64(StringView src, void* dst, Base64Options const& options = {}, sizet* errorPos = nullptr)
+	{
+		sizet const len = DataEncoding_Impl::getUnpaddedLength(src);
+		if (len % 4 == 1)
+		{
+			return DataEncoding_Impl::decodeError(errorPos, src.getLength());
+		}
+
+		ubyte* const bytes = static_cast<ubyte*>(dst);
+		if (sizet const pos = PlatformString::decodeBase64(*src, len, bytes, options.urlSafe); pos < len)
+		{
+			return DataEncoding_Impl::decodeError(errorPos, pos);
+		}
+
+		return bytes + len * 3 / 4;
+	}
+
+	/**
+	 * @brief Returns the hex encoding of a
+	 * buffer.
+	 * @see encodeHex
+	 */
+	FORCE_INLINE String toHex(void const* src, sizet n, bool upperCase = false)
+	{
+		return String::create(hexEncodedLength(n), [=](ansichar* dst) {
+
+			encodeHex(src, n, dst, upperCase);
+		});
+	}
+
+	/**
+	 * @brief Returns the base64 encoding of a
+	 * buffer.
+	 * @see encodeBase64
+	 */
+	FORCE_INLINE String toBase64(void const* src, sizet n, Base64Options const& options = {})
+	{
+		return String::create(base64EncodedLength(n, options), [&](ansichar* dst) {
+
+			encodeBase64(src, n, dst, options);
+		});
+	}
+
+	/**
+	 * @brief Returns the Bytes of a hex
+	 * encoding.
+	 * @see decodeHex
+	 *
+	 * @return the Bytes
+	 * @return empty optional on error
+	 */
+	inline Optional<Array<ubyte>> fromHex(StringView src, sizet* errorPos = nullptr)
+	{
+		bool valid = false;
+		Array<ubyte> bytes = Array<ubyte>::create(src.getLength() / 2, [&](ubyte* dst) {
+
+			valid = decodeHex(src, dst, errorPos).hasValue();
+		});
+
+		if (!valid)
+		{
+			return {};
+		}
+
+		return move(bytes);
+	}
+
+	/**
+	 * @brief Returns the Bytes of a base64
+	 * encoding.
+	 * @see decodeBase64
+	 *
+	 * @return the Bytes
+	 * @return empty optional on error
+	 */
+	inline Optional<Array<ubyte>> fromBase64(StringView src, Base64Options const& options = {}, sizet* errorPos = nullptr)
+	{
+		bool valid = false;
+		Array<ubyte> bytes = Array<ubyte>::create(base64DecodedLength(src), [&](ubyte* dst) {
+
+			valid = decodeBase64(src, dst, options, errorPos).hasValue();
+		});
+
+		if (!valid)
+		{
+			return {};
+		}
+
+		return move(bytes);
+	}
+} // namespace Korin
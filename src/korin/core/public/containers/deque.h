@@ -0,0 +1,744 @@
+#pragma once
+
+#include "containers_types.h"
+#include "templates/utility.h"
+#include "hal/platform_memory.h"
+#include "hal/platform_math.h"
+
+namespace Korin
+{
+	template<typename> class DequeIterator;
+	template<typename> class DequeConstIterator;
+
+	/**
+	 * @brief Iterator used to iterate over the
+	 * items of a deque.
+	 *
+	 * @tparam T the type of the items
+	 */
+	template<typename T>
+	class DequeIterator
+	{
+		friend Deque<T>;
+		friend DequeConstIterator<T>;
+
+		using SelfT = DequeIterator;
+
+	public:
+		using RefT = T&;
+		using PtrT = T*;
+
+		FORCE_INLINE DequeIterator(Deque<T>* inDeque, sizet inIdx)
+			: deque{inDeque}
+			, idx{inIdx}
+		{
+			//
+		}
+
+		FORCE_INLINE RefT operator*() const
+		{
+			return (*deque)[idx];
+		}
+
+		FORCE_INLINE PtrT operator->() const
+		{
+			return &(**this);
+		}
+
+		FORCE_INLINE bool operator==(SelfT const& other) const
+		{
+			return idx == other.idx;
+		}
+
+		FORCE_INLINE bool operator!=(SelfT const& other) const
+		{
+			return !(*this == other);
+		}
+
+		FORCE_INLINE SelfT& operator++()
+		{
+			++idx;
+			return *this;
+		}
+
+		FORCE_INLINE SelfT operator++(int32)
+		{
+			SelfT copy{*this};
+			++idx;
+			return copy;
+		}
+
+		FORCE_INLINE SelfT& operator--()
+		{
+			--idx;
+			return *this;
+		}
+
+		FORCE_INLINE SelfT operator--(int32)
+		{
+			SelfT copy{*this};
+			--idx;
+			return copy;
+		}
+
+	protected:
+		/* Deque being iterated. */
+		Deque<T>* deque;
+
+		/* Index of the current item. */
+		sizet idx;
+	};
+
+	/**
+	 * @brief Constant iterator for deques.
+	 * @see DequeIterator
+	 *
+	 * @tparam T the type of the items
+	 */
+	template<typename T>
+	class DequeConstIterator
+	{
+		friend Deque<T>;
+
+		using SelfT = DequeConstIterator;
+
+	public:
+		using RefT = T const&;
+		using PtrT = T const*;
+
+		FORCE_INLINE DequeConstIterator(Deque<T> const* inDeque, sizet inIdx)
+			: deque{inDeque}
+			, idx{inIdx}
+		{
+			//
+		}
+
+		FORCE_INLINE DequeConstIterator(DequeIterator<T> const& other)
+			: deque{other.deque}
+			, idx{other.idx}
+		{
+			//
+		}
+
+		FORCE_INLINE RefT operator*() const
+		{
+			return (*deque)[idx];
+		}
+
+		FORCE_INLINE PtrT operator->() const
+		{
+			return &(**this);
+		}
+
+		FORCE_INLINE bool operator==(SelfT const& other) const
+		{
+			return idx == other.idx;
+		}
+
+		FORCE_INLINE bool operator!=(SelfT const& other) const
+		{
+			return !(*this == other);
+		}
+
+		FORCE_INLINE SelfT& operator++()
+		{
+			++idx;
+			return *this;
+		}
+
+		FORCE_INLINE SelfT operator++(int32)
+		{
+			SelfT copy{*this};
+			++idx;
+			return copy;
+		}
+
+		FORCE_INLINE SelfT& operator--()
+		{
+			--idx;
+			return *this;
+		}
+
+		FORCE_INLINE SelfT operator--(int32)
+		{
+			SelfT copy{*this};
+			--idx;
+			return copy;
+		}
+
+	protected:
+		/* Deque being iterated. */
+		Deque<T> const* deque;
+
+		/* Index of the current item. */
+		sizet idx;
+	};
+
+	/**
+	 * @brief A double-ended queue that stores
+	 * its items in fixed-size chunks.
+	 *
+	 * A map of chunk pointers covers the items;
+	 * pushing at either end only allocates a new
+	 * chunk when the current edge chunk is full,
+	 * and random access costs a shift, a mask
+	 * and an indirection. Items are never moved
+	 * once constructed. When the map runs out of
+	 * slots at one end, the chunk pointers are
+	 * recentered (and the map grown if more than
+	 * half full), so a deque used as a FIFO
+	 * queue does not grow indefinitely.
+	 *
+	 * The last released chunk is kept aside and
+	 * reused by the next push that needs one, to
+	 * avoid allocator traffic at chunk
+	 * boundaries.
+	 *
+	 * @tparam T the type of the items
+	 */
+	template<typename T>
+	class Deque
+	{
+		friend DequeIterator<T>;
+		friend DequeConstIterator<T>;
+
+		/* Number of items in a chunk, about 512 Bytes worth. */
+		static constexpr sizet chunkSize = PlatformMath::roundUpToPowerOfTwo(PlatformMath::max(sizet(512 / sizeof(T)), sizet(16)));
+
+		/* Shift used to compute the chunk index. */
+		static constexpr sizet chunkShift = PlatformMath::floorLog2(chunkSize);
+
+		/* Mask used to compute the index within a chunk. */
+		static constexpr sizet chunkMask = chunkSize - 1;
+
+		/* Minimum number of slots in the map. */
+		static constexpr sizet minMapSize = 8;
+
+		/**
+		 * @brief Returns a ptr to the slot at the
+		 * given position.
+		 */
+		FORCE_INLINE T* getSlot(sizet pos) const
+		{
+			return map[pos >> chunkShift] + (pos & chunkMask);
+		}
+
+		/**
+		 * @brief Make sure the chunk that contains
+		 * the given position is allocated.
+		 */
+		FORCE_INLINE void ensureChunk(sizet pos)
+		{
+			T*& chunk = map[pos >> chunkShift];
+			if (!chunk)
+			{
+				if (spareChunk)
+				{
+					// Reuse last released chunk
+					chunk = spareChunk;
+					spareChunk = nullptr;
+				}
+				else
+				{
+					constexpr sizet alignment = PlatformMath::max(sizet(alignof(T)), sizet(MIN_ALIGNMENT));
+					chunk = reinterpret_cast<T*>(gMalloc->malloc(chunkSize * sizeof(T), alignment));
+				}
+			}
+		}
+
+		/**
+		 * @brief Release the chunk that contains
+		 * the given position.
+		 */
+		FORCE_INLINE void releaseChunk(sizet pos)
+		{
+			T*& chunk = map[pos >> chunkShift];
+			if (spareChunk)
+			{
+				gMalloc->free(spareChunk);
+			}
+
+			spareChunk = chunk;
+			chunk = nullptr;
+		}
+
+		/**
+		 * @brief Recenter the chunks in the map,
+		 * growing the map if necessary.
+		 *
+		 * @param numExtraChunks number of chunks
+		 * that must fit at both ends
+		 */
+		void remap(sizet numExtraChunks = 1)
+		{
+			// Range of chunks in use. An empty deque only
+			// keeps the chunk of its head if the head is not
+			// at the start of a chunk, which may be past the
+			// end of the map
+			sizet const firstChunk = head >> chunkShift;
+			sizet const numUsedChunks = count > 0 ? ((head + count - 1) >> chunkShift) - firstChunk + 1 : (head & chunkMask ? 1 : 0);
+
+			sizet newMapSize = PlatformMath::max(mapSize, minMapSize);
+			for (; newMapSize < 2 * (numUsedChunks + numExtraChunks); newMapSize <<= 1);
+
+			T** newMap = map;
+			if (newMapSize != mapSize)
+			{
+				newMap = reinterpret_cast<T**>(gMalloc->malloc(newMapSize * sizeof(T*), alignof(T*)));
+			}
+
+			// Move chunk pointers to the center of the map
+			sizet const newFirstChunk = (newMapSize - numUsedChunks) / 2;
+			if (numUsedChunks > 0)
+			{
+				PlatformMemory::memmove(newMap + newFirstChunk, map + firstChunk, numUsedChunks * sizeof(T*));
+			}
+
+			// Clear all other slots
+			for (sizet i = 0; i < newFirstChunk; ++i)
+			{
+				newMap[i] = nullptr;
+			}
+
+			for (sizet i = newFirstChunk + numUsedChunks; i < newMapSize; ++i)
+			{
+				newMap[i] = nullptr;
+			}
+
+			if (newMap != map && map)
+			{
+				gMalloc->free(map);
+			}
+
+			map = newMap;
+			mapSize = newMapSize;
+			head = (newFirstChunk << chunkShift) + (head & chunkMask);
+		}
+
+		/**
+		 * @brief Destroy all items and release all
+		 * chunks and the map.
+		 */
+		void destroy()
+		{
+			for (sizet pos = head; pos != head + count; ++pos)
+			{
+				destroyItems(getSlot(pos), 1);
+			}
+
+			for (sizet i = 0; i < mapSize; ++i)
+			{
+				if (map[i])
+				{
+					gMalloc->free(map[i]);
+				}
+			}
+
+			if (map)
+			{
+				gMalloc->free(map);
+			}
+
+			if (spareChunk)
+			{
+				gMalloc->free(spareChunk);
+			}
+
+			map = nullptr;
+			spareChunk = nullptr;
+			mapSize = head = count = 0;
+		}
+
+	public:
+		using IteratorT = DequeIterator<T>;
+		using ConstIteratorT = DequeConstIterator<T>;
+
+		/**
+		 * @brief Construct an empty deque.
+		 */
+		FORCE_INLINE Deque()
+			: map{nullptr}
+			, mapSize{0}
+			, head{0}
+			, count{0}
+			, spareChunk{nullptr}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a copy of another deque.
+		 *
+		 * @param other another deque
+		 */
+		Deque(Deque const& other)
+			: Deque{}
+		{
+			for (T const& item : other)
+			{
+				emplaceBack(item);
+			}
+		}
+
+		/**
+		 * @brief Move another deque.
+		 *
+		 * @param other another deque
+		 */
+		Deque(Deque&& other)
+			: map{other.map}
+			, mapSize{other.mapSize}
+			, head{other.head}
+			, count{other.count}
+			, spareChunk{other.spareChunk}
+		{
+			other.map = nullptr;
+			other.spareChunk = nullptr;
+			other.mapSize = other.head = other.count = 0;
+		}
+
+		/**
+		 * @brief Replace the items of this deque
+		 * with a copy of another deque's.
+		 *
+		 * @param other another deque
+		 * @return ref to self
+		 */
+		Deque& operator=(Deque const& other)
+		{
+			if (this != &other)
+			{
+				destroy();
+				for (T const& item : other)
+				{
+					emplaceBack(item);
+				}
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Destroy this deque and move
+		 * another deque.
+		 *
+		 * @param other another deque
+		 * @return ref to self
+		 */
+		Deque& operator=(Deque&& other)
+		{
+			// Swap with the other deque, which will then be destroyed
+			swap(map, other.map);
+			swap(mapSize, other.mapSize);
+			swap(head, other.head);
+			swap(count, other.count);
+			swap(spareChunk, other.spareChunk);
+
+			return *this;
+		}
+
+		/**
+		 * @brief Destroy the deque and all its
+		 * items.
+		 */
+		FORCE_INLINE ~Deque()
+		{
+			destroy();
+		}
+
+		/**
+		 * @brief Returns the number of items in
+		 * the deque.
+		 */
+		FORCE_INLINE sizet getNumItems() const
+		{
+			return count;
+		}
+
+		/**
+		 * @brief Returns true if the deque has no
+		 * items.
+		 */
+		FORCE_INLINE bool isEmpty() const
+		{
+			return count == 0;
+		}
+
+		/**
+		 * @brief Returns a ref to the i-th item.
+		 *
+		 * @param idx index of the item
+		 * @return ref to the item
+		 * @{
+		 */
+		FORCE_INLINE T& operator[](uint64 idx)
+		{
+			CHECK(idx < count)
+			return *getSlot(head + idx);
+		}
+
+		FORCE_INLINE T const& operator[](uint64 idx) const
+		{
+			CHECK(idx < count)
+			return *getSlot(head + idx);
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns a ref to the first item.
+		 * The deque must not be empty.
+		 * @{
+		 */
+		FORCE_INLINE T& getFirst()
+		{
+			return (*this)[0];
+		}
+
+		FORCE_INLINE T const& getFirst() const
+		{
+			return (*this)[0];
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns a ref to the last item.
+		 * The deque must not be empty.
+		 * @{
+		 */
+		FORCE_INLINE T& getLast()
+		{
+			return (*this)[count - 1];
+		}
+
+		FORCE_INLINE T const& getLast() const
+		{
+			return (*this)[count - 1];
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns an iterator that points
+		 * to the first item of the deque.
+		 * @{
+		 */
+		FORCE_INLINE IteratorT begin()
+		{
+			return {this, 0};
+		}
+
+		FORCE_INLINE ConstIteratorT begin() const
+		{
+			return {this, 0};
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns an iterator that points
+		 * past the last item of the deque.
+		 * @{
+		 */
+		FORCE_INLINE IteratorT end()
+		{
+			return {this, count};
+		}
+
+		FORCE_INLINE ConstIteratorT end() const
+		{
+			return {this, count};
+		}
+		/** @} */
+
+		/**
+		 * @brief Construct a new item at the end
+		 * of the deque.
+		 *
+		 * @param createArgs arguments used to
+		 * construct the item
+		 * @return ref to the new item
+		 */
+		T& emplaceBack(auto&& ...createArgs)
+		{
+			if (UNLIKELY(((head + count) >> chunkShift) >= mapSize))
+			{
+				remap();
+			}
+
+			sizet const pos = head + count;
+			ensureChunk(pos);
+
+			T* item = new (getSlot(pos)) T{FORWARD(createArgs)...};
+			count++;
+			return *item;
+		}
+
+		/**
+		 * @brief Push an item at the end of the
+		 * deque.
+		 *
+		 * @param value item to copy or move
+		 * @{
+		 */
+		FORCE_INLINE void pushBack(T const& value)
+		{
+			emplaceBack(value);
+		}
+
+		FORCE_INLINE void pushBack(T&& value)
+		{
+			emplaceBack(move(value));
+		}
+		/** @} */
+
+		/**
+		 * @brief Construct a new item at the
+		 * beginning of the deque.
+		 *
+		 * @param createArgs arguments used to
+		 * construct the item
+		 * @return ref to the new item
+		 */
+		T& emplaceFront(auto&& ...createArgs)
+		{
+			if (UNLIKELY(head == 0))
+			{
+				remap();
+			}
+
+			sizet const pos = head - 1;
+			ensureChunk(pos);
+
+			T* item = new (getSlot(pos)) T{FORWARD(createArgs)...};
+			head = pos;
+			count++;
+			return *item;
+		}
+
+		/**
+		 * @brief Push an item at the beginning of
+		 * the deque.
+		 *
+		 * @param value item to copy or move
+		 * @{
+		 */
+		FORCE_INLINE void pushFront(T const& value)
+		{
+			emplaceFront(value);
+		}
+
+		FORCE_INLINE void pushFront(T&& value)
+		{
+			emplaceFront(move(value));
+		}
+		/** @} */
+
+		/**
+		 * @brief Remove the last item of the deque
+		 * and return it. The deque must not be
+		 * empty.
+		 *
+		 * @return the removed item
+		 */
+		T popBack()
+		{
+			CHECK(count > 0)
+
+			sizet const pos = head + count - 1;
+			T* item = getSlot(pos);
+			T value{move(*item)};
+			destroyItems(item, 1);
+			count--;
+
+			if ((pos & chunkMask) == 0)
+			{
+				// First item of the chunk was removed
+				releaseChunk(pos);
+			}
+
+			return value;
+		}
+
+		/**
+		 * @brief Remove the last item of the deque,
+		 * if any.
+		 *
+		 * @param outValue item that receives the
+		 * removed item
+		 * @return true if an item was removed
+		 */
+		FORCE_INLINE bool popBack(T& outValue)
+		{
+			if (count == 0) return false;
+
+			outValue = popBack();
+			return true;
+		}
+
+		/**
+		 * @brief Remove the first item of the deque
+		 * and return it. The deque must not be
+		 * empty.
+		 *
+		 * @return the removed item
+		 */
+		T popFront()
+		{
+			CHECK(count > 0)
+
+			sizet const pos = head;
+			T* item = getSlot(pos);
+			T value{move(*item)};
+			destroyItems(item, 1);
+			head++;
+			count--;
+
+			if ((head & chunkMask) == 0)
+			{
+				// Last item of the chunk was removed
+				releaseChunk(pos);
+			}
+
+			return value;
+		}
+
+		/**
+		 * @brief Remove the first item of the deque,
+		 * if any.
+		 *
+		 * @param outValue item that receives the
+		 * removed item
+		 * @return true if an item was removed
+		 */
+		FORCE_INLINE bool popFront(T& outValue)
+		{
+			if (count == 0) return false;
+
+			outValue = popFront();
+			return true;
+		}
+
+		/**
+		 * @brief Remove all items and release all
+		 * memory.
+		 */
+		FORCE_INLINE void reset()
+		{
+			destroy();
+		}
+
+	protected:
+		/* Map of chunk pointers, null for unused slots. */
+		T** map;
+
+		/* Number of slots in the map. */
+		sizet mapSize;
+
+		/* Position of the first item. */
+		sizet head;
+
+		/* Number of items in the deque. */
+		sizet count;
+
+		/* Last released chunk, kept for reuse. */
+		T* spareChunk;
+	};
+} // namespace Korin
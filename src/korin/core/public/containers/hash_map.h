@@ -115,6 +115,23 @@ namespace Korin
 		}
 		/** @} */
 
+		/**
+		 * @brief Insert all the kv-pairs in the
+		 * given range. Pairs are skipped if a pair
+		 * with the same key already exists.
+		 *
+		 * The buckets are grown once to fit all
+		 * the items before inserting them.
+		 *
+		 * @tparam ItT the type of the iterator
+		 * @param first,last begin and end iterators
+		 */
+		template<typename ItT>
+		FORCE_INLINE void insert(ItT first, ItT last)
+		{
+			SuperT::findOrInsert(first, last);
+		}
+
 		/**
 		 * @brief Returns true if the map contains
 		 * a pair with the given key
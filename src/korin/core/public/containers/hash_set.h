@@ -215,6 +215,23 @@ namespace Korin
 		}
 		/** @} */
 
+		/**
+		 * @brief Insert all the items in the given
+		 * range. Items are skipped if an item with
+		 * the same key already exists.
+		 *
+		 * The buckets are grown once to fit all
+		 * the items before inserting them.
+		 *
+		 * @tparam ItT the type of the iterator
+		 * @param first,last begin and end iterators
+		 */
+		template<typename ItT>
+		FORCE_INLINE void insert(ItT first, ItT last)
+		{
+			SuperT::findOrInsert(first, last);
+		}
+
 		/**
 		 * @brief Removes the item identified by
 		 * the key.
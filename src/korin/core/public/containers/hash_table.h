@@ -412,6 +412,26 @@ namespace Korin
 		}
 		/** @} */
 
+		/**
+		 * @brief Insert all the items in the given
+		 * range, if no duplicate exists.
+		 *
+		 * The buckets are grown once to fit all
+		 * the items before inserting them.
+		 *
+		 * @tparam ItT the type of the iterator
+		 * @param first,last begin and end iterators
+		 */
+		template<typename ItT>
+		void findOrInsert(ItT first, ItT last)
+		{
+			reserve(Korin::distance(first, last));
+			for (; first != last; ++first)
+			{
+				findOrInsert(*first);
+			}
+		}
+
 		/**
 		 * @brief Remove the item pointed by the
 		 * given iterator from the table.
@@ -441,7 +461,10 @@ namespace Korin
 				// placeholder for the next bucket
 				// we need to udpate the placeholder
 				nextBucketIdx = getBucketIdx(node->next);
-				buckets[nextBucketIdx] = prev;
+				if (nextBucketIdx != bucketIdx)
+				{
+					buckets[nextBucketIdx] = prev;
+				}
 			}
 
 			if (prev == buckets[bucketIdx] && (!node->next || nextBucketIdx != bucketIdx))
@@ -610,8 +633,13 @@ namespace Korin
 			sizet const newNumItems = numItems + extraItems;
 			if (newNumItems / static_cast<float>(numBuckets) >= HASH_BUCKET_LOAD_FACTOR)
 			{
-				// Double the number of buckets
-				reallocBuckets(numBuckets << 1);
+				// Double the number of buckets until all
+				// items fit, so that items are rehashed once.
+				// A moved-from table has no buckets
+				sizet newNumBuckets = PlatformMath::max(numBuckets << 1, sizet(HASH_BUCKET_INITIAL_COUNT));
+				for (; newNumItems / static_cast<float>(newNumBuckets) >= HASH_BUCKET_LOAD_FACTOR; newNumBuckets <<= 1);
+
+				reallocBuckets(newNumBuckets);
 				return true;
 			}
 
@@ -717,6 +745,12 @@ namespace Korin
 		 */
 		BucketT* locateNode([[maybe_unused]] auto const& key, HashKey hkey)
 		{
+			if (numBuckets == 0)
+			{
+				// Moved-from table
+				return nullptr;
+			}
+
 			sizet const bucketIdx = getBucketIdx(hkey);
 			for (BucketT* it = getBucketFirstNode(bucketIdx);
 			     it && getBucketIdx(it->hkey) == bucketIdx;
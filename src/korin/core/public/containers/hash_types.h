@@ -16,6 +16,27 @@ namespace Korin
 	 */
 	using HashKey = uintp;
 
+	/**
+	 * @brief Returns a well distributed hash
+	 * of an integer, with a multiply-xorshift
+	 * mixer. Each bit of the input affects
+	 * all the bits of the output. The mixer
+	 * is a bijection, so distinct inputs have
+	 * distinct 64 bits hashes.
+	 *
+	 * @param x the integer to hash
+	 * @return the hash of x
+	 */
+	constexpr FORCE_INLINE HashKey hashInt(uint64 x)
+	{
+		x ^= x >> 32;
+		x *= 0xd6e8feb86659fd93ull;
+		x ^= x >> 32;
+		x *= 0xd6e8feb86659fd93ull;
+		x ^= x >> 32;
+		return static_cast<HashKey>(x);
+	}
+
 	namespace HashBucket_Impl
 	{
 		/**
@@ -45,8 +66,9 @@ namespace Korin
 		 * @brief Computes the hash of the key, using
 		 * the given hash function.
 		 *
-		 * The hash key may be further hashed to reduce
-		 * the number of collisions.
+		 * The hash key is further hashed to reduce
+		 * the number of collisions of user-defined
+		 * hash functions.
 		 *
 		 * @tparam HashT the type of the hash function
 		 * @param key the key object to hash
@@ -56,11 +78,7 @@ namespace Korin
 		template<typename HashT>
 		constexpr FORCE_INLINE HashKey computeHash(auto const& key, HashT&& h)
 		{
-			HashKey hkey = h(key);
-#if KORIN_RELEASE
-			hkey = hashKey(hkey);
-#endif
-			return hkey;
+			return hashKey(h(key));
 		}
 	} // namespace HashBucket_Impl
 
@@ -143,14 +161,15 @@ namespace Korin
 		template<typename IntT>
 		constexpr FORCE_INLINE typename EnableIf<IsIntegral<IntT>::value, HashKey>::Type operator()(IntT key) const
 		{
-			// Identity hash
-			return static_cast<HashKey>(key);
+			// Sequential keys must not fill
+			// adjacent buckets
+			return hashInt(static_cast<uint64>(key));
 		}
 
 		constexpr FORCE_INLINE HashKey operator()(double key) const
 		{
 			constexpr uint64 mask = ~0xfull;
-			return *reinterpret_cast<HashKey*>(&key) & mask;
+			return hashInt(*reinterpret_cast<uint64*>(&key) & mask);
 		}
 
 		constexpr FORCE_INLINE HashKey operator()(float key) const
@@ -173,4 +192,25 @@ namespace Korin
 	 * @return the hash of key
 	 */
 	HashKey murmur(void const* key, sizet len, HashKey seed = -1);
+
+	/**
+	 * @brief The default hash function of
+	 * Bytes and strings, suitable for
+	 * non-cryptographic uses. Faster and
+	 * better distributed than murmur.
+	 *
+	 * Inputs up to 2 KiB are hashed with
+	 * wyhash; longer inputs are accumulated
+	 * in stripes of 64 Bytes, like XXH3, with
+	 * AVX2 or SSE2 as chosen at runtime. The
+	 * hash is the same on all CPUs.
+	 *
+	 * https://github.com/wangyi-fudan/wyhash
+	 *
+	 * @param key data of the key to hash
+	 * @param len length of the data in Bytes
+	 * @param seed optional random seed
+	 * @return the hash of key
+	 */
+	HashKey hashBytes(void const* key, sizet len, HashKey seed = 0);
 } // namespace Korin
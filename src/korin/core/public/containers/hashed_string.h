@@ -0,0 +1,310 @@
+#pragma once
+
+#include "templates/enable_if.h"
+#include "templates/types.h"
+#include "containers_types.h"
+#include "hash_types.h"
+#include "string_view.h"
+#include "string.h"
+
+namespace Korin
+{
+	/**
+	 * @brief A string that caches its hash key.
+	 *
+	 * The hash key is computed when the string
+	 * is created or modified, so hash containers
+	 * never hash the characters again, and
+	 * strings with different hash keys compare
+	 * unequal without looking at the characters.
+	 * Use it for long keys that are looked up
+	 * many times; short keys and keys that are
+	 * modified often are better served by
+	 * @c StringBase.
+	 *
+	 * The characters can be read but not
+	 * modified in place, which would invalidate
+	 * the hash key.
+	 *
+	 * @tparam CharT the type of the characters
+	 */
+	template<typename CharT>
+	class HashedStringBase
+	{
+	public:
+		using StringSourceT = StringSource<CharT>;
+		using StringViewT = StringViewBase<CharT>;
+
+		/**
+		 * @brief Construct an empty string.
+		 */
+		FORCE_INLINE HashedStringBase()
+			: str{}
+			, hkey{StringViewT{}.toHashKey()}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a string with a copy of
+		 * any string source.
+		 *
+		 * @param src string source
+		 */
+		FORCE_INLINE HashedStringBase(StringSourceT const& src)
+			: str{src}
+			, hkey{StringViewT{str}.toHashKey()}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a string from a
+		 * null-terminated string.
+		 *
+		 * @param cstr pointer to C string
+		 */
+		FORCE_INLINE HashedStringBase(CharT const* cstr)
+			: HashedStringBase{StringSourceT{cstr}}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a string by reading
+		 * @c len characters from source.
+		 *
+		 * @param src pointer to buffer to read from
+		 * @param len number of characters to read
+		 */
+		FORCE_INLINE HashedStringBase(CharT const* src, sizet len)
+			: HashedStringBase{StringSourceT{src, len}}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a string by taking the
+		 * characters of another string.
+		 *
+		 * @param other string to move
+		 */
+		FORCE_INLINE explicit HashedStringBase(StringBase<CharT>&& other)
+			: str{move(other)}
+			, hkey{StringViewT{str}.toHashKey()}
+		{
+			//
+		}
+
+		/**
+		 * @brief Returns the length of the string
+		 * (excluding the terminating character).
+		 */
+		FORCE_INLINE sizet getLength() const
+		{
+			return str.getLength();
+		}
+
+		/**
+		 * @brief Returns true if the string is
+		 * empty.
+		 */
+		FORCE_INLINE bool isEmpty() const
+		{
+			return getLength() == 0;
+		}
+
+		/**
+		 * @brief Returns a ref to the i-th
+		 * character of the string.
+		 *
+		 * @param idx index of the character
+		 * @return ref to character
+		 */
+		FORCE_INLINE CharT const& operator[](int32 idx) const
+		{
+			return str[idx];
+		}
+
+		/**
+		 * @brief Returns a pointer to the
+		 * null-terminated C string.
+		 */
+		FORCE_INLINE CharT const* operator*() const
+		{
+			return *str;
+		}
+
+		/**
+		 * @brief Returns a ref to the underlying
+		 * string.
+		 */
+		FORCE_INLINE StringBase<CharT> const& getString() const
+		{
+			return str;
+		}
+
+		/**
+		 * @brief Returns the cached hash key, which
+		 * is equal to the hash key of the other
+		 * string types.
+		 */
+		FORCE_INLINE HashKey toHashKey() const
+		{
+			return hkey;
+		}
+
+		/**
+		 * @brief Compare two strings. Strings with
+		 * different hash keys are unequal, only
+		 * strings with the same hash key compare
+		 * their characters.
+		 *
+		 * @param other another hashed string
+		 * @return true if strings are equal
+		 * @return false otherwise
+		 * @{
+		 */
+		template<typename OtherT>
+		FORCE_INLINE typename EnableIf<SameType<OtherT, HashedStringBase>::value, bool>::Type operator==(OtherT const& other) const
+		{
+			return hkey == other.hkey && str == StringViewT{other.str};
+		}
+
+		template<typename OtherT>
+		FORCE_INLINE typename EnableIf<SameType<OtherT, HashedStringBase>::value, bool>::Type operator!=(OtherT const& other) const
+		{
+			return !(*this == other);
+		}
+		/** @} */
+
+		/**
+		 * @brief Compare with any string view.
+		 *
+		 * @param other another string
+		 * @return true if strings are equal
+		 * @return false otherwise
+		 * @{
+		 */
+		FORCE_INLINE bool operator==(StringViewT const& other) const
+		{
+			return str == other;
+		}
+
+		FORCE_INLINE bool operator!=(StringViewT const& other) const
+		{
+			return !(*this == other);
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns true if this string precedes
+		 * the other string in alphabetical order.
+		 *
+		 * @param other another string
+		 * @return true if this string precedes other
+		 * @return false otherwise
+		 */
+		FORCE_INLINE bool operator<(StringViewT const& other) const
+		{
+			return str < other;
+		}
+
+		/**
+		 * @brief Returns true if this string succeeds
+		 * the other string in alphabetical order.
+		 *
+		 * @param other another string
+		 * @return true if this string succeeds other
+		 * @return false otherwise
+		 */
+		FORCE_INLINE bool operator>(StringViewT const& other) const
+		{
+			return str > other;
+		}
+
+		/**
+		 * @brief Append a character to the end of the
+		 * string, and compute the new hash key.
+		 *
+		 * @param c the character to append
+		 * @return ref to self
+		 */
+		FORCE_INLINE HashedStringBase& operator+=(CharT c)
+		{
+			return *this += StringSourceT{&c, 1};
+		}
+
+		/**
+		 * @brief Append another string source to this
+		 * string, and compute the new hash key.
+		 *
+		 * @param other any string source
+		 * @return ref to self
+		 */
+		FORCE_INLINE HashedStringBase& operator+=(StringSourceT const& other)
+		{
+			str += other;
+			hkey = StringViewT{str}.toHashKey();
+
+			return *this;
+		}
+
+	protected:
+		/* The characters of the string. */
+		StringBase<CharT> str;
+
+		/* Hash key of the characters. */
+		HashKey hkey;
+	};
+
+	/**
+	 * @brief Hashed strings are sorted in
+	 * alphabetical order, and can be compared
+	 * with any string view.
+	 *
+	 * @tparam CharT the type of a string character
+	 */
+	template<typename CharT>
+	struct ChoosePolicy<HashedStringBase<CharT>> : public ChoosePolicy<StringViewBase<CharT>>
+	{
+		//
+	};
+
+	/**
+	 * @brief Specialization for hashing hashed
+	 * string keys. Hashed strings return the
+	 * cached hash key, other keys hash their
+	 * characters to the same key.
+	 *
+	 * @tparam CharT the type of a string character
+	 */
+	template<typename CharT>
+	struct ChooseHashPolicy<HashedStringBase<CharT>>
+	{
+		using Type = struct HashHashedString
+		{
+			using StringViewT = StringViewBase<CharT>;
+
+			/**
+			 * @brief Returns the hash key for the given
+			 * string.
+			 *
+			 * @param key the key string to hash
+			 * @return the corresponding hash key
+			 * @{
+			 */
+			FORCE_INLINE HashKey operator()(HashedStringBase<CharT> const& key) const
+			{
+				return key.toHashKey();
+			}
+
+			template<typename KeyT>
+			FORCE_INLINE HashKey operator()(KeyT const& key) const
+			{
+				return StringViewT{key}.toHashKey();
+			}
+			/** @} */
+		};
+	};
+} // namespace Korin
@@ -201,6 +201,21 @@ namespace Korin
 		}
 		/** @} */
 
+		/**
+		 * @brief Insert all the kv-pairs in the given
+		 * range. Pairs with an existing key replace
+		 * the existing pair. Ranges sorted by key are
+		 * inserted faster.
+		 *
+		 * @tparam ItT the iterator type
+		 * @param first,last begin and end iterators
+		 */
+		template<typename ItT>
+		FORCE_INLINE void insert(ItT first, ItT last)
+		{
+			tree.insertUnique(first, last);
+		}
+
 		/**
 		 * @brief Attempts to find a kv-pair matching
 		 * the given key, and constructs a new kv-pair
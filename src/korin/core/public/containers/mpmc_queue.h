@@ -0,0 +1,499 @@
+#pragma once
+
+#include "containers_types.h"
+#include "span.h"
+#include "templates/utility.h"
+#include "hal/platform_memory.h"
+#include "hal/platform_math.h"
+#include "hal/atomic.h"
+
+namespace Korin
+{
+	namespace MpmcQueue_Impl
+	{
+		/**
+		 * @brief A slot of the queue. The sequence
+		 * number tells whether the slot is free or
+		 * holds an item, and for which lap.
+		 */
+		template<typename T>
+		struct Slot
+		{
+			/* Sequence number of the slot. */
+			Atomic<sizet> sequence;
+
+			/* Storage for the item. */
+			alignas(T) ubyte item[sizeof(T)];
+
+			/**
+			 * @brief Returns a ptr to the item.
+			 */
+			FORCE_INLINE T* getItem()
+			{
+				return reinterpret_cast<T*>(item);
+			}
+		};
+	} // namespace MpmcQueue_Impl
+
+	/**
+	 * @brief A bounded queue that can be shared
+	 * by any number of producers and consumers.
+	 *
+	 * Each slot of the ring buffer carries a
+	 * sequence number, so that producers and
+	 * consumers only contend on their own index
+	 * and never on each other's. The try methods
+	 * are lock-free and fail if the queue is full
+	 * (or empty). The blocking methods park the
+	 * thread until the operation succeeds.
+	 *
+	 * Batch methods claim a run of consecutive
+	 * slots with a single atomic operation.
+	 *
+	 * @tparam T the type of the items
+	 */
+	template<typename T>
+	class MpmcQueue
+	{
+		using SlotT = MpmcQueue_Impl::Slot<T>;
+
+		/**
+		 * @brief Returns the signed distance
+		 * between a sequence number and a
+		 * position.
+		 */
+		static FORCE_INLINE intp getLag(sizet sequence, sizet pos)
+		{
+			return static_cast<intp>(sequence - pos);
+		}
+
+		/**
+		 * @brief Claim up to the given number of
+		 * free slots for writing.
+		 *
+		 * @param maxSlots maximum number of slots
+		 * to claim
+		 * @param outPos position of the first
+		 * claimed slot
+		 * @return number of slots claimed
+		 */
+		sizet claimPush(sizet maxSlots, sizet& outPos)
+		{
+			sizet pos = pushPos.load(MemoryOrder::Relaxed);
+			for (;;)
+			{
+				// Count free slots from the current position
+				sizet numSlots = 0;
+				intp lag = 0;
+				for (; numSlots < maxSlots; ++numSlots)
+				{
+					lag = getLag(slots[(pos + numSlots) & mask].sequence.load(MemoryOrder::Acquire), pos + numSlots);
+					if (lag != 0)
+					{
+						break;
+					}
+				}
+
+				if (numSlots > 0)
+				{
+					if (pushPos.compareExchangeWeak(pos, pos + numSlots, MemoryOrder::Relaxed, MemoryOrder::Relaxed))
+					{
+						outPos = pos;
+						return numSlots;
+					}
+				}
+				else if (lag < 0)
+				{
+					// Queue is full
+					return 0;
+				}
+				else
+				{
+					// Another producer got here first
+					pos = pushPos.load(MemoryOrder::Relaxed);
+				}
+			}
+		}
+
+		/**
+		 * @brief Claim up to the given number of
+		 * full slots for reading.
+		 *
+		 * @param maxSlots maximum number of slots
+		 * to claim
+		 * @param outPos position of the first
+		 * claimed slot
+		 * @return number of slots claimed
+		 */
+		sizet claimPop(sizet maxSlots, sizet& outPos)
+		{
+			sizet pos = popPos.load(MemoryOrder::Relaxed);
+			for (;;)
+			{
+				// Count full slots from the current position
+				sizet numSlots = 0;
+				intp lag = 0;
+				for (; numSlots < maxSlots; ++numSlots)
+				{
+					lag = getLag(slots[(pos + numSlots) & mask].sequence.load(MemoryOrder::Acquire), pos + numSlots + 1);
+					if (lag != 0)
+					{
+						break;
+					}
+				}
+
+				if (numSlots > 0)
+				{
+					if (popPos.compareExchangeWeak(pos, pos + numSlots, MemoryOrder::Relaxed, MemoryOrder::Relaxed))
+					{
+						outPos = pos;
+						return numSlots;
+					}
+				}
+				else if (lag < 0)
+				{
+					// Queue is empty
+					return 0;
+				}
+				else
+				{
+					// Another consumer got here first
+					pos = popPos.load(MemoryOrder::Relaxed);
+				}
+			}
+		}
+
+		/**
+		 * @brief Wake threads blocked on the other
+		 * side of the queue, if any.
+		 *
+		 * The fence orders the preceding slot
+		 * update before the load of the number of
+		 * waiters, which pairs with the increment
+		 * in @c waitFor().
+		 *
+		 * @param epoch epoch the waiters wait on
+		 * @param numWaiters number of waiters
+		 */
+		static FORCE_INLINE void notify(Atomic<uint32>& epoch, Atomic<uint32>& numWaiters)
+		{
+			PlatformAtomics::threadFence();
+			if (UNLIKELY(numWaiters.load(MemoryOrder::Relaxed) > 0))
+			{
+				epoch.fetchAdd(1);
+				epoch.wakeAll();
+			}
+		}
+
+		/**
+		 * @brief Retry an operation until it
+		 * succeeds, blocking the thread on the
+		 * given epoch in between attempts.
+		 *
+		 * @param epoch epoch bumped by the other
+		 * side of the queue
+		 * @param numWaiters number of waiters
+		 * @param attempt operation to retry
+		 */
+		static void waitFor(Atomic<uint32>& epoch, Atomic<uint32>& numWaiters, auto&& attempt)
+		{
+			// Spin a little before parking the thread
+			for (int32 numSpins = 0; numSpins < 64; ++numSpins)
+			{
+				if (attempt())
+				{
+					return;
+				}
+
+				PlatformAtomics::yieldProcessor();
+			}
+
+			numWaiters.fetchAdd(1);
+			for (;;)
+			{
+				uint32 const expected = epoch.load();
+				if (attempt())
+				{
+					break;
+				}
+
+				epoch.wait(expected);
+			}
+
+			numWaiters.fetchSub(1);
+		}
+
+	public:
+		/**
+		 * @brief Construct an empty queue.
+		 *
+		 * @param minCapacity minimum number of
+		 * items the queue can hold, rounded up to
+		 * a power of two
+		 */
+		explicit MpmcQueue(sizet minCapacity)
+			: slots{nullptr}
+			, capacity{PlatformMath::roundUpToPowerOfTwo(PlatformMath::max(minCapacity, sizet(2)))}
+			, mask{capacity - 1}
+			, pushPos{0}
+			, popPos{0}
+			, pushEpoch{0}
+			, numPopWaiters{0}
+			, popEpoch{0}
+			, numPushWaiters{0}
+		{
+			constexpr sizet alignment = PlatformMath::max(sizet(alignof(SlotT)), sizet(PLATFORM_CACHE_LINE_SIZE));
+			slots = reinterpret_cast<SlotT*>(gMalloc->malloc(capacity * sizeof(SlotT), alignment));
+
+			for (sizet i = 0; i < capacity; ++i)
+			{
+				// Slot i is free for lap 0
+				new (&slots[i].sequence) Atomic<sizet>{i};
+			}
+		}
+
+		/**
+		 * @brief Queues are shared by many threads
+		 * and cannot be copied or moved.
+		 * @{
+		 */
+		MpmcQueue(MpmcQueue const&) = delete;
+		MpmcQueue& operator=(MpmcQueue const&) = delete;
+		/** @} */
+
+		/**
+		 * @brief Destroy the remaining items and
+		 * the slots. No thread may access the
+		 * queue anymore.
+		 */
+		~MpmcQueue()
+		{
+			sizet const begin = popPos.load(MemoryOrder::Acquire);
+			sizet const end = pushPos.load(MemoryOrder::Acquire);
+
+			for (sizet pos = begin; pos != end; ++pos)
+			{
+				destroyItems(slots[pos & mask].getItem(), 1);
+			}
+
+			gMalloc->free(slots);
+		}
+
+		/**
+		 * @brief Returns the maximum number of
+		 * items in the queue.
+		 */
+		FORCE_INLINE sizet getCapacity() const
+		{
+			return capacity;
+		}
+
+		/**
+		 * @brief Returns the approximate number of
+		 * items in the queue.
+		 */
+		FORCE_INLINE sizet getNumItems() const
+		{
+			sizet const begin = popPos.load(MemoryOrder::Acquire);
+			sizet const end = pushPos.load(MemoryOrder::Acquire);
+			return getLag(end, begin) > 0 ? end - begin : 0;
+		}
+
+		/**
+		 * @brief Returns true if the queue is
+		 * approximately empty.
+		 */
+		FORCE_INLINE bool isEmpty() const
+		{
+			return getNumItems() == 0;
+		}
+
+		/**
+		 * @brief Construct a new item at the back
+		 * of the queue.
+		 *
+		 * @param createArgs arguments used to
+		 * construct the item
+		 * @return true if the item was pushed,
+		 * false if the queue is full
+		 */
+		bool tryEmplace(auto&& ...createArgs)
+		{
+			sizet pos;
+			if (claimPush(1, pos) == 0)
+			{
+				return false;
+			}
+
+			SlotT& slot = slots[pos & mask];
+			new (slot.getItem()) T{FORWARD(createArgs)...};
+			slot.sequence.store(pos + 1, MemoryOrder::Release);
+
+			notify(pushEpoch, numPopWaiters);
+			return true;
+		}
+
+		/**
+		 * @brief Push an item at the back of the
+		 * queue.
+		 *
+		 * @param item item to copy or move
+		 * @return true if the item was pushed,
+		 * false if the queue is full
+		 */
+		FORCE_INLINE bool tryPush(auto&& item)
+		{
+			return tryEmplace(FORWARD(item));
+		}
+
+		/**
+		 * @brief Copy as many items as possible at
+		 * the back of the queue. Items pushed in
+		 * the same batch are popped in order.
+		 *
+		 * @param inItems items to push
+		 * @return number of items pushed
+		 */
+		sizet tryPushBatch(Span<T const> inItems)
+		{
+			if (inItems.isEmpty())
+			{
+				return 0;
+			}
+
+			sizet pos;
+			sizet const numItems = claimPush(inItems.getNumItems(), pos);
+			for (sizet i = 0; i < numItems; ++i)
+			{
+				SlotT& slot = slots[(pos + i) & mask];
+				copyConstructItems(slot.getItem(), &inItems[i], 1);
+				slot.sequence.store(pos + i + 1, MemoryOrder::Release);
+			}
+
+			if (numItems > 0)
+			{
+				notify(pushEpoch, numPopWaiters);
+			}
+
+			return numItems;
+		}
+
+		/**
+		 * @brief Push an item at the back of the
+		 * queue, blocking the thread while the
+		 * queue is full.
+		 *
+		 * @param item item to copy or move
+		 */
+		void push(auto&& item)
+		{
+			waitFor(popEpoch, numPushWaiters, [this, &item]() {
+
+				return tryPush(FORWARD(item));
+			});
+		}
+
+		/**
+		 * @brief Pop the item at the front of the
+		 * queue.
+		 *
+		 * @param outItem item that receives the
+		 * popped item
+		 * @return true if an item was popped,
+		 * false if the queue is empty
+		 */
+		bool tryPop(T& outItem)
+		{
+			sizet pos;
+			if (claimPop(1, pos) == 0)
+			{
+				return false;
+			}
+
+			SlotT& slot = slots[pos & mask];
+			outItem = move(*slot.getItem());
+			destroyItems(slot.getItem(), 1);
+			slot.sequence.store(pos + capacity, MemoryOrder::Release);
+
+			notify(popEpoch, numPushWaiters);
+			return true;
+		}
+
+		/**
+		 * @brief Pop as many items as possible from
+		 * the front of the queue.
+		 *
+		 * @param outItems items that receive the
+		 * popped items
+		 * @return number of items popped
+		 */
+		sizet tryPopBatch(Span<T> outItems)
+		{
+			if (outItems.isEmpty())
+			{
+				return 0;
+			}
+
+			sizet pos;
+			sizet const numItems = claimPop(outItems.getNumItems(), pos);
+			for (sizet i = 0; i < numItems; ++i)
+			{
+				SlotT& slot = slots[(pos + i) & mask];
+				outItems[i] = move(*slot.getItem());
+				destroyItems(slot.getItem(), 1);
+				slot.sequence.store(pos + i + capacity, MemoryOrder::Release);
+			}
+
+			if (numItems > 0)
+			{
+				notify(popEpoch, numPushWaiters);
+			}
+
+			return numItems;
+		}
+
+		/**
+		 * @brief Pop the item at the front of the
+		 * queue, blocking the thread while the
+		 * queue is empty.
+		 *
+		 * @param outItem item that receives the
+		 * popped item
+		 */
+		void pop(T& outItem)
+		{
+			waitFor(pushEpoch, numPopWaiters, [this, &outItem]() {
+
+				return tryPop(outItem);
+			});
+		}
+
+	protected:
+		/* Ring buffer of slots, read-only after construction. */
+		SlotT* slots;
+
+		/* Number of slots in the ring buffer. */
+		sizet capacity;
+
+		/* Mask used to wrap positions. */
+		sizet mask;
+
+		/* Position of the next slot to push. */
+		alignas(PLATFORM_CACHE_LINE_SIZE) Atomic<sizet> pushPos;
+
+		/* Position of the next slot to pop. */
+		alignas(PLATFORM_CACHE_LINE_SIZE) Atomic<sizet> popPos;
+
+		/* Bumped after a push if consumers are waiting. */
+		alignas(PLATFORM_CACHE_LINE_SIZE) Atomic<uint32> pushEpoch;
+
+		/* Number of consumers blocked on an empty queue. */
+		Atomic<uint32> numPopWaiters;
+
+		/* Bumped after a pop if producers are waiting. */
+		alignas(PLATFORM_CACHE_LINE_SIZE) Atomic<uint32> popEpoch;
+
+		/* Number of producers blocked on a full queue. */
+		Atomic<uint32> numPushWaiters;
+	};
+} // namespace Korin
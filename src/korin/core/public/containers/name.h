@@ -0,0 +1,413 @@
+#pragma once
+
+#include "containers_types.h"
+#include "optional.h"
+#include "string_view.h"
+#include "string.h"
+
+namespace Korin
+{
+	namespace Name_Impl
+	{
+		/**
+		 * @brief An entry of the global name
+		 * table. The characters are stored right
+		 * after the entry and are null-terminated.
+		 */
+		struct Entry
+		{
+			/* Id of the first entry that is equal to this one, regardless of case. */
+			uint32 noCaseId;
+
+			/* Number of characters, excluding the terminating character. */
+			uint32 length;
+
+			/**
+			 * @brief Returns a ptr to the first
+			 * character.
+			 */
+			FORCE_INLINE ansichar const* getChars() const
+			{
+				return reinterpret_cast<ansichar const*>(this + 1);
+			}
+		};
+
+		/**
+		 * @brief Returns the entry with the given
+		 * id. The id must have been returned by
+		 * the name table.
+		 *
+		 * @param id id of the entry
+		 * @return ref to entry
+		 */
+		Entry const& getEntry(uint32 id);
+
+		/**
+		 * @brief Returns the id of the given
+		 * string, adding it to the name table if
+		 * necessary.
+		 *
+		 * @param str string to intern
+		 * @return id of the string
+		 */
+		uint32 intern(StringView str);
+
+		/**
+		 * @brief Returns the id of the given
+		 * string, or -1 if the string was never
+		 * interned.
+		 *
+		 * @param str string to find
+		 * @param ignoreCase whether to ignore
+		 * the case of the characters
+		 * @return id of the string or -1
+		 */
+		int64 find(StringView str, bool ignoreCase);
+	} // namespace Name_Impl
+
+	/**
+	 * @brief An interned, immutable string.
+	 *
+	 * Names are stored in a global, thread-safe
+	 * table that is never shrunk. A name is
+	 * just the 32-bit id of its entry, so copies,
+	 * comparisons and hashing take constant
+	 * time and never touch the characters. Use
+	 * names for identifiers that are compared
+	 * and hashed often, and that come from a
+	 * limited set of strings.
+	 *
+	 * Names are ordered by id, which is stable
+	 * within a process but not alphabetical.
+	 *
+	 * The default name is the empty name.
+	 */
+	class Name
+	{
+		friend class NameNoCase;
+
+	public:
+		/**
+		 * @brief Construct the empty name.
+		 */
+		constexpr FORCE_INLINE Name()
+			: id{0}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a name from a string,
+		 * adding the string to the name table if
+		 * it was never interned.
+		 *
+		 * @param str the string to intern
+		 * @{
+		 */
+		FORCE_INLINE explicit Name(StringView str)
+			: id{Name_Impl::intern(str)}
+		{
+			//
+		}
+
+		FORCE_INLINE explicit Name(ansichar const* str)
+			: Name{StringView{str}}
+		{
+			//
+		}
+
+		FORCE_INLINE explicit Name(String const& str)
+			: Name{StringView{str}}
+		{
+			//
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns the name for the given
+		 * string, if the string was interned. It
+		 * never adds the string to the table.
+		 *
+		 * @param str string to find
+		 * @return the name, if any
+		 */
+		static Optional<Name> find(StringView str)
+		{
+			if (int64 const id = Name_Impl::find(str, false); id >= 0)
+			{
+				return Name{static_cast<uint32>(id), 0};
+			}
+
+			return {};
+		}
+
+		/**
+		 * @brief Returns the id of the name.
+		 */
+		constexpr FORCE_INLINE uint32 getId() const
+		{
+			return id;
+		}
+
+		/**
+		 * @brief Returns true if this is the
+		 * empty name.
+		 */
+		constexpr FORCE_INLINE bool isEmpty() const
+		{
+			return id == 0;
+		}
+
+		/**
+		 * @brief Returns the length of the name.
+		 */
+		FORCE_INLINE sizet getLength() const
+		{
+			return Name_Impl::getEntry(id).length;
+		}
+
+		/**
+		 * @brief Returns a ptr to the
+		 * null-terminated characters of the name.
+		 */
+		FORCE_INLINE ansichar const* operator*() const
+		{
+			return Name_Impl::getEntry(id).getChars();
+		}
+
+		/**
+		 * @brief Returns a view over the
+		 * characters of the name.
+		 */
+		FORCE_INLINE StringView toView() const
+		{
+			Name_Impl::Entry const& entry = Name_Impl::getEntry(id);
+			return {entry.getChars(), entry.length};
+		}
+
+		/**
+		 * @brief Returns a copy of the characters
+		 * of the name.
+		 */
+		FORCE_INLINE String toString() const
+		{
+			return String{toView()};
+		}
+
+		/**
+		 * @brief Returns true if two names are
+		 * equal, regardless of case.
+		 *
+		 * @param other another name
+		 */
+		FORCE_INLINE bool equalsNoCase(Name const& other) const
+		{
+			return id == other.id || Name_Impl::getEntry(id).noCaseId == Name_Impl::getEntry(other.id).noCaseId;
+		}
+
+		/**
+		 * @brief Compare two names.
+		 * @{
+		 */
+		constexpr FORCE_INLINE bool operator==(Name const& other) const
+		{
+			return id == other.id;
+		}
+
+		constexpr FORCE_INLINE bool operator!=(Name const& other) const
+		{
+			return id != other.id;
+		}
+
+		constexpr FORCE_INLINE bool operator<(Name const& other) const
+		{
+			return id < other.id;
+		}
+
+		constexpr FORCE_INLINE bool operator>(Name const& other) const
+		{
+			return id > other.id;
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns the hash key of the name,
+		 * which is its id.
+		 */
+		constexpr FORCE_INLINE HashKey toHashKey() const
+		{
+			return id;
+		}
+
+	protected:
+		/**
+		 * @brief Construct a name with the given
+		 * id.
+		 *
+		 * @param inId id of the name
+		 */
+		constexpr FORCE_INLINE Name(uint32 inId, int)
+			: id{inId}
+		{
+			//
+		}
+
+		/* Id of the name entry. */
+		uint32 id;
+	};
+
+	/**
+	 * @brief An interned string that ignores the
+	 * case of its characters (ASCII only).
+	 *
+	 * All the strings that are equal regardless
+	 * of case map to the same id, and the
+	 * characters are those of the first of them
+	 * to be interned.
+	 */
+	class NameNoCase
+	{
+	public:
+		/**
+		 * @brief Construct the empty name.
+		 */
+		constexpr FORCE_INLINE NameNoCase()
+			: id{0}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a name from a string,
+		 * adding the string to the name table if
+		 * it was never interned.
+		 *
+		 * @param str the string to intern
+		 * @{
+		 */
+		FORCE_INLINE explicit NameNoCase(StringView str)
+			: NameNoCase{Name{str}}
+		{
+			//
+		}
+
+		FORCE_INLINE explicit NameNoCase(ansichar const* str)
+			: NameNoCase{StringView{str}}
+		{
+			//
+		}
+		/** @} */
+
+		/**
+		 * @brief Construct from a case-sensitive
+		 * name.
+		 *
+		 * @param name a case-sensitive name
+		 */
+		FORCE_INLINE explicit NameNoCase(Name const& name)
+			: id{Name_Impl::getEntry(name.id).noCaseId}
+		{
+			//
+		}
+
+		/**
+		 * @brief Returns the name for the given
+		 * string, if a string equal to it
+		 * regardless of case was interned.
+		 *
+		 * @param str string to find
+		 * @return the name, if any
+		 */
+		static Optional<NameNoCase> find(StringView str)
+		{
+			if (int64 const id = Name_Impl::find(str, true); id >= 0)
+			{
+				return NameNoCase{Name{static_cast<uint32>(id), 0}};
+			}
+
+			return {};
+		}
+
+		/**
+		 * @brief Returns the id of the name.
+		 */
+		constexpr FORCE_INLINE uint32 getId() const
+		{
+			return id;
+		}
+
+		/**
+		 * @brief Returns true if this is the
+		 * empty name.
+		 */
+		constexpr FORCE_INLINE bool isEmpty() const
+		{
+			return id == 0;
+		}
+
+		/**
+		 * @brief Returns the name with the
+		 * original case.
+		 */
+		constexpr FORCE_INLINE Name toName() const
+		{
+			return Name{id, 0};
+		}
+
+		/**
+		 * @brief Returns a view over the
+		 * characters of the name.
+		 */
+		FORCE_INLINE StringView toView() const
+		{
+			return toName().toView();
+		}
+
+		/**
+		 * @brief Returns a ptr to the
+		 * null-terminated characters of the name.
+		 */
+		FORCE_INLINE ansichar const* operator*() const
+		{
+			return *toName();
+		}
+
+		/**
+		 * @brief Compare two names.
+		 * @{
+		 */
+		constexpr FORCE_INLINE bool operator==(NameNoCase const& other) const
+		{
+			return id == other.id;
+		}
+
+		constexpr FORCE_INLINE bool operator!=(NameNoCase const& other) const
+		{
+			return id != other.id;
+		}
+
+		constexpr FORCE_INLINE bool operator<(NameNoCase const& other) const
+		{
+			return id < other.id;
+		}
+
+		constexpr FORCE_INLINE bool operator>(NameNoCase const& other) const
+		{
+			return id > other.id;
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns the hash key of the name,
+		 * which is its id.
+		 */
+		constexpr FORCE_INLINE HashKey toHashKey() const
+		{
+			return id;
+		}
+
+	protected:
+		/* Id of the first name entry equal to this one, regardless of case. */
+		uint32 id;
+	};
+} // namespace Korin
@@ -155,6 +155,11 @@ namespace Korin
 		 * values is expected to be a kv-pair of the
 		 * given type).
 		 *
+		 * The key-like value is passed as-is to the
+		 * key policy, so a policy that accepts
+		 * other types (e.g. string views) can find
+		 * pairs without converting to the key type.
+		 *
 		 * @param lhs,rhs values to compare
 		 * @return 1, 0 or -1 depending on ordering
 		 * @{
@@ -164,12 +169,12 @@ namespace Korin
 			return PolicyT::operator()(lhs.getKey(), rhs.getKey());
 		}
 
-		constexpr int32 operator()(PairT const& lhs, KeyT const& rhs) const
+		constexpr int32 operator()(PairT const& lhs, auto const& rhs) const
 		{
 			return PolicyT::operator()(lhs.getKey(), rhs);
 		}
 
-		constexpr int32 operator()(KeyT const& lhs, PairT const& rhs) const
+		constexpr int32 operator()(auto const& lhs, PairT const& rhs) const
 		{
 			return PolicyT::operator()(lhs, rhs.getKey());
 		}
@@ -187,8 +192,6 @@ namespace Korin
 	template<typename PairT, typename HashPolicyT>
 	struct HashPair : private HashPolicyT
 	{
-		using HashPolicyT::operator();
-
 		/**
 		 * @brief Returns the hash key of the pair.
 		 *
@@ -199,6 +202,19 @@ namespace Korin
 		{
 			return HashPolicyT::operator()(pair.getKey());
 		}
+
+		/**
+		 * @brief Returns the hash key of a key-like
+		 * value. The value is passed as-is to the
+		 * key policy.
+		 *
+		 * @param key a key-like value
+		 * @return the corresponding hash key
+		 */
+		constexpr HashKey operator()(auto const& key) const
+		{
+			return HashPolicyT::operator()(key);
+		}
 	};
 } // namespace Korin
 
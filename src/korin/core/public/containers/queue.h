@@ -0,0 +1,132 @@
+#pragma once
+
+#include "containers_types.h"
+#include "deque.h"
+
+namespace Korin
+{
+	/**
+	 * @brief A first-in first-out queue.
+	 *
+	 * Items are stored in a @c Deque, so pushing
+	 * and popping do not allocate for every item.
+	 *
+	 * @tparam T the type of the items
+	 */
+	template<typename T>
+	class Queue
+	{
+	public:
+		/**
+		 * @brief Returns the number of items in
+		 * the queue.
+		 */
+		FORCE_INLINE sizet getNumItems() const
+		{
+			return items.getNumItems();
+		}
+
+		/**
+		 * @brief Returns true if the queue has no
+		 * items.
+		 */
+		FORCE_INLINE bool isEmpty() const
+		{
+			return items.isEmpty();
+		}
+
+		/**
+		 * @brief Returns a ref to the item at the
+		 * front of the queue, i.e. the next item to
+		 * be popped. The queue must not be empty.
+		 * @{
+		 */
+		FORCE_INLINE T& getFront()
+		{
+			return items.getFirst();
+		}
+
+		FORCE_INLINE T const& getFront() const
+		{
+			return items.getFirst();
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns a ref to the item at the
+		 * back of the queue, i.e. the last item
+		 * pushed. The queue must not be empty.
+		 * @{
+		 */
+		FORCE_INLINE T& getBack()
+		{
+			return items.getLast();
+		}
+
+		FORCE_INLINE T const& getBack() const
+		{
+			return items.getLast();
+		}
+		/** @} */
+
+		/**
+		 * @brief Construct a new item at the back
+		 * of the queue.
+		 *
+		 * @param createArgs arguments used to
+		 * construct the item
+		 * @return ref to the new item
+		 */
+		FORCE_INLINE T& emplace(auto&& ...createArgs)
+		{
+			return items.emplaceBack(FORWARD(createArgs)...);
+		}
+
+		/**
+		 * @brief Push an item at the back of the
+		 * queue.
+		 *
+		 * @param value item to copy or move
+		 * @{
+		 */
+		FORCE_INLINE void push(T const& value)
+		{
+			items.pushBack(value);
+		}
+
+		FORCE_INLINE void push(T&& value)
+		{
+			items.pushBack(move(value));
+		}
+		/** @} */
+
+		/**
+		 * @brief Remove the item at the front of
+		 * the queue and return it. The queue must
+		 * not be empty.
+		 *
+		 * @return the removed item
+		 */
+		FORCE_INLINE T pop()
+		{
+			return items.popFront();
+		}
+
+		/**
+		 * @brief Remove the item at the front of
+		 * the queue, if any.
+		 *
+		 * @param outValue item that receives the
+		 * removed item
+		 * @return true if an item was removed
+		 */
+		FORCE_INLINE bool pop(T& outValue)
+		{
+			return items.popFront(outValue);
+		}
+
+	protected:
+		/* Items of the queue, front first. */
+		Deque<T> items;
+	};
+} // namespace Korin
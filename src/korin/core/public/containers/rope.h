@@ -0,0 +1,864 @@
+#pragma once
+
+#include "hal/malloc.h"
+#include "hal/platform_math.h"
+#include "hal/platform_memory.h"
+#include "templates/utility.h"
+#include "containers_types.h"
+#include "shared_array.h"
+#include "string_view.h"
+#include "string.h"
+#include "tree_node.h"
+
+namespace Korin
+{
+	/**
+	 * @brief Payload of a rope node. A chunk is
+	 * a slice of a buffer that may be shared
+	 * with other chunks and other ropes, so
+	 * chunks can be split and copied without
+	 * copying characters.
+	 *
+	 * @tparam CharT the type of the characters
+	 */
+	template<typename CharT>
+	struct RopeChunk
+	{
+		/* Buffer that holds the characters. */
+		SharedArray<CharT> buffer;
+
+		/* Index of the first character in the buffer. */
+		sizet offset;
+
+		/* Number of characters in the chunk. */
+		sizet length;
+
+		/* Number of characters in the subtree. */
+		sizet size;
+
+		/**
+		 * @brief Construct a chunk that slices a
+		 * buffer.
+		 *
+		 * @param inBuffer buffer to share
+		 * @param inOffset index of the first
+		 * character
+		 * @param inLength number of characters
+		 */
+		FORCE_INLINE RopeChunk(SharedArray<CharT> const& inBuffer, sizet inOffset, sizet inLength)
+			: buffer{inBuffer}
+			, offset{inOffset}
+			, length{inLength}
+			, size{inLength}
+		{
+			//
+		}
+
+		/**
+		 * @brief Returns a ptr to the first
+		 * character of the chunk.
+		 */
+		FORCE_INLINE CharT const* getData() const
+		{
+			return *buffer + offset;
+		}
+
+		/**
+		 * @brief Returns a view of the chunk.
+		 */
+		FORCE_INLINE StringViewBase<CharT> getView() const
+		{
+			return {getData(), length};
+		}
+
+		/**
+		 * @brief Update the size of the subtree.
+		 * @see TreeNode::Impl::updateNode
+		 */
+		FORCE_INLINE void update(RopeChunk const* left, RopeChunk const* right)
+		{
+			size = (left ? left->size : 0) + length + (right ? right->size : 0);
+		}
+	};
+
+	/**
+	 * @brief Iterator over the chunks of a rope,
+	 * in order.
+	 * @see RopeBase::chunks
+	 *
+	 * @tparam CharT the type of the characters
+	 */
+	template<typename CharT>
+	class RopeChunkIterator
+	{
+		using SelfT = RopeChunkIterator;
+		using NodeT = BinaryNodeBase<RopeChunk<CharT>>;
+
+	public:
+		/**
+		 * @brief Construct an iterator that points
+		 * to the given node.
+		 *
+		 * @param inNode node of the chunk, or null
+		 * for the end iterator
+		 */
+		constexpr FORCE_INLINE RopeChunkIterator(NodeT const* inNode = nullptr)
+			: node{inNode}
+		{
+			//
+		}
+
+		/**
+		 * @brief Returns a view of the current
+		 * chunk.
+		 */
+		FORCE_INLINE StringViewBase<CharT> operator*() const
+		{
+			return node->getView();
+		}
+
+		constexpr FORCE_INLINE bool operator==(SelfT const& other) const
+		{
+			return node == other.node;
+		}
+
+		constexpr FORCE_INLINE bool operator!=(SelfT const& other) const
+		{
+			return !(*this == other);
+		}
+
+		constexpr FORCE_INLINE SelfT& operator++()
+		{
+			node = node->next;
+			return *this;
+		}
+
+	protected:
+		/* Node of the current chunk. */
+		NodeT const* node;
+	};
+
+	/**
+	 * @brief Range over the chunks of a rope.
+	 * @see RopeBase::chunks
+	 *
+	 * @tparam CharT the type of the characters
+	 */
+	template<typename CharT>
+	struct RopeChunkRange
+	{
+		/* Node of the first chunk. */
+		BinaryNodeBase<RopeChunk<CharT>> const* first;
+
+		constexpr FORCE_INLINE RopeChunkIterator<CharT> begin() const
+		{
+			return {first};
+		}
+
+		constexpr FORCE_INLINE RopeChunkIterator<CharT> end() const
+		{
+			return {};
+		}
+	};
+
+	/**
+	 * @brief A string for large editable text,
+	 * stored as a balanced tree of chunks.
+	 *
+	 * Inserting and removing text takes
+	 * logarithmic time in the number of chunks,
+	 * rather than linear time in the length of
+	 * the text. Chunks slice buffers that are
+	 * shared and never modified while shared,
+	 * so splitting a chunk, taking a substring
+	 * and copying or concatenating ropes never
+	 * copy the characters.
+	 *
+	 * Small insertions are merged into the
+	 * chunk they fall in, so typing does not
+	 * create a chunk per character. Note that a
+	 * chunk keeps its whole buffer alive: a
+	 * short substring of a large text keeps the
+	 * large text in memory until the substring
+	 * is edited or destroyed.
+	 *
+	 * @tparam CharT the type of the characters
+	 */
+	template<typename CharT>
+	class RopeBase
+	{
+	public:
+		using NodeT = BinaryNodeBase<RopeChunk<CharT>>;
+		using StringViewT = StringViewBase<CharT>;
+
+		/* Max length of a chunk that text is merged into. Longer texts get a chunk of their own. */
+		static constexpr sizet maxMergedLength = 1024;
+
+		/**
+		 * @brief Construct an empty rope.
+		 */
+		FORCE_INLINE RopeBase()
+			: root{nullptr}
+			, numChunks{0}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a rope with a copy of
+		 * the given text.
+		 *
+		 * @param text text to copy
+		 */
+		FORCE_INLINE RopeBase(StringViewT text)
+			: RopeBase{}
+		{
+			insert(0, text);
+		}
+
+		/**
+		 * @brief Construct a rope that shares the
+		 * chunks of another rope.
+		 *
+		 * @param other rope to copy
+		 */
+		FORCE_INLINE RopeBase(RopeBase const& other)
+			: root{nullptr}
+			, numChunks{other.numChunks}
+		{
+			if (other.root)
+			{
+				// Clone tree structure
+				root = cloneNode(other.root);
+				cloneSubtree(root, other.root);
+			}
+		}
+
+		/**
+		 * @brief Construct a rope by moving
+		 * another rope.
+		 *
+		 * @param other rope to move
+		 */
+		FORCE_INLINE RopeBase(RopeBase&& other)
+			: root{other.root}
+			, numChunks{other.numChunks}
+		{
+			other.root = nullptr;
+			other.numChunks = 0;
+		}
+
+		/**
+		 * @brief Share the chunks of another rope.
+		 *
+		 * @param other rope to copy
+		 * @return ref to self
+		 */
+		FORCE_INLINE RopeBase& operator=(RopeBase const& other)
+		{
+			if (this != &other)
+			{
+				*this = RopeBase{other};
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Move another rope.
+		 *
+		 * @param other rope to move
+		 * @return ref to self
+		 */
+		FORCE_INLINE RopeBase& operator=(RopeBase&& other)
+		{
+			destroy();
+
+			root = other.root;
+			numChunks = other.numChunks;
+
+			other.root = nullptr;
+			other.numChunks = 0;
+
+			return *this;
+		}
+
+		/**
+		 * @brief Destroy the rope.
+		 */
+		FORCE_INLINE ~RopeBase()
+		{
+			destroy();
+		}
+
+		/**
+		 * @brief Returns the number of characters
+		 * in the rope.
+		 */
+		FORCE_INLINE sizet getLength() const
+		{
+			return root ? root->size : 0;
+		}
+
+		/**
+		 * @brief Returns true if the rope is
+		 * empty.
+		 */
+		FORCE_INLINE bool isEmpty() const
+		{
+			return !root;
+		}
+
+		/**
+		 * @brief Returns the number of chunks in
+		 * the rope.
+		 */
+		FORCE_INLINE sizet getNumChunks() const
+		{
+			return numChunks;
+		}
+
+		/**
+		 * @brief Returns a ref to the i-th
+		 * character of the rope, in logarithmic
+		 * time.
+		 *
+		 * @param idx index of the character
+		 * @return ref to character
+		 */
+		FORCE_INLINE CharT const& operator[](sizet idx) const
+		{
+			CHECKF(idx < getLength(), "Index out of bounds")
+
+			NodeT const* node = findChunk(idx);
+			return node->getData()[idx];
+		}
+
+		/**
+		 * @brief Returns a range over the chunks of
+		 * the rope, as string views.
+		 *
+		 * ```
+		 * for (StringView chunk : rope.chunks())
+		 * {
+		 *     file.write(*chunk, chunk.getLength());
+		 * }
+		 * ```
+		 */
+		FORCE_INLINE RopeChunkRange<CharT> chunks() const
+		{
+			return {root ? TreeNode::getMin(root) : nullptr};
+		}
+
+		/**
+		 * @brief Compare the rope with a string
+		 * view.
+		 *
+		 * @param other another string
+		 * @return true if the characters are equal
+		 * @return false otherwise
+		 * @{
+		 */
+		bool operator==(StringViewT const& other) const
+		{
+			if (getLength() != other.getLength())
+			{
+				return false;
+			}
+
+			CharT const* it = *other;
+			for (StringViewT chunk : chunks())
+			{
+				if (chunk != StringViewT{it, chunk.getLength()})
+				{
+					return false;
+				}
+
+				it += chunk.getLength();
+			}
+
+			return true;
+		}
+
+		FORCE_INLINE bool operator!=(StringViewT const& other) const
+		{
+			return !(*this == other);
+		}
+		/** @} */
+
+		/**
+		 * @brief Insert text at the given position.
+		 *
+		 * @param pos index of the first inserted
+		 * character, at most the length of the
+		 * rope
+		 * @param text text to insert, must not
+		 * point into this rope
+		 * @return ref to self
+		 */
+		RopeBase& insert(sizet pos, StringViewT text)
+		{
+			CHECKF(pos <= getLength(), "Index out of bounds")
+
+			sizet const len = text.getLength();
+			if (len == 0)
+			{
+				return *this;
+			}
+
+			if (!root)
+			{
+				insertAfter(nullptr, createNode(SharedArray<CharT>{*text, len}, 0, len));
+				return *this;
+			}
+
+			// Find the chunk that contains the position,
+			// text at the start of a chunk is appended
+			// to the previous chunk
+			sizet offset = pos;
+			NodeT* node = pos < getLength() ? findChunk(offset) : TreeNode::getMax(root);
+			if (pos == getLength())
+			{
+				offset = node->length;
+			}
+			else if (offset == 0 && node->prev)
+			{
+				node = node->prev;
+				offset = node->length;
+			}
+
+			if (mergeText(node, offset, text))
+			{
+				return *this;
+			}
+
+			// Give the text a chunk of its own
+			NodeT* prev = node;
+			if (offset == 0)
+			{
+				prev = nullptr;
+			}
+			else if (offset < node->length)
+			{
+				splitChunk(node, offset);
+			}
+
+			insertAfter(prev, createNode(SharedArray<CharT>{*text, len}, 0, len));
+
+			return *this;
+		}
+
+		/**
+		 * @brief Append text to the end of the
+		 * rope.
+		 *
+		 * @param text text to append, must not
+		 * point into this rope
+		 * @return ref to self
+		 */
+		FORCE_INLINE RopeBase& operator+=(StringViewT text)
+		{
+			return insert(getLength(), text);
+		}
+
+		/**
+		 * @brief Append another rope to the end of
+		 * this rope. The chunks are shared, the
+		 * characters are not copied.
+		 *
+		 * @param other rope to append, may be this
+		 * rope
+		 * @return ref to self
+		 */
+		RopeBase& operator+=(RopeBase const& other)
+		{
+			// Read the number of chunks first, in case
+			// the rope is appended to itself
+			NodeT const* it = other.root ? TreeNode::getMin(other.root) : nullptr;
+			NodeT* last = root ? TreeNode::getMax(root) : nullptr;
+			for (sizet i = 0, n = other.numChunks; i < n; ++i, it = it->next)
+			{
+				last = insertAfter(last, createNode(it->buffer, it->offset, it->length));
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Remove a range of characters.
+		 * Takes logarithmic time for each chunk
+		 * that is touched.
+		 *
+		 * @param pos index of the first character
+		 * to remove
+		 * @param count number of characters to
+		 * remove
+		 * @return ref to self
+		 */
+		RopeBase& remove(sizet pos, sizet count)
+		{
+			CHECKF(pos + count <= getLength(), "Range out of bounds")
+
+			if (count == 0)
+			{
+				return *this;
+			}
+
+			sizet offset = pos;
+			NodeT* node = findChunk(offset);
+			if (offset > 0)
+			{
+				node = splitChunk(node, offset);
+			}
+
+			while (count > 0)
+			{
+				if (node->length <= count)
+				{
+					// Remove the whole chunk
+					count -= node->length;
+					node = removeNode(node);
+				}
+				else
+				{
+					// Slice the start of the last chunk
+					node->offset += count;
+					node->length -= count;
+					TreeNode::Impl::updatePath(node);
+					count = 0;
+				}
+			}
+
+			// Merge the chunks around the removed range
+			// if they are small
+			if (node && node->prev && mergeText(node->prev, node->prev->length, node->getView()))
+			{
+				removeNode(node);
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Returns a rope with a range of
+		 * characters of this rope. The chunks are
+		 * shared, the characters are not copied.
+		 *
+		 * @param pos index of the first character
+		 * @param count max number of characters
+		 * @return the substring
+		 */
+		RopeBase substr(sizet pos, sizet count = -1) const
+		{
+			CHECKF(pos <= getLength(), "Index out of bounds")
+
+			count = PlatformMath::min(count, getLength() - pos);
+
+			RopeBase rope;
+			if (count == 0)
+			{
+				return rope;
+			}
+
+			sizet offset = pos;
+			NodeT const* node = findChunk(offset);
+			NodeT* last = nullptr;
+			for (; count > 0; node = node->next, offset = 0)
+			{
+				sizet const len = PlatformMath::min(node->length - offset, count);
+				last = rope.insertAfter(last, rope.createNode(node->buffer, node->offset + offset, len));
+				count -= len;
+			}
+
+			return rope;
+		}
+
+		/**
+		 * @brief Returns a flat string with the
+		 * characters of the rope.
+		 */
+		StringBase<CharT> toString() const
+		{
+			StringBase<CharT> str(getLength());
+
+			CharT* dst = str.getData();
+			for (StringViewT chunk : chunks())
+			{
+				PlatformMemory::memcpy(dst, *chunk, chunk.getLength() * sizeof(CharT));
+				dst += chunk.getLength();
+			}
+
+			return str;
+		}
+
+	protected:
+		/**
+		 * @brief Returns the chunk that contains
+		 * the character at the given index.
+		 *
+		 * @param pos index of the character, less
+		 * than the length of the rope; returns the
+		 * index of the character in the chunk
+		 * @return node of the chunk
+		 */
+		NodeT* findChunk(sizet& pos) const
+		{
+			NodeT* node = root;
+			for (;;)
+			{
+				sizet const leftSize = node->left ? node->left->size : 0;
+				if (pos < leftSize)
+				{
+					node = node->left;
+				}
+				else if ((pos -= leftSize) < node->length)
+				{
+					return node;
+				}
+				else
+				{
+					pos -= node->length;
+					node = node->right;
+				}
+			}
+		}
+
+		/**
+		 * @brief Insert text in a chunk, if the
+		 * chunk does not grow longer than
+		 * @c maxMergedLength. The buffer is
+		 * modified in place if the chunk is its
+		 * only owner, otherwise the chunk gets a
+		 * new buffer.
+		 *
+		 * @param node node of the chunk
+		 * @param offset index in the chunk
+		 * @param text text to insert
+		 * @return true if the text was merged
+		 * @return false otherwise
+		 */
+		bool mergeText(NodeT* node, sizet offset, StringViewT text)
+		{
+			sizet const len = text.getLength();
+			if (node->length + len > maxMergedLength)
+			{
+				return false;
+			}
+
+			SharedArray<CharT>& buffer = node->buffer;
+			CharT const* const data = node->getData() - node->offset;
+			bool const isTail = offset == node->length && node->offset + node->length == buffer.getNumItems();
+			bool const isAliased = *text >= data && *text < data + buffer.getNumItems();
+
+			if (isTail && !buffer.isShared() && !isAliased)
+			{
+				// Append in place
+				buffer.appendRange(*text, *text + len);
+			}
+			else
+			{
+				CharT const* const chunk = node->getData();
+
+				SharedArray<CharT> merged;
+				merged.reserve(node->length + len);
+				merged.appendRange(chunk, chunk + offset);
+				merged.appendRange(*text, *text + len);
+				merged.appendRange(chunk + offset, chunk + node->length);
+
+				buffer = move(merged);
+				node->offset = 0;
+			}
+
+			node->length += len;
+			TreeNode::Impl::updatePath(node);
+
+			return true;
+		}
+
+		/**
+		 * @brief Split a chunk in two chunks that
+		 * share its buffer.
+		 *
+		 * @param node node of the chunk
+		 * @param offset index of the first
+		 * character of the second chunk
+		 * @return node of the second chunk
+		 */
+		NodeT* splitChunk(NodeT* node, sizet offset)
+		{
+			ASSERT(offset > 0 && offset < node->length)
+
+			NodeT* tail = createNode(node->buffer, node->offset + offset, node->length - offset);
+			node->length = offset;
+			TreeNode::Impl::updatePath(node);
+
+			return insertAfter(node, tail);
+		}
+
+		/**
+		 * @brief Insert a new node after another
+		 * node, and rebalance the tree.
+		 *
+		 * @param prev node to insert after, or
+		 * null to insert at the start
+		 * @param node node to insert
+		 * @return the inserted node
+		 */
+		NodeT* insertAfter(NodeT* prev, NodeT* node)
+		{
+			if (!root)
+			{
+				// Node is the new root
+			}
+			else if (!prev)
+			{
+				TreeNode::Impl::insertLeft(TreeNode::getMin(root), node);
+			}
+			else if (!prev->right)
+			{
+				TreeNode::Impl::insertRight(prev, node);
+			}
+			else
+			{
+				TreeNode::Impl::insertLeft(TreeNode::getMin(prev->right), node);
+			}
+
+			TreeNode::Impl::updatePath(node);
+			TreeNode::Impl::repair(node);
+			root = TreeNode::getRoot(node);
+			numChunks++;
+
+			return node;
+		}
+
+		/**
+		 * @brief Remove a node and rebalance the
+		 * tree.
+		 *
+		 * @param node node to remove
+		 * @return node of the next chunk
+		 */
+		NodeT* removeNode(NodeT* node)
+		{
+			// The node that is evicted may be a
+			// different one, that holds the payload
+			NodeT* next = node->next;
+			root = TreeNode::remove(node, next);
+
+			destroyNode(node);
+			numChunks--;
+
+			return next;
+		}
+
+		/**
+		 * @brief Create a new node.
+		 *
+		 * @param buffer buffer to share
+		 * @param offset index of the first
+		 * character
+		 * @param length number of characters
+		 * @return ptr to created node
+		 */
+		FORCE_INLINE NodeT* createNode(SharedArray<CharT> const& buffer, sizet offset, sizet length)
+		{
+			void* mem = gMalloc->malloc(sizeof(NodeT));
+			return new(mem) NodeT{buffer, offset, length};
+		}
+
+		/**
+		 * @brief Create a copy of a node, without
+		 * linking it.
+		 *
+		 * @param src node to copy
+		 * @return ptr to created node
+		 */
+		FORCE_INLINE NodeT* cloneNode(NodeT const* src)
+		{
+			NodeT* node = createNode(src->buffer, src->offset, src->length);
+			node->size = src->size;
+			node->color = src->color;
+
+			return node;
+		}
+
+		/**
+		 * @brief Recursively clone a subtree.
+		 *
+		 * @param dst root of new subtree
+		 * @param src root of the source subtree
+		 */
+		void cloneSubtree(NodeT* dst, NodeT const* src)
+		{
+			ASSERT(src != nullptr)
+
+			if (src->left)
+			{
+				NodeT* left = cloneNode(src->left);
+				TreeNode::Impl::insertLeft(dst, left);
+				cloneSubtree(left, src->left);
+			}
+
+			if (src->right)
+			{
+				NodeT* right = cloneNode(src->right);
+				TreeNode::Impl::insertRight(dst, right);
+				cloneSubtree(right, src->right);
+			}
+		}
+
+		/**
+		 * @brief Destroy a node.
+		 *
+		 * @param node ptr to node to destroy
+		 */
+		FORCE_INLINE void destroyNode(NodeT* node)
+		{
+			ASSERT(node != nullptr)
+			node->~NodeT();
+			gMalloc->free(node);
+		}
+
+		/**
+		 * @brief Recursively destroy all the nodes
+		 * in the subtree.
+		 *
+		 * @param node root node of the subtree
+		 */
+		void destroySubtree(NodeT* node)
+		{
+			// Recursion is fine, tree height is log2(n)
+			if (node->left)
+			{
+				destroySubtree(node->left);
+			}
+
+			if (node->right)
+			{
+				destroySubtree(node->right);
+			}
+
+			destroyNode(node);
+		}
+
+		/**
+		 * @brief Destroy all the chunks.
+		 */
+		FORCE_INLINE void destroy()
+		{
+			if (root)
+			{
+				destroySubtree(root);
+				root = nullptr;
+			}
+
+			numChunks = 0;
+		}
+
+		/* Root node of the tree. */
+		NodeT* root;
+
+		/* Number of chunks in the rope. */
+		sizet numChunks;
+	};
+} // namespace Korin
@@ -0,0 +1,615 @@
+#pragma once
+
+#include "containers_types.h"
+#include "templates/utility.h"
+#include "hal/platform_memory.h"
+#include "array.h"
+#include "span.h"
+
+namespace Korin
+{
+	template<typename, sizet> class SegmentedArrayIterator;
+	template<typename, sizet> class SegmentedArrayConstIterator;
+
+	namespace SegmentedArray_Impl
+	{
+		/**
+		 * @brief Returns the base 2 logarithm of a
+		 * power of two, at compile time.
+		 *
+		 * @param n a power of two
+		 * @return log2(n)
+		 */
+		constexpr sizet log2(sizet n)
+		{
+			sizet k = 0;
+			for (; n > 1; n >>= 1, ++k);
+			return k;
+		}
+	} // namespace SegmentedArray_Impl
+
+	/**
+	 * @brief Iterator used to iterate over the
+	 * items of a segmented array.
+	 *
+	 * @tparam T the type of the items
+	 * @tparam chunkSize number of items in a chunk
+	 */
+	template<typename T, sizet chunkSize>
+	class SegmentedArrayIterator
+	{
+		friend SegmentedArray<T, chunkSize>;
+		friend SegmentedArrayConstIterator<T, chunkSize>;
+
+		using SelfT = SegmentedArrayIterator;
+
+	public:
+		using RefT = T&;
+		using PtrT = T*;
+
+		/**
+		 * @brief Construct an iterator that points
+		 * to the i-th item of the given chunks.
+		 *
+		 * @param inChunks ptr to the chunk table
+		 * @param inIdx index of the item
+		 */
+		FORCE_INLINE SegmentedArrayIterator(T* const* inChunks, sizet inIdx)
+			: chunks{inChunks}
+			, idx{inIdx}
+		{
+			//
+		}
+
+		FORCE_INLINE RefT operator*() const
+		{
+			return SegmentedArray<T, chunkSize>::resolve(chunks, idx);
+		}
+
+		FORCE_INLINE PtrT operator->() const
+		{
+			return &(**this);
+		}
+
+		FORCE_INLINE bool operator==(SelfT const& other) const
+		{
+			return idx == other.idx;
+		}
+
+		FORCE_INLINE bool operator!=(SelfT const& other) const
+		{
+			return !(*this == other);
+		}
+
+		FORCE_INLINE SelfT& operator++()
+		{
+			++idx;
+			return *this;
+		}
+
+		FORCE_INLINE SelfT operator++(int32)
+		{
+			SelfT copy{*this};
+			++idx;
+			return copy;
+		}
+
+		FORCE_INLINE SelfT& operator--()
+		{
+			--idx;
+			return *this;
+		}
+
+		FORCE_INLINE SelfT operator--(int32)
+		{
+			SelfT copy{*this};
+			--idx;
+			return copy;
+		}
+
+	protected:
+		/* Ptr to the chunk table. */
+		T* const* chunks;
+
+		/* Index of the current item. */
+		sizet idx;
+	};
+
+	/**
+	 * @brief Constant iterator for segmented
+	 * arrays.
+	 * @see SegmentedArrayIterator
+	 *
+	 * @tparam T the type of the items
+	 * @tparam chunkSize number of items in a chunk
+	 */
+	template<typename T, sizet chunkSize>
+	class SegmentedArrayConstIterator
+	{
+		friend SegmentedArray<T, chunkSize>;
+
+		using SelfT = SegmentedArrayConstIterator;
+
+	public:
+		using RefT = T const&;
+		using PtrT = T const*;
+
+		FORCE_INLINE SegmentedArrayConstIterator(T* const* inChunks, sizet inIdx)
+			: chunks{inChunks}
+			, idx{inIdx}
+		{
+			//
+		}
+
+		FORCE_INLINE SegmentedArrayConstIterator(SegmentedArrayIterator<T, chunkSize> const& other)
+			: chunks{other.chunks}
+			, idx{other.idx}
+		{
+			//
+		}
+
+		FORCE_INLINE RefT operator*() const
+		{
+			return SegmentedArray<T, chunkSize>::resolve(chunks, idx);
+		}
+
+		FORCE_INLINE PtrT operator->() const
+		{
+			return &(**this);
+		}
+
+		FORCE_INLINE bool operator==(SelfT const& other) const
+		{
+			return idx == other.idx;
+		}
+
+		FORCE_INLINE bool operator!=(SelfT const& other) const
+		{
+			return !(*this == other);
+		}
+
+		FORCE_INLINE SelfT& operator++()
+		{
+			++idx;
+			return *this;
+		}
+
+		FORCE_INLINE SelfT operator++(int32)
+		{
+			SelfT copy{*this};
+			++idx;
+			return copy;
+		}
+
+		FORCE_INLINE SelfT& operator--()
+		{
+			--idx;
+			return *this;
+		}
+
+		FORCE_INLINE SelfT operator--(int32)
+		{
+			SelfT copy{*this};
+			--idx;
+			return copy;
+		}
+
+	protected:
+		/* Ptr to the chunk table. */
+		T* const* chunks;
+
+		/* Index of the current item. */
+		sizet idx;
+	};
+
+	/**
+	 * @brief A growing array that stores its
+	 * items in fixed-size chunks.
+	 *
+	 * Unlike @c Array, items are never moved
+	 * once constructed: growing the array only
+	 * appends new chunks, so pointers and refs
+	 * to items remain valid until the item is
+	 * removed.
+	 *
+	 * The number of items per chunk is a power
+	 * of two, so random access only costs a
+	 * shift, a mask and an indirection. Use
+	 * @c getChunk() or @c forEachChunk() to
+	 * iterate with contiguous-array speed.
+	 *
+	 * @tparam T the type of the items
+	 * @tparam chunkSize number of items in a
+	 * chunk, must be a power of two
+	 */
+	template<typename T, sizet chunkSize>
+	class SegmentedArray
+	{
+		friend SegmentedArrayIterator<T, chunkSize>;
+		friend SegmentedArrayConstIterator<T, chunkSize>;
+
+		static_assert(chunkSize > 0 && (chunkSize & (chunkSize - 1)) == 0, "Chunk size must be a power of two");
+
+		/* Shift used to compute the chunk index. */
+		static constexpr sizet chunkShift = SegmentedArray_Impl::log2(chunkSize);
+
+		/* Mask used to compute the index within a chunk. */
+		static constexpr sizet chunkMask = chunkSize - 1;
+
+		/**
+		 * @brief Returns a ref to the i-th item,
+		 * given the chunk table.
+		 */
+		static FORCE_INLINE T& resolve(T* const* chunks, sizet idx)
+		{
+			return chunks[idx >> chunkShift][idx & chunkMask];
+		}
+
+		/**
+		 * @brief Allocate chunks until the array
+		 * can fit the required number of items.
+		 *
+		 * @param requiredSize number of items to
+		 * fit
+		 */
+		void growToFit(sizet const requiredSize)
+		{
+			// The alignment is known at compile time
+			constexpr sizet alignment = max(alignof(T), MIN_ALIGNMENT);
+
+			while (chunks.getNumItems() << chunkShift < requiredSize)
+			{
+				// Append a new chunk, existing items are not touched
+				T* chunk = reinterpret_cast<T*>(gMalloc->malloc(chunkSize * sizeof(T), alignment));
+				chunks.append(chunk);
+			}
+		}
+
+		/**
+		 * @brief Release unused chunks.
+		 *
+		 * One spare chunk is kept to avoid
+		 * allocator traffic when items are
+		 * repeatedly added and removed at a
+		 * chunk boundary.
+		 */
+		void shrinkToFit()
+		{
+			sizet const numUsedChunks = (count + chunkMask) >> chunkShift;
+			while (chunks.getNumItems() > numUsedChunks + 1)
+			{
+				gMalloc->free(chunks[chunks.getNumItems() - 1]);
+				chunks.pop();
+			}
+		}
+
+		/**
+		 * @brief Destroy all items and release all
+		 * chunks.
+		 */
+		void destroy()
+		{
+			// Destroy items chunk by chunk
+			forEachChunk([](Span<T> chunk) {
+
+				destroyItems(*chunk, chunk.getNumItems());
+			});
+
+			for (T* chunk : chunks)
+			{
+				gMalloc->free(chunk);
+			}
+
+			chunks = Array<T*>{};
+			count = 0;
+		}
+
+		/**
+		 * @brief Copy construct all the items of
+		 * another segmented array.
+		 *
+		 * This array must be empty.
+		 */
+		void copyItemsFrom(SegmentedArray const& other)
+		{
+			growToFit(other.count);
+			other.forEachChunk([this, offset = 0ull](Span<T const> chunk) mutable {
+
+				copyConstructItems(chunks[offset >> chunkShift], *chunk, chunk.getNumItems());
+				offset += chunk.getNumItems();
+			});
+			count = other.count;
+		}
+
+	public:
+		using IteratorT = SegmentedArrayIterator<T, chunkSize>;
+		using ConstIteratorT = SegmentedArrayConstIterator<T, chunkSize>;
+
+		/**
+		 * @brief Construct an empty segmented
+		 * array.
+		 */
+		FORCE_INLINE SegmentedArray()
+			: chunks{}
+			, count{0}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct an empty segmented array
+		 * with enough chunks to store the given
+		 * number of items.
+		 *
+		 * @param reservedSize number of items to
+		 * reserve space for
+		 */
+		FORCE_INLINE explicit SegmentedArray(sizet reservedSize)
+			: SegmentedArray{}
+		{
+			growToFit(reservedSize);
+		}
+
+		/**
+		 * @brief Construct a copy of another
+		 * segmented array.
+		 *
+		 * @param other another segmented array
+		 */
+		SegmentedArray(SegmentedArray const& other)
+			: SegmentedArray{}
+		{
+			copyItemsFrom(other);
+		}
+
+		/**
+		 * @brief Move another segmented array.
+		 *
+		 * Items are not moved, refs to the other
+		 * array's items now refer to this array's
+		 * items.
+		 *
+		 * @param other another segmented array
+		 */
+		SegmentedArray(SegmentedArray&& other)
+			: chunks{move(other.chunks)}
+			, count{other.count}
+		{
+			other.count = 0;
+		}
+
+		/**
+		 * @brief Destroy this array and copy
+		 * another segmented array.
+		 *
+		 * @param other another segmented array
+		 * @return ref to self
+		 */
+		SegmentedArray& operator=(SegmentedArray const& other)
+		{
+			if (this != &other)
+			{
+				destroy();
+				copyItemsFrom(other);
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Destroy this array and move
+		 * another segmented array.
+		 *
+		 * @param other another segmented array
+		 * @return ref to self
+		 */
+		SegmentedArray& operator=(SegmentedArray&& other)
+		{
+			destroy();
+			chunks = move(other.chunks);
+			count = other.count;
+			other.count = 0;
+
+			return *this;
+		}
+
+		/**
+		 * @brief Destroy the array and all its
+		 * items.
+		 */
+		FORCE_INLINE ~SegmentedArray()
+		{
+			destroy();
+		}
+
+		/**
+		 * @brief Returns the number of items in
+		 * the array.
+		 */
+		FORCE_INLINE sizet getNumItems() const
+		{
+			return count;
+		}
+
+		/**
+		 * @brief Returns the number of chunks
+		 * allocated.
+		 */
+		FORCE_INLINE sizet getNumChunks() const
+		{
+			return chunks.getNumItems();
+		}
+
+		/**
+		 * @brief Returns the number of items
+		 * stored in a chunk.
+		 */
+		static constexpr FORCE_INLINE sizet getChunkSize()
+		{
+			return chunkSize;
+		}
+
+		/**
+		 * @brief Returns a ref to the i-th item.
+		 *
+		 * @param idx index of the item
+		 * @return ref to the item
+		 * @{
+		 */
+		FORCE_INLINE T& operator[](uint64 idx)
+		{
+			CHECK(idx < count)
+			return resolve(*chunks, idx);
+		}
+
+		FORCE_INLINE T const& operator[](uint64 idx) const
+		{
+			return const_cast<SegmentedArray&>(*this)[idx];
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns a span over the used
+		 * items of the i-th chunk.
+		 *
+		 * @param chunkIdx index of the chunk
+		 * @return span over the chunk items
+		 * @{
+		 */
+		FORCE_INLINE Span<T> getChunk(sizet chunkIdx)
+		{
+			sizet const offset = chunkIdx << chunkShift;
+			CHECK(offset < count)
+			sizet const numItems = count - offset < chunkSize ? count - offset : chunkSize;
+			return {chunks[chunkIdx], numItems};
+		}
+
+		FORCE_INLINE Span<T const> getChunk(sizet chunkIdx) const
+		{
+			return const_cast<SegmentedArray&>(*this).getChunk(chunkIdx);
+		}
+		/** @} */
+
+		/**
+		 * @brief Call the given function once for
+		 * each non-empty chunk, passing a span over
+		 * the chunk items.
+		 *
+		 * @param callback function that receives
+		 * a span of items
+		 * @{
+		 */
+		template<typename CallbackT>
+		void forEachChunk(CallbackT&& callback)
+		{
+			for (sizet offset = 0, chunkIdx = 0; offset < count; offset += chunkSize, ++chunkIdx)
+			{
+				callback(getChunk(chunkIdx));
+			}
+		}
+
+		template<typename CallbackT>
+		void forEachChunk(CallbackT&& callback) const
+		{
+			for (sizet offset = 0, chunkIdx = 0; offset < count; offset += chunkSize, ++chunkIdx)
+			{
+				callback(getChunk(chunkIdx));
+			}
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns an iterator that points
+		 * to the first item of the array.
+		 * @{
+		 */
+		FORCE_INLINE IteratorT begin()
+		{
+			return {*chunks, 0};
+		}
+
+		FORCE_INLINE ConstIteratorT begin() const
+		{
+			return const_cast<SegmentedArray&>(*this).begin();
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns an iterator that points
+		 * to the end of the array.
+		 * @{
+		 */
+		FORCE_INLINE IteratorT end()
+		{
+			return {*chunks, count};
+		}
+
+		FORCE_INLINE ConstIteratorT end() const
+		{
+			return const_cast<SegmentedArray&>(*this).end();
+		}
+		/** @} */
+
+		/**
+		 * @brief Append one or more items to the
+		 * end of the array.
+		 *
+		 * Existing items are never moved.
+		 *
+		 * @param items items to append
+		 */
+		void append(auto&& ...items)
+		{
+			constexpr sizet numItems = sizeof...(items);
+
+			// Allocate new chunks if necessary
+			growToFit(count + numItems);
+			(new (&resolve(*chunks, count++)) T{FORWARD(items)}, ...);
+		}
+
+		/**
+		 * @brief Construct and append an item to
+		 * the array.
+		 *
+		 * @param createArgs arguments used to
+		 * construct the item
+		 * @return ref to the new item
+		 */
+		FORCE_INLINE T& emplaceLast(auto&& ...createArgs)
+		{
+			growToFit(count + 1);
+
+			T* item = &resolve(*chunks, count++);
+			return *new (item) T{FORWARD(createArgs)...};
+		}
+
+		/**
+		 * @brief Remove the last item of the
+		 * array.
+		 */
+		void pop()
+		{
+			CHECK(count > 0)
+
+			count--;
+			destroyItems(&resolve(*chunks, count), 1);
+			shrinkToFit();
+		}
+
+		/**
+		 * @brief Remove all items and release all
+		 * chunks.
+		 */
+		FORCE_INLINE void reset()
+		{
+			destroy();
+		}
+
+	protected:
+		/* Table of pointers to the chunks. */
+		Array<T*> chunks;
+
+		/* Number of items in the array. */
+		sizet count;
+	};
+} // namespace Korin
@@ -273,20 +273,30 @@ namespace Korin
 		}
 		/** @} */
 
+		/**
+		 * @brief Insert all items in the given
+		 * range that are not already in the set.
+		 * Sorted ranges are inserted faster.
+		 *
+		 * @tparam ItT the iterator type
+		 * @param first,last begin and end iterators
+		 */
+		template<typename ItT>
+		FORCE_INLINE void insert(ItT first, ItT last)
+		{
+			TreeT::findOrInsert(first, last);
+		}
+
 		/**
 		 * @brief Insert all items in the given range.
 		 *
 		 * @tparam ItT the iterator type
-		 * @param begin,end begin and end iterators
+		 * @param first,last begin and end iterators
 		 */
 		template<typename ItT>
-		FORCE_INLINE void update(ItT begin, ItT end)
+		FORCE_INLINE void update(ItT first, ItT last)
 		{
-			for (; begin != end; ++begin)
-			{
-				// Insert all items from iterator
-				insert(*begin);
-			}
+			TreeT::findOrInsert(first, last);
 		}
 
 		/**
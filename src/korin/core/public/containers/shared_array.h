@@ -0,0 +1,544 @@
+#pragma once
+
+#include "containers_types.h"
+#include "templates/utility.h"
+#include "hal/platform_memory.h"
+#include "hal/platform_math.h"
+#include "hal/atomic.h"
+#include "array.h"
+#include "span.h"
+
+namespace Korin
+{
+	namespace SharedArray_Impl
+	{
+		/**
+		 * @brief Header of a shared buffer. The
+		 * items are stored right after the header,
+		 * in the same allocation.
+		 */
+		template<typename T>
+		struct Block
+		{
+			/* Offset of the first item from the start of the block. */
+			static constexpr sizet itemsOffset = (sizeof(Atomic<sizet>) + 2 * sizeof(sizet) + alignof(T) - 1) & ~(alignof(T) - 1);
+
+			/* Number of arrays that share this block. */
+			Atomic<sizet> refCount;
+
+			/* Number of items that fit in the block. */
+			sizet size;
+
+			/* Number of items in the block. */
+			sizet count;
+
+			/**
+			 * @brief Returns a ptr to the first item.
+			 */
+			FORCE_INLINE T* getItems()
+			{
+				return reinterpret_cast<T*>(reinterpret_cast<ubyte*>(this) + itemsOffset);
+			}
+
+			/**
+			 * @brief Allocate a new empty block with
+			 * a single reference.
+			 *
+			 * @param size number of items that fit
+			 * in the block
+			 * @return ptr to new block
+			 */
+			static Block* create(sizet size)
+			{
+				constexpr sizet alignment = PlatformMath::max(sizet(alignof(T)), PlatformMath::max(sizet(alignof(Block)), sizet(MIN_ALIGNMENT)));
+
+				Block* block = reinterpret_cast<Block*>(gMalloc->malloc(itemsOffset + size * sizeof(T), alignment));
+				new (&block->refCount) Atomic<sizet>{1};
+				block->size = size;
+				block->count = 0;
+				return block;
+			}
+
+			/**
+			 * @brief Destroy all items and deallocate
+			 * the block.
+			 */
+			FORCE_INLINE void destroy()
+			{
+				destroyItems(getItems(), count);
+				gMalloc->free(this);
+			}
+		};
+	} // namespace SharedArray_Impl
+
+	/**
+	 * @brief A growing array whose buffer is
+	 * shared between copies.
+	 *
+	 * Copying a shared array only increments an
+	 * atomic reference count, so it takes constant
+	 * time regardless of the number of items. The
+	 * buffer is copied the first time a copy is
+	 * mutated while still shared with other
+	 * copies (copy-on-write).
+	 *
+	 * Copies can be read and released from
+	 * different threads, but a single instance
+	 * must not be mutated while other threads
+	 * access the same instance.
+	 *
+	 * Read-only access goes through the const
+	 * overloads; calling a non-const accessor on
+	 * a shared array detaches it first, so prefer
+	 * const refs for read-mostly payloads.
+	 *
+	 * @tparam T the type of the items
+	 */
+	template<typename T>
+	class SharedArray
+	{
+		using BlockT = SharedArray_Impl::Block<T>;
+
+		using Iterator = T*;
+		using ConstIterator = T const*;
+
+		/**
+		 * @brief Release the reference to the
+		 * block, destroying it if this was the
+		 * last one.
+		 */
+		FORCE_INLINE void release()
+		{
+			if (block && block->refCount.fetchSub(1, MemoryOrder::AcquireRelease) == 1)
+			{
+				block->destroy();
+			}
+
+			block = nullptr;
+		}
+
+		/**
+		 * @brief Replace the block with a new block
+		 * that holds a copy of all the items.
+		 *
+		 * @param newSize size of the new block
+		 */
+		void detach(sizet newSize)
+		{
+			BlockT* newBlock = BlockT::create(newSize);
+			if (block)
+			{
+				copyConstructItems(newBlock->getItems(), block->getItems(), block->count);
+				newBlock->count = block->count;
+			}
+
+			release();
+			block = newBlock;
+		}
+
+		/**
+		 * @brief Make sure this array is the only
+		 * owner of its block, and that the block
+		 * can fit the required number of items.
+		 *
+		 * @param requiredSize min size in number
+		 * of items
+		 */
+		void makeUniqueToFit(sizet const requiredSize)
+		{
+			sizet const size = block ? block->size : 0;
+			if (size >= requiredSize)
+			{
+				if (isShared())
+				{
+					// Copy on write
+					detach(size);
+				}
+
+				return;
+			}
+
+			// Find appropriate size
+			sizet newSize = PlatformMath::max(size, sizet(KORIN_ARRAY_MIN_SIZE));
+			for (; newSize < requiredSize; newSize = newSize << 1);
+
+			if (isShared())
+			{
+				detach(newSize);
+				return;
+			}
+
+			// Sole owner, items can be moved
+			BlockT* newBlock = BlockT::create(newSize);
+			if (block)
+			{
+				moveConstructItems(newBlock->getItems(), block->getItems(), block->count);
+				newBlock->count = block->count;
+				block->count = 0;
+				block->destroy();
+			}
+
+			block = newBlock;
+		}
+
+		/**
+		 * @brief Make sure this array is the only
+		 * owner of its block.
+		 */
+		FORCE_INLINE void makeUnique()
+		{
+			if (isShared())
+			{
+				detach(block->size);
+			}
+		}
+
+	public:
+		/**
+		 * @brief Construct an empty array. Empty
+		 * arrays do not allocate.
+		 */
+		constexpr FORCE_INLINE SharedArray()
+			: block{nullptr}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct an array with a copy of
+		 * the given items.
+		 *
+		 * @param items ptr to the items to copy
+		 * @param numItems number of items
+		 */
+		SharedArray(T const* items, sizet numItems)
+			: SharedArray{}
+		{
+			if (numItems > 0)
+			{
+				block = BlockT::create(numItems);
+				copyConstructItems(block->getItems(), items, numItems);
+				block->count = numItems;
+			}
+		}
+
+		/**
+		 * @brief Construct an array with a copy of
+		 * the items of an unshared array.
+		 *
+		 * @param other array to copy
+		 */
+		FORCE_INLINE explicit SharedArray(Array<T> const& other)
+			: SharedArray{*other, other.getNumItems()}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct an array by moving the
+		 * items of an unshared array.
+		 *
+		 * @param other array to move items from
+		 */
+		explicit SharedArray(Array<T>&& other)
+			: SharedArray{}
+		{
+			if (sizet const numItems = other.getNumItems())
+			{
+				block = BlockT::create(numItems);
+				moveConstructItems(block->getItems(), *other, numItems);
+				block->count = numItems;
+				other = Array<T>{};
+			}
+		}
+
+		/**
+		 * @brief Share the buffer of another
+		 * array.
+		 *
+		 * @param other another array
+		 */
+		FORCE_INLINE SharedArray(SharedArray const& other)
+			: block{other.block}
+		{
+			if (block)
+			{
+				block->refCount.fetchAdd(1, MemoryOrder::Relaxed);
+			}
+		}
+
+		/**
+		 * @brief Take the buffer of another
+		 * array, leaving it empty.
+		 *
+		 * @param other another array
+		 */
+		FORCE_INLINE SharedArray(SharedArray&& other)
+			: block{other.block}
+		{
+			other.block = nullptr;
+		}
+
+		/**
+		 * @brief Share the buffer of another array
+		 * and release the current one.
+		 *
+		 * @param other another array
+		 * @return ref to self
+		 */
+		SharedArray& operator=(SharedArray const& other)
+		{
+			if (block != other.block)
+			{
+				if (other.block)
+				{
+					other.block->refCount.fetchAdd(1, MemoryOrder::Relaxed);
+				}
+
+				release();
+				block = other.block;
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Take the buffer of another array
+		 * and release the current one.
+		 *
+		 * @param other another array
+		 * @return ref to self
+		 */
+		SharedArray& operator=(SharedArray&& other)
+		{
+			if (this != &other)
+			{
+				release();
+				block = other.block;
+				other.block = nullptr;
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Release the buffer.
+		 */
+		FORCE_INLINE ~SharedArray()
+		{
+			release();
+		}
+
+		/**
+		 * @brief Returns the number of items in
+		 * the array.
+		 */
+		FORCE_INLINE sizet getNumItems() const
+		{
+			return block ? block->count : 0;
+		}
+
+		/**
+		 * @brief Returns the number of bytes used
+		 * by the items.
+		 */
+		FORCE_INLINE sizet getNumBytes() const
+		{
+			return getNumItems() * sizeof(T);
+		}
+
+		/**
+		 * @brief Returns the number of arrays that
+		 * share the buffer with this one, this
+		 * array included.
+		 */
+		FORCE_INLINE sizet getRefCount() const
+		{
+			return block ? block->refCount.load(MemoryOrder::Relaxed) : 0;
+		}
+
+		/**
+		 * @brief Returns true if the buffer is
+		 * shared with other arrays.
+		 */
+		FORCE_INLINE bool isShared() const
+		{
+			return block && block->refCount.load(MemoryOrder::Acquire) > 1;
+		}
+
+		/**
+		 * @brief Returns a ptr to the first item.
+		 * The non-const overload detaches the
+		 * array if it is shared.
+		 * @{
+		 */
+		FORCE_INLINE T const* operator*() const
+		{
+			return block ? block->getItems() : nullptr;
+		}
+
+		FORCE_INLINE T* operator*()
+		{
+			makeUnique();
+			return block ? block->getItems() : nullptr;
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns a ref to the i-th item.
+		 * The non-const overload detaches the
+		 * array if it is shared.
+		 *
+		 * @param idx index of the item
+		 * @return ref to item
+		 * @{
+		 */
+		FORCE_INLINE T const& operator[](uint64 idx) const
+		{
+			CHECK(idx < getNumItems())
+			return block->getItems()[idx];
+		}
+
+		FORCE_INLINE T& operator[](uint64 idx)
+		{
+			CHECK(idx < getNumItems())
+			makeUnique();
+			return block->getItems()[idx];
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns an iterator that points
+		 * to the first item.
+		 * @{
+		 */
+		FORCE_INLINE Iterator begin()
+		{
+			return **this;
+		}
+
+		FORCE_INLINE ConstIterator begin() const
+		{
+			return **this;
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns an iterator that points
+		 * past the last item.
+		 * @{
+		 */
+		FORCE_INLINE Iterator end()
+		{
+			return **this + getNumItems();
+		}
+
+		FORCE_INLINE ConstIterator end() const
+		{
+			return **this + getNumItems();
+		}
+		/** @} */
+
+		/**
+		 * @brief Append one or more items to the
+		 * array.
+		 *
+		 * @param items items to append
+		 */
+		void append(auto&& ...items)
+		{
+			constexpr sizet numItems = sizeof...(items);
+
+			makeUniqueToFit(getNumItems() + numItems);
+			T* dst = block->getItems() + block->count;
+			((new (dst++) T{FORWARD(items)}), ...);
+			block->count += numItems;
+		}
+
+		/**
+		 * @brief Append a copy of the items in the
+		 * given range, with at most one resize.
+		 * The range must not point into this
+		 * array.
+		 *
+		 * @param begin ptr to the first item
+		 * @param end ptr past the last item
+		 */
+		void appendRange(T const* begin, T const* end)
+		{
+			CHECK(begin <= end)
+
+			if (sizet const numItems = end - begin)
+			{
+				makeUniqueToFit(getNumItems() + numItems);
+				copyConstructItems(block->getItems() + block->count, begin, numItems);
+				block->count += numItems;
+			}
+		}
+
+		/**
+		 * @brief Remove the last item of the
+		 * array.
+		 */
+		void pop()
+		{
+			CHECK(getNumItems() > 0)
+
+			makeUnique();
+			block->count--;
+			destroyItems(block->getItems() + block->count, 1);
+		}
+
+		/**
+		 * @brief Make sure the array can store the
+		 * given number of items without resizing.
+		 *
+		 * @param reservedSize number of items
+		 */
+		FORCE_INLINE void reserve(sizet reservedSize)
+		{
+			makeUniqueToFit(reservedSize);
+		}
+
+		/**
+		 * @brief Release the buffer, leaving the
+		 * array empty. Other arrays that share the
+		 * buffer are not affected.
+		 */
+		FORCE_INLINE void reset()
+		{
+			release();
+		}
+
+		/**
+		 * @brief Returns an unshared copy of the
+		 * items.
+		 */
+		FORCE_INLINE Array<T> toArray() const
+		{
+			return Array<T>{**this, getNumItems()};
+		}
+
+		/**
+		 * @brief Returns a read-only view of the
+		 * items.
+		 */
+		FORCE_INLINE Span<T const> view() const
+		{
+			return {**this, getNumItems()};
+		}
+
+		/**
+		 * @brief Implicit conversion to a read-only
+		 * span.
+		 */
+		FORCE_INLINE operator Span<T const>() const
+		{
+			return view();
+		}
+
+	protected:
+		/* Shared block that holds the items, null if empty. */
+		BlockT* block;
+	};
+} // namespace Korin
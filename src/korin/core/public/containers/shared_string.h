@@ -0,0 +1,303 @@
+#pragma once
+
+#include "templates/types.h"
+#include "hal/platform_string.h"
+#include "containers_types.h"
+#include "shared_array.h"
+#include "string.h"
+
+namespace Korin
+{
+	/**
+	 * @brief An immutable-by-default string whose
+	 * characters are shared between copies.
+	 *
+	 * Copies take constant time and only bump an
+	 * atomic reference count; the characters are
+	 * copied the first time a shared copy is
+	 * modified. Use it for large strings that are
+	 * copied into many containers but rarely
+	 * modified (e.g. config blobs), and convert to
+	 * a @c StringBase to do heavy editing.
+	 *
+	 * @tparam CharT the type of the characters
+	 */
+	template<typename CharT>
+	class SharedStringBase
+	{
+		static_assert(IsIntegral<CharT>::value, "Char type must be an integral value");
+
+		static constexpr CharT termChar{0};
+
+	public:
+		using StringSourceT = StringSource<CharT>;
+		using StringViewT = StringViewBase<CharT>;
+
+		/**
+		 * @brief Construct an empty string. Empty
+		 * strings do not allocate.
+		 */
+		constexpr FORCE_INLINE SharedStringBase()
+			: chars{}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a string with a copy of
+		 * any string source.
+		 *
+		 * @param src string source
+		 */
+		SharedStringBase(StringSourceT const& src)
+			: chars{}
+		{
+			if (src.len > 0)
+			{
+				chars.reserve(src.len + 1);
+				chars.appendRange(src.src, src.src + src.len);
+				chars.append(termChar);
+			}
+		}
+
+		/**
+		 * @brief Construct a string from a
+		 * null-terminated string.
+		 *
+		 * @param cstr pointer to C string
+		 */
+		FORCE_INLINE SharedStringBase(CharT const* cstr)
+			: SharedStringBase{StringSourceT{cstr}}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a string by reading
+		 * @c len characters from source.
+		 *
+		 * @param src pointer to buffer to read from
+		 * @param len number of characters to read
+		 */
+		FORCE_INLINE SharedStringBase(CharT const* src, sizet len)
+			: SharedStringBase{StringSourceT{src, len}}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a string with a copy of
+		 * an unshared string.
+		 *
+		 * @param other string to copy
+		 */
+		FORCE_INLINE explicit SharedStringBase(StringBase<CharT> const& other)
+			: SharedStringBase{StringSourceT{other}}
+		{
+			//
+		}
+
+		/**
+		 * @brief Returns the length of the string
+		 * (excluding the terminating character).
+		 */
+		FORCE_INLINE sizet getLength() const
+		{
+			sizet const numItems = chars.getNumItems();
+			return numItems > 0 ? numItems - 1 : 0;
+		}
+
+		/**
+		 * @brief Helper that returns the number of bytes
+		 * required to store the string, including the
+		 * terminating character.
+		 */
+		FORCE_INLINE sizet getNumBytes() const
+		{
+			return (getLength() + 1) * sizeof(CharT);
+		}
+
+		/**
+		 * @brief Returns true if the characters are
+		 * shared with other strings.
+		 */
+		FORCE_INLINE bool isShared() const
+		{
+			return chars.isShared();
+		}
+
+		/**
+		 * @brief Returns the number of strings that
+		 * share the characters with this one, this
+		 * string included.
+		 */
+		FORCE_INLINE sizet getRefCount() const
+		{
+			return chars.getRefCount();
+		}
+
+		/**
+		 * @brief Returns a ref to the i-th
+		 * character of the string. The non-const
+		 * overload detaches the string if it is
+		 * shared.
+		 *
+		 * @param idx index of the character
+		 * @return ref to character
+		 * @{
+		 */
+		FORCE_INLINE CharT const& operator[](sizet idx) const
+		{
+			CHECKF(idx < getLength(), "Index %llu out of bounds (length %llu)", idx, getLength())
+			return chars[idx];
+		}
+
+		FORCE_INLINE CharT& operator[](sizet idx)
+		{
+			CHECKF(idx < getLength(), "Index %llu out of bounds (length %llu)", idx, getLength())
+			return chars[idx];
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns a pointer to the
+		 * null-terminated C string.
+		 */
+		FORCE_INLINE CharT const* operator*() const
+		{
+			static constexpr CharT emptyString[1]{termChar};
+			return chars.getNumItems() > 0 ? *chars : emptyString;
+		}
+
+		/**
+		 * @brief Compare two strings.
+		 *
+		 * @param other another string
+		 * @return true if strings are equal
+		 * @return false otherwise
+		 */
+		FORCE_INLINE bool operator==(StringViewT const& other) const
+		{
+			return StringViewT{*this} == other;
+		}
+
+		/**
+		 * @brief Compare two strings.
+		 *
+		 * @param other another string
+		 * @return true if strings are not equal
+		 * @return false otherwise
+		 */
+		FORCE_INLINE bool operator!=(StringViewT const& other) const
+		{
+			return !(*this == other);
+		}
+
+		/**
+		 * @brief Returns true if this string precedes
+		 * the other string in alphabetical order.
+		 *
+		 * @param other another string
+		 * @return true if this string precedes other
+		 * @return false otherwise
+		 */
+		FORCE_INLINE bool operator<(StringViewT const& other) const
+		{
+			return StringViewT{*this} < other;
+		}
+
+		/**
+		 * @brief Returns true if this string succeeds
+		 * the other string in alphabetical order.
+		 *
+		 * @param other another string
+		 * @return true if this string succeeds other
+		 * @return false otherwise
+		 */
+		FORCE_INLINE bool operator>(StringViewT const& other) const
+		{
+			return StringViewT{*this} > other;
+		}
+
+		/**
+		 * @brief Append a character to the end of the
+		 * string. Detaches the string if it is
+		 * shared.
+		 *
+		 * @param c the character to append
+		 * @return ref to self
+		 */
+		SharedStringBase& operator+=(CharT c)
+		{
+			return *this += StringSourceT{&c, 1};
+		}
+
+		/**
+		 * @brief Append another string source to this
+		 * string. Detaches the string if it is
+		 * shared.
+		 *
+		 * @param other any string source
+		 * @return ref to self
+		 */
+		SharedStringBase& operator+=(StringSourceT const& other)
+		{
+			KORIN_ASSERTF(other.src != nullptr || other.len == 0, "Appending null string source of length %llu", other.len)
+
+			if (other.len > 0)
+			{
+				// Detach and grow at most once, then replace
+				// the terminating character
+				chars.reserve(getLength() + other.len + 1);
+				if (chars.getNumItems() > 0)
+				{
+					chars.pop();
+				}
+
+				chars.appendRange(other.src, other.src + other.len);
+				chars.append(termChar);
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Returns an unshared copy of the
+		 * string.
+		 */
+		FORCE_INLINE StringBase<CharT> toString() const
+		{
+			return StringBase<CharT>{**this, getLength()};
+		}
+
+	protected:
+		/* Characters of the string, including the terminating character. Empty if the string is empty. */
+		SharedArray<CharT> chars;
+	};
+
+	/**
+	 * @brief Shared strings are sorted in
+	 * alphabetical order, and can be compared
+	 * with any string view.
+	 *
+	 * @tparam CharT the type of a string character
+	 */
+	template<typename CharT>
+	struct ChoosePolicy<SharedStringBase<CharT>> : public ChoosePolicy<StringViewBase<CharT>>
+	{
+		//
+	};
+
+	/**
+	 * @brief Specialization for hashing shared
+	 * string keys. Equal strings hash to the same
+	 * key as the unshared string type.
+	 *
+	 * @tparam CharT the type of a sring character
+	 */
+	template<typename CharT>
+	struct ChooseHashPolicy<SharedStringBase<CharT>> : public ChooseHashPolicy<StringViewBase<CharT>>
+	{
+		//
+	};
+} // namespace Korin
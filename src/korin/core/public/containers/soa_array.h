@@ -0,0 +1,477 @@
+#pragma once
+
+#include "containers_types.h"
+#include "templates/utility.h"
+#include "templates/sequence.h"
+#include "hal/platform_memory.h"
+#include "hal/platform_math.h"
+#include "array.h"
+#include "span.h"
+#include "tuple.h"
+
+namespace Korin
+{
+	namespace SoAArray_Impl
+	{
+		/**
+		 * @brief Selects the type at the given
+		 * index of a type list.
+		 *
+		 * @tparam idx index of the type
+		 * @tparam HeadT first type of the list
+		 * @tparam ItemsT rest of the list
+		 */
+		template<sizet idx, typename HeadT, typename ...ItemsT>
+		struct TypeAt
+		{
+			using Type = typename TypeAt<idx - 1, ItemsT...>::Type;
+		};
+
+		template<typename HeadT, typename ...ItemsT>
+		struct TypeAt<0, HeadT, ItemsT...>
+		{
+			using Type = HeadT;
+		};
+
+		/**
+		 * @brief Round a size up to a multiple of
+		 * the given power-of-two alignment.
+		 */
+		constexpr FORCE_INLINE sizet alignUp(sizet size, sizet alignment)
+		{
+			return (size + alignment - 1) & ~(alignment - 1);
+		}
+
+		/**
+		 * @brief Returns the largest alignment
+		 * among the given types and a cache line.
+		 */
+		template<typename ...ItemsT>
+		constexpr sizet getColumnAlignment()
+		{
+			sizet alignment = PLATFORM_CACHE_LINE_SIZE;
+			((alignment = PlatformMath::max(alignment, sizet(alignof(ItemsT)))), ...);
+			return alignment;
+		}
+	} // namespace SoAArray_Impl
+
+	/**
+	 * @brief A growing array of records whose
+	 * fields are stored in separate columns
+	 * (structure of arrays).
+	 *
+	 * Each column is a contiguous buffer aligned
+	 * to at least a cache line, so that loops
+	 * that only touch a few fields only load
+	 * those fields, and can be vectorized by
+	 * the compiler. All columns live in the same
+	 * allocation and grow together.
+	 *
+	 * Rows are accessed as tuples of refs, and
+	 * columns as spans.
+	 *
+	 * @tparam ItemsT the types of the fields
+	 */
+	template<typename ...ItemsT>
+	class SoAArray
+	{
+		static_assert(sizeof...(ItemsT) > 0, "SoAArray requires at least one field");
+
+		/* Number of columns. */
+		static constexpr sizet numColumns = sizeof...(ItemsT);
+
+		/* Alignment of each column. */
+		static constexpr sizet columnAlignment = SoAArray_Impl::getColumnAlignment<ItemsT...>();
+
+		/* Index sequence of the columns. */
+		using ColumnIdxs = decltype(seq<sizet, numColumns>());
+
+		template<sizet idx>
+		using ColumnT = typename SoAArray_Impl::TypeAt<idx, ItemsT...>::Type;
+
+		/**
+		 * @brief Returns a ptr to the first item
+		 * of a column.
+		 */
+		template<sizet idx>
+		FORCE_INLINE ColumnT<idx>* getColumnData() const
+		{
+			return reinterpret_cast<ColumnT<idx>*>(columns[idx]);
+		}
+
+		/**
+		 * @brief Returns the size of the buffer
+		 * required to store the given number of
+		 * rows.
+		 */
+		static constexpr sizet getBufferSize(sizet numRows)
+		{
+			return (SoAArray_Impl::alignUp(numRows * sizeof(ItemsT), columnAlignment) + ...);
+		}
+
+		/**
+		 * @brief Compute the column ptrs for the
+		 * given buffer.
+		 *
+		 * @param buffer ptr to the buffer
+		 * @param numRows capacity of the buffer
+		 * @param outColumns column ptrs
+		 */
+		static FORCE_INLINE void layoutColumns(ubyte* buffer, sizet numRows, void** outColumns)
+		{
+			sizet offset = 0;
+			sizet idx = 0;
+			((outColumns[idx++] = buffer + offset, offset += SoAArray_Impl::alignUp(numRows * sizeof(ItemsT), columnAlignment)), ...);
+		}
+
+		/**
+		 * @brief Move all items to a new buffer
+		 * that fits the given number of rows.
+		 *
+		 * @param newCapacity capacity of the new
+		 * buffer, in number of rows
+		 */
+		template<sizet ...idxs>
+		void resize(sizet const newCapacity, IndexSequence<idxs...>)
+		{
+			CHECKF(newCapacity >= count, "Cannot fit %llu rows in new buffer (%llu rows)", count, newCapacity)
+
+			// One allocation for all columns
+			ubyte* newBuffer = reinterpret_cast<ubyte*>(gMalloc->malloc(getBufferSize(newCapacity), columnAlignment));
+			void* newColumns[numColumns];
+			layoutColumns(newBuffer, newCapacity, newColumns);
+
+			if (count > 0)
+			{
+				// Move existing items column by column
+				((moveConstructItems(reinterpret_cast<ColumnT<idxs>*>(newColumns[idxs]), getColumnData<idxs>(), count),
+				  destroyItems(getColumnData<idxs>(), count)), ...);
+			}
+
+			if (columns[0])
+			{
+				gMalloc->free(columns[0]);
+			}
+
+			((columns[idxs] = newColumns[idxs]), ...);
+			capacity = newCapacity;
+		}
+
+		/**
+		 * @brief Resize the buffer to fit the
+		 * required number of rows.
+		 *
+		 * @param requiredSize min number of rows
+		 */
+		FORCE_INLINE void growToFit(sizet const requiredSize)
+		{
+			if (capacity < requiredSize)
+			{
+				// Find appropriate size
+				sizet newCapacity = PlatformMath::max(capacity, sizet(KORIN_ARRAY_MIN_SIZE));
+				for (; newCapacity < requiredSize; newCapacity = newCapacity << 1);
+
+				resize(newCapacity, ColumnIdxs{});
+			}
+		}
+
+		/**
+		 * @brief Destroy all items and deallocate
+		 * the buffer.
+		 */
+		template<sizet ...idxs>
+		void destroy(IndexSequence<idxs...>)
+		{
+			if (columns[0])
+			{
+				(destroyItems(getColumnData<idxs>(), count), ...);
+				gMalloc->free(columns[0]);
+				((columns[idxs] = nullptr), ...);
+			}
+
+			count = capacity = 0;
+		}
+
+		/**
+		 * @brief Copy construct the rows of
+		 * another array. This array must be empty.
+		 */
+		template<sizet ...idxs>
+		void copyRows(SoAArray const& other, IndexSequence<idxs...>)
+		{
+			if (other.count > 0)
+			{
+				growToFit(other.count);
+				(copyConstructItems(getColumnData<idxs>(), other.template getColumnData<idxs>(), other.count), ...);
+				count = other.count;
+			}
+		}
+
+		/**
+		 * @brief Take the buffer of another array,
+		 * leaving it empty. This array must be
+		 * empty.
+		 */
+		FORCE_INLINE void steal(SoAArray& other)
+		{
+			for (sizet idx = 0; idx < numColumns; ++idx)
+			{
+				columns[idx] = other.columns[idx];
+				other.columns[idx] = nullptr;
+			}
+
+			capacity = other.capacity;
+			count = other.count;
+			other.capacity = other.count = 0;
+		}
+
+		/**
+		 * @brief Construct a new row at the end of
+		 * the array.
+		 */
+		template<sizet ...idxs>
+		FORCE_INLINE void appendRow(IndexSequence<idxs...>, auto&& ...items)
+		{
+			(new (getColumnData<idxs>() + count) ColumnT<idxs>{FORWARD(items)}, ...);
+		}
+
+		/**
+		 * @brief Returns a tuple of refs to the
+		 * fields of a row.
+		 */
+		template<typename RowT, sizet ...idxs>
+		FORCE_INLINE RowT getRow(uint64 idx, IndexSequence<idxs...>) const
+		{
+			return RowT{getColumnData<idxs>()[idx]...};
+		}
+
+		/**
+		 * @brief Destroy the fields of a row.
+		 */
+		template<sizet ...idxs>
+		FORCE_INLINE void destroyRow(uint64 idx, IndexSequence<idxs...>)
+		{
+			(destroyItems(getColumnData<idxs>() + idx, 1), ...);
+		}
+
+	public:
+		/**
+		 * @brief Construct an empty array.
+		 */
+		FORCE_INLINE SoAArray()
+			: columns{}
+			, capacity{0}
+			, count{0}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct an empty array with
+		 * space for the given number of rows.
+		 *
+		 * @param reservedSize number of rows to
+		 * reserve
+		 */
+		FORCE_INLINE explicit SoAArray(sizet reservedSize)
+			: SoAArray{}
+		{
+			growToFit(reservedSize);
+		}
+
+		/**
+		 * @brief Construct a copy of another
+		 * array.
+		 *
+		 * @param other another array
+		 */
+		SoAArray(SoAArray const& other)
+			: SoAArray{}
+		{
+			copyRows(other, ColumnIdxs{});
+		}
+
+		/**
+		 * @brief Move another array.
+		 *
+		 * @param other another array
+		 */
+		SoAArray(SoAArray&& other)
+			: SoAArray{}
+		{
+			steal(other);
+		}
+
+		/**
+		 * @brief Replace the rows of this array
+		 * with a copy of another array's.
+		 *
+		 * @param other another array
+		 * @return ref to self
+		 */
+		SoAArray& operator=(SoAArray const& other)
+		{
+			if (this != &other)
+			{
+				destroy(ColumnIdxs{});
+				copyRows(other, ColumnIdxs{});
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Destroy this array and move
+		 * another array.
+		 *
+		 * @param other another array
+		 * @return ref to self
+		 */
+		SoAArray& operator=(SoAArray&& other)
+		{
+			if (this != &other)
+			{
+				destroy(ColumnIdxs{});
+				steal(other);
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Destroy all rows and deallocate
+		 * the buffer.
+		 */
+		FORCE_INLINE ~SoAArray()
+		{
+			destroy(ColumnIdxs{});
+		}
+
+		/**
+		 * @brief Returns the number of rows in
+		 * the array.
+		 */
+		FORCE_INLINE sizet getNumItems() const
+		{
+			return count;
+		}
+
+		/**
+		 * @brief Returns the number of rows that
+		 * fit in the current buffer.
+		 */
+		FORCE_INLINE sizet getCapacity() const
+		{
+			return capacity;
+		}
+
+		/**
+		 * @brief Returns the number of fields of
+		 * each row.
+		 */
+		static constexpr FORCE_INLINE sizet getNumColumns()
+		{
+			return numColumns;
+		}
+
+		/**
+		 * @brief Returns a span over the given
+		 * column.
+		 *
+		 * @tparam idx index of the column
+		 * @return span of field values
+		 * @{
+		 */
+		template<sizet idx>
+		FORCE_INLINE Span<ColumnT<idx>> getColumn()
+		{
+			return {getColumnData<idx>(), count};
+		}
+
+		template<sizet idx>
+		FORCE_INLINE Span<ColumnT<idx> const> getColumn() const
+		{
+			return {getColumnData<idx>(), count};
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns a tuple of refs to the
+		 * fields of the i-th row.
+		 *
+		 * @param idx index of the row
+		 * @return tuple of refs
+		 * @{
+		 */
+		FORCE_INLINE Tuple<ItemsT&...> operator[](uint64 idx)
+		{
+			CHECK(idx < count)
+			return getRow<Tuple<ItemsT&...>>(idx, ColumnIdxs{});
+		}
+
+		FORCE_INLINE Tuple<ItemsT const&...> operator[](uint64 idx) const
+		{
+			CHECK(idx < count)
+			return getRow<Tuple<ItemsT const&...>>(idx, ColumnIdxs{});
+		}
+		/** @} */
+
+		/**
+		 * @brief Make sure the array can store the
+		 * given number of rows without resizing.
+		 *
+		 * @param reservedSize number of rows
+		 */
+		FORCE_INLINE void reserve(sizet reservedSize)
+		{
+			growToFit(reservedSize);
+		}
+
+		/**
+		 * @brief Append a new row at the end of the
+		 * array.
+		 *
+		 * @param items the fields of the row, one
+		 * for each column
+		 * @return index of the new row
+		 */
+		sizet append(auto&& ...items)
+		{
+			static_assert(sizeof...(items) == numColumns, "Expected one value for each column");
+
+			growToFit(count + 1);
+			appendRow(ColumnIdxs{}, FORWARD(items)...);
+			return count++;
+		}
+
+		/**
+		 * @brief Remove the last row of the array.
+		 */
+		void pop()
+		{
+			CHECK(count > 0)
+
+			count--;
+			destroyRow(count, ColumnIdxs{});
+		}
+
+		/**
+		 * @brief Remove all rows and deallocate
+		 * the buffer.
+		 */
+		FORCE_INLINE void reset()
+		{
+			destroy(ColumnIdxs{});
+		}
+
+	protected:
+		/* Ptr to the first item of each column, the first is also the buffer. */
+		void* columns[numColumns];
+
+		/* Number of rows that fit in the buffer. */
+		sizet capacity;
+
+		/* Number of rows in the array. */
+		sizet count;
+	};
+} // namespace Korin
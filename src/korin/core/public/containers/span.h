@@ -0,0 +1,265 @@
+#pragma once
+
+#include "containers_types.h"
+#include "templates/enable_if.h"
+#include "templates/types.h"
+
+namespace Korin
+{
+	/**
+	 * @brief A non-owning view over a contiguous
+	 * sequence of items.
+	 *
+	 * A span does not manage the lifetime of the
+	 * items it refers to, and it's invalidated as
+	 * soon as the underlying buffer is resized or
+	 * destroyed.
+	 *
+	 * Arrays, static arrays and pointer ranges
+	 * convert implicitly to spans, so functions
+	 * that only need to read (or modify in place)
+	 * a sequence of items should accept a span
+	 * rather than an array.
+	 *
+	 * A span of constant items is declared as
+	 * `Span<T const>`.
+	 *
+	 * @tparam T the type of the items
+	 */
+	template<typename T>
+	class Span
+	{
+		template<typename> friend class Span;
+
+	public:
+		using Iterator = T*;
+		using ConstIterator = T const*;
+
+		/**
+		 * @brief Construct an empty span.
+		 */
+		constexpr FORCE_INLINE Span()
+			: data{nullptr}
+			, count{0}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a span that refers to
+		 * the given buffer.
+		 *
+		 * @param inData ptr to the first item
+		 * @param inCount number of items
+		 */
+		constexpr FORCE_INLINE Span(T* inData, sizet inCount)
+			: data{inData}
+			, count{inCount}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a span from a range of
+		 * pointers.
+		 *
+		 * The end must be a pointer, so that
+		 * `Span{ptr, 0}` picks the count overload.
+		 *
+		 * @param inBegin ptr to the first item
+		 * @param inEnd ptr past the last item
+		 */
+		template<typename EndT, typename = typename EnableIf<IsPointer<EndT>::value>::Type>
+		constexpr FORCE_INLINE Span(T* inBegin, EndT inEnd)
+			: data{inBegin}
+			, count{static_cast<sizet>(inEnd - inBegin)}
+		{
+			CHECKF(inBegin <= inEnd, "Span end precedes its begin")
+		}
+
+		/**
+		 * @brief Construct a span that refers to
+		 * a static array.
+		 *
+		 * @tparam n length of the array
+		 * @param items the static array
+		 */
+		template<sizet n>
+		constexpr FORCE_INLINE Span(T (&items)[n])
+			: data{items}
+			, count{n}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a span of constant items
+		 * from a span of mutable items.
+		 *
+		 * @param other another span
+		 */
+		template<typename U, typename = typename EnableIf<SameType<U const, T>::value>::Type>
+		constexpr FORCE_INLINE Span(Span<U> const& other)
+			: data{other.data}
+			, count{other.count}
+		{
+			//
+		}
+
+		/**
+		 * @brief Returns the number of items in
+		 * the span.
+		 */
+		constexpr FORCE_INLINE sizet getNumItems() const
+		{
+			return count;
+		}
+
+		/**
+		 * @brief Returns the number of Bytes
+		 * spanned by the items.
+		 */
+		constexpr FORCE_INLINE sizet getNumBytes() const
+		{
+			return count * sizeof(T);
+		}
+
+		/**
+		 * @brief Returns true if the span has no
+		 * items.
+		 */
+		constexpr FORCE_INLINE bool isEmpty() const
+		{
+			return count == 0;
+		}
+
+		/**
+		 * @brief Returns a pointer to the first
+		 * item of the span.
+		 */
+		constexpr FORCE_INLINE T* operator*() const
+		{
+			return data;
+		}
+
+		/**
+		 * @brief Returns a reference to the
+		 * i-th item.
+		 *
+		 * @param idx index of the item
+		 * @return ref to the item
+		 */
+		constexpr FORCE_INLINE T& operator[](uint64 idx) const
+		{
+			CHECKF(idx < count, "Index %llu out of bounds (%llu items)", idx, count)
+			return data[idx];
+		}
+
+		/**
+		 * @brief Returns an iterator that points
+		 * to the first item of the span.
+		 */
+		constexpr FORCE_INLINE Iterator begin() const
+		{
+			return data;
+		}
+
+		/**
+		 * @brief Returns an iterator that points
+		 * to the end of the span.
+		 */
+		constexpr FORCE_INLINE Iterator end() const
+		{
+			return data + count;
+		}
+
+		/**
+		 * @brief Returns a ref to the first item.
+		 * The span must not be empty.
+		 */
+		constexpr FORCE_INLINE T& getFirst() const
+		{
+			CHECKF(count > 0, "Span is empty")
+			return data[0];
+		}
+
+		/**
+		 * @brief Returns a ref to the last item.
+		 * The span must not be empty.
+		 */
+		constexpr FORCE_INLINE T& getLast() const
+		{
+			CHECKF(count > 0, "Span is empty")
+			return data[count - 1];
+		}
+
+		/**
+		 * @brief Returns a span that refers to a
+		 * subsequence of this span's items.
+		 *
+		 * No item is copied.
+		 *
+		 * @param offset index of the first item
+		 * @param numItems number of items; if
+		 * omitted, spans until the end
+		 * @return new span
+		 * @{
+		 */
+		constexpr FORCE_INLINE Span subspan(sizet offset, sizet numItems) const
+		{
+			CHECKF(offset <= count, "Subspan offset %llu out of bounds (%llu items)", offset, count)
+			CHECKF(numItems <= count - offset, "Subspan [%llu:+%llu] out of bounds (%llu items)", offset, numItems, count)
+			return {data + offset, numItems};
+		}
+
+		constexpr FORCE_INLINE Span subspan(sizet offset) const
+		{
+			CHECKF(offset <= count, "Subspan offset %llu out of bounds (%llu items)", offset, count)
+			return {data + offset, count - offset};
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns a slice of the span.
+		 *
+		 * Unlike @c Array::slice() this never
+		 * copies the items.
+		 *
+		 * @param beginIdx index of the beginning
+		 * of the slice
+		 * @param endIdx index of the end of the
+		 * slice (excluded); if omitted assume end
+		 * of span.
+		 * @return sliced span
+		 * @{
+		 */
+		constexpr FORCE_INLINE Span slice(uint64 beginIdx, uint64 endIdx) const
+		{
+			CHECKF(endIdx <= count, "Slice end %llu out of bounds (%llu items)", endIdx, count)
+			CHECKF(beginIdx <= endIdx, "Slice begin %llu past its end %llu", beginIdx, endIdx)
+			return {data + beginIdx, endIdx - beginIdx};
+		}
+
+		constexpr FORCE_INLINE Span slice(uint64 beginIdx) const
+		{
+			return slice(beginIdx, count);
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns a span that views the same
+		 * items as raw Bytes.
+		 */
+		FORCE_INLINE Span<ubyte const> asBytes() const
+		{
+			return {reinterpret_cast<ubyte const*>(data), getNumBytes()};
+		}
+
+	protected:
+		/* Pointer to the first item. */
+		T* data;
+
+		/* Number of items in the span. */
+		sizet count;
+	};
+} // namespace Korin
@@ -0,0 +1,328 @@
+#pragma once
+
+#include "containers_types.h"
+#include "span.h"
+#include "templates/utility.h"
+#include "hal/platform_memory.h"
+#include "hal/platform_math.h"
+#include "hal/atomic.h"
+
+namespace Korin
+{
+	/**
+	 * @brief A bounded, lock-free queue that
+	 * hands items from exactly one producer
+	 * thread to exactly one consumer thread.
+	 *
+	 * The queue is a ring buffer whose capacity
+	 * is rounded up to a power of two. Push and
+	 * pop operations are wait-free: they never
+	 * block nor retry, and fail if the queue is
+	 * full or empty, respectively.
+	 *
+	 * Producer and consumer indices live on
+	 * separate cache lines. Each side keeps a
+	 * private copy of the other side's index and
+	 * only reloads it when the copy says the
+	 * queue is full (or empty), which keeps
+	 * cache line transfers to a minimum.
+	 *
+	 * Only the producer thread may call the
+	 * push methods, and only the consumer thread
+	 * may call the pop methods.
+	 *
+	 * @tparam T the type of the items
+	 */
+	template<typename T>
+	class SpscQueue
+	{
+		/**
+		 * @brief Returns the number of slots that
+		 * can be read or written starting from the
+		 * given index without wrapping around.
+		 */
+		FORCE_INLINE sizet getNumContiguousSlots(sizet idx, sizet numSlots) const
+		{
+			return PlatformMath::min(numSlots, capacity - (idx & mask));
+		}
+
+	public:
+		/**
+		 * @brief Construct an empty queue.
+		 *
+		 * @param minCapacity minimum number of
+		 * items the queue can hold, rounded up to
+		 * a power of two
+		 */
+		explicit SpscQueue(sizet minCapacity)
+			: items{nullptr}
+			, capacity{PlatformMath::roundUpToPowerOfTwo(PlatformMath::max(minCapacity, sizet(2)))}
+			, mask{capacity - 1}
+			, head{0}
+			, cachedTail{0}
+			, tail{0}
+			, cachedHead{0}
+		{
+			constexpr sizet alignment = PlatformMath::max(sizet(alignof(T)), sizet(PLATFORM_CACHE_LINE_SIZE));
+			items = reinterpret_cast<T*>(gMalloc->malloc(capacity * sizeof(T), alignment));
+		}
+
+		/**
+		 * @brief Queues are shared by two threads
+		 * and cannot be copied or moved.
+		 * @{
+		 */
+		SpscQueue(SpscQueue const&) = delete;
+		SpscQueue& operator=(SpscQueue const&) = delete;
+		/** @} */
+
+		/**
+		 * @brief Destroy the remaining items and
+		 * the ring buffer. No thread may access
+		 * the queue anymore.
+		 */
+		~SpscQueue()
+		{
+			sizet const h = head.load(MemoryOrder::Acquire);
+			sizet const t = tail.load(MemoryOrder::Acquire);
+
+			for (sizet i = h; i != t; ++i)
+			{
+				destroyItems(items + (i & mask), 1);
+			}
+
+			gMalloc->free(items);
+		}
+
+		/**
+		 * @brief Returns the maximum number of
+		 * items in the queue.
+		 */
+		FORCE_INLINE sizet getCapacity() const
+		{
+			return capacity;
+		}
+
+		/**
+		 * @brief Returns the number of items in
+		 * the queue. The value may be out of date
+		 * by the time it's returned.
+		 */
+		FORCE_INLINE sizet getNumItems() const
+		{
+			sizet const h = head.load(MemoryOrder::Acquire);
+			sizet const t = tail.load(MemoryOrder::Acquire);
+			return t - h;
+		}
+
+		/**
+		 * @brief Returns true if the queue is
+		 * empty. The value may be out of date by
+		 * the time it's returned.
+		 */
+		FORCE_INLINE bool isEmpty() const
+		{
+			return getNumItems() == 0;
+		}
+
+		/**
+		 * @brief Construct a new item at the back
+		 * of the queue. Producer only.
+		 *
+		 * @param createArgs arguments used to
+		 * construct the item
+		 * @return true if the item was pushed,
+		 * false if the queue is full
+		 */
+		bool tryEmplace(auto&& ...createArgs)
+		{
+			sizet const t = tail.load(MemoryOrder::Relaxed);
+			if (t - cachedHead == capacity)
+			{
+				// Refresh consumer index
+				cachedHead = head.load(MemoryOrder::Acquire);
+				if (t - cachedHead == capacity)
+				{
+					return false;
+				}
+			}
+
+			new (items + (t & mask)) T{FORWARD(createArgs)...};
+
+			// Publish item
+			tail.store(t + 1, MemoryOrder::Release);
+			return true;
+		}
+
+		/**
+		 * @brief Push an item at the back of the
+		 * queue. Producer only.
+		 *
+		 * @param item item to copy or move
+		 * @return true if the item was pushed,
+		 * false if the queue is full
+		 */
+		FORCE_INLINE bool tryPush(auto&& item)
+		{
+			return tryEmplace(FORWARD(item));
+		}
+
+		/**
+		 * @brief Copy as many items as possible at
+		 * the back of the queue, in order.
+		 * Producer only.
+		 *
+		 * All items are published at once with a
+		 * single store.
+		 *
+		 * @param inItems items to push
+		 * @return number of items pushed
+		 */
+		sizet tryPushBatch(Span<T const> inItems)
+		{
+			sizet const t = tail.load(MemoryOrder::Relaxed);
+			sizet numSlots = capacity - (t - cachedHead);
+			if (numSlots < inItems.getNumItems())
+			{
+				// Refresh consumer index
+				cachedHead = head.load(MemoryOrder::Acquire);
+				numSlots = capacity - (t - cachedHead);
+			}
+
+			sizet const numItems = PlatformMath::min(numSlots, inItems.getNumItems());
+			if (numItems == 0)
+			{
+				return 0;
+			}
+
+			// Copy items in at most two chunks
+			sizet const numFirst = getNumContiguousSlots(t, numItems);
+			copyConstructItems(items + (t & mask), *inItems, numFirst);
+			if (numFirst < numItems)
+			{
+				copyConstructItems(items, *inItems + numFirst, numItems - numFirst);
+			}
+
+			// Publish items
+			tail.store(t + numItems, MemoryOrder::Release);
+			return numItems;
+		}
+
+		/**
+		 * @brief Pop the item at the front of the
+		 * queue. Consumer only.
+		 *
+		 * @param outItem item that receives the
+		 * popped item
+		 * @return true if an item was popped,
+		 * false if the queue is empty
+		 */
+		bool tryPop(T& outItem)
+		{
+			sizet const h = head.load(MemoryOrder::Relaxed);
+			if (h == cachedTail)
+			{
+				// Refresh producer index
+				cachedTail = tail.load(MemoryOrder::Acquire);
+				if (h == cachedTail)
+				{
+					return false;
+				}
+			}
+
+			T* item = items + (h & mask);
+			outItem = move(*item);
+			destroyItems(item, 1);
+
+			// Release slot
+			head.store(h + 1, MemoryOrder::Release);
+			return true;
+		}
+
+		/**
+		 * @brief Pop as many items as possible from
+		 * the front of the queue, in order.
+		 * Consumer only.
+		 *
+		 * All slots are released at once with a
+		 * single store.
+		 *
+		 * @param outItems items that receive the
+		 * popped items
+		 * @return number of items popped
+		 */
+		sizet tryPopBatch(Span<T> outItems)
+		{
+			sizet const h = head.load(MemoryOrder::Relaxed);
+			sizet numAvailable = cachedTail - h;
+			if (numAvailable < outItems.getNumItems())
+			{
+				// Refresh producer index
+				cachedTail = tail.load(MemoryOrder::Acquire);
+				numAvailable = cachedTail - h;
+			}
+
+			sizet const numItems = PlatformMath::min(numAvailable, outItems.getNumItems());
+			if (numItems == 0)
+			{
+				return 0;
+			}
+
+			// Move items out in at most two chunks
+			sizet const numFirst = getNumContiguousSlots(h, numItems);
+			moveItems(*outItems, items + (h & mask), numFirst);
+			destroyItems(items + (h & mask), numFirst);
+			if (numFirst < numItems)
+			{
+				moveItems(*outItems + numFirst, items, numItems - numFirst);
+				destroyItems(items, numItems - numFirst);
+			}
+
+			// Release slots
+			head.store(h + numItems, MemoryOrder::Release);
+			return numItems;
+		}
+
+		/**
+		 * @brief Returns a ptr to the item at the
+		 * front of the queue, or nullptr if the
+		 * queue is empty. Consumer only.
+		 */
+		T* peek()
+		{
+			sizet const h = head.load(MemoryOrder::Relaxed);
+			if (h == cachedTail)
+			{
+				cachedTail = tail.load(MemoryOrder::Acquire);
+				if (h == cachedTail)
+				{
+					return nullptr;
+				}
+			}
+
+			return items + (h & mask);
+		}
+
+	protected:
+		/* Ring buffer, read-only after construction. */
+		T* items;
+
+		/* Number of slots in the ring buffer. */
+		sizet capacity;
+
+		/* Mask used to wrap indices. */
+		sizet mask;
+
+		/* Index of the next item to pop, written by the consumer. */
+		alignas(PLATFORM_CACHE_LINE_SIZE) Atomic<sizet> head;
+
+		/* Consumer copy of the producer index. */
+		sizet cachedTail;
+
+		/* Index of the next slot to push, written by the producer. */
+		alignas(PLATFORM_CACHE_LINE_SIZE) Atomic<sizet> tail;
+
+		/* Producer copy of the consumer index. */
+		sizet cachedHead;
+	};
+} // namespace Korin
@@ -3,9 +3,11 @@
 #include "templates/types.h"
 #include "hal/platform_memory.h"
 #include "hal/platform_string.h"
+#include "hal/platform_math.h"
 #include "containers_types.h"
+#include "string_convert.h"
 #include "tuple.h"
-#include "array.h"
+#include "string_view.h"
 
 namespace Korin
 {
@@ -77,13 +79,87 @@ namespace Korin
 			//
 		}
 
+		/**
+		 * @brief Accept a string view.
+		 *
+		 * @param other a string view
+		 */
+		constexpr FORCE_INLINE StringSource(StringViewBase<CharT> const& other)
+			: StringSource{*other, other.getLength()}
+		{
+			//
+		}
+
+		/**
+		 * @brief Accept a shared string.
+		 *
+		 * @param other a shared string
+		 */
+		constexpr FORCE_INLINE StringSource(SharedStringBase<CharT> const& other)
+			: StringSource{*other, other.getLength()}
+		{
+			//
+		}
+
+		/**
+		 * @brief Accept a hashed string.
+		 *
+		 * @param other a hashed string
+		 */
+		constexpr FORCE_INLINE StringSource(HashedStringBase<CharT> const& other)
+			: StringSource{*other, other.getLength()}
+		{
+			//
+		}
+
 	private:
 		StringSource() = delete;
 	};
 
+	/**
+	 * @brief Range over a string that it owns.
+	 * Returned by the ranges of temporary
+	 * strings, which would otherwise be
+	 * destroyed before the loop starts.
+	 *
+	 * The view range is created when iterating,
+	 * because moving the range moves the inline
+	 * characters of short strings.
+	 *
+	 * @tparam CharT the type of the characters
+	 * @tparam MakeRangeT function that returns
+	 * the view range of a view over the string
+	 */
+	template<typename CharT, typename MakeRangeT>
+	struct StringOwnedRange
+	{
+		/* String to iterate. */
+		StringBase<CharT> str;
+
+		/* Creates the view range. */
+		MakeRangeT makeRange;
+
+		FORCE_INLINE auto begin() const
+		{
+			return makeRange(StringViewBase<CharT>{str}).begin();
+		}
+
+		FORCE_INLINE auto end() const
+		{
+			return makeRange(StringViewBase<CharT>{str}).end();
+		}
+	};
+
 	/**
 	 * @brief Base class for string types.
 	 *
+	 * Short strings are stored inline, without
+	 * allocating: on 64-bit platforms, strings
+	 * of up to 22 8-bit characters fit in the
+	 * string object itself. Longer strings are
+	 * stored in a heap buffer whose capacity is
+	 * stored right before the characters.
+	 *
 	 * @tparam CharT the type of the characters
 	 */
 	template<typename CharT>
@@ -93,14 +169,30 @@ namespace Korin
 
 		static constexpr CharT termChar{0};
 
+		/* Number of characters in the inline buffer. */
+		static constexpr sizet bufferSize = (2 * sizeof(CharT*) + sizeof(sizet)) / sizeof(CharT);
+
+		/* Max length of an inline string. The buffer also holds the terminating character and the tag. */
+		static constexpr sizet inlineCapacity = bufferSize - 2;
+
+		/* Tag value of heap strings. Inline strings store their length instead. */
+		static constexpr CharT heapTag = CharT(inlineCapacity + 1);
+
+		static_assert(inlineCapacity > 0, "Char type is too wide for the inline buffer");
+
+		/* Ropes flatten into an uninitialized string. */
+		template<typename> friend class RopeBase;
+
 	public:
 		using StringSourceT = StringSource<CharT>;
+		using StringViewT = StringViewBase<CharT>;
 
 		/**
-		 * @brief Construct an empty string.
+		 * @brief Construct an empty string. Empty
+		 * strings do not allocate.
 		 */
 		FORCE_INLINE StringBase()
-			: array{1, termChar}
+			: buffer{}
 		{
 			//
 		}
@@ -112,10 +204,10 @@ namespace Korin
 		 * @param src string source
 		 */
 		FORCE_INLINE StringBase(StringSourceT const& src)
-			: array{src.len + 1, termChar}
+			: StringBase{src.len}
 		{
 			// Copy source string
-			PlatformMemory::memcpy(*array, src.src, src.len);
+			PlatformMemory::memcpy(getData(), src.src, src.len * sizeof(CharT));
 		}
 
 		/**
@@ -165,10 +257,210 @@ namespace Korin
 		 * @param n number of repeats
 		 */
 		FORCE_INLINE explicit StringBase(CharT const& c, sizet n)
-			: array{n + 1, c}
+			: StringBase{n}
 		{
-			// Terminate the string
-			terminate();
+			CharT* data = getData();
+			for (sizet i = 0; i < n; ++i)
+			{
+				data[i] = c;
+			}
+		}
+
+		/**
+		 * @brief Construct a string from a
+		 * concatenation expression, with a single
+		 * allocation.
+		 * @see StringConcat
+		 *
+		 * @param expr concatenation expression
+		 */
+		template<typename LhsT, typename RhsT>
+		FORCE_INLINE StringBase(StringConcat<CharT, LhsT, RhsT> const& expr)
+			: StringBase{expr.getLength()}
+		{
+			expr.writeTo(getData());
+		}
+
+		/**
+		 * @brief Copy another string.
+		 *
+		 * @param other string to copy
+		 */
+		FORCE_INLINE StringBase(StringBase const& other)
+			: StringBase{other, 0}
+		{
+			//
+		}
+
+		/**
+		 * @brief Move another string, leaving it
+		 * empty.
+		 *
+		 * @param other string to move
+		 */
+		FORCE_INLINE StringBase(StringBase&& other)
+		{
+			steal(other);
+		}
+
+		/**
+		 * @brief Replace the characters of this
+		 * string with a copy of another string's.
+		 * The buffer is reused if large enough.
+		 *
+		 * @param other string to copy
+		 * @return ref to self
+		 */
+		StringBase& operator=(StringBase const& other)
+		{
+			if (this != &other)
+			{
+				sizet const otherLen = other.getLength();
+				if (otherLen > getCapacity())
+				{
+					// Need a larger buffer
+					return *this = StringBase{other};
+				}
+
+				PlatformMemory::memcpy(getData(), *other, otherLen * sizeof(CharT));
+				setLength(otherLen);
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Release the characters of this
+		 * string and move another string.
+		 *
+		 * @param other string to move
+		 * @return ref to self
+		 */
+		FORCE_INLINE StringBase& operator=(StringBase&& other)
+		{
+			if (this != &other)
+			{
+				release();
+				steal(other);
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Release the heap buffer, if any.
+		 */
+		FORCE_INLINE ~StringBase()
+		{
+			release();
+		}
+
+		/**
+		 * @brief Returns a string with the code
+		 * points of a view in another encoding.
+		 * Invalid sequences are replaced with
+		 * U+FFFD.
+		 * @see Korin::transcode
+		 *
+		 * ```
+		 * WideString wide = WideString::transcode(utf8);
+		 * String utf8 = String::transcode(wide);
+		 * ```
+		 *
+		 * @param src view to convert
+		 * @return new string
+		 * @{
+		 */
+		template<typename OtherCharT>
+		static StringBase transcode(StringViewBase<OtherCharT> src)
+		{
+			StringBase str{maxTranscodedLength<CharT, OtherCharT>(src.getLength())};
+			str.setLength(Korin::transcode(*src, src.getLength(), str.getData()) - str.getData());
+
+			return str;
+		}
+
+		template<typename OtherCharT>
+		static FORCE_INLINE StringBase transcode(StringBase<OtherCharT> const& src)
+		{
+			return transcode(StringViewBase<OtherCharT>{src});
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns the concatenation of a
+		 * range of strings, with a separator
+		 * between consecutive ones. The result is
+		 * allocated once.
+		 *
+		 * ```
+		 * String csv = String::join(fields, ",");
+		 * ```
+		 *
+		 * @param items range of strings, or of any
+		 * type convertible to a view
+		 * @param separator separator between
+		 * consecutive strings
+		 * @return new string
+		 */
+		template<typename RangeT>
+		static StringBase join(RangeT const& items, StringViewT separator)
+		{
+			sizet len = 0, numItems = 0;
+			for (auto const& item : items)
+			{
+				len += StringViewT{item}.getLength();
+				++numItems;
+			}
+
+			if (numItems == 0)
+			{
+				return {};
+			}
+
+			StringBase str{len + (numItems - 1) * separator.getLength()};
+			CharT* it = str.getData();
+			bool first = true;
+			for (auto const& item : items)
+			{
+				if (!first)
+				{
+					PlatformMemory::memcpy(it, *separator, separator.getLength() * sizeof(CharT));
+					it += separator.getLength();
+				}
+
+				StringViewT const view{item};
+				PlatformMemory::memcpy(it, *view, view.getLength() * sizeof(CharT));
+				it += view.getLength();
+				first = false;
+			}
+
+			return str;
+		}
+
+		/**
+		 * @brief Returns a string of the given
+		 * length, whose characters are written by
+		 * a callable. The characters are not
+		 * initialized before.
+		 *
+		 * ```
+		 * String hex = String::create(2 * n, [&](ansichar* dst) { encodeHex(src, n, dst); });
+		 * ```
+		 *
+		 * @param len length of the string
+		 * @param write callable that receives a
+		 * ptr to the len characters and writes
+		 * all of them
+		 * @return new string
+		 */
+		template<typename WriteT>
+		static FORCE_INLINE StringBase create(sizet len, WriteT&& write)
+		{
+			StringBase str{len};
+			write(str.getData());
+
+			return str;
 		}
 
 		/**
@@ -177,8 +469,7 @@ namespace Korin
 		 */
 		FORCE_INLINE sizet getLen() const
 		{
-			// Exclude terminating character
-			return array.getNumItems() - 1;
+			return getLength();
 		}
 
 		/**
@@ -187,8 +478,7 @@ namespace Korin
 		 */
 		FORCE_INLINE sizet getLength() const
 		{
-			// Subtract terminating character
-			return array.getNumItems() - 1;
+			return isInline() ? static_cast<sizet>(getTag()) : heap.length;
 		}
 
 		/**
@@ -197,7 +487,26 @@ namespace Korin
 		 */
 		FORCE_INLINE sizet getNumBytes() const
 		{
-			return array.getNumBytes();
+			// Include terminating character
+			return (getLength() + 1) * sizeof(CharT);
+		}
+
+		/**
+		 * @brief Returns the max length the string
+		 * can reach without allocating a new buffer.
+		 */
+		FORCE_INLINE sizet getCapacity() const
+		{
+			return isInline() ? inlineCapacity : reinterpret_cast<sizet const*>(heap.data)[-1];
+		}
+
+		/**
+		 * @brief Returns true if the characters are
+		 * stored inside the string object.
+		 */
+		FORCE_INLINE bool isInline() const
+		{
+			return getTag() != heapTag;
 		}
 
 		/**
@@ -211,13 +520,13 @@ namespace Korin
 		FORCE_INLINE CharT const& operator[](int32 idx) const
 		{
 			CHECK(idx < getLen())
-			return array[idx];
+			return getData()[idx];
 		}
 
 		FORCE_INLINE CharT& operator[](int32 idx)
 		{
 			CHECK(idx < getLen())
-			return array[idx];
+			return getData()[idx];
 		}
 		/** @} */
 
@@ -228,12 +537,12 @@ namespace Korin
 		 */
 		FORCE_INLINE CharT const* operator*() const
 		{
-			return *array;
+			return getData();
 		}
 
 		FORCE_INLINE CharT* operator*()
 		{
-			return *array;
+			return getData();
 		}
 		/** @} */
 
@@ -244,9 +553,9 @@ namespace Korin
 		 * @return true if strings are equal
 		 * @return false otherwise
 		 */
-		FORCE_INLINE bool operator==(StringSourceT const& other) const
+		FORCE_INLINE bool operator==(StringViewT const& other) const
 		{
-			return PlatformString::cmpn(*array, other.src, other.len) == 0;
+			return StringViewT{*this} == other;
 		}
 
 		/**
@@ -256,7 +565,7 @@ namespace Korin
 		 * @return true if strings are not equal
 		 * @return false otherwise
 		 */
-		FORCE_INLINE bool operator!=(StringSourceT const& other) const
+		FORCE_INLINE bool operator!=(StringViewT const& other) const
 		{
 			return !(*this == other);
 		}
@@ -269,9 +578,9 @@ namespace Korin
 		 * @return true if this string precedes other
 		 * @return false otherwise
 		 */
-		FORCE_INLINE bool operator<(StringSourceT const& other) const
+		FORCE_INLINE bool operator<(StringViewT const& other) const
 		{
-			return PlatformString::cmpn(*array, other.src, other.len) < 0;
+			return StringViewT{*this} < other;
 		}
 
 		/**
@@ -282,9 +591,9 @@ namespace Korin
 		 * @return true if this string succeeds other
 		 * @return false otherwise
 		 */
-		FORCE_INLINE bool operator>(StringSourceT const& other) const
+		FORCE_INLINE bool operator>(StringViewT const& other) const
 		{
-			return PlatformString::cmpn(*array, other.src, other.len) > 0;
+			return StringViewT{*this} > other;
 		}
 
 		/**
@@ -296,7 +605,7 @@ namespace Korin
 		 * string
 		 * @return false otherwise
 		 */
-		FORCE_INLINE bool operator<=(StringSourceT const& other) const
+		FORCE_INLINE bool operator<=(StringViewT const& other) const
 		{
 			return !(*this > other);
 		}
@@ -310,77 +619,167 @@ namespace Korin
 		 * string
 		 * @return false otherwise
 		 */
-		FORCE_INLINE bool operator>=(StringSourceT const& other) const
+		FORCE_INLINE bool operator>=(StringViewT const& other) const
 		{
 			return !(*this < other);
 		}
 
 		/**
-		 * @brief Append a character to the end of the
-		 * string.
-		 *
-		 * @param c the character to append
-		 * @return ref to self
+		 * @brief Returns the index of the first
+		 * occurrence of a substring or character,
+		 * or -1 if not found.
+		 * @see StringViewBase::find
+		 * @{
 		 */
-		StringBase& operator+=(CharT c)
+		FORCE_INLINE ssizet find(StringViewT needle, sizet offset = 0) const
 		{
-			// Grow array if necessary
-			array.growToFit(array.count + 1);
+			return StringViewT{*this}.find(needle, offset);
+		}
 
-			// Set character
-			array[getLength()] = c;
-			array.count++;
-			terminate();
+		FORCE_INLINE ssizet find(CharT c, sizet offset = 0) const
+		{
+			return StringViewT{*this}.find(c, offset);
+		}
+		/** @} */
 
-			return *this;
+		/**
+		 * @brief Returns the index of the last
+		 * occurrence of a substring or character,
+		 * or -1 if not found.
+		 * @see StringViewBase::rfind
+		 * @{
+		 */
+		FORCE_INLINE ssizet rfind(StringViewT needle, sizet offset = -1) const
+		{
+			return StringViewT{*this}.rfind(needle, offset);
+		}
+
+		FORCE_INLINE ssizet rfind(CharT c, sizet offset = -1) const
+		{
+			return StringViewT{*this}.rfind(c, offset);
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns true if the string
+		 * contains the given substring or
+		 * character.
+		 * @{
+		 */
+		FORCE_INLINE bool contains(StringViewT needle) const
+		{
+			return find(needle) >= 0;
+		}
+
+		FORCE_INLINE bool contains(CharT c) const
+		{
+			return find(c) >= 0;
 		}
+		/** @} */
 
 		/**
-		 * @brief Return a new string equal to this string
-		 * and append the character.
+		 * @brief Returns a range over the indices
+		 * of all the non-overlapping occurrences
+		 * of a substring. The string must not be
+		 * modified while iterating. Temporary
+		 * strings are moved into the range.
+		 * @see StringViewBase::findAll
 		 *
-		 * @param c the character to append
-		 * @return new string ending with the character
+		 * @param needle the substring to find
+		 * @return range of indices
 		 * @{
 		 */
-		StringBase operator+(CharT c) const&
+		FORCE_INLINE StringFindRange<CharT> findAll(StringViewT needle) const&
 		{
-			// Create new string from this one
-			StringBase newString{*this, 1};
+			return StringViewT{*this}.findAll(needle);
+		}
 
-			// Append character
-			newString[newString.getLength()] = c;
-			newString.array.count++;
-			newString.terminate();
+		FORCE_INLINE auto findAll(StringViewT needle) &&
+		{
+			return toOwnedRange([needle](StringViewT str) { return str.findAll(needle); });
+		}
+		/** @} */
 
-			return newString;
+		/**
+		 * @brief Returns a range over the tokens of
+		 * the string. Tokens are views over the
+		 * characters of the string, which must not
+		 * be modified while iterating. Temporary
+		 * strings are moved into the range.
+		 * @see StringViewBase::split
+		 * @see StringViewBase::tokenize
+		 * @see StringViewBase::splitLines
+		 * @{
+		 */
+		FORCE_INLINE auto split(CharT delimiter, SplitOptions options = {}) const&
+		{
+			return StringViewT{*this}.split(delimiter, options);
 		}
 
-		StringBase operator+(CharT c)&&
+		FORCE_INLINE auto split(CharT delimiter, SplitOptions options = {}) &&
 		{
-			// We can probably reuse the buffer from this string
-			if (UNLIKELY(array.size < array.count + 1))
-			{
-				// No optimization available
-				return *this + c;
-			}
+			return toOwnedRange([=](StringViewT str) { return str.split(delimiter, options); });
+		}
 
-			// Create string using this string's buffer
-			StringBase newString{move(*this)};
+		FORCE_INLINE auto split(StringViewT separator, SplitOptions options = {}) const&
+		{
+			return StringViewT{*this}.split(separator, options);
+		}
 
-			// Append character
-			newString[newString.getLength()] = c;
-			newString.array.count++;
-			newString.terminate();
+		FORCE_INLINE auto split(StringViewT separator, SplitOptions options = {}) &&
+		{
+			return toOwnedRange([=](StringViewT str) { return str.split(separator, options); });
+		}
 
-			return newString;
+		FORCE_INLINE auto tokenize(StringViewT delimiters, SplitOptions options = {.skipEmpty = true}) const&
+		{
+			return StringViewT{*this}.tokenize(delimiters, options);
+		}
+
+		FORCE_INLINE auto tokenize(StringViewT delimiters, SplitOptions options = {.skipEmpty = true}) &&
+		{
+			return toOwnedRange([=](StringViewT str) { return str.tokenize(delimiters, options); });
+		}
+
+		FORCE_INLINE auto splitLines(SplitOptions options = {}) const&
+		{
+			return StringViewT{*this}.splitLines(options);
+		}
+
+		FORCE_INLINE auto splitLines(SplitOptions options = {}) &&
+		{
+			return toOwnedRange([=](StringViewT str) { return str.splitLines(options); });
 		}
 		/** @} */
 
+		/**
+		 * @brief Returns a range over the code
+		 * points of the string.
+		 * @see StringViewBase::codePoints
+		 */
+		FORCE_INLINE auto codePoints() const
+		{
+			return StringViewT{*this}.codePoints();
+		}
+
+		/**
+		 * @brief Append a character to the end of the
+		 * string.
+		 *
+		 * @param c the character to append
+		 * @return ref to self
+		 */
+		FORCE_INLINE StringBase& operator+=(CharT c)
+		{
+			return *this += StringSourceT{&c, 1};
+		}
+
 		/**
 		 * @brief Append another string source to this
 		 * string.
 		 *
+		 * The source may point into this string.
+		 *
 		 * @param other any string source
 		 * @return ref to self
 		 */
@@ -388,81 +787,100 @@ namespace Korin
 		{
 			ASSERT(other.src != nullptr)
 
-			// Grow array if necessary
-			array.growToFit(array.count + other.len);
+			sizet const len = getLength();
+			sizet const newLen = len + other.len;
+			if (newLen > getCapacity())
+			{
+				// Copy to a larger buffer before releasing this
+				// one, the source may point into this string
+				StringBase newString{*this, PlatformMath::max(other.len, len)};
+				PlatformMemory::memcpy(newString.getData() + len, other.src, other.len * sizeof(CharT));
+				newString.setLength(newLen);
+
+				return *this = move(newString);
+			}
 
 			// Copy data
-			copyItems(*array + getLength(), other.src, other.len);
-			array.count += other.len;
-			terminate();
+			PlatformMemory::memcpy(getData() + len, other.src, other.len * sizeof(CharT));
+			setLength(newLen);
 
 			return *this;
 		}
 
 		/**
-		 * @brief Return a new string equal to the
-		 * result of concatenating two string sources.
+		 * @brief Append a concatenation expression
+		 * to this string, growing the buffer at most
+		 * once.
+		 * @see StringConcat
 		 *
-		 * @param lhs,rhs any two string sources
-		 * @return new string
-		 * @{
+		 * The expression may refer to this string.
+		 *
+		 * @param expr concatenation expression
+		 * @return ref to self
 		 */
-		friend StringBase operator+(StringSourceT const& lhs, StringSourceT const& rhs)
+		template<typename LhsT, typename RhsT>
+		StringBase& operator+=(StringConcat<CharT, LhsT, RhsT> const& expr)
 		{
-			ASSERT(lhs.src != nullptr)
-			ASSERT(rhs.src != nullptr)
+			sizet const len = getLength();
+			sizet const newLen = len + expr.getLength();
+			if (newLen > getCapacity())
+			{
+				// The expression may refer to this string,
+				// write it before releasing the buffer
+				StringBase newString{*this, PlatformMath::max(expr.getLength(), len)};
+				expr.writeTo(newString.getData() + len);
+				newString.setLength(newLen);
 
-			// Create new string
-			StringBase newString{lhs.len + rhs.len};
+				return *this = move(newString);
+			}
 
-			// Copy characters
-			copyItems(*newString, lhs.src, lhs.len);
-			copyItems(*newString + lhs.len, rhs.src, rhs.len);
+			expr.writeTo(getData() + len);
+			setLength(newLen);
 
-			return newString;
+			return *this;
 		}
 
-		friend StringBase operator+(StringBase&& lhs, StringSourceT const& rhs)
+		/**
+		 * @brief Append the decimal representation
+		 * of an integer.
+		 * @see intToChars
+		 *
+		 * @param value the integer to append
+		 * @return ref to self
+		 */
+		template<typename IntT>
+		FORCE_INLINE StringBase& appendInt(IntT value)
 		{
-			// Get required length
-			sizet const newLen = lhs.getLength() + rhs.len;
-			if (lhs.array.size < newLen + 1)
-			{
-				// No optimization available
-				return lhs + rhs;
-			}
-
-			// We can reuse lhs buffer
-			StringBase newString{move(lhs)};
+			reserveAppend(maxIntLength);
+			setLength(intToChars(getData() + getLength(), value) - getData());
 
-			// Copy characters from second source
-			copyItems(*newString + lhs.getLength(), rhs.src, rhs.len);
-			newString.array.count = newLen + 1;
-			newString.terminate();
-
-			return newString;
+			return *this;
 		}
 
-		friend StringBase operator+(StringSourceT const& lhs, StringBase&& rhs)
+		/**
+		 * @brief Append a floating-point number,
+		 * with the fewest digits that read back to
+		 * the same value.
+		 * @see floatToChars
+		 *
+		 * @param value the number to append
+		 * @return ref to self
+		 * @{
+		 */
+		FORCE_INLINE StringBase& appendFloat(float64 value)
 		{
-			// Get required length
-			sizet const newLen = lhs.len + rhs.getLength();
-			if (rhs.array.size < newLen + 1)
-			{
-				// No optimization available
-				return lhs + rhs;
-			}
+			reserveAppend(maxFloatLength);
+			setLength(floatToChars(getData() + getLength(), value) - getData());
 
-			// We can reuse rhs buffer
-			StringBase newString{move(rhs)};
+			return *this;
+		}
 
-			// We still have to copy all the items though
-			copyItems(*newString, lhs.src, lhs.len);
-			copyItems(*newString + lhs.len, *rhs, rhs.getLength());
-			newString.array.count = newLen + 1;
-			newString.terminate();
+		FORCE_INLINE StringBase& appendFloat(float32 value)
+		{
+			reserveAppend(maxFloatLength);
+			setLength(floatToChars(getData() + getLength(), value) - getData());
 
-			return newString;
+			return *this;
 		}
 		/** @} */
 
@@ -478,17 +896,16 @@ namespace Korin
 			// Compute new size and reserve space
 			sizet const prefixLen = getLength();
 			sizet const newLen = prefixLen * repeats;
-			array.growToFit(newLen + 1);
+			reserve(newLen);
 
+			CharT* data = getData();
 			for (uint32 rep = 1; rep < repeats; rep *= 2)
 			{
 				// Copy in powers of two, much more efficient
-				// TODO: Replace with `min()`
-				uint32 const maxRep = rep < repeats - rep ? rep : repeats - rep;
-				copyItems(*array + rep * prefixLen, *array, maxRep * prefixLen);
+				uint32 const maxRep = PlatformMath::min(rep, repeats - rep);
+				PlatformMemory::memcpy(data + rep * prefixLen, data, maxRep * prefixLen * sizeof(CharT));
 			}
-			array.count = newLen + 1;
-			terminate();
+			setLength(newLen);
 
 			return *this;
 		}
@@ -510,15 +927,19 @@ namespace Korin
 			sizet const prefixLen = prefix.len;
 			sizet const newLen = prefixLen * repeats;
 			StringBase newString{newLen};
+			if (repeats == 0)
+			{
+				return newString;
+			}
 
 			// Copy prefix once first
-			copyItems(*newString, prefix.src, prefixLen);
-			for (uint32 rep = 1; rep < repeats; rep *= 2)
+			CharT* data = *newString;
+			PlatformMemory::memcpy(data, prefix.src, prefixLen * sizeof(CharT));
+			for (sizet rep = 1; rep < repeats; rep *= 2)
 			{
 				// Copy in powers of two, much more efficient
-				// TODO: Replace with `min()`
-				uint32 const maxRep = rep < repeats - rep ? rep : repeats - rep;
-				copyItems(*newString + rep * prefixLen, *newString, maxRep * prefixLen);
+				sizet const maxRep = PlatformMath::min(rep, repeats - rep);
+				PlatformMemory::memcpy(data + rep * prefixLen, data, maxRep * prefixLen * sizeof(CharT));
 			}
 
 			return newString;
@@ -540,18 +961,113 @@ namespace Korin
 			return *this % tie(FORWARD(args)...);
 		}
 
+		/**
+		 * @brief Replace all the non-overlapping
+		 * occurrences of a substring, from left
+		 * to right.
+		 *
+		 * The string is modified in place if the
+		 * replacement is not longer than the
+		 * substring, otherwise the result is
+		 * built in a new buffer of the exact
+		 * length. Either may point into this
+		 * string.
+		 *
+		 * @param from the substring to replace
+		 * @param to the replacement
+		 * @return ref to self
+		 */
+		StringBase& replace(StringViewT from, StringViewT to)
+		{
+			if (from.isEmpty())
+			{
+				return *this;
+			}
+
+			CharT const* begin = getData();
+			CharT const* end = begin + getLength();
+			if ((*from < end && *from + from.getLength() > begin) || (*to < end && *to + to.getLength() > begin))
+			{
+				// Arguments would be overwritten
+				StringBase const fromCopy{from}, toCopy{to};
+				return replace(fromCopy, toCopy);
+			}
+
+			sizet const len = getLength();
+			sizet const fromLen = from.getLength();
+			sizet const toLen = to.getLength();
+			if (toLen <= fromLen)
+			{
+				// Occurrences are searched ahead of the
+				// characters that are written
+				CharT* data = getData();
+				sizet src = 0, dst = 0;
+				for (sizet idx : findAll(from))
+				{
+					if (dst != src)
+					{
+						PlatformMemory::memmove(data + dst, data + src, (idx - src) * sizeof(CharT));
+					}
+
+					dst += idx - src;
+					PlatformMemory::memcpy(data + dst, *to, toLen * sizeof(CharT));
+					dst += toLen;
+					src = idx + fromLen;
+				}
+
+				PlatformMemory::memmove(data + dst, data + src, (len - src) * sizeof(CharT));
+				setLength(dst + len - src);
+
+				return *this;
+			}
+
+			sizet numMatches = 0;
+			for ([[maybe_unused]] sizet idx : findAll(from)) ++numMatches;
+
+			if (numMatches == 0)
+			{
+				return *this;
+			}
+
+			StringBase newString{len + numMatches * (toLen - fromLen)};
+			CharT* data = *newString;
+			sizet src = 0, dst = 0;
+			for (sizet idx : findAll(from))
+			{
+				PlatformMemory::memcpy(data + dst, getData() + src, (idx - src) * sizeof(CharT));
+				dst += idx - src;
+				PlatformMemory::memcpy(data + dst, *to, toLen * sizeof(CharT));
+				dst += toLen;
+				src = idx + fromLen;
+			}
+
+			PlatformMemory::memcpy(data + dst, getData() + src, (len - src) * sizeof(CharT));
+
+			return *this = move(newString);
+		}
+
 	protected:
 		/**
-		 * @brief Create an empty string, with an
-		 * initial array size equal to the given
-		 * string length.
+		 * @brief Create a string of the given
+		 * length. The characters are left
+		 * uninitialized, but the string is
+		 * terminated.
 		 *
 		 * @param len future length of the string
 		 */
 		FORCE_INLINE StringBase(sizet len)
-			: array{len + 1, termChar}
+			: buffer{}
 		{
-			//
+			if (len > inlineCapacity)
+			{
+				setHeap(allocate(len), len);
+			}
+			else
+			{
+				setTag(CharT(len));
+			}
+
+			terminate();
 		}
 
 		/**
@@ -562,25 +1078,203 @@ namespace Korin
 		 * @param slack extra space to reserve
 		 */
 		FORCE_INLINE StringBase(StringBase const& other, sizet slack)
-			: array{other.array, slack}
+			: buffer{}
 		{
-			// Make sure string is terminated
+			sizet const len = other.getLength();
+			if (len + slack > inlineCapacity)
+			{
+				setHeap(allocate(len + slack), len);
+			}
+			else
+			{
+				setTag(CharT(len));
+			}
+
+			// Copy characters and terminating character
+			PlatformMemory::memcpy(getData(), *other, (len + 1) * sizeof(CharT));
+		}
+
+		/**
+		 * @brief Returns a ptr to the first
+		 * character.
+		 * @{
+		 */
+		FORCE_INLINE CharT* getData()
+		{
+			return isInline() ? buffer : heap.data;
+		}
+
+		FORCE_INLINE CharT const* getData() const
+		{
+			return isInline() ? buffer : heap.data;
+		}
+		/** @} */
+
+		/**
+		 * @brief Set the length of the string and
+		 * append the terminating character. The
+		 * string must have enough capacity.
+		 *
+		 * @param newLen new length of the string
+		 */
+		FORCE_INLINE void setLength(sizet newLen)
+		{
+			CHECK(newLen <= getCapacity())
+
+			if (isInline())
+			{
+				setTag(CharT(newLen));
+			}
+			else
+			{
+				heap.length = newLen;
+			}
+
 			terminate();
 		}
 
+		/**
+		 * @brief Make sure the string can reach the
+		 * given length without allocating.
+		 *
+		 * @param minCapacity min capacity of the
+		 * string
+		 */
+		void reserve(sizet minCapacity)
+		{
+			if (minCapacity > getCapacity())
+			{
+				StringBase newString{*this, minCapacity - getLength()};
+				*this = move(newString);
+			}
+		}
+
+		/**
+		 * @brief Make sure that the given number
+		 * of characters can be appended without
+		 * allocating. The capacity grows
+		 * geometrically.
+		 *
+		 * @param slack number of characters to
+		 * append
+		 */
+		FORCE_INLINE void reserveAppend(sizet slack)
+		{
+			sizet const len = getLength();
+			if (len + slack > getCapacity())
+			{
+				*this = StringBase{*this, PlatformMath::max(slack, len)};
+			}
+		}
+
 		/**
 		 * @brief Append the terminating character
 		 * to the end of the string.
 		 */
 		FORCE_INLINE void terminate()
 		{
-			array[getLength()] = CharT{0};
+			getData()[getLength()] = termChar;
 		}
 
-		/* The array that holds the string characters. */
-		Array<CharT> array;
+		union
+		{
+			/* Heap representation, only valid if the tag is the heap tag. */
+			struct
+			{
+				/* Ptr to the first character, the capacity is stored before it. */
+				CharT* data;
+
+				/* Length of the string. */
+				sizet length;
+			} heap;
+
+			/* Inline characters. The last one is the tag, which holds the length of inline strings. */
+			CharT buffer[bufferSize];
+		};
 
 	private:
+		/**
+		 * @brief Returns the tag of the string.
+		 */
+		FORCE_INLINE CharT getTag() const
+		{
+			return buffer[bufferSize - 1];
+		}
+
+		/**
+		 * @brief Set the tag of the string.
+		 */
+		FORCE_INLINE void setTag(CharT tag)
+		{
+			buffer[bufferSize - 1] = tag;
+		}
+
+		/**
+		 * @brief Switch to the heap representation.
+		 *
+		 * @param data ptr to the heap characters
+		 * @param len length of the string
+		 */
+		FORCE_INLINE void setHeap(CharT* data, sizet len)
+		{
+			heap.data = data;
+			heap.length = len;
+			setTag(heapTag);
+		}
+
+		/**
+		 * @brief Allocate a heap buffer that fits
+		 * a string of the given length.
+		 *
+		 * @param capacity max length of the string
+		 * @return ptr to the first character
+		 */
+		static FORCE_INLINE CharT* allocate(sizet capacity)
+		{
+			sizet* header = reinterpret_cast<sizet*>(gMalloc->malloc(sizeof(sizet) + (capacity + 1) * sizeof(CharT), alignof(sizet)));
+			*header = capacity;
+			return reinterpret_cast<CharT*>(header + 1);
+		}
+
+		/**
+		 * @brief Release the heap buffer, if any.
+		 * The string is left in an invalid state.
+		 */
+		FORCE_INLINE void release()
+		{
+			if (!isInline())
+			{
+				gMalloc->free(reinterpret_cast<sizet*>(heap.data) - 1);
+			}
+		}
+
+		/**
+		 * @brief Take the characters of another
+		 * string, leaving it empty.
+		 *
+		 * @param other string to move
+		 */
+		FORCE_INLINE void steal(StringBase& other)
+		{
+			PlatformMemory::memcpy(buffer, other.buffer, sizeof(buffer));
+			other.buffer[0] = termChar;
+			other.setTag(CharT(0));
+		}
+
+		/**
+		 * @brief Move the string into a range
+		 * that owns it.
+		 *
+		 * @param makeRange function that returns
+		 * the view range of a view
+		 * @return the owned range
+		 */
+		template<typename MakeRangeT>
+		FORCE_INLINE StringOwnedRange<CharT, MakeRangeT> toOwnedRange(MakeRangeT const& makeRange)
+		{
+			return {move(*this), makeRange};
+		}
+
 		/**
 		 * @brief Private implementation for formatting
 		 * using a tuple.
@@ -595,8 +1289,14 @@ namespace Korin
 		static StringBase formatTuple_Impl(StringSourceT const& fmt, auto const& args, IndexSequence<idxs...>)
 		{
 			// We don't know a priori the length of the
-			// formatted string.
-			const sizet newLen = ::snprintf(nullptr, 0, fmt.src, prepareFormatArg(args.template get<idxs>())...);
+			// formatted string, try with a buffer on
+			// the stack first
+			CharT buffer[256];
+			sizet const newLen = ::snprintf(buffer, sizeof(buffer), fmt.src, prepareFormatArg(args.template get<idxs>())...);
+			if (newLen < sizeof(buffer))
+			{
+				return StringBase{buffer, newLen};
+			}
 
 			// Create new string
 			StringBase newString{newLen};
@@ -654,29 +1354,31 @@ namespace Korin
 		return StringBase<char>::formatTuple_Impl(fmt, args, iseqFor(args));
 	}
 
+	/**
+	 * @brief Strings are sorted in alphabetical
+	 * order, and can be compared with any string
+	 * view.
+	 *
+	 * @tparam CharT the type of a string character
+	 */
+	template<typename CharT>
+	struct ChoosePolicy<StringBase<CharT>> : public ChoosePolicy<StringViewBase<CharT>>
+	{
+		//
+	};
+
 	/**
 	 * @brief Specialization for hashing string keys.
+	 * Strings hash like the corresponding string
+	 * views.
 	 *
 	 * @tparam CharT the type of a sring character
 	 */
 	template<typename CharT>
-	struct ChooseHashPolicy<StringBase<CharT>>
+	struct ChooseHashPolicy<StringBase<CharT>> : public ChooseHashPolicy<StringViewBase<CharT>>
 	{
-		using Type = struct HashString
-		{
-			using StringT = StringBase<CharT>;
-
-			/**
-			 * @brief Returns the hash key for the given
-			 * string.
-			 *
-			 * @param key the key string to hash
-			 * @return the corresponding hash key
-			 */
-			FORCE_INLINE HashKey operator()(StringT const& key) const
-			{
-				return murmur(*key, key.getNumBytes());
-			}
-		};
+		//
 	};
 } // namespace Korin
+
+#include "string_concat.h"
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "templates/enable_if.h"
+#include "templates/types.h"
+#include "templates/utility.h"
+#include "hal/platform_memory.h"
+#include "containers_types.h"
+#include "string_view.h"
+#include "string.h"
+
+namespace Korin
+{
+	namespace StringConcat_Impl
+	{
+		/**
+		 * @brief Describes the types that can be
+		 * concatenated. Strings are stored in
+		 * expressions as views, characters and
+		 * expressions as they are.
+		 *
+		 * @tparam T the type of the operand,
+		 * without references and qualifiers
+		 */
+		template<typename T>
+		struct Operand
+		{
+			enum { valid = false, isString = false };
+		};
+
+		template<typename CharT>
+		struct StringOperand
+		{
+			using CharType = CharT;
+			using Type = StringViewBase<CharT>;
+			enum { valid = true, isString = true };
+		};
+
+		template<typename CharT>
+		struct CStringOperand
+		{
+			using CharType = CharT;
+			using Type = StringViewBase<CharT>;
+			enum { valid = true, isString = false };
+		};
+
+		template<typename CharT>
+		struct CharOperand
+		{
+			using CharType = CharT;
+			using Type = CharT;
+			enum { valid = true, isString = false };
+		};
+
+		template<typename CharT> struct Operand<StringBase<CharT>>       : StringOperand<CharT> {};
+		template<typename CharT> struct Operand<StringViewBase<CharT>>   : StringOperand<CharT> {};
+		template<typename CharT> struct Operand<SharedStringBase<CharT>> : StringOperand<CharT> {};
+		template<typename CharT> struct Operand<HashedStringBase<CharT>> : StringOperand<CharT> {};
+
+		template<typename CharT, typename LhsT, typename RhsT>
+		struct Operand<StringConcat<CharT, LhsT, RhsT>>
+		{
+			using CharType = CharT;
+			using Type = StringConcat<CharT, LhsT, RhsT>;
+			enum { valid = true, isString = true };
+		};
+
+		template<>         struct Operand<ansichar>             : CharOperand<ansichar> {};
+		template<>         struct Operand<ansichar*>            : CStringOperand<ansichar> {};
+		template<>         struct Operand<ansichar const*>      : CStringOperand<ansichar> {};
+		template<sizet n>  struct Operand<ansichar[n]>          : CStringOperand<ansichar> {};
+		template<sizet n>  struct Operand<ansichar const[n]>    : CStringOperand<ansichar> {};
+		template<>         struct Operand<widechar>             : CharOperand<widechar> {};
+		template<>         struct Operand<widechar*>            : CStringOperand<widechar> {};
+		template<>         struct Operand<widechar const*>      : CStringOperand<widechar> {};
+		template<sizet n>  struct Operand<widechar[n]>          : CStringOperand<widechar> {};
+		template<sizet n>  struct Operand<widechar const[n]>    : CStringOperand<widechar> {};
+
+		/**
+		 * @brief Operand description of a forwarded
+		 * type.
+		 */
+		template<typename T>
+		using OperandOf = Operand<typename RemoveCV<typename RemoveReference<T>::Type>::Type>;
+
+		/**
+		 * @brief Two operands can be concatenated
+		 * lazily if they have the same character
+		 * type and at least one of them is a string
+		 * or an expression. An rvalue string on the
+		 * left is instead appended to, to reuse its
+		 * buffer.
+		 */
+		template<typename LhsT, typename RhsT>
+		struct IsLazy
+		{
+			using LhsOperandT = OperandOf<LhsT>;
+			using RhsOperandT = OperandOf<RhsT>;
+
+			static constexpr bool isRvalueString()
+			{
+				if constexpr (LhsOperandT::valid) return SameType<LhsT, StringBase<typename LhsOperandT::CharType>>::value;
+				else return false;
+			}
+
+			static constexpr bool haveSameChar()
+			{
+				if constexpr (LhsOperandT::valid && RhsOperandT::valid) return SameType<typename LhsOperandT::CharType, typename RhsOperandT::CharType>::value;
+				else return false;
+			}
+
+			enum { value = haveSameChar() && (LhsOperandT::isString || RhsOperandT::isString) && !isRvalueString() };
+		};
+	} // namespace StringConcat_Impl
+
+	/**
+	 * @brief A lazy concatenation of strings,
+	 * views, C strings and characters, created
+	 * by @c operator+.
+	 *
+	 * The expression only stores views over the
+	 * operands, and the total length. When it is
+	 * converted to a string, the characters are
+	 * copied once into a buffer of the right
+	 * size, so chains like @c a+b+c+d allocate
+	 * once instead of once per operator.
+	 *
+	 * Since expressions do not own the
+	 * characters, they must be converted before
+	 * the end of the full expression that
+	 * created them:
+	 *
+	 * ```
+	 * String url = scheme + "://" + host + '/' + path;
+	 * ```
+	 *
+	 * @tparam CharT the type of the characters
+	 * @tparam LhsT,RhsT the types of the operands
+	 */
+	template<typename CharT, typename LhsT, typename RhsT>
+	class StringConcat
+	{
+	public:
+		/**
+		 * @brief Construct the concatenation of
+		 * two operands.
+		 *
+		 * @param inLhs,inRhs the operands
+		 */
+		constexpr FORCE_INLINE StringConcat(LhsT const& inLhs, RhsT const& inRhs)
+			: lhs{inLhs}
+			, rhs{inRhs}
+			, length{getOperandLength(inLhs) + getOperandLength(inRhs)}
+		{
+			//
+		}
+
+		/**
+		 * @brief Returns the length of the
+		 * concatenated string.
+		 */
+		constexpr FORCE_INLINE sizet getLength() const
+		{
+			return length;
+		}
+
+		/**
+		 * @brief Copy the concatenated characters
+		 * to a buffer. No terminating character is
+		 * written.
+		 *
+		 * @param dst ptr to a buffer with room for
+		 * @c getLength() characters
+		 * @return ptr past the last character
+		 * written
+		 */
+		FORCE_INLINE CharT* writeTo(CharT* dst) const
+		{
+			return writeOperand(writeOperand(dst, lhs), rhs);
+		}
+
+		/**
+		 * @brief Returns the concatenated string.
+		 */
+		FORCE_INLINE StringBase<CharT> toString() const
+		{
+			return StringBase<CharT>{*this};
+		}
+
+	protected:
+		/**
+		 * @brief Returns the number of characters
+		 * of an operand.
+		 */
+		template<typename OperandT>
+		static constexpr FORCE_INLINE sizet getOperandLength(OperandT const& operand)
+		{
+			if constexpr (SameType<OperandT, CharT>::value) return 1;
+			else return operand.getLength();
+		}
+
+		/**
+		 * @brief Copy the characters of an operand
+		 * to a buffer, and returns a ptr past the
+		 * last one.
+		 */
+		template<typename OperandT>
+		static FORCE_INLINE CharT* writeOperand(CharT* dst, OperandT const& operand)
+		{
+			if constexpr (SameType<OperandT, CharT>::value)
+			{
+				*dst = operand;
+				return dst + 1;
+			}
+			else if constexpr (SameType<OperandT, StringViewBase<CharT>>::value)
+			{
+				PlatformMemory::memcpy(dst, *operand, operand.getLength() * sizeof(CharT));
+				return dst + operand.getLength();
+			}
+			else
+			{
+				return operand.writeTo(dst);
+			}
+		}
+
+		/* Left operand. */
+		LhsT lhs;
+
+		/* Right operand. */
+		RhsT rhs;
+
+		/* Total number of characters. */
+		sizet length;
+	};
+
+	/**
+	 * @brief Returns the lazy concatenation of
+	 * two operands. At least one of them must be
+	 * a string, a view or an expression.
+	 * @see StringConcat
+	 *
+	 * @param lhs,rhs the operands
+	 * @return expression
+	 */
+	template<typename LhsT, typename RhsT>
+	constexpr FORCE_INLINE auto operator+(LhsT&& lhs, RhsT&& rhs) -> typename EnableIf<
+		StringConcat_Impl::IsLazy<LhsT, RhsT>::value,
+		StringConcat<
+			typename StringConcat_Impl::OperandOf<LhsT>::CharType,
+			typename StringConcat_Impl::OperandOf<LhsT>::Type,
+			typename StringConcat_Impl::OperandOf<RhsT>::Type
+		>
+	>::Type
+	{
+		using LhsOperandT = typename StringConcat_Impl::OperandOf<LhsT>::Type;
+		using RhsOperandT = typename StringConcat_Impl::OperandOf<RhsT>::Type;
+		return {LhsOperandT{lhs}, RhsOperandT{rhs}};
+	}
+
+	/**
+	 * @brief Appends an operand to an rvalue
+	 * string, reusing its buffer.
+	 *
+	 * @param lhs string to append to
+	 * @param rhs string, view, C string,
+	 * character or expression to append
+	 * @return the string
+	 */
+	template<typename CharT, typename RhsT>
+	FORCE_INLINE auto operator+(StringBase<CharT>&& lhs, RhsT&& rhs) -> typename EnableIf<
+		SameType<typename StringConcat_Impl::OperandOf<RhsT>::CharType, CharT>::value,
+		StringBase<CharT>
+	>::Type
+	{
+		StringBase<CharT> newString{move(lhs)};
+		newString += rhs;
+
+		return newString;
+	}
+} // namespace Korin
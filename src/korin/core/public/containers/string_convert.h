@@ -0,0 +1,808 @@
+#pragma once
+
+#include "core_types.h"
+#include "hal/platform_crt.h"
+#include "hal/platform_math.h"
+#include "hal/platform_memory.h"
+#include "hal/malloc.h"
+#include "templates/types.h"
+#include "string_view.h"
+#include "optional.h"
+
+namespace Korin
+{
+	/* Max number of characters written by intToChars. */
+	constexpr sizet maxIntLength = 20;
+
+	/* Max number of characters written by floatToChars. */
+	constexpr sizet maxFloatLength = 24;
+
+	namespace StringConvert_Impl
+	{
+		/* Pairs of decimal digits, from 00 to 99. */
+		inline constexpr ansichar digitPairs[] =
+			"00010203040506070809"
+			"10111213141516171819"
+			"20212223242526272829"
+			"30313233343536373839"
+			"40414243444546474849"
+			"50515253545556575859"
+			"60616263646566676869"
+			"70717273747576777879"
+			"80818283848586878889"
+			"90919293949596979899";
+
+		/* Powers of ten that fit in 64 bits. */
+		inline constexpr uint64 powersOfTen[] = {
+			1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+			10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+			1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull,
+			10000000000000000000ull
+		};
+
+		/**
+		 * @brief A positive number in the form
+		 * significand * 10^exponent.
+		 */
+		struct DecimalFloat
+		{
+			/* The decimal digits. */
+			uint64 significand;
+
+			/* The power of ten of the last digit. */
+			int32 exponent;
+		};
+
+		/**
+		 * @brief Returns the decimal number with
+		 * the fewest digits that reads back to the
+		 * given value, using the Schubfach
+		 * algorithm. If two such numbers exist,
+		 * returns the closest one. The value must
+		 * be positive and finite.
+		 * @{
+		 */
+		DecimalFloat toShortestDecimal(float64 value);
+		DecimalFloat toShortestDecimal(float32 value);
+		/** @} */
+
+		/**
+		 * @brief Bit layout of a floating-point
+		 * type. Numbers are classified by their
+		 * bits, because fast-math flags let the
+		 * compiler assume that NaN and infinity
+		 * never occur, and flush subnormals to
+		 * zero in comparisons.
+		 *
+		 * @tparam FloatT either float32 or float64
+		 */
+		template<typename FloatT>
+		struct FloatBits;
+
+		template<>
+		struct FloatBits<float64>
+		{
+			using Type = uint64;
+
+			/* Mask of the sign bit. */
+			static constexpr Type signMask = 1ull << 63;
+
+			/* Mask of the exponent bits, also the bits of infinity. */
+			static constexpr Type exponentMask = 0x7ffull << 52;
+
+			/* Bits of the default quiet NaN. */
+			static constexpr Type quietNaN = 0x7ff8ull << 48;
+		};
+
+		template<>
+		struct FloatBits<float32>
+		{
+			using Type = uint32;
+			static constexpr Type signMask = 1u << 31;
+			static constexpr Type exponentMask = 0xffu << 23;
+			static constexpr Type quietNaN = 0x7fc0u << 16;
+		};
+
+		/**
+		 * @brief Returns the bits of a
+		 * floating-point number.
+		 */
+		template<typename FloatT>
+		FORCE_INLINE typename FloatBits<FloatT>::Type toBits(FloatT value)
+		{
+			typename FloatBits<FloatT>::Type bits;
+			PlatformMemory::memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+
+		/**
+		 * @brief Returns the floating-point number
+		 * with the given bits.
+		 */
+		template<typename FloatT>
+		FORCE_INLINE FloatT fromBits(typename FloatBits<FloatT>::Type bits)
+		{
+			FloatT value;
+			PlatformMemory::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		/**
+		 * @brief Returns true if the number is
+		 * neither infinite nor NaN.
+		 */
+		template<typename FloatT>
+		FORCE_INLINE bool isFinite(FloatT value)
+		{
+			using BitsT = FloatBits<FloatT>;
+			return (toBits(value) & BitsT::exponentMask) != BitsT::exponentMask;
+		}
+
+		/**
+		 * @brief Returns true if the number is NaN.
+		 */
+		template<typename FloatT>
+		FORCE_INLINE bool isNaN(FloatT value)
+		{
+			using BitsT = FloatBits<FloatT>;
+			return (toBits(value) & ~BitsT::signMask) > BitsT::exponentMask;
+		}
+
+		/**
+		 * @brief Returns the number of decimal
+		 * digits of a number. Zero has one digit.
+		 */
+		constexpr FORCE_INLINE uint32 countDigits(uint64 x)
+		{
+			// log10(x) ~= log2(x) * 1233 / 4096
+			uint32 const n = ((PlatformMath::floorLog2(x | 1) + 1) * 1233) >> 12;
+			return n + ((x | 1) >= powersOfTen[n]);
+		}
+
+		/**
+		 * @brief Write the decimal digits of a
+		 * number, two at a time.
+		 *
+		 * @param dst ptr to the first digit
+		 * @param x the number
+		 * @param n the number of digits
+		 */
+		template<typename CharT>
+		constexpr FORCE_INLINE void writeDigits(CharT* dst, uint64 x, uint32 n)
+		{
+			CharT* it = dst + n;
+			while (x >= (1ull << 32))
+			{
+				// Get to 32-bit divisions quickly
+				uint32 low = static_cast<uint32>(x % 100000000);
+				x /= 100000000;
+				for (uint32 i = 0; i < 4; ++i, low /= 100)
+				{
+					uint32 const pair = (low % 100) * 2;
+					*--it = CharT(digitPairs[pair + 1]);
+					*--it = CharT(digitPairs[pair]);
+				}
+			}
+
+			uint32 y = static_cast<uint32>(x);
+			for (; y >= 100; y /= 100)
+			{
+				uint32 const pair = (y % 100) * 2;
+				*--it = CharT(digitPairs[pair + 1]);
+				*--it = CharT(digitPairs[pair]);
+			}
+
+			if (y >= 10)
+			{
+				*--it = CharT(digitPairs[y * 2 + 1]);
+				*--it = CharT(digitPairs[y * 2]);
+			}
+			else
+			{
+				*--it = CharT('0' + y);
+			}
+		}
+
+		/**
+		 * @brief Write a decimal number, in fixed
+		 * notation if it is at least 1e-4 and less
+		 * than 1e16, in scientific notation
+		 * otherwise.
+		 *
+		 * @param dst ptr to the first character
+		 * @param decimal the number to write
+		 * @return ptr past the last character
+		 */
+		template<typename CharT>
+		constexpr CharT* writeDecimal(CharT* dst, DecimalFloat decimal)
+		{
+			uint32 const n = countDigits(decimal.significand);
+			int32 const exponent = static_cast<int32>(n) - 1 + decimal.exponent;
+			if (exponent < -4 || exponent >= 16)
+			{
+				// Like 1.25e+20, the first digit is
+				// moved before the point
+				writeDigits(dst + 1, decimal.significand, n);
+				dst[0] = dst[1];
+				dst[1] = CharT('.');
+				dst += n + (n > 1);
+
+				uint32 const abs = exponent < 0 ? -exponent : exponent;
+				*dst++ = CharT('e');
+				*dst++ = CharT(exponent < 0 ? '-' : '+');
+				if (abs >= 100)
+				{
+					*dst++ = CharT('0' + abs / 100);
+				}
+
+				*dst++ = CharT(digitPairs[(abs % 100) * 2]);
+				*dst++ = CharT(digitPairs[(abs % 100) * 2 + 1]);
+				return dst;
+			}
+
+			if (decimal.exponent >= 0)
+			{
+				// Integer
+				writeDigits(dst, decimal.significand, n);
+				dst += n;
+				for (int32 i = 0; i < decimal.exponent; ++i)
+				{
+					*dst++ = CharT('0');
+				}
+
+				return dst;
+			}
+
+			if (exponent >= 0)
+			{
+				// Move the integer digits before the
+				// point
+				writeDigits(dst + 1, decimal.significand, n);
+				for (int32 i = 0; i <= exponent; ++i)
+				{
+					dst[i] = dst[i + 1];
+				}
+
+				dst[exponent + 1] = CharT('.');
+				return dst + n + 1;
+			}
+
+			// Like 0.00125
+			*dst++ = CharT('0');
+			*dst++ = CharT('.');
+			for (int32 i = -1; i > exponent; --i)
+			{
+				*dst++ = CharT('0');
+			}
+
+			writeDigits(dst, decimal.significand, n);
+			return dst + n;
+		}
+
+		/**
+		 * @brief Write a floating-point number
+		 * with the fewest digits that read back to
+		 * the same value.
+		 * @see floatToChars
+		 */
+		template<typename CharT, typename FloatT>
+		FORCE_INLINE CharT* writeFloat(CharT* dst, FloatT value)
+		{
+			using BitsT = FloatBits<FloatT>;
+			if (isNaN(value))
+			{
+				dst[0] = CharT('n'), dst[1] = CharT('a'), dst[2] = CharT('n');
+				return dst + 3;
+			}
+
+			typename BitsT::Type bits = toBits(value);
+			if (bits & BitsT::signMask)
+			{
+				*dst++ = CharT('-');
+				bits &= ~BitsT::signMask;
+			}
+
+			if (bits == BitsT::exponentMask)
+			{
+				dst[0] = CharT('i'), dst[1] = CharT('n'), dst[2] = CharT('f');
+				return dst + 3;
+			}
+
+			if (bits == 0)
+			{
+				*dst = CharT('0');
+				return dst + 1;
+			}
+
+			return writeDecimal(dst, toShortestDecimal(fromBits<FloatT>(bits)));
+		}
+	} // namespace StringConvert_Impl
+
+	/**
+	 * @brief Write the decimal representation
+	 * of an integer. The buffer must fit at
+	 * least maxIntLength characters. The
+	 * string is not null-terminated.
+	 *
+	 * @param dst ptr to the first character
+	 * @param value the integer to write
+	 * @return ptr past the last character
+	 */
+	template<typename CharT, typename IntT>
+	constexpr FORCE_INLINE CharT* intToChars(CharT* dst, IntT value)
+	{
+		uint64 abs = static_cast<uint64>(value);
+		if constexpr (IntT(-1) < IntT(0))
+		{
+			if (value < 0)
+			{
+				*dst++ = CharT('-');
+				abs = 0 - abs;
+			}
+		}
+
+		uint32 const n = StringConvert_Impl::countDigits(abs);
+		StringConvert_Impl::writeDigits(dst, abs, n);
+		return dst + n;
+	}
+
+	/**
+	 * @brief Write a floating-point number with
+	 * the fewest digits that read back to the
+	 * same value, with no dependency on the
+	 * locale. Numbers from 1e-4 up to 1e16 are
+	 * written in fixed notation, like 0.001 and
+	 * 1250, other numbers in scientific
+	 * notation, like 1.25e+20. Infinities and
+	 * NaNs are written as inf, -inf and nan.
+	 *
+	 * The buffer must fit at least
+	 * maxFloatLength characters. The string is
+	 * not null-terminated.
+	 *
+	 * @param dst ptr to the first character
+	 * @param value the number to write
+	 * @return ptr past the last character
+	 * @{
+	 */
+	template<typename CharT>
+	FORCE_INLINE CharT* floatToChars(CharT* dst, float64 value)
+	{
+		return StringConvert_Impl::writeFloat<CharT, float64>(dst, value);
+	}
+
+	template<typename CharT>
+	FORCE_INLINE CharT* floatToChars(CharT* dst, float32 value)
+	{
+		return StringConvert_Impl::writeFloat<CharT, float32>(dst, value);
+	}
+	/** @} */
+
+	namespace StringConvert_Impl
+	{
+		/**
+		 * @brief Returns true if the character is
+		 * a decimal digit.
+		 */
+		template<typename CharT>
+		constexpr FORCE_INLINE bool isDigit(CharT c)
+		{
+			return c >= CharT('0') && c <= CharT('9');
+		}
+
+		/**
+		 * @brief Returns true if the eight
+		 * characters packed in a little-endian
+		 * integer are all decimal digits.
+		 */
+		constexpr FORCE_INLINE bool isEightDigits(uint64 chunk)
+		{
+			// Digits are 0x30 to 0x39, adding 6 must
+			// not carry into the high nibble
+			return ((chunk & 0xf0f0f0f0f0f0f0f0ull) | (((chunk + 0x0606060606060606ull) & 0xf0f0f0f0f0f0f0f0ull) >> 4)) == 0x3333333333333333ull;
+		}
+
+		/**
+		 * @brief Returns the value of eight
+		 * decimal digits packed in a little-endian
+		 * integer, the first digit being the most
+		 * significant one. Digits are combined in
+		 * pairs, then in groups of four, then
+		 * eight.
+		 */
+		constexpr FORCE_INLINE uint32 parseEightDigits(uint64 chunk)
+		{
+			constexpr uint64 mask = 0x000000ff000000ffull;
+			constexpr uint64 mul1 = 100 + (1000000ull << 32);
+			constexpr uint64 mul2 = 1 + (10000ull << 32);
+
+			chunk -= 0x3030303030303030ull;
+			chunk = chunk * 10 + (chunk >> 8);
+			return static_cast<uint32>((((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32);
+		}
+
+		/**
+		 * @brief Parse up to the given number of
+		 * digits, eight at a time if possible.
+		 *
+		 * @param it ref to ptr to the first
+		 * character, moved past the last digit
+		 * @param end ptr past the last character
+		 * @param maxDigits max number of digits to
+		 * parse
+		 * @param value ref to the value, the
+		 * digits are appended to it
+		 */
+		template<typename CharT>
+		FORCE_INLINE void parseDigits(CharT const*& it, CharT const* end, sizet maxDigits, uint64& value)
+		{
+			CharT const* const last = it + PlatformMath::min(maxDigits, sizet(end - it));
+			if constexpr (sizeof(CharT) == 1 && PLATFORM_LITTLE_ENDIAN)
+			{
+				for (uint64 chunk; last - it >= 8; it += 8)
+				{
+					PlatformMemory::memcpy(&chunk, it, sizeof(chunk));
+					if (!isEightDigits(chunk))
+					{
+						break;
+					}
+
+					value = value * 100000000 + parseEightDigits(chunk);
+				}
+			}
+
+			for (; it != last && isDigit(*it); ++it)
+			{
+				value = value * 10 + (*it - CharT('0'));
+			}
+		}
+
+		/**
+		 * @brief Returns true if a view starts
+		 * with an ASCII word, ignoring case.
+		 */
+		template<typename CharT>
+		constexpr FORCE_INLINE bool startsWithNoCase(CharT const* it, CharT const* end, ansichar const* word, sizet len)
+		{
+			if (sizet(end - it) < len)
+			{
+				return false;
+			}
+
+			for (sizet i = 0; i < len; ++i)
+			{
+				if (PlatformString::toLower(it[i]) != CharT(word[i]))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Computes w * 10^q, correctly
+		 * rounded, with the Clinger fast path or
+		 * the Eisel-Lemire algorithm. Values too
+		 * small or too large are rounded to zero
+		 * or to infinity.
+		 *
+		 * @param w the decimal significand
+		 * @param q the decimal exponent
+		 * @param value ref to the result
+		 * @return false if the algorithm cannot
+		 * decide how to round the result
+		 * @{
+		 */
+		bool toBinary(uint64 w, int64 q, float64& value);
+		bool toBinary(uint64 w, int64 q, float32& value);
+		/** @} */
+
+		/**
+		 * @brief Parse a floating-point number
+		 * with strtod, which is exact but slow.
+		 * The digits are copied without the point,
+		 * so that the locale does not matter.
+		 *
+		 * @param intBegin,intEnd the integer digits
+		 * @param fracBegin,fracEnd the fractional
+		 * digits
+		 * @param exponent the explicit exponent
+		 * @return the parsed value
+		 */
+		template<typename FloatT, typename CharT>
+		FloatT parseFloatSlow(CharT const* intBegin, CharT const* intEnd, CharT const* fracBegin, CharT const* fracEnd, int64 exponent)
+		{
+			sizet const numDigits = (intEnd - intBegin) + (fracEnd - fracBegin);
+			ansichar stackBuffer[512];
+			ansichar* const buffer = numDigits + maxIntLength + 3 <= sizeof(stackBuffer)
+			                       ? stackBuffer
+			                       : reinterpret_cast<ansichar*>(gMalloc->malloc(numDigits + maxIntLength + 3));
+
+			ansichar* it = buffer;
+			for (CharT const* jt = intBegin; jt != intEnd; ++jt)
+			{
+				*it++ = static_cast<ansichar>(*jt);
+			}
+
+			for (CharT const* jt = fracBegin; jt != fracEnd; ++jt)
+			{
+				*it++ = static_cast<ansichar>(*jt);
+			}
+
+			*it++ = 'e';
+			it = intToChars(it, exponent - (fracEnd - fracBegin));
+			*it = '\0';
+
+			FloatT const value = SameType<FloatT, float32>::value ? ::strtof(buffer, nullptr) : ::strtod(buffer, nullptr);
+			if (buffer != stackBuffer)
+			{
+				gMalloc->free(buffer);
+			}
+
+			return value;
+		}
+
+		/**
+		 * @brief Sets the error position, if
+		 * requested, and returns an empty
+		 * optional.
+		 */
+		template<typename T>
+		FORCE_INLINE Optional<T> parseError(sizet* errorPos, sizet pos)
+		{
+			if (errorPos)
+			{
+				*errorPos = pos;
+			}
+
+			return {};
+		}
+	} // namespace StringConvert_Impl
+
+	/**
+	 * @brief Parse a decimal integer, with an
+	 * optional sign. The whole view must be the
+	 * number, whitespace is not skipped. Eight
+	 * digits are parsed at a time.
+	 *
+	 * @tparam IntT the type of the integer
+	 * @tparam CharT the type of the characters
+	 * @param src the view to parse
+	 * @param errorPos if not null, on error
+	 * receives the index of the first invalid
+	 * character, or the length of the view if
+	 * it ends too early. If the number does not
+	 * fit the type, receives the index of its
+	 * first digit
+	 * @return the parsed integer, or empty on
+	 * error
+	 */
+	template<typename IntT, typename CharT = ansichar>
+	Optional<IntT> parseInt(StringViewBase<typename TypeIdentity<CharT>::Type> src, sizet* errorPos = nullptr)
+	{
+		using namespace StringConvert_Impl;
+		constexpr bool isSigned = IntT(-1) < IntT(0);
+
+		CharT const* const begin = src.begin();
+		CharT const* const end = src.end();
+		CharT const* it = begin;
+
+		bool negative = false;
+		if (it != end && (*it == CharT('-') || *it == CharT('+')))
+		{
+			negative = *it++ == CharT('-');
+			if (negative && !isSigned)
+			{
+				return parseError<IntT>(errorPos, 0);
+			}
+		}
+
+		// Leading zeros do not count toward the
+		// max number of digits
+		CharT const* const digits = it;
+		for (; it != end && *it == CharT('0'); ++it);
+
+		CharT const* const first = it;
+		uint64 value = 0;
+		parseDigits(it, end, 19, value);
+
+		if (it != end && isDigit(*it))
+		{
+			// The 20th digit may overflow
+			uint64 const digit = *it++ - CharT('0');
+			if (value > (~0ull - digit) / 10 || (it != end && isDigit(*it)))
+			{
+				return parseError<IntT>(errorPos, first - begin);
+			}
+
+			value = value * 10 + digit;
+		}
+
+		if (it == digits || it != end)
+		{
+			return parseError<IntT>(errorPos, it - begin);
+		}
+
+		constexpr uint64 max = isSigned ? (1ull << (sizeof(IntT) * 8 - 1)) - 1 : ~0ull >> (64 - sizeof(IntT) * 8);
+		if (value > max + negative)
+		{
+			return parseError<IntT>(errorPos, first - begin);
+		}
+
+		return static_cast<IntT>(negative ? 0 - value : value);
+	}
+
+	/**
+	 * @brief Parse a floating-point number, with
+	 * an optional sign, integer and fractional
+	 * digits and exponent, like -1.5e+3, .5 or
+	 * 2. Also parses inf, infinity and nan,
+	 * ignoring case. The whole view must be the
+	 * number, whitespace is not skipped. The
+	 * point is always a period, regardless of
+	 * the locale.
+	 *
+	 * The result is correctly rounded. The
+	 * Eisel-Lemire algorithm handles numbers
+	 * with up to 19 significant digits, longer
+	 * numbers fall back to strtod if rounding
+	 * is ambiguous. Numbers too large or too
+	 * small become infinity or zero.
+	 *
+	 * @tparam FloatT either float32 or float64
+	 * @tparam CharT the type of the characters
+	 * @param src the view to parse
+	 * @param errorPos if not null, on error
+	 * receives the index of the first invalid
+	 * character, or the length of the view if
+	 * it ends too early
+	 * @return the parsed number, or empty on
+	 * error
+	 */
+	template<typename FloatT, typename CharT = ansichar>
+	Optional<FloatT> parseFloat(StringViewBase<typename TypeIdentity<CharT>::Type> src, sizet* errorPos = nullptr)
+	{
+		using namespace StringConvert_Impl;
+		static_assert(SameType<FloatT, float32>::value || SameType<FloatT, float64>::value, "Type must be float32 or float64");
+
+		CharT const* const begin = src.begin();
+		CharT const* const end = src.end();
+		CharT const* it = begin;
+
+		// Results are built from their bits, fast-math
+		// flags may break infinity, NaN and subnormals
+		using BitsT = FloatBits<FloatT>;
+
+		bool negative = false;
+		if (it != end && (*it == CharT('-') || *it == CharT('+')))
+		{
+			negative = *it++ == CharT('-');
+		}
+
+		typename BitsT::Type const sign = negative ? BitsT::signMask : 0;
+		if (it != end && !isDigit(*it) && *it != CharT('.'))
+		{
+			// Infinity or NaN
+			if (startsWithNoCase(it, end, "inf", 3))
+			{
+				it += startsWithNoCase(it, end, "infinity", 8) ? 8 : 3;
+				return it == end ? Optional<FloatT>{fromBits<FloatT>(BitsT::exponentMask | sign)} : parseError<FloatT>(errorPos, it - begin);
+			}
+
+			if (startsWithNoCase(it, end, "nan", 3))
+			{
+				it += 3;
+				return it == end ? Optional<FloatT>{fromBits<FloatT>(BitsT::quietNaN)} : parseError<FloatT>(errorPos, it - begin);
+			}
+
+			return parseError<FloatT>(errorPos, it - begin);
+		}
+
+		// All the digits are accumulated, and w
+		// wraps if there are more than 19
+		// significant ones. In that case it is
+		// recomputed from the first 19 below
+		uint64 w = 0;
+		CharT const* const intBegin = it;
+		parseDigits(it, end, ~sizet(0), w);
+		CharT const* const intEnd = it;
+
+		CharT const* fracBegin = it;
+		CharT const* fracEnd = it;
+		if (it != end && *it == CharT('.'))
+		{
+			fracBegin = ++it;
+			parseDigits(it, end, ~sizet(0), w);
+			fracEnd = it;
+		}
+
+		sizet numDigits = (intEnd - intBegin) + (fracEnd - fracBegin);
+		if (numDigits == 0)
+		{
+			return parseError<FloatT>(errorPos, it - begin);
+		}
+
+		int64 exponent = 0;
+		if (it != end && (*it == CharT('e') || *it == CharT('E')))
+		{
+			++it;
+			bool negativeExponent = false;
+			if (it != end && (*it == CharT('-') || *it == CharT('+')))
+			{
+				negativeExponent = *it++ == CharT('-');
+			}
+
+			if (it == end || !isDigit(*it))
+			{
+				return parseError<FloatT>(errorPos, it - begin);
+			}
+
+			for (; it != end && isDigit(*it); ++it)
+			{
+				// Larger exponents round to zero or
+				// infinity anyway
+				if (exponent < 0x10000000)
+				{
+					exponent = exponent * 10 + (*it - CharT('0'));
+				}
+			}
+
+			exponent = negativeExponent ? -exponent : exponent;
+		}
+
+		if (it != end)
+		{
+			return parseError<FloatT>(errorPos, it - begin);
+		}
+
+		int64 q = exponent - (fracEnd - fracBegin);
+		bool truncated = false;
+		if (numDigits > 19)
+		{
+			// Leading zeros are not significant
+			for (CharT const* jt = intBegin; jt != fracEnd && (*jt == CharT('0') || *jt == CharT('.')); ++jt)
+			{
+				numDigits -= *jt == CharT('0');
+			}
+
+			if (numDigits > 19)
+			{
+				// Keep the first 19 significant
+				// digits
+				truncated = true;
+				w = 0;
+
+				CharT const* jt = intBegin;
+				for (; jt != intEnd && w < 1000000000000000000ull; ++jt)
+				{
+					w = w * 10 + (*jt - CharT('0'));
+				}
+
+				if (w >= 1000000000000000000ull)
+				{
+					q = exponent + (intEnd - jt);
+				}
+				else
+				{
+					for (jt = fracBegin; jt != fracEnd && w < 1000000000000000000ull; ++jt)
+					{
+						w = w * 10 + (*jt - CharT('0'));
+					}
+
+					q = exponent - (jt - fracBegin);
+				}
+			}
+		}
+
+		// If digits were truncated, the value is
+		// between w and w + 1
+		FloatT value, upper;
+		if (!toBinary(w, q, value) || (truncated && (!toBinary(w + 1, q, upper) || toBits(value) != toBits(upper))))
+		{
+			value = parseFloatSlow<FloatT>(intBegin, intEnd, fracBegin, fracEnd, exponent);
+		}
+
+		return fromBits<FloatT>(toBits(value) | sign);
+	}
+} // namespace Korin
@@ -0,0 +1,404 @@
+#pragma once
+
+#include "hal/platform_string.h"
+#include "hal/platform_math.h"
+#include "hal/platform_memory.h"
+#include "string_view.h"
+
+namespace Korin
+{
+	/* Code point that replaces invalid sequences. */
+	constexpr uint32 replacementChar = 0xfffd;
+
+	namespace StringEncoding_Impl
+	{
+		/**
+		 * @brief Decodes the code point at the
+		 * start of a buffer. The encoding depends
+		 * on the size of the characters: UTF-8,
+		 * UTF-16 or UTF-32. Invalid sequences
+		 * decode to U+FFFD.
+		 *
+		 * @param src ptr to the buffer
+		 * @param n number of characters in the
+		 * buffer, at least 1
+		 * @param codePoint decoded code point
+		 * @return number of characters read
+		 */
+		template<typename CharT>
+		constexpr FORCE_INLINE sizet decode(CharT const* src, sizet n, uint32& codePoint)
+		{
+			if constexpr (sizeof(CharT) == 1)
+			{
+				int32 const len = PlatformString::decodeUtf8(reinterpret_cast<ansichar const*>(src), n, codePoint);
+				if (len > 0) return len;
+
+				codePoint = replacementChar;
+				return -len;
+			}
+			else if constexpr (sizeof(CharT) == 2)
+			{
+				uint32 const c = static_cast<uint32>(src[0]) & 0xffff;
+				if (c - 0xd800 >= 0x800)
+				{
+					codePoint = c;
+					return 1;
+				}
+
+				// A high surrogate must be followed by
+				// a low surrogate
+				uint32 const d = n > 1 ? static_cast<uint32>(src[1]) & 0xffff : 0;
+				if (c < 0xdc00 && d - 0xdc00 < 0x400)
+				{
+					codePoint = 0x10000 + ((c - 0xd800) << 10) + (d - 0xdc00);
+					return 2;
+				}
+
+				codePoint = replacementChar;
+				return 1;
+			}
+			else
+			{
+				uint32 const c = static_cast<uint32>(src[0]);
+				codePoint = c > 0x10ffff || c - 0xd800 < 0x800 ? replacementChar : c;
+				return 1;
+			}
+		}
+
+		/**
+		 * @brief Decodes a UTF-8 sequence that is
+		 * known to be valid, without branches.
+		 * Always reads 4 Bytes.
+		 *
+		 * @param src ptr to the sequence
+		 * @param codePoint decoded code point
+		 * @return length of the sequence
+		 */
+		FORCE_INLINE sizet decodeValidUtf8(ubyte const* src, uint32& codePoint)
+		{
+			constexpr uint32 leadMasks[] = {0, 0x7f, 0x1f, 0x0f, 0x07};
+
+			// The length is the number of leading ones
+			// of the first Byte, or 1 for ASCII
+			uint32 const ones = PlatformMath::countLeadingZeros(~(static_cast<uint64>(src[0]) << 56));
+			uint32 const len = ones + (ones == 0);
+			uint32 const bits = (src[0] & leadMasks[len]) << 18 | (src[1] & 0x3f) << 12 | (src[2] & 0x3f) << 6 | (src[3] & 0x3f);
+			codePoint = bits >> (6 * (4 - len));
+
+			return len;
+		}
+
+		/**
+		 * @brief Encodes a valid code point, in
+		 * the encoding given by the size of the
+		 * characters.
+		 *
+		 * @param dst ptr to the output buffer
+		 * @param codePoint code point to encode
+		 * @return ptr past the last character
+		 * written
+		 */
+		template<typename CharT>
+		constexpr FORCE_INLINE CharT* encode(CharT* dst, uint32 codePoint)
+		{
+			if constexpr (sizeof(CharT) == 1)
+			{
+				if (codePoint < 0x80)
+				{
+					*dst++ = CharT(codePoint);
+				}
+				else if (codePoint < 0x800)
+				{
+					*dst++ = CharT(0xc0 | codePoint >> 6);
+					*dst++ = CharT(0x80 | (codePoint & 0x3f));
+				}
+				else if (codePoint < 0x10000)
+				{
+					*dst++ = CharT(0xe0 | codePoint >> 12);
+					*dst++ = CharT(0x80 | (codePoint >> 6 & 0x3f));
+					*dst++ = CharT(0x80 | (codePoint & 0x3f));
+				}
+				else
+				{
+					*dst++ = CharT(0xf0 | codePoint >> 18);
+					*dst++ = CharT(0x80 | (codePoint >> 12 & 0x3f));
+					*dst++ = CharT(0x80 | (codePoint >> 6 & 0x3f));
+					*dst++ = CharT(0x80 | (codePoint & 0x3f));
+				}
+			}
+			else if constexpr (sizeof(CharT) == 2)
+			{
+				if (codePoint < 0x10000)
+				{
+					*dst++ = CharT(codePoint);
+				}
+				else
+				{
+					*dst++ = CharT(0xd800 + ((codePoint - 0x10000) >> 10));
+					*dst++ = CharT(0xdc00 + (codePoint & 0x3ff));
+				}
+			}
+			else
+			{
+				*dst++ = CharT(codePoint);
+			}
+
+			return dst;
+		}
+	} // namespace StringEncoding_Impl
+
+	/**
+	 * @brief Returns true if a view is valid
+	 * UTF-8. Vectorized on platforms that
+	 * support it, ASCII text is validated at
+	 * close to memory speed.
+	 *
+	 * @param src view to validate
+	 * @param errorPos if not null, set to the
+	 * index of the first invalid sequence, or
+	 * the length of the view if valid
+	 * @return true if the view is valid UTF-8
+	 */
+	FORCE_INLINE bool isValidUtf8(StringView src, sizet* errorPos = nullptr)
+	{
+		sizet const pos = PlatformString::validateUtf8(*src, src.getLength());
+		if (errorPos) *errorPos = pos;
+		return pos == src.getLength();
+	}
+
+	/**
+	 * @brief Returns the max number of
+	 * characters written by @c transcode for the
+	 * given number of input characters.
+	 *
+	 * @tparam DstT the type of the output
+	 * characters
+	 * @tparam SrcT the type of the input
+	 * characters
+	 * @param n number of input characters
+	 * @return max number of output characters
+	 */
+	template<typename DstT, typename SrcT>
+	constexpr FORCE_INLINE sizet maxTranscodedLength(sizet n)
+	{
+		// U+FFFD takes 3 UTF-8 Bytes, the most any
+		// code unit but a UTF-32 one can produce
+		if constexpr (sizeof(DstT) == 1) return n * (sizeof(SrcT) == 4 ? 4 : 3);
+		else if constexpr (sizeof(DstT) == 2 && sizeof(SrcT) == 4) return n * 2;
+		else return n;
+	}
+
+	/**
+	 * @brief Converts text between encodings.
+	 * The encodings are given by the size of
+	 * the characters: UTF-8 for 1 Byte, UTF-16
+	 * for 2 and UTF-32 for 4. Invalid
+	 * sequences are replaced with U+FFFD.
+	 *
+	 * ```
+	 * widechar buffer[maxTranscodedLength<widechar, ansichar>(len)];
+	 * widechar* end = transcode(src, len, buffer);
+	 * ```
+	 *
+	 * @tparam DstT the type of the output
+	 * characters
+	 * @tparam SrcT the type of the input
+	 * characters
+	 * @param src ptr to the input characters
+	 * @param n number of input characters
+	 * @param dst ptr to the output buffer, with
+	 * room for @c maxTranscodedLength characters
+	 * @return ptr past the last character
+	 * written
+	 */
+	template<typename DstT, typename SrcT>
+	DstT* transcode(SrcT const* src, sizet n, DstT* dst)
+	{
+		sizet i = 0;
+		while (i < n)
+		{
+			// UTF-8 input is validated first, so that
+			// valid sequences need no checks
+			sizet valid = n;
+			if constexpr (sizeof(SrcT) == 1)
+			{
+				ubyte const* const bytes = reinterpret_cast<ubyte const*>(src);
+				valid = i + PlatformString::validateUtf8(reinterpret_cast<ansichar const*>(src) + i, n - i);
+
+				if constexpr (sizeof(DstT) == 1)
+				{
+					PlatformMemory::memcpy(dst, src + i, valid - i);
+					dst += valid - i;
+					i = valid;
+				}
+				else
+				{
+					while (i < valid && i + 4 <= n)
+					{
+						// Widen runs of ASCII characters, 8
+						// at a time
+						if (i + 8 <= valid)
+						{
+							uint64 chunk;
+							PlatformMemory::memcpy(&chunk, bytes + i, sizeof(chunk));
+							if ((chunk & 0x8080808080808080ull) == 0)
+							{
+								for (sizet k = 0; k < 8; ++k)
+								{
+									dst[k] = DstT(bytes[i + k]);
+								}
+
+								i += 8;
+								dst += 8;
+								continue;
+							}
+						}
+
+						uint32 codePoint = 0;
+						i += StringEncoding_Impl::decodeValidUtf8(bytes + i, codePoint);
+						dst = StringEncoding_Impl::encode(dst, codePoint);
+					}
+				}
+			}
+
+			// Decode the rest one code point at a
+			// time, then the invalid sequence if any
+			uint32 codePoint = 0;
+			while (i < valid)
+			{
+				i += StringEncoding_Impl::decode(src + i, n - i, codePoint);
+				dst = StringEncoding_Impl::encode(dst, codePoint);
+			}
+
+			if (i < n)
+			{
+				i += StringEncoding_Impl::decode(src + i, n - i, codePoint);
+				dst = StringEncoding_Impl::encode(dst, codePoint);
+			}
+		}
+
+		return dst;
+	}
+
+	/**
+	 * @brief Iterator over the code points of a
+	 * string view. The encoding is given by the
+	 * size of the characters, invalid sequences
+	 * are returned as U+FFFD.
+	 * @see StringViewBase::codePoints
+	 *
+	 * @tparam CharT the type of the characters
+	 */
+	template<typename CharT>
+	class CodePointIterator
+	{
+		using SelfT = CodePointIterator;
+
+	public:
+		/**
+		 * @brief Construct an iterator that points
+		 * to the code point at the start of a
+		 * buffer.
+		 *
+		 * @param inIt ptr to the first character
+		 * @param inEnd ptr past the last character
+		 */
+		constexpr FORCE_INLINE CodePointIterator(CharT const* inIt, CharT const* inEnd)
+			: it{inIt}
+			, end{inEnd}
+			, codePoint{0}
+			, len{0}
+		{
+			decodeNext();
+		}
+
+		/**
+		 * @brief Returns the current code point.
+		 */
+		constexpr FORCE_INLINE uint32 operator*() const
+		{
+			return codePoint;
+		}
+
+		/**
+		 * @brief Returns a ptr to the first
+		 * character of the current code point.
+		 */
+		constexpr FORCE_INLINE CharT const* getData() const
+		{
+			return it;
+		}
+
+		/**
+		 * @brief Returns the number of characters
+		 * of the current code point.
+		 */
+		constexpr FORCE_INLINE sizet getLength() const
+		{
+			return len;
+		}
+
+		constexpr FORCE_INLINE bool operator==(SelfT const& other) const
+		{
+			return it == other.it;
+		}
+
+		constexpr FORCE_INLINE bool operator!=(SelfT const& other) const
+		{
+			return !(*this == other);
+		}
+
+		constexpr FORCE_INLINE SelfT& operator++()
+		{
+			it += len;
+			decodeNext();
+			return *this;
+		}
+
+	protected:
+		/**
+		 * @brief Decodes the code point at the
+		 * current position, if any.
+		 */
+		constexpr FORCE_INLINE void decodeNext()
+		{
+			len = it < end ? StringEncoding_Impl::decode(it, end - it, codePoint) : 0;
+		}
+
+		/* Ptr to the first character of the current code point. */
+		CharT const* it;
+
+		/* Ptr past the last character. */
+		CharT const* end;
+
+		/* Current code point. */
+		uint32 codePoint;
+
+		/* Number of characters of the current code point. */
+		sizet len;
+	};
+
+	/**
+	 * @brief Range over the code points of a
+	 * string view.
+	 * @see StringViewBase::codePoints
+	 *
+	 * @tparam CharT the type of the characters
+	 */
+	template<typename CharT>
+	struct CodePointRange
+	{
+		/* View to decode. */
+		StringViewBase<CharT> src;
+
+		constexpr FORCE_INLINE CodePointIterator<CharT> begin() const
+		{
+			return {src.begin(), src.end()};
+		}
+
+		constexpr FORCE_INLINE CodePointIterator<CharT> end() const
+		{
+			return {src.end(), src.end()};
+		}
+	};
+} // namespace Korin
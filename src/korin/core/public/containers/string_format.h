@@ -0,0 +1,1323 @@
+#pragma once
+
+#include "core_types.h"
+#include "hal/platform_crt.h"
+#include "hal/platform_math.h"
+#include "hal/platform_memory.h"
+#include "hal/platform_string.h"
+#include "hal/malloc.h"
+#include "templates/enable_if.h"
+#include "templates/sequence.h"
+#include "templates/types.h"
+#include "containers_types.h"
+#include "string_view.h"
+#include "string.h"
+#include "string_convert.h"
+#include "array.h"
+#include "tuple.h"
+#include "optional.h"
+
+namespace Korin
+{
+	/**
+	 * @brief Formats values of type T. A type
+	 * can be formatted if it specializes this
+	 * template with two static functions:
+	 *
+	 * ```
+	 * template<>
+	 * struct Formatter<Vec2>
+	 * {
+	 * 	static constexpr bool check(FormatSpec const& spec)
+	 * 	{
+	 * 		return Formatter<float32>::check(spec);
+	 * 	}
+	 *
+	 * 	template<typename CharT>
+	 * 	static void format(FormatBuffer<CharT>& out, Vec2 const& v, FormatSpec const& spec)
+	 * 	{
+	 * 		formatTo(out, "({}, {})", v.x, v.y);
+	 * 	}
+	 * };
+	 * ```
+	 *
+	 * @c check is called at compile time and
+	 * returns true if the spec is valid for the
+	 * type, @c format writes the value to the
+	 * buffer.
+	 *
+	 * @tparam T the type of the values
+	 */
+	template<typename T, typename = void>
+	struct Formatter;
+
+	/**
+	 * @brief The options of a replacement field,
+	 * with the syntax:
+	 *
+	 * ```
+	 * [[fill]align][sign][#][0][width][.precision][type]
+	 * ```
+	 *
+	 * Which is a subset of the syntax of Python
+	 * and C++20 format strings.
+	 */
+	struct FormatSpec
+	{
+		/* Character used to pad the value to the min width. */
+		uint32 fill = ' ';
+
+		/* One of '<', '>' and '^', or zero for the default alignment of the type. */
+		ansichar align = 0;
+
+		/* One of '+', '-' and ' '. */
+		ansichar sign = '-';
+
+		/* If true, use the alternate form, e.g. with the 0x prefix for hexadecimal numbers. */
+		bool alternate = false;
+
+		/* If true, pad numbers with zeros after the sign. */
+		bool zeroPad = false;
+
+		/* Min width of the field. */
+		uint32 width = 0;
+
+		/* Precision of floating-point numbers or max length of strings, -1 if not set. */
+		int32 precision = -1;
+
+		/* Presentation type, or zero for the default presentation. */
+		ansichar type = 0;
+	};
+
+	/**
+	 * @brief The output of the formatter. A
+	 * buffer of characters that may grow when
+	 * it is full. A buffer that cannot grow
+	 * drops the characters that don't fit, but
+	 * keeps counting them.
+	 *
+	 * @tparam CharT the type of the characters
+	 */
+	template<typename CharT>
+	class FormatBuffer
+	{
+	protected:
+		using GrowFnT = void (*)(FormatBuffer&, sizet);
+
+	public:
+		/**
+		 * @brief Construct a buffer over a fixed
+		 * range of characters.
+		 *
+		 * @param inData ptr to the first character
+		 * @param inCapacity max number of
+		 * characters
+		 */
+		FORCE_INLINE FormatBuffer(CharT* inData, sizet inCapacity)
+			: FormatBuffer{inData, inCapacity, nullptr}
+		{
+			//
+		}
+
+		FormatBuffer(FormatBuffer const&) = delete;
+		FormatBuffer& operator=(FormatBuffer const&) = delete;
+
+		/**
+		 * @brief Returns the number of characters
+		 * written, including the ones that did
+		 * not fit.
+		 */
+		FORCE_INLINE sizet getLength() const
+		{
+			return length;
+		}
+
+		/**
+		 * @brief Returns a ptr to the first
+		 * character.
+		 */
+		FORCE_INLINE CharT const* getData() const
+		{
+			return data;
+		}
+
+		/**
+		 * @brief Returns true if all the
+		 * characters fit in the buffer.
+		 */
+		FORCE_INLINE bool isComplete() const
+		{
+			return length <= capacity;
+		}
+
+		/**
+		 * @brief Make sure the buffer can hold
+		 * the given number of characters, if it
+		 * can grow.
+		 *
+		 * @param minCapacity min number of
+		 * characters
+		 * @return true if the characters fit
+		 */
+		FORCE_INLINE bool reserve(sizet minCapacity)
+		{
+			if (minCapacity > capacity && growFn)
+			{
+				growFn(*this, minCapacity);
+			}
+
+			return minCapacity <= capacity;
+		}
+
+		/**
+		 * @brief Append a character.
+		 *
+		 * @param c the character to append
+		 */
+		FORCE_INLINE void append(CharT c)
+		{
+			if (length < capacity || reserve(length + 1))
+			{
+				data[length] = c;
+			}
+
+			++length;
+		}
+
+		/**
+		 * @brief Append a range of characters.
+		 *
+		 * @param src ptr to the first character
+		 * @param n number of characters
+		 */
+		FORCE_INLINE void append(CharT const* src, sizet n)
+		{
+			if (length + n <= capacity || reserve(length + n) || length < capacity)
+			{
+				PlatformMemory::memcpy(data + length, src, PlatformMath::min(n, capacity - length) * sizeof(CharT));
+			}
+
+			length += n;
+		}
+
+		/**
+		 * @brief Append a character many times.
+		 *
+		 * @param c the character to append
+		 * @param n number of times
+		 */
+		FORCE_INLINE void appendFill(CharT c, sizet n)
+		{
+			reserve(length + n);
+			for (sizet i = length, end = PlatformMath::min(length + n, capacity); i < end; ++i)
+			{
+				data[i] = c;
+			}
+
+			length += n;
+		}
+
+		/**
+		 * @brief Append a range of ASCII
+		 * characters, converting them if the
+		 * buffer has wider characters.
+		 *
+		 * @param src ptr to the first character
+		 * @param n number of characters
+		 */
+		FORCE_INLINE void appendAnsi(ansichar const* src, sizet n)
+		{
+			if constexpr (SameType<CharT, ansichar>::value)
+			{
+				append(src, n);
+			}
+			else for (sizet i = 0; i < n; ++i)
+			{
+				append(CharT(src[i]));
+			}
+		}
+
+	protected:
+		/**
+		 * @brief Construct a buffer that calls the
+		 * given function to grow.
+		 */
+		FORCE_INLINE FormatBuffer(CharT* inData, sizet inCapacity, GrowFnT inGrowFn)
+			: data{inData}
+			, capacity{inCapacity}
+			, length{0}
+			, growFn{inGrowFn}
+		{
+			//
+		}
+
+		/* Ptr to the first character. */
+		CharT* data;
+
+		/* Max number of characters. */
+		sizet capacity;
+
+		/* Number of characters written. */
+		sizet length;
+
+		/* Called to grow the buffer, null if the buffer cannot grow. */
+		GrowFnT growFn;
+	};
+
+	/**
+	 * @brief A format buffer that stores the
+	 * first characters inline, and moves to the
+	 * heap when they don't fit.
+	 *
+	 * @tparam CharT the type of the characters
+	 * @tparam inlineCapacity number of inline
+	 * characters
+	 */
+	template<typename CharT, sizet inlineCapacity = 256>
+	class MemoryFormatBuffer : public FormatBuffer<CharT>
+	{
+		using SuperT = FormatBuffer<CharT>;
+
+	public:
+		/**
+		 * @brief Construct an empty buffer.
+		 */
+		FORCE_INLINE MemoryFormatBuffer()
+			: SuperT{storage, inlineCapacity, &grow}
+		{
+			//
+		}
+
+		/**
+		 * @brief Free the heap characters, if
+		 * any.
+		 */
+		FORCE_INLINE ~MemoryFormatBuffer()
+		{
+			if (this->data != storage)
+			{
+				gMalloc->free(this->data);
+			}
+		}
+
+	protected:
+		/**
+		 * @brief Move the characters to a larger
+		 * heap buffer.
+		 */
+		static void grow(SuperT& buffer, sizet minCapacity)
+		{
+			MemoryFormatBuffer& self = static_cast<MemoryFormatBuffer&>(buffer);
+			sizet const newCapacity = PlatformMath::max(minCapacity, self.capacity * 2);
+			CharT* newData = reinterpret_cast<CharT*>(gMalloc->malloc(newCapacity * sizeof(CharT)));
+			PlatformMemory::memcpy(newData, self.data, self.length * sizeof(CharT));
+
+			if (self.data != self.storage)
+			{
+				gMalloc->free(self.data);
+			}
+
+			self.data = newData;
+			self.capacity = newCapacity;
+		}
+
+		/* Inline characters. */
+		CharT storage[inlineCapacity];
+	};
+
+	namespace Format_Impl
+	{
+		/**
+		 * @brief A type-erased format argument.
+		 *
+		 * @tparam CharT the type of the characters
+		 */
+		template<typename CharT>
+		struct FormatArg
+		{
+			/* Ptr to the value. */
+			void const* value;
+
+			/* Formats the value. */
+			void (*format)(FormatBuffer<CharT>&, void const*, FormatSpec const&);
+		};
+
+		/**
+		 * @brief Returns the type-erased argument
+		 * for a value.
+		 */
+		template<typename CharT, typename T>
+		FORCE_INLINE FormatArg<CharT> makeArg(T const& value)
+		{
+			return {&value, [](FormatBuffer<CharT>& out, void const* ptr, FormatSpec const& spec) {
+
+				Formatter<typename Decay<T>::Type>::format(out, *static_cast<T const*>(ptr), spec);
+			}};
+		}
+
+		/**
+		 * @brief Called when a format string is
+		 * not valid. It is not constexpr, so the
+		 * format string fails to compile.
+		 */
+		inline void invalidFormatString(char const*)
+		{
+			//
+		}
+
+		template<typename CharT>
+		constexpr FORCE_INLINE bool isDigit(CharT c)
+		{
+			return c >= CharT('0') && c <= CharT('9');
+		}
+
+		template<typename CharT>
+		constexpr FORCE_INLINE bool isAlign(CharT c)
+		{
+			return c == CharT('<') || c == CharT('>') || c == CharT('^');
+		}
+
+		/**
+		 * @brief Parse a replacement field.
+		 * Fields without an index take the index
+		 * after the one of the previous field
+		 * without an index.
+		 *
+		 * @param it ptr past the opening brace
+		 * @param end ptr past the end of the
+		 * format string
+		 * @param nextArg index of the next
+		 * argument
+		 * @param argIdx returns the index of the
+		 * argument
+		 * @param spec returns the options of the
+		 * field
+		 * @return ptr past the closing brace
+		 * @return nullptr if the field is not
+		 * valid
+		 */
+		template<typename CharT>
+		constexpr CharT const* parseField(CharT const* it, CharT const* end, sizet& nextArg, sizet& argIdx, FormatSpec& spec)
+		{
+			if (it != end && isDigit(*it))
+			{
+				for (argIdx = 0; it != end && isDigit(*it); ++it)
+				{
+					argIdx = argIdx * 10 + (*it - CharT('0'));
+				}
+			}
+			else
+			{
+				argIdx = nextArg++;
+			}
+
+			if (it != end && *it == CharT(':'))
+			{
+				++it;
+				if (end - it >= 2 && isAlign(it[1]) && *it != CharT('{') && *it != CharT('}'))
+				{
+					spec.fill = static_cast<uint32>(it[0]);
+					spec.align = static_cast<ansichar>(it[1]);
+					it += 2;
+				}
+				else if (it != end && isAlign(*it))
+				{
+					spec.align = static_cast<ansichar>(*it++);
+				}
+
+				if (it != end && (*it == CharT('+') || *it == CharT('-') || *it == CharT(' ')))
+				{
+					spec.sign = static_cast<ansichar>(*it++);
+				}
+
+				if (it != end && *it == CharT('#'))
+				{
+					spec.alternate = true;
+					++it;
+				}
+
+				if (it != end && *it == CharT('0'))
+				{
+					spec.zeroPad = true;
+					++it;
+				}
+
+				for (; it != end && isDigit(*it); ++it)
+				{
+					spec.width = spec.width * 10 + (*it - CharT('0'));
+				}
+
+				if (it != end && *it == CharT('.'))
+				{
+					if (++it == end || !isDigit(*it))
+					{
+						return nullptr;
+					}
+
+					for (spec.precision = 0; it != end && isDigit(*it); ++it)
+					{
+						spec.precision = spec.precision * 10 + (*it - CharT('0'));
+					}
+				}
+
+				if (it != end && ((*it >= CharT('a') && *it <= CharT('z')) || (*it >= CharT('A') && *it <= CharT('Z'))))
+				{
+					spec.type = static_cast<ansichar>(*it++);
+				}
+			}
+
+			return it != end && *it == CharT('}') ? it + 1 : nullptr;
+		}
+
+		/**
+		 * @brief Write the format string to the
+		 * buffer, replacing the fields with the
+		 * formatted arguments. The format string
+		 * must be valid.
+		 *
+		 * @param out the output buffer
+		 * @param fmt the format string
+		 * @param args the type-erased arguments
+		 */
+		template<typename CharT>
+		void vformatTo(FormatBuffer<CharT>& out, StringViewBase<CharT> fmt, FormatArg<CharT> const* args)
+		{
+			CharT const* it = fmt.begin();
+			CharT const* const end = fmt.end();
+			for (sizet nextArg = 0;;)
+			{
+				// Copy characters up to the next brace,
+				// literal runs are too short for a
+				// vectorized scan to pay off
+				sizet len = 0; for (; it + len != end && it[len] != CharT('{') && it[len] != CharT('}'); ++len);
+				out.append(it, len);
+				it += len;
+
+				if (it == end)
+				{
+					return;
+				}
+
+				if (it + 1 != end && it[1] == *it)
+				{
+					// Escaped brace
+					out.append(*it);
+					it += 2;
+					continue;
+				}
+
+				sizet argIdx;
+				FormatSpec spec;
+				it = parseField(it + 1, end, nextArg, argIdx, spec);
+				args[argIdx].format(out, args[argIdx].value, spec);
+			}
+		}
+
+		/**
+		 * @brief Write a value of the given length
+		 * padded to the min width of the field.
+		 *
+		 * @param out the output buffer
+		 * @param spec the options of the field
+		 * @param len length of the value
+		 * @param defaultAlign alignment if the
+		 * spec has none
+		 * @param write writes the value
+		 */
+		template<typename CharT, typename WriteT>
+		FORCE_INLINE void writePadded(FormatBuffer<CharT>& out, FormatSpec const& spec, sizet len, ansichar defaultAlign, WriteT&& write)
+		{
+			if (len >= spec.width)
+			{
+				write();
+				return;
+			}
+
+			sizet const padding = spec.width - len;
+			ansichar const align = spec.align ? spec.align : defaultAlign;
+			sizet const before = align == '>' ? padding : align == '^' ? padding / 2 : 0;
+
+			out.appendFill(CharT(spec.fill), before);
+			write();
+			out.appendFill(CharT(spec.fill), padding - before);
+		}
+
+		/**
+		 * @brief Write a number, given the sign
+		 * and prefix and the digits.
+		 */
+		template<typename CharT>
+		void writeNumber(FormatBuffer<CharT>& out, FormatSpec const& spec, ansichar const* prefix, sizet prefixLen, ansichar const* digits, sizet numDigits)
+		{
+			sizet const len = prefixLen + numDigits;
+			if (spec.zeroPad && !spec.align)
+			{
+				out.appendAnsi(prefix, prefixLen);
+				out.appendFill(CharT('0'), spec.width > len ? spec.width - len : 0);
+				out.appendAnsi(digits, numDigits);
+				return;
+			}
+
+			writePadded(out, spec, len, '>', [&]() {
+
+				out.appendAnsi(prefix, prefixLen);
+				out.appendAnsi(digits, numDigits);
+			});
+		}
+
+		/**
+		 * @brief Write the digits of a number
+		 * backwards, the base is a constant so
+		 * that divisions are cheap.
+		 *
+		 * @param end ptr past the last digit
+		 * @param abs the number
+		 * @param chars the digits of the base
+		 * @return ptr to the first digit
+		 */
+		template<uint32 base>
+		FORCE_INLINE ansichar* writeDigits(ansichar* end, uint64 abs, ansichar const* chars)
+		{
+			do
+			{
+				*--end = chars[abs % base];
+				abs /= base;
+			}
+			while (abs);
+
+			return end;
+		}
+
+		/**
+		 * @brief Write an integer.
+		 *
+		 * @param out the output buffer
+		 * @param abs the absolute value
+		 * @param negative true if the value is
+		 * negative
+		 * @param spec the options of the field
+		 */
+		template<typename CharT>
+		void formatInt(FormatBuffer<CharT>& out, uint64 abs, bool negative, FormatSpec const& spec)
+		{
+			ansichar prefix[4];
+			sizet prefixLen = 0;
+			if (negative)
+			{
+				prefix[prefixLen++] = '-';
+			}
+			else if (spec.sign != '-')
+			{
+				prefix[prefixLen++] = spec.sign;
+			}
+
+			uint32 base = 10;
+			switch (spec.type)
+			{
+				case 'x': case 'X': base = 16; break;
+				case 'o': base = 8; break;
+				case 'b': case 'B': base = 2; break;
+			}
+
+			if (spec.alternate && base != 10)
+			{
+				prefix[prefixLen++] = '0';
+				if (base != 8)
+				{
+					prefix[prefixLen++] = spec.type;
+				}
+			}
+
+			ansichar digits[64];
+			ansichar* const end = digits + sizeof(digits);
+			ansichar* it = end;
+			switch (base)
+			{
+				case 10:
+				{
+					uint32 const numDigits = StringConvert_Impl::countDigits(abs);
+					it = end - numDigits;
+					StringConvert_Impl::writeDigits(it, abs, numDigits);
+					break;
+				}
+				case 16: it = writeDigits<16>(end, abs, spec.type == 'X' ? "0123456789ABCDEF" : "0123456789abcdef"); break;
+				case 8: it = writeDigits<8>(end, abs, "01234567"); break;
+				case 2: it = writeDigits<2>(end, abs, "01"); break;
+			}
+
+			writeNumber(out, spec, prefix, prefixLen, it, end - it);
+		}
+
+		/**
+		 * @brief Write a floating-point number.
+		 * Without a type and precision, prints
+		 * the shortest number that reads back to
+		 * the same value, otherwise prints like
+		 * printf.
+		 *
+		 * @param out the output buffer
+		 * @param value the number
+		 * @param spec the options of the field
+		 */
+		template<typename CharT, typename FloatT>
+		void formatFloat(FormatBuffer<CharT>& out, FloatT value, FormatSpec const& spec)
+		{
+			bool const isFinite = StringConvert_Impl::isFinite(value);
+			if (spec.type == 0 && spec.precision < 0)
+			{
+				ansichar buffer[maxFloatLength + 2];
+				ansichar* it = buffer + 1;
+				ansichar* const end = floatToChars(it, value);
+				if (*it != '-' && spec.sign != '-')
+				{
+					*--it = spec.sign;
+				}
+
+				ansichar* last = end;
+				if (spec.alternate && isFinite && !PlatformString::chrn(it, end - it, '.'))
+				{
+					// Always print the point, before the
+					// exponent if any
+					ansichar* const exp = PlatformString::chrn(it, end - it, 'e');
+					ansichar* const point = exp ? exp : end;
+					PlatformMemory::memmove(point + 1, point, end - point);
+					*point = '.';
+					++last;
+				}
+
+				// Split the sign, so that zeros go after it
+				sizet const signLen = *it == '-' || *it == '+' || *it == ' ';
+				FormatSpec finiteSpec = spec;
+				finiteSpec.zeroPad &= isFinite;
+				writeNumber(out, finiteSpec, it, signLen, it + signLen, last - it - signLen);
+				return;
+			}
+
+			ansichar fmt[8] = {'%'};
+			sizet fmtLen = 1;
+			if (spec.sign != '-')
+			{
+				fmt[fmtLen++] = spec.sign;
+			}
+
+			if (spec.alternate)
+			{
+				fmt[fmtLen++] = '#';
+			}
+
+			fmt[fmtLen++] = '.';
+			fmt[fmtLen++] = '*';
+			fmt[fmtLen++] = spec.type ? spec.type : 'g';
+
+			float64 const arg = value;
+			int32 const precision = spec.precision < 0 ? 6 : spec.precision;
+			ansichar buffer[128];
+			int32 const len = ::snprintf(buffer, sizeof(buffer), fmt, precision, arg);
+
+			ansichar* digits = buffer;
+			if (len >= static_cast<int32>(sizeof(buffer)))
+			{
+				digits = reinterpret_cast<ansichar*>(gMalloc->malloc(len + 1));
+				::snprintf(digits, len + 1, fmt, precision, arg);
+			}
+
+			sizet const signLen = *digits == '-' || *digits == '+' || *digits == ' ';
+			FormatSpec finiteSpec = spec;
+			finiteSpec.zeroPad &= isFinite;
+			writeNumber(out, finiteSpec, digits, signLen, digits + signLen, len - signLen);
+
+			if (digits != buffer)
+			{
+				gMalloc->free(digits);
+			}
+		}
+
+		/**
+		 * @brief Write a string, truncated to the
+		 * precision of the field.
+		 */
+		template<typename CharT, typename CharU>
+		void formatString(FormatBuffer<CharT>& out, CharU const* src, sizet len, FormatSpec const& spec)
+		{
+			if (spec.precision >= 0)
+			{
+				len = PlatformMath::min(len, sizet(spec.precision));
+			}
+
+			writePadded(out, spec, len, '<', [&]() {
+
+				if constexpr (SameType<CharT, CharU>::value)
+				{
+					out.append(src, len);
+				}
+				else for (sizet i = 0; i < len; ++i)
+				{
+					out.append(CharT(src[i]));
+				}
+			});
+		}
+
+		/**
+		 * @brief Returns true if the spec has
+		 * only the options that apply to any
+		 * type.
+		 */
+		constexpr FORCE_INLINE bool isPlainSpec(FormatSpec const& spec)
+		{
+			return spec.sign == '-' && !spec.alternate && !spec.zeroPad && spec.precision < 0;
+		}
+
+		/**
+		 * @brief Returns true if the spec is
+		 * valid for an integer.
+		 */
+		constexpr FORCE_INLINE bool isIntSpec(FormatSpec const& spec)
+		{
+			switch (spec.type)
+			{
+				case 0: case 'd': case 'x': case 'X': case 'o': case 'b': case 'B':
+					return spec.precision < 0;
+				default:
+					return false;
+			}
+		}
+
+		/**
+		 * @brief Formats a character type.
+		 */
+		template<typename CharU>
+		struct CharFormatter
+		{
+			static constexpr bool check(FormatSpec const& spec)
+			{
+				return spec.type == 'c' || (spec.type == 0 && isPlainSpec(spec)) || (spec.type != 0 && isIntSpec(spec));
+			}
+
+			template<typename CharT>
+			static void format(FormatBuffer<CharT>& out, CharU c, FormatSpec const& spec)
+			{
+				if (spec.type == 0 || spec.type == 'c')
+				{
+					writePadded(out, spec, 1, '<', [&]() { out.append(CharT(c)); });
+				}
+				else
+				{
+					formatInt(out, static_cast<uint64>(c), false, spec);
+				}
+			}
+		};
+
+		/**
+		 * @brief Formats a null-terminated string,
+		 * or the address of a pointer.
+		 */
+		template<typename T, bool = SameType<typename RemoveCV<T>::Type, ansichar>::value || SameType<typename RemoveCV<T>::Type, widechar>::value>
+		struct PointerFormatter
+		{
+			static constexpr bool check(FormatSpec const& spec)
+			{
+				return (spec.type == 0 || spec.type == 's') && spec.sign == '-' && !spec.alternate && !spec.zeroPad;
+			}
+
+			template<typename CharT>
+			static void format(FormatBuffer<CharT>& out, T* cstr, FormatSpec const& spec)
+			{
+				if (cstr)
+				{
+					formatString(out, cstr, PlatformString::len(cstr), spec);
+				}
+				else
+				{
+					formatString(out, "(null)", 6, spec);
+				}
+			}
+		};
+
+		template<typename T>
+		struct PointerFormatter<T, false>
+		{
+			static constexpr bool check(FormatSpec const& spec)
+			{
+				return (spec.type == 0 || spec.type == 'p') && isPlainSpec(spec);
+			}
+
+			template<typename CharT>
+			static void format(FormatBuffer<CharT>& out, T* ptr, FormatSpec const& spec)
+			{
+				FormatSpec hexSpec = spec;
+				hexSpec.type = 'x';
+				hexSpec.alternate = true;
+				formatInt(out, reinterpret_cast<uintp>(ptr), false, hexSpec);
+			}
+		};
+
+		/**
+		 * @brief Write the items of a tuple,
+		 * separated by commas.
+		 */
+		template<typename CharT, typename TupleT, sizet ...idxs>
+		FORCE_INLINE void formatItems(FormatBuffer<CharT>& out, TupleT const& tup, FormatSpec const& spec, IndexSequence<idxs...>)
+		{
+			([&]() {
+
+				if constexpr (idxs > 0)
+				{
+					out.appendAnsi(", ", 2);
+				}
+
+				auto const& item = tup.template get<idxs>();
+				Formatter<typename Decay<decltype(item)>::Type>::format(out, item, spec);
+			}(), ...);
+		}
+	} // namespace Format_Impl
+
+	/**
+	 * @brief A format string, checked at
+	 * compile time against the types of the
+	 * arguments.
+	 *
+	 * Replacement fields are delimited by
+	 * braces, and literal braces are doubled:
+	 *
+	 * ```
+	 * {[index][:spec]}
+	 * ```
+	 *
+	 * Fields without an index use the
+	 * arguments in order. The spec is parsed
+	 * by FormatSpec, and each type decides
+	 * which options it accepts. A format
+	 * string with wrong fields or options, or
+	 * that uses an argument that does not
+	 * exist, does not compile.
+	 *
+	 * @tparam CharT the type of the characters
+	 * @tparam ArgsT the types of the arguments
+	 */
+	template<typename CharT, typename ...ArgsT>
+	class BasicFormatString
+	{
+	public:
+		/**
+		 * @brief Construct and check a format
+		 * string.
+		 *
+		 * @param str the format string
+		 * @{
+		 */
+		consteval BasicFormatString(CharT const* str)
+			: fmt{str}
+		{
+			check();
+		}
+
+		consteval BasicFormatString(StringViewBase<CharT> str)
+			: fmt{str}
+		{
+			check();
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns a view over the format
+		 * string.
+		 */
+		constexpr FORCE_INLINE StringViewBase<CharT> get() const
+		{
+			return fmt;
+		}
+
+	protected:
+		/**
+		 * @brief Check that the fields are valid
+		 * for the types of the arguments.
+		 */
+		consteval void check() const
+		{
+			bool (*const checks[])(FormatSpec const&) = {&Formatter<typename Decay<ArgsT>::Type>::check..., nullptr};
+
+			CharT const* it = fmt.begin();
+			CharT const* const end = fmt.end();
+			for (sizet nextArg = 0; it != end;)
+			{
+				if (*it != CharT('{') && *it != CharT('}'))
+				{
+					++it;
+					continue;
+				}
+
+				if (it + 1 != end && it[1] == *it)
+				{
+					it += 2;
+					continue;
+				}
+
+				if (*it == CharT('}'))
+				{
+					Format_Impl::invalidFormatString("Unmatched closing brace");
+				}
+
+				sizet argIdx;
+				FormatSpec spec;
+				it = Format_Impl::parseField(it + 1, end, nextArg, argIdx, spec);
+				if (!it)
+				{
+					Format_Impl::invalidFormatString("Invalid replacement field");
+				}
+
+				if (argIdx >= sizeof...(ArgsT))
+				{
+					Format_Impl::invalidFormatString("Argument index out of range");
+				}
+
+				if (!checks[argIdx](spec))
+				{
+					Format_Impl::invalidFormatString("Invalid format spec for the type of the argument");
+				}
+			}
+		}
+
+		/* The format string. */
+		StringViewBase<CharT> fmt;
+	};
+
+	template<typename ...ArgsT>
+	using FormatString = BasicFormatString<ansichar, typename TypeIdentity<ArgsT>::Type...>;
+
+	/**
+	 * @brief Write formatted arguments to a
+	 * format buffer. Useful to implement
+	 * formatters in terms of other formatters.
+	 *
+	 * @param out the output buffer
+	 * @param fmt the format string
+	 * @param args the arguments
+	 */
+	template<typename CharT, typename ...ArgsT>
+	FORCE_INLINE void formatTo(FormatBuffer<CharT>& out, BasicFormatString<ansichar, typename TypeIdentity<ArgsT>::Type...> fmt, ArgsT const& ...args)
+	{
+		if constexpr (SameType<CharT, ansichar>::value)
+		{
+			Format_Impl::FormatArg<CharT> const argArray[] = {Format_Impl::makeArg<CharT>(args)..., {}};
+			Format_Impl::vformatTo(out, fmt.get(), argArray);
+		}
+		else
+		{
+			// Format to a narrow buffer first
+			MemoryFormatBuffer<ansichar> narrow;
+			formatTo<ansichar, ArgsT...>(narrow, fmt, args...);
+			out.appendAnsi(narrow.getData(), narrow.getLength());
+		}
+	}
+
+	/**
+	 * @brief Format the arguments into a new
+	 * string. The string is built in a single
+	 * pass, and short strings don't allocate
+	 * more than the result.
+	 *
+	 * ```
+	 * String msg = format("{} took {:.2f} ms", name, time);
+	 * ```
+	 *
+	 * @param fmt the format string
+	 * @param args the arguments
+	 * @return the formatted string
+	 */
+	template<typename ...ArgsT>
+	String format(FormatString<ArgsT...> fmt, ArgsT const& ...args)
+	{
+		MemoryFormatBuffer<ansichar> out;
+		formatTo<ansichar, ArgsT...>(out, fmt, args...);
+		return String{out.getData(), out.getLength()};
+	}
+
+	/**
+	 * @brief Append the formatted arguments to
+	 * a string.
+	 *
+	 * @param dst the string to append to
+	 * @param fmt the format string
+	 * @param args the arguments
+	 * @return ref to the string
+	 */
+	template<typename ...ArgsT>
+	String& formatTo(String& dst, FormatString<ArgsT...> fmt, ArgsT const& ...args)
+	{
+		MemoryFormatBuffer<ansichar> out;
+		formatTo<ansichar, ArgsT...>(out, fmt, args...);
+		return dst += StringView{out.getData(), out.getLength()};
+	}
+
+	/**
+	 * @brief Format the arguments into a
+	 * caller-provided buffer, without
+	 * allocating. The output is truncated to
+	 * the size of the buffer, and it is always
+	 * null-terminated if the size is not zero.
+	 *
+	 * @param dst ptr to the buffer
+	 * @param size size of the buffer,
+	 * including the terminating character
+	 * @param fmt the format string
+	 * @param args the arguments
+	 * @return the length of the whole
+	 * formatted string, which is larger than
+	 * or equal to size if it was truncated
+	 */
+	template<typename ...ArgsT>
+	sizet formatTo(ansichar* dst, sizet size, FormatString<ArgsT...> fmt, ArgsT const& ...args)
+	{
+		FormatBuffer<ansichar> out{dst, size > 0 ? size - 1 : 0};
+		formatTo<ansichar, ArgsT...>(out, fmt, args...);
+		if (size > 0)
+		{
+			dst[PlatformMath::min(out.getLength(), size - 1)] = '\0';
+		}
+
+		return out.getLength();
+	}
+
+	/**
+	 * @brief Integers are formatted in
+	 * decimal, or in hexadecimal (x, X), octal
+	 * (o) and binary (b, B). With the # option
+	 * the number is prefixed by the base, and
+	 * with the c type it is formatted as a
+	 * character.
+	 */
+	template<typename T>
+	struct Formatter<T, typename EnableIf<IsIntegral<T>::value || SameType<T, long>::value || SameType<T, unsigned long>::value>::Type>
+	{
+		static constexpr bool check(FormatSpec const& spec)
+		{
+			return Format_Impl::isIntSpec(spec) || (spec.type == 'c' && Format_Impl::isPlainSpec(spec));
+		}
+
+		template<typename CharT>
+		static void format(FormatBuffer<CharT>& out, T value, FormatSpec const& spec)
+		{
+			if (spec.type == 'c')
+			{
+				Format_Impl::writePadded(out, spec, 1, '<', [&]() { out.append(CharT(value)); });
+			}
+			else if constexpr (T(-1) < T(0))
+			{
+				Format_Impl::formatInt(out, value < 0 ? 0 - static_cast<uint64>(value) : static_cast<uint64>(value), value < 0, spec);
+			}
+			else
+			{
+				Format_Impl::formatInt(out, static_cast<uint64>(value), false, spec);
+			}
+		}
+	};
+
+	/**
+	 * @brief Characters are formatted as
+	 * characters, or as integers with an
+	 * integer type.
+	 * @{
+	 */
+	template<>
+	struct Formatter<ansichar> : public Format_Impl::CharFormatter<ansichar>
+	{
+		//
+	};
+
+	template<>
+	struct Formatter<widechar> : public Format_Impl::CharFormatter<widechar>
+	{
+		//
+	};
+	/** @} */
+
+	/**
+	 * @brief Booleans are formatted as true or
+	 * false, or as integers with an integer
+	 * type.
+	 */
+	template<>
+	struct Formatter<bool>
+	{
+		static constexpr bool check(FormatSpec const& spec)
+		{
+			return ((spec.type == 0 || spec.type == 's') && Format_Impl::isPlainSpec(spec)) || (spec.type != 0 && Format_Impl::isIntSpec(spec));
+		}
+
+		template<typename CharT>
+		static void format(FormatBuffer<CharT>& out, bool value, FormatSpec const& spec)
+		{
+			if (spec.type == 0 || spec.type == 's')
+			{
+				Format_Impl::formatString(out, value ? "true" : "false", value ? 4 : 5, spec);
+			}
+			else
+			{
+				Format_Impl::formatInt(out, value, false, spec);
+			}
+		}
+	};
+
+	/**
+	 * @brief Floating-point numbers are
+	 * formatted like printf does with the
+	 * same type (f, F, e, E, g, G, a, A) and
+	 * precision. Without a type and a
+	 * precision, they are formatted with the
+	 * fewest digits that read back to the
+	 * same value.
+	 * @{
+	 */
+	template<typename T>
+	struct Formatter<T, typename EnableIf<SameType<T, float32>::value || SameType<T, float64>::value>::Type>
+	{
+		static constexpr bool check(FormatSpec const& spec)
+		{
+			switch (spec.type)
+			{
+				case 0: case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+					return true;
+				default:
+					return false;
+			}
+		}
+
+		template<typename CharT>
+		static void format(FormatBuffer<CharT>& out, T value, FormatSpec const& spec)
+		{
+			Format_Impl::formatFloat(out, value, spec);
+		}
+	};
+	/** @} */
+
+	/**
+	 * @brief Pointers to characters are
+	 * formatted as null-terminated strings,
+	 * other pointers as hexadecimal
+	 * addresses.
+	 */
+	template<typename T>
+	struct Formatter<T*> : public Format_Impl::PointerFormatter<T>
+	{
+		//
+	};
+
+	/**
+	 * @brief Character arrays are formatted as
+	 * null-terminated strings.
+	 */
+	template<typename CharU, sizet n>
+	struct Formatter<CharU[n]> : public Format_Impl::PointerFormatter<CharU const>
+	{
+		//
+	};
+
+	/**
+	 * @brief Strings and string views. The
+	 * precision is the max number of
+	 * characters.
+	 * @{
+	 */
+	template<typename CharU>
+	struct Formatter<StringViewBase<CharU>>
+	{
+		static constexpr bool check(FormatSpec const& spec)
+		{
+			return (spec.type == 0 || spec.type == 's') && spec.sign == '-' && !spec.alternate && !spec.zeroPad;
+		}
+
+		template<typename CharT>
+		static void format(FormatBuffer<CharT>& out, StringViewBase<CharU> str, FormatSpec const& spec)
+		{
+			Format_Impl::formatString(out, *str, str.getLength(), spec);
+		}
+	};
+
+	template<typename CharU>
+	struct Formatter<StringBase<CharU>> : public Formatter<StringViewBase<CharU>>
+	{
+		//
+	};
+	/** @} */
+
+	/**
+	 * @brief Arrays are formatted as lists,
+	 * the spec applies to each item.
+	 */
+	template<typename T>
+	struct Formatter<Array<T>>
+	{
+		static constexpr bool check(FormatSpec const& spec)
+		{
+			return Formatter<T>::check(spec);
+		}
+
+		template<typename CharT>
+		static void format(FormatBuffer<CharT>& out, Array<T> const& arr, FormatSpec const& spec)
+		{
+			out.append(CharT('['));
+
+			bool first = true;
+			for (T const& item : arr)
+			{
+				if (!first)
+				{
+					out.appendAnsi(", ", 2);
+				}
+
+				Formatter<T>::format(out, item, spec);
+				first = false;
+			}
+
+			out.append(CharT(']'));
+		}
+	};
+
+	/**
+	 * @brief Tuples are formatted in
+	 * parentheses, the spec applies to each
+	 * item.
+	 */
+	template<typename ...ItemsT>
+	struct Formatter<Tuple<ItemsT...>>
+	{
+		static constexpr bool check(FormatSpec const& spec)
+		{
+			return (Formatter<typename Decay<ItemsT>::Type>::check(spec) && ...);
+		}
+
+		template<typename CharT>
+		static void format(FormatBuffer<CharT>& out, Tuple<ItemsT...> const& tup, FormatSpec const& spec)
+		{
+			out.append(CharT('('));
+			Format_Impl::formatItems(out, tup, spec, iseqFor(tup));
+			out.append(CharT(')'));
+		}
+	};
+
+	/**
+	 * @brief Optional values are formatted
+	 * as the value, or as none.
+	 */
+	template<typename T>
+	struct Formatter<Optional<T>>
+	{
+		static constexpr bool check(FormatSpec const& spec)
+		{
+			return Formatter<T>::check(spec);
+		}
+
+		template<typename CharT>
+		static void format(FormatBuffer<CharT>& out, Optional<T> const& opt, FormatSpec const& spec)
+		{
+			if (opt.hasValue())
+			{
+				Formatter<T>::format(out, *opt, spec);
+			}
+			else
+			{
+				Format_Impl::writePadded(out, spec, 4, '<', [&]() { out.appendAnsi("none", 4); });
+			}
+		}
+	};
+} // namespace Korin
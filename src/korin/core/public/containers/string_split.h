@@ -0,0 +1,404 @@
+#pragma once
+
+#include "string_view.h"
+
+namespace Korin
+{
+	namespace StringSplit_Impl
+	{
+		/**
+		 * @brief Finds the characters of a set by
+		 * scanning 64 characters at a time. The
+		 * mask of the last block is kept, so that
+		 * close delimiters are found without
+		 * scanning again.
+		 *
+		 * The searches must move forward and end
+		 * at the same position.
+		 *
+		 * @tparam CharT the type of the characters
+		 */
+		template<typename CharT>
+		struct SetScanner
+		{
+			/* Ptr to the first character of the last block. */
+			CharT const* base = nullptr;
+
+			/* Number of characters in the last block. */
+			sizet len = 0;
+
+			/* Mask of the characters of the last block that are in the set. */
+			uint64 mask = 0;
+
+			/**
+			 * @brief Returns the index of the first
+			 * character in the set, or n if none.
+			 */
+			constexpr sizet find(CharT const* src, sizet n, CharT const* set, sizet setLen)
+			{
+				CharT const* it = src;
+				if (base && src >= base && src < base + len)
+				{
+					if (uint64 const bits = mask >> (src - base))
+					{
+						return PlatformMath::countTrailingZeros(bits);
+					}
+
+					it = base + len;
+				}
+
+				for (CharT const* const end = src + n; it < end; it += len)
+				{
+					base = it;
+					len = PlatformMath::min(sizet(end - it), sizet(64));
+					mask = PlatformString::setMask(it, len, set, setLen);
+					if (mask)
+					{
+						return it - src + PlatformMath::countTrailingZeros(mask);
+					}
+				}
+
+				return n;
+			}
+		};
+
+		/**
+		 * @brief Splits on a single character.
+		 *
+		 * @tparam CharT the type of the characters
+		 */
+		template<typename CharT>
+		struct CharDelimiter
+		{
+			/* Whether an empty tail after the last delimiter is a token. */
+			static constexpr bool keepEmptyTail = true;
+
+			/* The delimiter character. */
+			CharT c;
+
+			/* Finds the delimiters. */
+			SetScanner<CharT> scanner = {};
+
+			/**
+			 * @brief Returns the index of the first
+			 * delimiter, or n if none.
+			 */
+			constexpr FORCE_INLINE sizet find(CharT const* src, sizet n)
+			{
+				return scanner.find(src, n, &c, 1);
+			}
+
+			/**
+			 * @brief Returns the length of the
+			 * delimiter that starts at the given
+			 * position.
+			 */
+			constexpr FORCE_INLINE sizet skip(CharT const*, sizet) const
+			{
+				return 1;
+			}
+		};
+
+		/**
+		 * @brief Splits on any character of a set.
+		 *
+		 * @tparam CharT the type of the characters
+		 */
+		template<typename CharT>
+		struct SetDelimiter
+		{
+			static constexpr bool keepEmptyTail = true;
+
+			/* The set of delimiter characters. */
+			StringViewBase<CharT> set;
+
+			SetScanner<CharT> scanner = {};
+
+			constexpr FORCE_INLINE sizet find(CharT const* src, sizet n)
+			{
+				return scanner.find(src, n, *set, set.getLength());
+			}
+
+			constexpr FORCE_INLINE sizet skip(CharT const*, sizet) const
+			{
+				return 1;
+			}
+		};
+
+		/**
+		 * @brief Splits on a substring. An empty
+		 * substring never matches.
+		 *
+		 * @tparam CharT the type of the characters
+		 */
+		template<typename CharT>
+		struct SubstringDelimiter
+		{
+			static constexpr bool keepEmptyTail = true;
+
+			/* The separator substring. */
+			StringViewBase<CharT> separator;
+
+			constexpr FORCE_INLINE sizet find(CharT const* src, sizet n) const
+			{
+				if (separator.isEmpty())
+				{
+					return n;
+				}
+
+				CharT const* it = PlatformString::findn(src, n, *separator, separator.getLength());
+				return it ? it - src : n;
+			}
+
+			constexpr FORCE_INLINE sizet skip(CharT const*, sizet) const
+			{
+				return separator.getLength();
+			}
+		};
+
+		/**
+		 * @brief Splits on line feeds, and on
+		 * carriage returns followed by a line
+		 * feed. A line break at the end does not
+		 * start a new line.
+		 *
+		 * @tparam CharT the type of the characters
+		 */
+		template<typename CharT>
+		struct LineDelimiter
+		{
+			static constexpr bool keepEmptyTail = false;
+
+			SetScanner<CharT> scanner = {};
+
+			constexpr FORCE_INLINE sizet find(CharT const* src, sizet n)
+			{
+				CharT const lf = '\n';
+				sizet const idx = scanner.find(src, n, &lf, 1);
+				return idx > 0 && idx < n && src[idx - 1] == CharT('\r') ? idx - 1 : idx;
+			}
+
+			constexpr FORCE_INLINE sizet skip(CharT const* src, sizet) const
+			{
+				return *src == CharT('\r') ? 2 : 1;
+			}
+		};
+	} // namespace StringSplit_Impl
+
+	/**
+	 * @brief Iterator over the tokens of a
+	 * string view. Tokens are views over the
+	 * characters of the original view, and they
+	 * are found lazily, while iterating.
+	 * @see StringViewBase::split
+	 *
+	 * @tparam CharT the type of the characters
+	 * @tparam DelimiterT the type that finds the
+	 * delimiters
+	 */
+	template<typename CharT, typename DelimiterT>
+	class StringSplitIterator
+	{
+		using SelfT = StringSplitIterator;
+		using StringViewT = StringViewBase<CharT>;
+
+	public:
+		/**
+		 * @brief Construct an iterator that points
+		 * to the first token of a view.
+		 *
+		 * @param src view to split
+		 * @param inDelimiter finds the delimiters
+		 * @param inOptions split options
+		 */
+		constexpr FORCE_INLINE StringSplitIterator(StringViewT src, DelimiterT const& inDelimiter, SplitOptions inOptions)
+			: delimiter{inDelimiter}
+			, options{inOptions}
+			, token{}
+			, next{src.begin()}
+			, last{src.end()}
+		{
+			if (!DelimiterT::keepEmptyTail && next == last)
+			{
+				next = nullptr;
+			}
+
+			++(*this);
+		}
+
+		/**
+		 * @brief Construct the end iterator.
+		 */
+		constexpr FORCE_INLINE StringSplitIterator()
+			: delimiter{}
+			, options{}
+			, token{}
+			, next{nullptr}
+			, last{nullptr}
+		{
+			//
+		}
+
+		/**
+		 * @brief Returns a view over the current
+		 * token.
+		 */
+		constexpr FORCE_INLINE StringViewT const& operator*() const
+		{
+			return token;
+		}
+
+		constexpr FORCE_INLINE StringViewT const* operator->() const
+		{
+			return &token;
+		}
+
+		constexpr FORCE_INLINE bool operator==(SelfT const& other) const
+		{
+			return last == other.last && next == other.next;
+		}
+
+		constexpr FORCE_INLINE bool operator!=(SelfT const& other) const
+		{
+			return !(*this == other);
+		}
+
+		/**
+		 * @brief Move to the next token.
+		 */
+		constexpr SelfT& operator++()
+		{
+			for (;;)
+			{
+				if (!next)
+				{
+					// Past the last token
+					last = nullptr;
+					return *this;
+				}
+
+				CharT const* const start = next;
+				sizet const n = last - start;
+				sizet len, first = 0, count;
+
+				if (options.quoted && n > 0 && *start == CharT('"'))
+				{
+					// A field made of just a quoted string
+					// loses the quotes
+					sizet const close = findClosingQuote(start, n);
+					len = close < n ? close + 1 + delimiter.find(start + close + 1, n - close - 1) : n;
+					if (close + 1 == len)
+					{
+						first = 1;
+						count = close - 1;
+					}
+					else
+					{
+						count = len;
+					}
+				}
+				else
+				{
+					len = count = delimiter.find(start, n);
+				}
+
+				if (len < n)
+				{
+					next = start + len + delimiter.skip(start + len, n - len);
+					if (!DelimiterT::keepEmptyTail && next == last)
+					{
+						next = nullptr;
+					}
+				}
+				else
+				{
+					next = nullptr;
+				}
+
+				if (count > 0 || !options.skipEmpty)
+				{
+					token = {start + first, count};
+					return *this;
+				}
+			}
+		}
+
+	protected:
+		/**
+		 * @brief Returns the index of the quote
+		 * that closes a quoted field, or n if the
+		 * quotes are not closed. Two consecutive
+		 * quotes are an escaped quote, they do not
+		 * close the field and are left as they
+		 * are in the token.
+		 */
+		static constexpr sizet findClosingQuote(CharT const* src, sizet n)
+		{
+			for (sizet i = 1; i < n; i += 2)
+			{
+				CharT const* it = PlatformString::chrn(src + i, n - i, CharT('"'));
+				if (!it)
+				{
+					break;
+				}
+
+				i = it - src;
+				if (i + 1 == n || src[i + 1] != CharT('"'))
+				{
+					return i;
+				}
+			}
+
+			return n;
+		}
+
+		/* Finds the delimiters. */
+		DelimiterT delimiter;
+
+		/* Split options. */
+		SplitOptions options;
+
+		/* The current token. */
+		StringViewT token;
+
+		/* Ptr to the start of the next token, or null if the current token is the last one. */
+		CharT const* next;
+
+		/* Ptr past the end of the view, or null past the last token. */
+		CharT const* last;
+	};
+
+	/**
+	 * @brief Range over the tokens of a string
+	 * view.
+	 * @see StringViewBase::split
+	 *
+	 * @tparam CharT the type of the characters
+	 * @tparam DelimiterT the type that finds the
+	 * delimiters
+	 */
+	template<typename CharT, typename DelimiterT>
+	struct StringSplitRange
+	{
+		using StringViewT = StringViewBase<CharT>;
+
+		/* View to split. */
+		StringViewT src;
+
+		/* Finds the delimiters. */
+		DelimiterT delimiter;
+
+		/* Split options. */
+		SplitOptions options;
+
+		constexpr FORCE_INLINE StringSplitIterator<CharT, DelimiterT> begin() const
+		{
+			return {src, delimiter, options};
+		}
+
+		constexpr FORCE_INLINE StringSplitIterator<CharT, DelimiterT> end() const
+		{
+			return {};
+		}
+	};
+} // namespace Korin
@@ -0,0 +1,713 @@
+#pragma once
+
+#include "templates/types.h"
+#include "hal/platform_string.h"
+#include "hal/platform_math.h"
+#include "hal/platform_memory.h"
+#include "containers_types.h"
+
+namespace Korin
+{
+	template<typename> class StringFindIterator;
+	template<typename> struct StringFindRange;
+	template<typename, typename> class StringSplitIterator;
+	template<typename, typename> struct StringSplitRange;
+	template<typename> class CodePointIterator;
+	template<typename> struct CodePointRange;
+
+	namespace StringSplit_Impl
+	{
+		template<typename> struct CharDelimiter;
+		template<typename> struct SetDelimiter;
+		template<typename> struct SubstringDelimiter;
+		template<typename> struct LineDelimiter;
+	} // namespace StringSplit_Impl
+
+	/**
+	 * @brief Options for splitting strings.
+	 * @see StringViewBase::split
+	 */
+	struct SplitOptions
+	{
+		/* If true, empty tokens are skipped. */
+		bool skipEmpty = false;
+
+		/* If true, delimiters inside double quotes do not split the string. */
+		bool quoted = false;
+	};
+
+	/**
+	 * @brief A non-owning view over a sequence of
+	 * characters.
+	 *
+	 * A view is just a pointer and a length, it
+	 * never allocates and it is cheap to pass by
+	 * value. The characters are not necessarily
+	 * null-terminated, and the view must not
+	 * outlive the characters it points to.
+	 *
+	 * Views compare and hash like the string
+	 * types, so string-keyed containers can be
+	 * searched with a view or a C string without
+	 * creating a temporary string.
+	 *
+	 * @tparam CharT the type of the characters
+	 */
+	template<typename CharT>
+	class StringViewBase
+	{
+		static_assert(IsIntegral<CharT>::value, "Char type must be an integral value");
+
+		static constexpr CharT emptyString[1]{0};
+
+	public:
+		/**
+		 * @brief Construct an empty view.
+		 */
+		constexpr FORCE_INLINE StringViewBase()
+			: data{emptyString}
+			, length{0}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a view over @c len
+		 * characters.
+		 *
+		 * @param src ptr to the first character
+		 * @param len number of characters
+		 */
+		constexpr FORCE_INLINE StringViewBase(CharT const* src, sizet len)
+			: data{src}
+			, length{len}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a view over a
+		 * null-terminated string.
+		 *
+		 * @param cstr pointer to C string
+		 */
+		constexpr FORCE_INLINE StringViewBase(CharT const* cstr)
+			: StringViewBase{cstr, PlatformString::len(cstr)}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct a view over the
+		 * characters of a string.
+		 *
+		 * @param str a managed string
+		 * @{
+		 */
+		FORCE_INLINE StringViewBase(StringBase<CharT> const& str)
+			: StringViewBase{*str, str.getLength()}
+		{
+			//
+		}
+
+		FORCE_INLINE StringViewBase(SharedStringBase<CharT> const& str)
+			: StringViewBase{*str, str.getLength()}
+		{
+			//
+		}
+
+		FORCE_INLINE StringViewBase(HashedStringBase<CharT> const& str)
+			: StringViewBase{*str, str.getLength()}
+		{
+			//
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns the number of characters
+		 * in the view.
+		 */
+		constexpr FORCE_INLINE sizet getLength() const
+		{
+			return length;
+		}
+
+		/**
+		 * @brief Returns true if the view has no
+		 * characters.
+		 */
+		constexpr FORCE_INLINE bool isEmpty() const
+		{
+			return length == 0;
+		}
+
+		/**
+		 * @brief Returns a ptr to the first
+		 * character. The characters are not
+		 * necessarily null-terminated.
+		 */
+		constexpr FORCE_INLINE CharT const* operator*() const
+		{
+			return data;
+		}
+
+		/**
+		 * @brief Returns a ref to the i-th
+		 * character.
+		 *
+		 * @param idx index of the character
+		 * @return ref to character
+		 */
+		constexpr FORCE_INLINE CharT const& operator[](sizet idx) const
+		{
+			CHECK(idx < length)
+			return data[idx];
+		}
+
+		/**
+		 * @brief Returns an iterator that points
+		 * to the first character.
+		 */
+		constexpr FORCE_INLINE CharT const* begin() const
+		{
+			return data;
+		}
+
+		/**
+		 * @brief Returns an iterator that points
+		 * past the last character.
+		 */
+		constexpr FORCE_INLINE CharT const* end() const
+		{
+			return data + length;
+		}
+
+		/**
+		 * @brief Returns a view over a range of
+		 * characters of this view. The range is
+		 * clamped to the end of the view.
+		 *
+		 * @param offset index of the first
+		 * character
+		 * @param count max number of characters
+		 * @return view over the range
+		 */
+		constexpr StringViewBase substr(sizet offset, sizet count = -1) const
+		{
+			offset = PlatformMath::min(offset, length);
+			return {data + offset, PlatformMath::min(count, length - offset)};
+		}
+
+		/**
+		 * @brief Returns the index of the first
+		 * occurrence of a substring, or -1 if the
+		 * substring does not occur in the view.
+		 *
+		 * Short substrings are found by testing
+		 * their first and last characters many
+		 * positions at a time, long ones with the
+		 * Two-Way algorithm. Neither allocates.
+		 *
+		 * @param needle the substring to find
+		 * @param offset index where to start the
+		 * search
+		 * @return index of first occurrence or -1
+		 */
+		constexpr ssizet find(StringViewBase needle, sizet offset = 0) const
+		{
+			if (offset > length)
+			{
+				return -1;
+			}
+
+			CharT const* it = PlatformString::findn(data + offset, length - offset, needle.data, needle.length);
+			return it ? it - data : -1;
+		}
+
+		/**
+		 * @brief Returns the index of the first
+		 * occurrence of a character, or -1 if the
+		 * character does not occur in the view.
+		 *
+		 * @param c the character to find
+		 * @param offset index where to start the
+		 * search
+		 * @return index of the character or -1
+		 */
+		constexpr ssizet find(CharT c, sizet offset = 0) const
+		{
+			if (offset >= length)
+			{
+				return -1;
+			}
+
+			CharT const* it = PlatformString::chrn(data + offset, length - offset, c);
+			return it ? it - data : -1;
+		}
+
+		/**
+		 * @brief Returns the index of the last
+		 * occurrence of a substring, or -1 if the
+		 * substring does not occur in the view.
+		 *
+		 * @param needle the substring to find
+		 * @param offset max index of the
+		 * occurrence
+		 * @return index of last occurrence or -1
+		 */
+		constexpr ssizet rfind(StringViewBase needle, sizet offset = -1) const
+		{
+			if (needle.length > length)
+			{
+				return -1;
+			}
+
+			sizet const len = PlatformMath::min(offset, length - needle.length) + needle.length;
+			CharT const* it = PlatformString::rfindn(data, len, needle.data, needle.length);
+			return it ? it - data : -1;
+		}
+
+		/**
+		 * @brief Returns the index of the last
+		 * occurrence of a character, or -1 if the
+		 * character does not occur in the view.
+		 *
+		 * @param c the character to find
+		 * @param offset max index of the character
+		 * @return index of the character or -1
+		 */
+		constexpr ssizet rfind(CharT c, sizet offset = -1) const
+		{
+			sizet const len = offset < length ? offset + 1 : length;
+			CharT const* it = PlatformString::rchrn(data, len, c);
+			return it ? it - data : -1;
+		}
+
+		/**
+		 * @brief Returns true if the view contains
+		 * the given substring or character.
+		 * @{
+		 */
+		constexpr FORCE_INLINE bool contains(StringViewBase needle) const
+		{
+			return find(needle) >= 0;
+		}
+
+		constexpr FORCE_INLINE bool contains(CharT c) const
+		{
+			return find(c) >= 0;
+		}
+		/** @} */
+
+		/**
+		 * @brief Returns a range over the indices
+		 * of all the non-overlapping occurrences
+		 * of a substring. Occurrences are found
+		 * lazily, while iterating. An empty
+		 * substring has no occurrences.
+		 *
+		 * ```
+		 * for (sizet idx : view.findAll("foo"))
+		 * ```
+		 *
+		 * @param needle the substring to find
+		 * @return range of indices
+		 */
+		constexpr FORCE_INLINE StringFindRange<CharT> findAll(StringViewBase needle) const
+		{
+			return {*this, needle};
+		}
+
+		/**
+		 * @brief Returns a range over the tokens
+		 * separated by a character. Tokens are
+		 * views over the characters of this view,
+		 * so splitting never allocates.
+		 *
+		 * With the default options, N delimiters
+		 * always give N + 1 tokens, some of which
+		 * may be empty. If @c options.quoted is
+		 * true, delimiters between double quotes
+		 * do not split, and a token that is just a
+		 * quoted field is returned without the
+		 * quotes. Two consecutive quotes inside a
+		 * quoted field are an escaped quote, they
+		 * are left as they are.
+		 *
+		 * ```
+		 * for (StringView field : line.split(','))
+		 * ```
+		 *
+		 * @param delimiter the delimiter character
+		 * @param options split options
+		 * @return range of tokens
+		 */
+		constexpr FORCE_INLINE StringSplitRange<CharT, StringSplit_Impl::CharDelimiter<CharT>> split(CharT delimiter, SplitOptions options = {}) const
+		{
+			return {*this, {delimiter}, options};
+		}
+
+		/**
+		 * @brief Returns a range over the tokens
+		 * separated by a substring. An empty
+		 * separator does not split the view.
+		 * @see split(CharT, SplitOptions)
+		 *
+		 * @param separator the separator substring
+		 * @param options split options
+		 * @return range of tokens
+		 */
+		constexpr FORCE_INLINE StringSplitRange<CharT, StringSplit_Impl::SubstringDelimiter<CharT>> split(StringViewBase separator, SplitOptions options = {}) const
+		{
+			return {*this, {separator}, options};
+		}
+
+		/**
+		 * @brief Returns a range over the tokens
+		 * separated by any of the given
+		 * characters. By default, empty tokens are
+		 * skipped, so runs of delimiters count as
+		 * one.
+		 * @see split(CharT, SplitOptions)
+		 *
+		 * ```
+		 * for (StringView word : text.tokenize(" \t\n"))
+		 * ```
+		 *
+		 * @param delimiters the set of delimiter
+		 * characters
+		 * @param options split options
+		 * @return range of tokens
+		 */
+		constexpr FORCE_INLINE StringSplitRange<CharT, StringSplit_Impl::SetDelimiter<CharT>> tokenize(StringViewBase delimiters, SplitOptions options = {.skipEmpty = true}) const
+		{
+			return {*this, {delimiters}, options};
+		}
+
+		/**
+		 * @brief Returns a range over the lines of
+		 * the view. Lines end with a line feed or
+		 * with a carriage return and a line feed,
+		 * which are not part of the line. A line
+		 * break at the end of the view does not
+		 * start an empty line.
+		 * @see split(CharT, SplitOptions)
+		 *
+		 * @param options split options
+		 * @return range of lines
+		 */
+		constexpr FORCE_INLINE StringSplitRange<CharT, StringSplit_Impl::LineDelimiter<CharT>> splitLines(SplitOptions options = {}) const
+		{
+			return {*this, {}, options};
+		}
+
+		/**
+		 * @brief Returns a range over the code
+		 * points of the view. The encoding is
+		 * given by the size of the characters:
+		 * UTF-8, UTF-16 or UTF-32. Invalid
+		 * sequences are returned as U+FFFD.
+		 *
+		 * ```
+		 * for (uint32 codePoint : text.codePoints())
+		 * ```
+		 *
+		 * @return range of code points
+		 */
+		constexpr FORCE_INLINE CodePointRange<CharT> codePoints() const
+		{
+			return {*this};
+		}
+
+		/**
+		 * @brief Lexicographically compare two
+		 * views.
+		 *
+		 * @param other another view
+		 * @return negative if this view precedes
+		 * the other view
+		 * @return positive if this view succeeds
+		 * the other view
+		 * @return zero if the views are equal
+		 */
+		constexpr int32 compare(StringViewBase const& other) const
+		{
+			sizet const minLength = PlatformMath::min(length, other.length);
+			if constexpr (sizeof(CharT) == 1)
+			{
+				// Bytes compare as unsigned values
+				if (!__builtin_is_constant_evaluated())
+				{
+					if (int32 const diff = PlatformMemory::memcmp(data, other.data, minLength))
+					{
+						return diff < 0 ? -1 : 1;
+					}
+				}
+				else for (sizet i = 0; i < minLength; ++i)
+				{
+					if (data[i] != other.data[i])
+					{
+						return static_cast<ubyte>(data[i]) < static_cast<ubyte>(other.data[i]) ? -1 : 1;
+					}
+				}
+			}
+			else for (sizet i = 0; i < minLength; ++i)
+			{
+				if (data[i] != other.data[i])
+				{
+					return data[i] < other.data[i] ? -1 : 1;
+				}
+			}
+
+			return static_cast<int32>(length > other.length) - static_cast<int32>(length < other.length);
+		}
+
+		/**
+		 * @brief Compare two views.
+		 *
+		 * @param other another view
+		 * @return true if views are equal
+		 * @return false otherwise
+		 */
+		constexpr FORCE_INLINE bool operator==(StringViewBase const& other) const
+		{
+			return length == other.length && compare(other) == 0;
+		}
+
+		/**
+		 * @brief Compare two views.
+		 *
+		 * @param other another view
+		 * @return true if views are not equal
+		 * @return false otherwise
+		 */
+		constexpr FORCE_INLINE bool operator!=(StringViewBase const& other) const
+		{
+			return !(*this == other);
+		}
+
+		/**
+		 * @brief Returns true if this view precedes
+		 * the other view in alphabetical order.
+		 */
+		constexpr FORCE_INLINE bool operator<(StringViewBase const& other) const
+		{
+			return compare(other) < 0;
+		}
+
+		/**
+		 * @brief Returns true if this view succeeds
+		 * the other view in alphabetical order.
+		 */
+		constexpr FORCE_INLINE bool operator>(StringViewBase const& other) const
+		{
+			return compare(other) > 0;
+		}
+
+		/**
+		 * @brief Returns true if this view is equal
+		 * or precedes the other view.
+		 */
+		constexpr FORCE_INLINE bool operator<=(StringViewBase const& other) const
+		{
+			return compare(other) <= 0;
+		}
+
+		/**
+		 * @brief Returns true if this view is equal
+		 * or succeeds the other view.
+		 */
+		constexpr FORCE_INLINE bool operator>=(StringViewBase const& other) const
+		{
+			return compare(other) >= 0;
+		}
+
+		/**
+		 * @brief Returns the hash key of the
+		 * characters. Strings with the same
+		 * characters have the same hash key.
+		 */
+		FORCE_INLINE HashKey toHashKey() const
+		{
+			return hashBytes(data, length * sizeof(CharT));
+		}
+
+	protected:
+		/* Ptr to the first character. */
+		CharT const* data;
+
+		/* Number of characters in the view. */
+		sizet length;
+	};
+
+	/**
+	 * @brief Iterator over the occurrences of a
+	 * substring in a string view.
+	 * @see StringViewBase::findAll
+	 *
+	 * @tparam CharT the type of the characters
+	 */
+	template<typename CharT>
+	class StringFindIterator
+	{
+		using SelfT = StringFindIterator;
+		using StringViewT = StringViewBase<CharT>;
+
+	public:
+		/**
+		 * @brief Construct an iterator that points
+		 * to the first occurrence at or after the
+		 * given index.
+		 *
+		 * @param inHaystack view to search
+		 * @param inNeedle substring to find
+		 * @param offset index where to start the
+		 * search
+		 */
+		constexpr FORCE_INLINE StringFindIterator(StringViewT inHaystack, StringViewT inNeedle, sizet offset)
+			: haystack{inHaystack}
+			, needle{inNeedle}
+			, idx{needle.isEmpty() ? -1 : haystack.find(needle, offset)}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct the end iterator.
+		 */
+		constexpr FORCE_INLINE StringFindIterator()
+			: haystack{}
+			, needle{}
+			, idx{-1}
+		{
+			//
+		}
+
+		/**
+		 * @brief Returns the index of the current
+		 * occurrence.
+		 */
+		constexpr FORCE_INLINE sizet operator*() const
+		{
+			return idx;
+		}
+
+		constexpr FORCE_INLINE bool operator==(SelfT const& other) const
+		{
+			return idx == other.idx;
+		}
+
+		constexpr FORCE_INLINE bool operator!=(SelfT const& other) const
+		{
+			return !(*this == other);
+		}
+
+		constexpr FORCE_INLINE SelfT& operator++()
+		{
+			idx = haystack.find(needle, idx + needle.getLength());
+			return *this;
+		}
+
+	protected:
+		/* View that is searched. */
+		StringViewT haystack;
+
+		/* Substring to find. */
+		StringViewT needle;
+
+		/* Index of the current occurrence, or -1 past the last one. */
+		ssizet idx;
+	};
+
+	/**
+	 * @brief Range over the occurrences of a
+	 * substring in a string view.
+	 * @see StringViewBase::findAll
+	 *
+	 * @tparam CharT the type of the characters
+	 */
+	template<typename CharT>
+	struct StringFindRange
+	{
+		using StringViewT = StringViewBase<CharT>;
+
+		/* View that is searched. */
+		StringViewT haystack;
+
+		/* Substring to find. */
+		StringViewT needle;
+
+		constexpr FORCE_INLINE StringFindIterator<CharT> begin() const
+		{
+			return {haystack, needle, 0};
+		}
+
+		constexpr FORCE_INLINE StringFindIterator<CharT> end() const
+		{
+			return {};
+		}
+	};
+
+	/**
+	 * @brief Ordering policy for string types.
+	 * Accepts any type convertible to a string
+	 * view, so that string-keyed trees can be
+	 * searched without creating a string.
+	 *
+	 * @tparam CharT the type of the characters
+	 */
+	template<typename CharT>
+	struct ChoosePolicy<StringViewBase<CharT>>
+	{
+		using Type = struct CompareString
+		{
+			using StringViewT = StringViewBase<CharT>;
+
+			/**
+			 * @brief Returns a value indicating the
+			 * ordering of two strings.
+			 *
+			 * @param x,y strings to compare
+			 * @return negative if x < y
+			 * @return positive if x > y
+			 * @return zero if x == y
+			 */
+			constexpr FORCE_INLINE int32 operator()(StringViewT x, StringViewT y) const
+			{
+				return x.compare(y);
+			}
+		};
+	};
+
+	/**
+	 * @brief Hash policy for string types.
+	 * Accepts any type convertible to a string
+	 * view, so that string-keyed hash containers
+	 * can be searched without creating a string.
+	 *
+	 * @tparam CharT the type of the characters
+	 */
+	template<typename CharT>
+	struct ChooseHashPolicy<StringViewBase<CharT>>
+	{
+		using Type = struct HashString
+		{
+			using StringViewT = StringViewBase<CharT>;
+
+			/**
+			 * @brief Returns the hash key for the given
+			 * string.
+			 *
+			 * @param key the key string to hash
+			 * @return the corresponding hash key
+			 */
+			FORCE_INLINE HashKey operator()(StringViewT key) const
+			{
+				return key.toHashKey();
+			}
+		};
+	};
+} // namespace Korin
+
+#include "string_split.h"
+#include "string_encoding.h"
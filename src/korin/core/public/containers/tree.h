@@ -692,6 +692,48 @@ namespace Korin
 		}
 		/** @} */
 
+		/**
+		 * @brief Insert all the items in the given
+		 * range.
+		 *
+		 * Items that are greater than all nodes in
+		 * the tree are linked after the last node
+		 * without searching the tree, so sorted
+		 * ranges are inserted with a single
+		 * comparison per item.
+		 *
+		 * @tparam ItT the type of the iterator
+		 * @param first,last begin and end iterators
+		 * @{
+		 */
+		template<typename ItT>
+		FORCE_INLINE void insert(ItT first, ItT last)
+		{
+			insertRange(first, last, [this](auto const& item) {
+
+				emplace(item);
+			});
+		}
+
+		template<typename ItT>
+		FORCE_INLINE void insertUnique(ItT first, ItT last)
+		{
+			insertRange(first, last, [this](auto const& item) {
+
+				emplaceUnique(item);
+			});
+		}
+
+		template<typename ItT>
+		FORCE_INLINE void findOrInsert(ItT first, ItT last)
+		{
+			insertRange(first, last, [this](auto const& item) {
+
+				findOrEmplace(item);
+			});
+		}
+		/** @} */
+
 		/**
 		 * @brief Construct a new item and inserts it into
 		 * the tree.
@@ -775,6 +817,44 @@ namespace Korin
 			return new(mem) NodeT{{FORWARD(createArgs)...}};
 		}
 
+		/**
+		 * @brief Implementation for range insertion.
+		 *
+		 * @param first,last begin and end iterators
+		 * @param insertItem callback used to insert
+		 * items that are not greater than the last
+		 * node
+		 */
+		template<typename ItT>
+		void insertRange(ItT first, ItT last, auto&& insertItem)
+		{
+			NodeT* lastNode = root ? TreeNode::getMax(root) : nullptr;
+			for (; first != last; ++first)
+			{
+				if (lastNode && PolicyT{}(*first, lastNode->value) <= 0)
+				{
+					// Search the tree, the last node may change
+					// if the item is equal to it
+					insertItem(*first);
+					for (; lastNode->next; lastNode = lastNode->next);
+					continue;
+				}
+
+				// Append after the last node
+				NodeT* node = createNode(*first);
+				if (lastNode)
+				{
+					TreeNode::Impl::insertRight(lastNode, node);
+				}
+
+				TreeNode::Impl::updatePath(node);
+				TreeNode::Impl::repair(node);
+				root = TreeNode::getRoot(root ? root : node);
+				numNodes++;
+				lastNode = node;
+			}
+		}
+
 		/**
 		 * @brief Destroy a node of the tree.
 		 *
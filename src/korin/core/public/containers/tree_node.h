@@ -82,6 +82,47 @@ namespace Korin
 
 		namespace Impl
 		{
+			/**
+			 * @brief Recompute the data a node keeps
+			 * about its subtree (e.g. its size) from
+			 * its children. Payloads that keep such
+			 * data define a method
+			 * @c update(left,right) which is called
+			 * whenever the subtree changes; for other
+			 * payloads this is a no-op.
+			 *
+			 * @tparam BaseT the node base type
+			 * @param node node to update
+			 */
+			template<typename BaseT>
+			FORCE_INLINE void updateNode(BinaryNodeBase<BaseT>* node)
+			{
+				if constexpr (requires { node->update(node->left, node->right); })
+				{
+					node->update(node->left, node->right);
+				}
+			}
+
+			/**
+			 * @brief Update a node and all its
+			 * ancestors, up to the root.
+			 * @see updateNode
+			 *
+			 * @tparam BaseT the node base type
+			 * @param node first node to update
+			 */
+			template<typename BaseT>
+			FORCE_INLINE void updatePath(BinaryNodeBase<BaseT>* node)
+			{
+				if constexpr (requires { node->update(node->left, node->right); })
+				{
+					for (; node; node = node->parent)
+					{
+						node->update(node->left, node->right);
+					}
+				}
+			}
+
 			/**
 			 * @brief Append left child to node.
 			 *
@@ -180,6 +221,10 @@ namespace Korin
 				{
 					child->parent = pivot;
 				}
+
+				// The pivot is now a child of node
+				updateNode(pivot);
+				updateNode(node);
 			}
 
 			/**
@@ -218,6 +263,10 @@ namespace Korin
 				{
 					child->parent = pivot;
 				}
+
+				// The pivot is now a child of node
+				updateNode(pivot);
+				updateNode(node);
 			}
 
 			/**
@@ -840,6 +889,7 @@ namespace Korin
 			}
 
 			// Repair the inserted node
+			Impl::updatePath(node);
 			Impl::repair(node);
 
 			// Return the new root
@@ -893,6 +943,7 @@ namespace Korin
 			}
 
 			// Repair insertion
+			Impl::updatePath(node);
 			Impl::repair(node);
 
 			// Return new root
@@ -943,6 +994,7 @@ namespace Korin
 			}
 
 			// Repair insertion
+			Impl::updatePath(node);
 			Impl::repair(node);
 
 			// Return new root
@@ -985,6 +1037,7 @@ namespace Korin
 			// or simply evict from tree
 			auto* parent = node->parent;
 			auto* repl = Impl::evictNode(node);
+			Impl::updatePath(parent);
 
 			// Repair after eviction
 			if (isBlack(node))
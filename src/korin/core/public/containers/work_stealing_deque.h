@@ -0,0 +1,305 @@
+#pragma once
+
+#include "containers_types.h"
+#include "templates/types.h"
+#include "hal/platform_memory.h"
+#include "hal/platform_math.h"
+#include "hal/atomic.h"
+
+namespace Korin
+{
+	namespace WorkStealingDeque_Impl
+	{
+		/**
+		 * @brief Circular storage of a work-stealing
+		 * deque. Buffers are never freed while the
+		 * deque is alive, because thieves may still
+		 * be reading from an old buffer after the
+		 * owner replaced it.
+		 */
+		template<typename T>
+		struct Buffer
+		{
+			/* Number of items in the buffer, a power of two. */
+			sizet capacity;
+
+			/* Previous (smaller) buffer, if any. */
+			Buffer* prev;
+
+			/**
+			 * @brief Returns a ptr to the first item.
+			 */
+			FORCE_INLINE T* getItems()
+			{
+				return reinterpret_cast<T*>(this + 1);
+			}
+
+			/**
+			 * @brief Atomically read the item at the
+			 * given position.
+			 */
+			FORCE_INLINE T get(int64 pos)
+			{
+				return PlatformAtomics::load(getItems() + (pos & (capacity - 1)), MemoryOrder::Relaxed);
+			}
+
+			/**
+			 * @brief Atomically write the item at the
+			 * given position.
+			 */
+			FORCE_INLINE void put(int64 pos, T item)
+			{
+				PlatformAtomics::store(getItems() + (pos & (capacity - 1)), item, MemoryOrder::Relaxed);
+			}
+
+			/**
+			 * @brief Allocate a new buffer.
+			 *
+			 * @param capacity number of items, must be
+			 * a power of two
+			 * @param prev previous buffer
+			 * @return ptr to new buffer
+			 */
+			static Buffer* create(sizet capacity, Buffer* prev)
+			{
+				static_assert(sizeof(Buffer) % alignof(T) == 0, "Items are not aligned");
+
+				Buffer* buffer = reinterpret_cast<Buffer*>(gMalloc->malloc(sizeof(Buffer) + capacity * sizeof(T), PLATFORM_CACHE_LINE_SIZE));
+				buffer->capacity = capacity;
+				buffer->prev = prev;
+				return buffer;
+			}
+		};
+	} // namespace WorkStealingDeque_Impl
+
+	/**
+	 * @brief A Chase-Lev work-stealing deque.
+	 *
+	 * The owner thread pushes and pops items at
+	 * the bottom of the deque like a stack, while
+	 * any other thread can steal items from the
+	 * top. The owner operations never block and
+	 * only synchronize with thieves when the deque
+	 * has at most one item left.
+	 *
+	 * The storage is circular and grows on demand.
+	 * Since thieves may still be reading from the
+	 * old storage, it is only released when the
+	 * deque is destroyed.
+	 *
+	 * Memory orderings follow Lê et al., "Correct
+	 * and Efficient Work-Stealing for Weak Memory
+	 * Models" (PPoPP 2013).
+	 *
+	 * @tparam T the type of the items, either an
+	 * integer or a pointer (e.g. to a job)
+	 */
+	template<typename T>
+	class WorkStealingDeque
+	{
+		static_assert(IsIntegral<T>::value || IsPointer<T>::value, "Items must be integers or pointers");
+
+		using BufferT = WorkStealingDeque_Impl::Buffer<T>;
+
+		/**
+		 * @brief Replace the buffer with one twice
+		 * as large, copying the live items.
+		 *
+		 * @param oldBuffer current buffer
+		 * @param t position of the top item
+		 * @param b position past the bottom item
+		 * @return the new buffer
+		 */
+		BufferT* grow(BufferT* oldBuffer, int64 t, int64 b)
+		{
+			BufferT* newBuffer = BufferT::create(oldBuffer->capacity * 2, oldBuffer);
+			for (int64 i = t; i < b; ++i)
+			{
+				newBuffer->put(i, oldBuffer->get(i));
+			}
+
+			buffer.store(newBuffer, MemoryOrder::Release);
+			return newBuffer;
+		}
+
+	public:
+		/**
+		 * @brief Construct an empty deque.
+		 *
+		 * @param minCapacity initial capacity,
+		 * rounded up to a power of two
+		 */
+		explicit WorkStealingDeque(sizet minCapacity = 64)
+			: top{0}
+			, bottom{0}
+			, buffer{BufferT::create(PlatformMath::roundUpToPowerOfTwo(PlatformMath::max(minCapacity, sizet(2))), nullptr)}
+		{
+			//
+		}
+
+		/**
+		 * @brief Deques are shared by many threads
+		 * and cannot be copied or moved.
+		 * @{
+		 */
+		WorkStealingDeque(WorkStealingDeque const&) = delete;
+		WorkStealingDeque& operator=(WorkStealingDeque const&) = delete;
+		/** @} */
+
+		/**
+		 * @brief Release all buffers. No thread may
+		 * access the deque anymore.
+		 */
+		~WorkStealingDeque()
+		{
+			for (BufferT* it = buffer.load(MemoryOrder::Relaxed); it;)
+			{
+				BufferT* prev = it->prev;
+				gMalloc->free(it);
+				it = prev;
+			}
+		}
+
+		/**
+		 * @brief Returns the current capacity of
+		 * the deque.
+		 */
+		FORCE_INLINE sizet getCapacity() const
+		{
+			return buffer.load(MemoryOrder::Relaxed)->capacity;
+		}
+
+		/**
+		 * @brief Returns the approximate number of
+		 * items in the deque.
+		 */
+		FORCE_INLINE sizet getNumItems() const
+		{
+			int64 const b = bottom.load(MemoryOrder::Relaxed);
+			int64 const t = top.load(MemoryOrder::Relaxed);
+			return b > t ? b - t : 0;
+		}
+
+		/**
+		 * @brief Returns true if the deque is
+		 * approximately empty.
+		 */
+		FORCE_INLINE bool isEmpty() const
+		{
+			return getNumItems() == 0;
+		}
+
+		/**
+		 * @brief Push an item at the bottom of the
+		 * deque. Owner only.
+		 *
+		 * @param item item to push
+		 */
+		void push(T item)
+		{
+			int64 const b = bottom.load(MemoryOrder::Relaxed);
+			int64 const t = top.load(MemoryOrder::Acquire);
+			BufferT* a = buffer.load(MemoryOrder::Relaxed);
+
+			if (UNLIKELY(b - t > static_cast<int64>(a->capacity) - 1))
+			{
+				// Deque is full
+				a = grow(a, t, b);
+			}
+
+			a->put(b, item);
+
+			// Publish item to thieves
+			PlatformAtomics::threadFence(MemoryOrder::Release);
+			bottom.store(b + 1, MemoryOrder::Relaxed);
+		}
+
+		/**
+		 * @brief Pop the item at the bottom of the
+		 * deque. Owner only.
+		 *
+		 * @param outItem item that receives the
+		 * popped item, untouched on failure
+		 * @return true if an item was popped,
+		 * false if the deque is empty or a thief
+		 * took the last item
+		 */
+		bool tryPop(T& outItem)
+		{
+			int64 const b = bottom.load(MemoryOrder::Relaxed) - 1;
+			BufferT* a = buffer.load(MemoryOrder::Relaxed);
+
+			// Reserve the bottom item before reading top
+			bottom.store(b, MemoryOrder::Relaxed);
+			PlatformAtomics::threadFence(MemoryOrder::SequentiallyConsistent);
+			int64 t = top.load(MemoryOrder::Relaxed);
+
+			if (t > b)
+			{
+				// Deque is empty, restore bottom
+				bottom.store(b + 1, MemoryOrder::Relaxed);
+				return false;
+			}
+
+			T const item = a->get(b);
+			if (t == b)
+			{
+				// Last item, race against thieves
+				bool const won = top.compareExchange(t, t + 1, MemoryOrder::SequentiallyConsistent, MemoryOrder::Relaxed);
+				bottom.store(b + 1, MemoryOrder::Relaxed);
+				if (!won)
+				{
+					// A thief took it
+					return false;
+				}
+			}
+
+			outItem = item;
+			return true;
+		}
+
+		/**
+		 * @brief Steal the item at the top of the
+		 * deque. Any thread.
+		 *
+		 * Fails if the deque is empty or if
+		 * another thread took the item first.
+		 *
+		 * @param outItem item that receives the
+		 * stolen item
+		 * @return true if an item was stolen
+		 */
+		bool trySteal(T& outItem)
+		{
+			int64 t = top.load(MemoryOrder::Acquire);
+			PlatformAtomics::threadFence(MemoryOrder::SequentiallyConsistent);
+			int64 const b = bottom.load(MemoryOrder::Acquire);
+
+			if (t >= b)
+			{
+				return false;
+			}
+
+			// Read the item before claiming it, the buffer may be replaced after the claim
+			BufferT* a = buffer.load(MemoryOrder::Acquire);
+			T const item = a->get(t);
+			if (!top.compareExchange(t, t + 1, MemoryOrder::SequentiallyConsistent, MemoryOrder::Relaxed))
+			{
+				return false;
+			}
+
+			outItem = item;
+			return true;
+		}
+
+	protected:
+		/* Position of the top item, incremented by thieves. */
+		alignas(PLATFORM_CACHE_LINE_SIZE) Atomic<int64> top;
+
+		/* Position past the bottom item, written by the owner. */
+		alignas(PLATFORM_CACHE_LINE_SIZE) Atomic<int64> bottom;
+
+		/* Current circular buffer. */
+		Atomic<BufferT*> buffer;
+	};
+} // namespace Korin
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "hal/platform.h"
+
+/**
+ * @brief Memory ordering constraints of an
+ * atomic operation.
+ */
+enum class MemoryOrder : int32
+{
+	Relaxed = __ATOMIC_RELAXED,
+	Consume = __ATOMIC_CONSUME,
+	Acquire = __ATOMIC_ACQUIRE,
+	Release = __ATOMIC_RELEASE,
+	AcquireRelease = __ATOMIC_ACQ_REL,
+	SequentiallyConsistent = __ATOMIC_SEQ_CST
+};
+
+/**
+ * @brief Atomics abstraction layer.
+ *
+ * All operations work on naturally aligned
+ * integers and pointers of up to 8 Bytes.
+ * The generic implementation relies on the
+ * compiler atomic builtins, which are
+ * available on all supported compilers.
+ */
+struct GenericPlatformAtomics
+{
+	/**
+	 * @brief Atomically load a value.
+	 *
+	 * @param src ptr to the value
+	 * @param order memory ordering
+	 * @return loaded value
+	 */
+	template<typename T>
+	static FORCE_INLINE T load(T const* src, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_load_n(src, static_cast<int32>(order));
+	}
+
+	/**
+	 * @brief Atomically store a value.
+	 *
+	 * @param dst ptr to the value
+	 * @param value value to store
+	 * @param order memory ordering
+	 */
+	template<typename T>
+	static FORCE_INLINE void store(T* dst, T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+	{
+		__atomic_store_n(dst, value, static_cast<int32>(order));
+	}
+
+	/**
+	 * @brief Atomically replace a value and
+	 * return the previous one.
+	 *
+	 * @param dst ptr to the value
+	 * @param value new value
+	 * @param order memory ordering
+	 * @return previous value
+	 */
+	template<typename T>
+	static FORCE_INLINE T exchange(T* dst, T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_exchange_n(dst, value, static_cast<int32>(order));
+	}
+
+	/**
+	 * @brief Atomically replace the value with
+	 * the desired value if it's equal to the
+	 * expected value. Otherwise, write the
+	 * current value in expected.
+	 *
+	 * The weak version may fail spuriously,
+	 * and should be used in loops.
+	 *
+	 * @param dst ptr to the value
+	 * @param expected ref to expected value
+	 * @param desired value to write
+	 * @param success memory ordering if the
+	 * value is replaced
+	 * @param failure memory ordering if the
+	 * comparison fails
+	 * @return true if the value was replaced
+	 * @{
+	 */
+	template<typename T>
+	static FORCE_INLINE bool compareExchange(T* dst, T& expected, T desired, MemoryOrder success = MemoryOrder::SequentiallyConsistent, MemoryOrder failure = MemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_compare_exchange_n(dst, &expected, desired, false, static_cast<int32>(success), static_cast<int32>(failure));
+	}
+
+	template<typename T>
+	static FORCE_INLINE bool compareExchangeWeak(T* dst, T& expected, T desired, MemoryOrder success = MemoryOrder::SequentiallyConsistent, MemoryOrder failure = MemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_compare_exchange_n(dst, &expected, desired, true, static_cast<int32>(success), static_cast<int32>(failure));
+	}
+	/** @} */
+
+	/**
+	 * @brief Atomically add to a value and
+	 * return the previous value.
+	 */
+	template<typename T, typename U>
+	static FORCE_INLINE T fetchAdd(T* dst, U value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_add(dst, value, static_cast<int32>(order));
+	}
+
+	/**
+	 * @brief Atomically subtract from a value
+	 * and return the previous value.
+	 */
+	template<typename T, typename U>
+	static FORCE_INLINE T fetchSub(T* dst, U value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_sub(dst, value, static_cast<int32>(order));
+	}
+
+	/**
+	 * @brief Atomically or a value and return
+	 * the previous value.
+	 */
+	template<typename T>
+	static FORCE_INLINE T fetchOr(T* dst, T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_or(dst, value, static_cast<int32>(order));
+	}
+
+	/**
+	 * @brief Atomically and a value and return
+	 * the previous value.
+	 */
+	template<typename T>
+	static FORCE_INLINE T fetchAnd(T* dst, T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_and(dst, value, static_cast<int32>(order));
+	}
+
+	/**
+	 * @brief Issue a memory fence.
+	 *
+	 * @param order memory ordering
+	 */
+	static FORCE_INLINE void threadFence(MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+	{
+		__atomic_thread_fence(static_cast<int32>(order));
+	}
+
+	/**
+	 * @brief Hint the processor that the
+	 * calling thread is busy waiting.
+	 */
+	static FORCE_INLINE void yieldProcessor()
+	{
+		//
+	}
+
+	/**
+	 * @brief Block the calling thread while the
+	 * value at the given address is equal to the
+	 * expected value.
+	 *
+	 * The call may return spuriously, callers
+	 * must check their condition in a loop. The
+	 * generic implementation never blocks.
+	 *
+	 * @param addr ptr to the value
+	 * @param expected expected value
+	 */
+	static FORCE_INLINE void wait(uint32 const* addr, uint32 expected)
+	{
+		(void)addr;
+		(void)expected;
+		GenericPlatformAtomics::yieldProcessor();
+	}
+
+	/**
+	 * @brief Wake one thread waiting on the
+	 * given address.
+	 *
+	 * @param addr ptr to the value
+	 */
+	static FORCE_INLINE void wakeOne(uint32 const* addr)
+	{
+		(void)addr;
+	}
+
+	/**
+	 * @brief Wake all threads waiting on the
+	 * given address.
+	 *
+	 * @param addr ptr to the value
+	 */
+	static FORCE_INLINE void wakeAll(uint32 const* addr)
+	{
+		(void)addr;
+	}
+};
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "hal/platform.h"
+
+/**
+ * @brief Math abstraction layer.
+ *
+ * Generic implementations are portable, the
+ * platform layers replace them with compiler
+ * intrinsics where available.
+ */
+struct GenericPlatformMath
+{
+	/**
+	 * @brief Returns the smallest of two values.
+	 */
+	template<typename T>
+	static constexpr FORCE_INLINE T min(T const& a, T const& b)
+	{
+		return a < b ? a : b;
+	}
+
+	/**
+	 * @brief Returns the largest of two values.
+	 */
+	template<typename T>
+	static constexpr FORCE_INLINE T max(T const& a, T const& b)
+	{
+		return a > b ? a : b;
+	}
+
+	/**
+	 * @brief Returns true if the given value is
+	 * a power of two. Zero is not a power of
+	 * two.
+	 */
+	static constexpr FORCE_INLINE bool isPowerOfTwo(uint64 x)
+	{
+		return x && (x & (x - 1)) == 0;
+	}
+
+	/**
+	 * @brief Returns the number of leading zero
+	 * bits. Returns 64 if the value is zero.
+	 */
+	static constexpr FORCE_INLINE uint32 countLeadingZeros(uint64 x)
+	{
+		uint32 n = 64;
+		for (; x; x >>= 1, --n);
+		return n;
+	}
+
+	/**
+	 * @brief Returns the number of trailing zero
+	 * bits. Returns 64 if the value is zero.
+	 */
+	static constexpr FORCE_INLINE uint32 countTrailingZeros(uint64 x)
+	{
+		if (x == 0)
+		{
+			return 64;
+		}
+
+		uint32 n = 0;
+		for (; (x & 1) == 0; x >>= 1, ++n);
+		return n;
+	}
+
+	/**
+	 * @brief Returns the number of set bits.
+	 */
+	static constexpr FORCE_INLINE uint32 popCount(uint64 x)
+	{
+		x = x - ((x >> 1) & 0x5555555555555555ull);
+		x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+		x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+		return (x * 0x0101010101010101ull) >> 56;
+	}
+
+	/**
+	 * @brief Returns the number of set bits of
+	 * an array of words.
+	 */
+	static constexpr FORCE_INLINE sizet countBits(uint64 const* src, sizet n)
+	{
+		sizet count = 0;
+		for (sizet i = 0; i < n; ++i)
+		{
+			count += popCount(src[i]);
+		}
+
+		return count;
+	}
+
+	/**
+	 * @brief Applies a bitwise operation to
+	 * two arrays of words and writes the
+	 * result in the first one. The arrays
+	 * must not overlap.
+	 *
+	 * @param dst ptr to the first operand and
+	 * the result
+	 * @param src ptr to the second operand
+	 * @param n number of words
+	 * @{
+	 */
+	static constexpr FORCE_INLINE void andBits(uint64* RESTRICT dst, uint64 const* RESTRICT src, sizet n)
+	{
+		for (sizet i = 0; i < n; ++i)
+		{
+			dst[i] &= src[i];
+		}
+	}
+
+	static constexpr FORCE_INLINE void orBits(uint64* RESTRICT dst, uint64 const* RESTRICT src, sizet n)
+	{
+		for (sizet i = 0; i < n; ++i)
+		{
+			dst[i] |= src[i];
+		}
+	}
+
+	static constexpr FORCE_INLINE void xorBits(uint64* RESTRICT dst, uint64 const* RESTRICT src, sizet n)
+	{
+		for (sizet i = 0; i < n; ++i)
+		{
+			dst[i] ^= src[i];
+		}
+	}
+
+	static constexpr FORCE_INLINE void andNotBits(uint64* RESTRICT dst, uint64 const* RESTRICT src, sizet n)
+	{
+		for (sizet i = 0; i < n; ++i)
+		{
+			dst[i] &= ~src[i];
+		}
+	}
+	/** @} */
+
+	/**
+	 * @brief Returns the base 2 logarithm of the
+	 * value, rounded down. The value must not be
+	 * zero.
+	 */
+	static constexpr FORCE_INLINE uint32 floorLog2(uint64 x)
+	{
+		return 63 - countLeadingZeros(x);
+	}
+
+	/**
+	 * @brief Returns the smallest power of two
+	 * greater than or equal to the value.
+	 * Returns 1 if the value is zero.
+	 */
+	static constexpr FORCE_INLINE uint64 roundUpToPowerOfTwo(uint64 x)
+	{
+		return x <= 1 ? 1 : 1ull << (64 - countLeadingZeros(x - 1));
+	}
+
+	/**
+	 * @brief Returns the high 64 bits of the
+	 * 128-bit product of two values, and
+	 * writes the low 64 bits.
+	 */
+	static constexpr FORCE_INLINE uint64 mulHigh(uint64 a, uint64 b, uint64& low)
+	{
+		uint64 const aLo = a & 0xffffffffull, aHi = a >> 32;
+		uint64 const bLo = b & 0xffffffffull, bHi = b >> 32;
+		uint64 const ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+		uint64 const mid = (ll >> 32) + (lh & 0xffffffffull) + (hl & 0xffffffffull);
+
+		low = (mid << 32) | (ll & 0xffffffffull);
+		return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+	}
+};
@@ -32,4 +32,18 @@ struct GenericPlatformMemory
 	{
 		::memmove(dst, src, size);
 	}
+
+	/**
+	 * @brief Compare two buffers Byte by Byte.
+	 *
+	 * @param lhs,rhs ptrs to buffers
+	 * @param size number of Bytes to compare
+	 * @return difference of the first
+	 * non-equal Bytes, as unsigned values
+	 * @return zero if buffers are equal
+	 */
+	static FORCE_INLINE int32 memcmp(void const* lhs, void const* rhs, sizet size)
+	{
+		return ::memcmp(lhs, rhs, size);
+	}
 };
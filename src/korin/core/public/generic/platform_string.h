@@ -1,13 +1,44 @@
 #pragma once
 
 #include "core_types.h"
+#include "hal/platform_crt.h"
+#include "templates/types.h"
+#include "hal/platform_math.h"
 
 /**
  * @brief String abstraction layer.
  */
 struct GenericPlatformString
 {
-#define ICMP(x, y) ((x) == (y) || ((x) - 'a' == (y) - 'A') || ((x) - 'A' == (y) - 'a'))
+	/**
+	 * @brief Returns the lower case version of
+	 * an ASCII character. Other characters are
+	 * returned as-is.
+	 *
+	 * @tparam CharT type of the character
+	 * @param c the character
+	 * @return lower case character
+	 */
+	template<typename CharT>
+	static constexpr FORCE_INLINE CharT toLower(CharT c)
+	{
+		return c >= CharT{'A'} && c <= CharT{'Z'} ? c - CharT{'A'} + CharT{'a'} : c;
+	}
+
+	/**
+	 * @brief Returns the upper case version of
+	 * an ASCII character. Other characters are
+	 * returned as-is.
+	 *
+	 * @tparam CharT type of the character
+	 * @param c the character
+	 * @return upper case character
+	 */
+	template<typename CharT>
+	static constexpr FORCE_INLINE CharT toUpper(CharT c)
+	{
+		return c >= CharT{'a'} && c <= CharT{'z'} ? c - CharT{'a'} + CharT{'A'} : c;
+	}
 
 	/**
 	 * @brief Returns the length of a
@@ -37,12 +68,12 @@ struct GenericPlatformString
 	 * @return zero if strings are equal
 	 */
 	template<typename CharT>
-	static constexpr FORCE_INLINE CharT cmp(CharT* lhs, CharT* rhs)
+	static constexpr FORCE_INLINE int32 cmp(CharT* lhs, CharT* rhs)
 	{
 		ASSERT(lhs != nullptr)
 		ASSERT(rhs != nullptr)
 		for (; *lhs == *rhs && *lhs != CharT{0}; ++rhs, ++lhs);
-		return *lhs - *rhs;
+		return charDiff(*lhs, *rhs);
 	}
 
 	/**
@@ -58,12 +89,12 @@ struct GenericPlatformString
 	 * n-th character
 	 */
 	template<typename CharT>
-	static constexpr FORCE_INLINE CharT cmpn(CharT* lhs, CharT* rhs, sizet n)
+	static constexpr FORCE_INLINE int32 cmpn(CharT* lhs, CharT* rhs, sizet n)
 	{
 		ASSERT(lhs != nullptr)
 		ASSERT(rhs != nullptr)
-		sizet i = 0; for (; lhs[i] == rhs[i] && i < n; ++i);
-		return lhs[i] - rhs[i];
+		sizet i = 0; for (; i < n && lhs[i] == rhs[i] && lhs[i] != CharT{0}; ++i);
+		return i < n ? charDiff(lhs[i], rhs[i]) : 0;
 	}
 
 	/**
@@ -74,17 +105,17 @@ struct GenericPlatformString
 	 * @tparam CharT the type of the characters
 	 * @param lhs,rhs strings to compare
 	 * @return difference of first non-equal
-	 * characters
+	 * lower case characters
 	 * @return zero if strings are equal,
 	 * redargless of case
 	 */
 	template<typename CharT>
-	static constexpr FORCE_INLINE CharT icmp(CharT* lhs, CharT* rhs)
+	static constexpr FORCE_INLINE int32 icmp(CharT* lhs, CharT* rhs)
 	{
 		ASSERT(lhs != nullptr)
 		ASSERT(rhs != nullptr)
-		for (; ICMP(*lhs, *rhs) && *lhs != CharT{0}; ++rhs, ++lhs);
-		return *lhs - *rhs; // FIXME: Difference between different cases
+		for (; toLower(*lhs) == toLower(*rhs) && *lhs != CharT{0}; ++rhs, ++lhs);
+		return charDiff(toLower(*lhs), toLower(*rhs));
 	}
 
 	/**
@@ -95,18 +126,604 @@ struct GenericPlatformString
 	 * @param lhs,rhs strings to compare
 	 * @param n max number of characters to read
 	 * @return difference of first non-equal
-	 * characters
+	 * lower case characters
 	 * @return zero if strings are equal up to
 	 * n-th character, redargless of case
 	 */
 	template<typename CharT>
-	static constexpr FORCE_INLINE CharT icmpn(CharT* lhs, CharT* rhs, sizet n)
+	static constexpr FORCE_INLINE int32 icmpn(CharT* lhs, CharT* rhs, sizet n)
 	{
 		ASSERT(lhs != nullptr)
 		ASSERT(rhs != nullptr)
-		sizet i = 0; for (; ICMP(lhs[i], rhs[i]) && i < n; ++i);
-		return lhs[i] - rhs[i];
+		sizet i = 0; for (; i < n && toLower(lhs[i]) == toLower(rhs[i]) && lhs[i] != CharT{0}; ++i);
+		return i < n ? charDiff(toLower(lhs[i]), toLower(rhs[i])) : 0;
+	}
+
+	/**
+	 * @brief Returns a ptr to the first
+	 * occurrence of a character in a
+	 * null-terminated string. The terminating
+	 * character can be searched too.
+	 *
+	 * @tparam CharT the type of the characters
+	 * @param cstr pointer to C string
+	 * @param c the character to find
+	 * @return ptr to first occurrence
+	 * @return nullptr if not found
+	 */
+	template<typename CharT>
+	static constexpr FORCE_INLINE CharT* chr(CharT* cstr, typename RemoveCV<CharT>::Type c)
+	{
+		ASSERT(cstr != nullptr)
+		for (; *cstr != c; ++cstr) if (*cstr == CharT{0}) return nullptr;
+		return cstr;
+	}
+
+	/**
+	 * @brief Returns a ptr to the first
+	 * occurrence of a character in the first
+	 * @c n characters of a buffer. Does not
+	 * stop at null characters.
+	 *
+	 * @tparam CharT the type of the characters
+	 * @param src ptr to the buffer
+	 * @param n number of characters to search
+	 * @param c the character to find
+	 * @return ptr to first occurrence
+	 * @return nullptr if not found
+	 */
+	template<typename CharT>
+	static constexpr FORCE_INLINE CharT* chrn(CharT* src, sizet n, typename RemoveCV<CharT>::Type c)
+	{
+		for (sizet i = 0; i < n; ++i) if (src[i] == c) return src + i;
+		return nullptr;
+	}
+
+	/**
+	 * @brief Like @c chrn but returns a ptr to
+	 * the last occurrence.
+	 *
+	 * @tparam CharT the type of the characters
+	 * @param src ptr to the buffer
+	 * @param n number of characters to search
+	 * @param c the character to find
+	 * @return ptr to last occurrence
+	 * @return nullptr if not found
+	 */
+	template<typename CharT>
+	static constexpr FORCE_INLINE CharT* rchrn(CharT* src, sizet n, typename RemoveCV<CharT>::Type c)
+	{
+		for (sizet i = n; i > 0; --i) if (src[i - 1] == c) return src + i - 1;
+		return nullptr;
+	}
+
+	/**
+	 * @brief Returns the number of leading
+	 * characters of a buffer that belong to
+	 * the given set. Does not stop at null
+	 * characters.
+	 *
+	 * @tparam CharT the type of the characters
+	 * @param src ptr to the buffer
+	 * @param n number of characters to scan
+	 * @param set ptr to the characters of the
+	 * set
+	 * @param setLen number of characters in
+	 * the set
+	 * @return length of the leading span
+	 */
+	template<typename CharT>
+	static constexpr FORCE_INLINE sizet spn(CharT* src, sizet n, typename RemoveCV<CharT>::Type const* set, sizet setLen)
+	{
+		sizet i = 0; for (; i < n && chrn(set, setLen, src[i]); ++i);
+		return i;
+	}
+
+	/**
+	 * @brief Returns the number of leading
+	 * characters of a buffer that do not
+	 * belong to the given set. Does not stop
+	 * at null characters.
+	 *
+	 * @tparam CharT the type of the characters
+	 * @param src ptr to the buffer
+	 * @param n number of characters to scan
+	 * @param set ptr to the characters of the
+	 * set
+	 * @param setLen number of characters in
+	 * the set
+	 * @return length of the leading span
+	 */
+	template<typename CharT>
+	static constexpr FORCE_INLINE sizet cspn(CharT* src, sizet n, typename RemoveCV<CharT>::Type const* set, sizet setLen)
+	{
+		sizet i = 0; for (; i < n && !chrn(set, setLen, src[i]); ++i);
+		return i;
+	}
+
+	/**
+	 * @brief Returns a bit mask of the first
+	 * min(n, 64) characters of a buffer, where
+	 * the i-th bit is set if the i-th
+	 * character belongs to the given set.
+	 * Does not stop at null characters.
+	 *
+	 * Scanning 64 characters at a time makes
+	 * it cheap to find many delimiters close
+	 * to each other.
+	 *
+	 * @tparam CharT the type of the characters
+	 * @param src ptr to the buffer
+	 * @param n number of characters to scan
+	 * @param set ptr to the characters of the
+	 * set
+	 * @param setLen number of characters in
+	 * the set
+	 * @return mask of the characters in the set
+	 */
+	template<typename CharT>
+	static constexpr FORCE_INLINE uint64 setMask(CharT* src, sizet n, typename RemoveCV<CharT>::Type const* set, sizet setLen)
+	{
+		uint64 mask = 0;
+		for (sizet i = 0, len = n < 64 ? n : 64; i < len; ++i)
+		{
+			mask |= uint64(chrn(set, setLen, src[i]) != nullptr) << i;
+		}
+
+		return mask;
+	}
+
+	/**
+	 * @brief Returns a ptr to the first
+	 * occurrence of a substring in the first
+	 * @c n characters of a buffer. Does not
+	 * stop at null characters.
+	 *
+	 * Uses the Two-Way algorithm, which runs in
+	 * linear time and constant space.
+	 *
+	 * @tparam CharT the type of the characters
+	 * @param src ptr to the buffer
+	 * @param n number of characters to search
+	 * @param needle ptr to the substring
+	 * @param m length of the substring
+	 * @return ptr to first occurrence
+	 * @return nullptr if not found
+	 */
+	template<typename CharT>
+	static constexpr FORCE_INLINE CharT* findn(CharT* src, sizet n, typename RemoveCV<CharT>::Type const* needle, sizet m)
+	{
+		if (m > n) return nullptr;
+		if (m == 0) return src;
+		if (m == 1) return chrn(src, n, *needle);
+		sizet const i = twoWay<false>(src, n, needle, m);
+		return i < n ? src + i : nullptr;
+	}
+
+	/**
+	 * @brief Like @c findn but returns a ptr to
+	 * the last occurrence.
+	 *
+	 * @tparam CharT the type of the characters
+	 * @param src ptr to the buffer
+	 * @param n number of characters to search
+	 * @param needle ptr to the substring
+	 * @param m length of the substring
+	 * @return ptr to last occurrence
+	 * @return nullptr if not found
+	 */
+	template<typename CharT>
+	static constexpr FORCE_INLINE CharT* rfindn(CharT* src, sizet n, typename RemoveCV<CharT>::Type const* needle, sizet m)
+	{
+		if (m > n) return nullptr;
+		if (m == 0) return src + n;
+		if (m == 1) return rchrn(src, n, *needle);
+		sizet const i = twoWay<true>(src, n, needle, m);
+		return i < n ? src + i : nullptr;
+	}
+
+	/**
+	 * @brief Decodes the UTF-8 sequence at the
+	 * start of a buffer.
+	 *
+	 * Overlong encodings, surrogates, code
+	 * points beyond U+10FFFF and truncated
+	 * sequences are invalid. The length of an
+	 * invalid sequence is the length of its
+	 * maximal subpart, i.e. the longest prefix
+	 * of a valid sequence, or 1, as the
+	 * Unicode standard recommends when they are
+	 * replaced with U+FFFD.
+	 *
+	 * @param src ptr to the buffer
+	 * @param n number of Bytes in the buffer,
+	 * at least 1
+	 * @param codePoint decoded code point
+	 * @return length of the sequence
+	 * @return minus the length of the sequence
+	 * if it is not valid
+	 */
+	static constexpr FORCE_INLINE int32 decodeUtf8(ansichar const* src, sizet n, uint32& codePoint)
+	{
+		uint32 const lead = static_cast<ubyte>(src[0]);
+		if (lead < 0x80)
+		{
+			codePoint = lead;
+			return 1;
+		}
+
+		// Valid lead Bytes are in [C2, F4]
+		if (lead < 0xc2 || lead > 0xf4) return -1;
+		int32 const len = lead < 0xe0 ? 2 : lead < 0xf0 ? 3 : 4;
+
+		// Second Byte ranges exclude overlong
+		// encodings, surrogates and code points
+		// beyond U+10FFFF
+		uint32 const low = lead == 0xe0 ? 0xa0 : lead == 0xf0 ? 0x90 : 0x80;
+		uint32 const high = lead == 0xed ? 0x9f : lead == 0xf4 ? 0x8f : 0xbf;
+
+		codePoint = lead & (0x7f >> len);
+		for (int32 i = 1; i < len; ++i)
+		{
+			uint32 const c = i < static_cast<int32>(n) ? static_cast<ubyte>(src[i]) : 0;
+			if (i == 1 ? c < low || c > high : (c & 0xc0) != 0x80) return -i;
+			codePoint = codePoint << 6 | (c & 0x3f);
+		}
+
+		return len;
+	}
+
+	/**
+	 * @brief Returns the index of the first
+	 * invalid UTF-8 sequence in a buffer.
+	 *
+	 * @param src ptr to the buffer
+	 * @param n number of Bytes to validate
+	 * @return index of the first invalid
+	 * sequence
+	 * @return n if the buffer is valid UTF-8
+	 */
+	static constexpr FORCE_INLINE sizet validateUtf8(ansichar const* src, sizet n)
+	{
+		uint32 codePoint = 0;
+		for (sizet i = 0; i < n;)
+		{
+			int32 const len = decodeUtf8(src + i, n - i, codePoint);
+			if (len < 0) return i;
+			i += len;
+		}
+
+		return n;
+	}
+
+	/**
+	 * @brief Returns the value of a hex digit,
+	 * in either case.
+	 *
+	 * @param c the character
+	 * @return value of the digit
+	 * @return -1 if not a hex digit
+	 */
+	static constexpr FORCE_INLINE int32 decodeHexChar(ansichar c)
+	{
+		uint32 const digit = static_cast<ubyte>(c) - uint32('0');
+		uint32 const letter = (static_cast<ubyte>(c) | 0x20) - uint32('a');
+		return digit < 10 ? int32(digit) : letter < 6 ? int32(letter + 10) : -1;
+	}
+
+	/**
+	 * @brief Write the hex digits of a buffer,
+	 * two per Byte, high digit first.
+	 *
+	 * @param src ptr to the Bytes
+	 * @param n number of Bytes
+	 * @param dst ptr to a buffer with room for
+	 * 2n characters
+	 * @param upperCase whether to write digits
+	 * above 9 in upper case
+	 */
+	static constexpr FORCE_INLINE void encodeHex(ubyte const* src, sizet n, ansichar* dst, bool upperCase)
+	{
+		ansichar const* const digits = upperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+		for (sizet i = 0; i < n; ++i)
+		{
+			dst[2 * i] = digits[src[i] >> 4];
+			dst[2 * i + 1] = digits[src[i] & 0x0f];
+		}
+	}
+
+	/**
+	 * @brief Read the Bytes encoded by pairs of
+	 * hex digits, in either case.
+	 *
+	 * @param src ptr to the digits
+	 * @param n number of digits, must be even
+	 * @param dst ptr to a buffer with room for
+	 * n / 2 Bytes
+	 * @return index of the first character that
+	 * is not a hex digit
+	 * @return n if all the characters are valid
+	 */
+	static constexpr FORCE_INLINE sizet decodeHex(ansichar const* src, sizet n, ubyte* dst)
+	{
+		KORIN_ASSERTF(n % 2 == 0, "Odd number of hex digits (%llu)", n)
+
+		for (sizet i = 0; i < n; i += 2)
+		{
+			int32 const high = decodeHexChar(src[i]);
+			int32 const low = decodeHexChar(src[i + 1]);
+			if ((high | low) < 0) return high < 0 ? i : i + 1;
+			dst[i / 2] = static_cast<ubyte>(high << 4 | low);
+		}
+
+		return n;
+	}
+
+	/**
+	 * @brief Returns the 64 characters of a
+	 * base64 alphabet. The URL-safe alphabet
+	 * has - and _ instead of + and /.
+	 */
+	static constexpr FORCE_INLINE ansichar const* getBase64Alphabet(bool urlSafe)
+	{
+		return urlSafe
+			? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+			: "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	}
+
+	/**
+	 * @brief Returns the value of a base64
+	 * character.
+	 *
+	 * @param c the character
+	 * @param urlSafe whether to use the
+	 * URL-safe alphabet
+	 * @return value of the character
+	 * @return -1 if not in the alphabet
+	 */
+	static constexpr FORCE_INLINE int32 decodeBase64Char(ansichar c, bool urlSafe)
+	{
+		uint32 const u = static_cast<ubyte>(c);
+		if (u - uint32('A') < 26) return u - 'A';
+		if (u - uint32('a') < 26) return u - 'a' + 26;
+		if (u - uint32('0') < 10) return u - '0' + 52;
+		if (c == (urlSafe ? '-' : '+')) return 62;
+		if (c == (urlSafe ? '_' : '/')) return 63;
+		return -1;
+	}
+
+	/**
+	 * @brief Write the base64 encoding of a
+	 * buffer, without padding.
+	 *
+	 * @param src ptr to the Bytes
+	 * @param n number of Bytes
+	 * @param dst ptr to a buffer with room for
+	 * ceil(4n / 3) characters
+	 * @param urlSafe whether to use the
+	 * URL-safe alphabet
+	 */
+	static constexpr FORCE_INLINE void encodeBase64(ubyte const* src, sizet n, ansichar* dst, bool urlSafe)
+	{
+		ansichar const* const alphabet = getBase64Alphabet(urlSafe);
+
+		sizet i = 0;
+		for (; i + 3 <= n; i += 3, dst += 4)
+		{
+			uint32 const bits = uint32(src[i]) << 16 | uint32(src[i + 1]) << 8 | src[i + 2];
+			dst[0] = alphabet[bits >> 18];
+			dst[1] = alphabet[bits >> 12 & 0x3f];
+			dst[2] = alphabet[bits >> 6 & 0x3f];
+			dst[3] = alphabet[bits & 0x3f];
+		}
+
+		if (n - i == 1)
+		{
+			dst[0] = alphabet[src[i] >> 2];
+			dst[1] = alphabet[(src[i] & 0x03) << 4];
+		}
+		else if (n - i == 2)
+		{
+			dst[0] = alphabet[src[i] >> 2];
+			dst[1] = alphabet[(src[i] & 0x03) << 4 | src[i + 1] >> 4];
+			dst[2] = alphabet[(src[i + 1] & 0x0f) << 2];
+		}
+	}
+
+	/**
+	 * @brief Read the Bytes encoded in base64,
+	 * without padding. The unused bits of the
+	 * last character must be zero, so that
+	 * each buffer has one encoding only.
+	 *
+	 * @param src ptr to the characters
+	 * @param n number of characters, must not
+	 * be 1 more than a multiple of 4
+	 * @param dst ptr to a buffer with room for
+	 * floor(3n / 4) Bytes
+	 * @param urlSafe whether to use the
+	 * URL-safe alphabet
+	 * @return index of the first invalid
+	 * character
+	 * @return n if all the characters are valid
+	 */
+	static constexpr FORCE_INLINE sizet decodeBase64(ansichar const* src, sizet n, ubyte* dst, bool urlSafe)
+	{
+		KORIN_ASSERTF(n % 4 != 1, "Invalid length of unpadded base64 (%llu)", n)
+
+		uint32 bits = 0;
+		for (sizet i = 0; i < n; ++i)
+		{
+			int32 const value = decodeBase64Char(src[i], urlSafe);
+			if (value < 0) return i;
+			bits = bits << 6 | value;
+
+			if (i % 4 == 3)
+			{
+				*dst++ = static_cast<ubyte>(bits >> 16);
+				*dst++ = static_cast<ubyte>(bits >> 8);
+				*dst++ = static_cast<ubyte>(bits);
+			}
+		}
+
+		// Write the Bytes of the last group
+		if (n % 4 == 2)
+		{
+			if (bits & 0x0f) return n - 1;
+			*dst = static_cast<ubyte>(bits >> 4);
+		}
+		else if (n % 4 == 3)
+		{
+			if (bits & 0x03) return n - 1;
+			dst[0] = static_cast<ubyte>(bits >> 10);
+			dst[1] = static_cast<ubyte>(bits >> 2);
+		}
+
+		return n;
+	}
+
+protected:
+	/**
+	 * @brief Returns the difference between
+	 * two characters. Bytes compare as
+	 * unsigned values, like in memcmp.
+	 */
+	template<typename CharT>
+	static constexpr FORCE_INLINE int32 charDiff(CharT lhs, CharT rhs)
+	{
+		if constexpr (sizeof(CharT) == 1)
+		{
+			return static_cast<int32>(static_cast<ubyte>(lhs)) - static_cast<int32>(static_cast<ubyte>(rhs));
+		}
+		else
+		{
+			return static_cast<int32>(lhs) - static_cast<int32>(rhs);
+		}
 	}
 
-#undef ICMP
+	/**
+	 * @brief Two-Way string matching, as
+	 * described by Crochemore and Perrin.
+	 *
+	 * The needle is split at a critical
+	 * factorization: the right part is matched
+	 * left to right, then the left part right
+	 * to left. Mismatches in the right part
+	 * shift by the number of matched
+	 * characters, full matches by the period of
+	 * the needle.
+	 *
+	 * If @c reverse is true, both strings are
+	 * read backwards, which finds the last
+	 * occurrence.
+	 *
+	 * @tparam reverse whether to find the last
+	 * occurrence
+	 * @param src ptr to the buffer
+	 * @param n number of characters to search
+	 * @param needle ptr to the substring
+	 * @param m length of the substring, at
+	 * least 1 and at most n
+	 * @return index of the occurrence
+	 * @return n if not found
+	 */
+	template<bool reverse, typename CharT>
+	static constexpr sizet twoWay(CharT const* src, sizet n, CharT const* needle, sizet m)
+	{
+		// Read strings backwards if necessary
+		auto const hay = [=](sizet i) { return reverse ? src[n - 1 - i] : src[i]; };
+		auto const pat = [=](sizet i) { return reverse ? needle[m - 1 - i] : needle[i]; };
+
+		// Find the critical factorization, which
+		// is the latest of the maximal suffixes
+		// for the two orderings
+		sizet period = 1;
+		sizet suffix = 0;
+		for (int32 order = 0; order < 2; ++order)
+		{
+			sizet maxSuffix = -1;
+			sizet j = 0, k = 1, p = 1;
+			while (j + k < m)
+			{
+				CharT const a = pat(j + k);
+				CharT const b = pat(maxSuffix + k);
+				if (a == b)
+				{
+					if (k != p) ++k;
+					else j += p, k = 1;
+				}
+				else if ((a < b) == (order == 0))
+				{
+					j += k, k = 1;
+					p = j - maxSuffix;
+				}
+				else
+				{
+					maxSuffix = j++;
+					k = p = 1;
+				}
+			}
+
+			if (order == 0 || maxSuffix + 1 >= suffix)
+			{
+				suffix = maxSuffix + 1;
+				period = p;
+			}
+		}
+
+		bool periodic = true;
+		for (sizet i = 0; i < suffix && periodic; ++i) periodic = pat(i) == pat(i + period);
+
+		if (periodic)
+		{
+			// Remember the prefix matched by the
+			// previous shift to avoid reading it
+			// again
+			sizet memory = 0;
+			for (sizet j = 0; j <= n - m;)
+			{
+				sizet i = PlatformMath::max(suffix, memory);
+				for (; i < m && pat(i) == hay(i + j); ++i);
+				if (i < m)
+				{
+					j += i - suffix + 1;
+					memory = 0;
+					continue;
+				}
+
+				for (i = suffix; i > memory && pat(i - 1) == hay(i - 1 + j); --i);
+				if (i <= memory)
+				{
+					return reverse ? n - m - j : j;
+				}
+
+				j += period;
+				memory = m - period;
+			}
+		}
+		else
+		{
+			period = PlatformMath::max(suffix, m - suffix) + 1;
+			for (sizet j = 0; j <= n - m;)
+			{
+				sizet i = suffix;
+				for (; i < m && pat(i) == hay(i + j); ++i);
+				if (i < m)
+				{
+					j += i - suffix + 1;
+					continue;
+				}
+
+				for (i = suffix; i > 0 && pat(i - 1) == hay(i - 1 + j); --i);
+				if (i == 0)
+				{
+					return reverse ? n - m - j : j;
+				}
+
+				j += period;
+			}
+		}
+
+		return n;
+	}
 };
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "core_types.h"
+#include "platform_atomics.h"
+
+namespace Korin
+{
+	/**
+	 * @brief An integer or pointer value that is
+	 * accessed atomically.
+	 *
+	 * All operations default to sequentially
+	 * consistent ordering, pass a weaker order
+	 * explicitly where appropriate.
+	 *
+	 * @tparam T an integer or pointer type
+	 */
+	template<typename T>
+	class Atomic
+	{
+		static_assert(sizeof(T) <= 8, "Atomic type is too large");
+
+	public:
+		/**
+		 * @brief Construct a zero-initialized
+		 * atomic value.
+		 */
+		constexpr FORCE_INLINE Atomic()
+			: value{}
+		{
+			//
+		}
+
+		/**
+		 * @brief Construct an atomic value with
+		 * the given initial value.
+		 *
+		 * @param inValue initial value
+		 */
+		constexpr FORCE_INLINE Atomic(T inValue)
+			: value{inValue}
+		{
+			//
+		}
+
+		/**
+		 * @brief Atomic values cannot be copied.
+		 * @{
+		 */
+		Atomic(Atomic const&) = delete;
+		Atomic& operator=(Atomic const&) = delete;
+		/** @} */
+
+		/**
+		 * @brief Atomically load the value.
+		 *
+		 * @param order memory ordering
+		 * @return the value
+		 */
+		FORCE_INLINE T load(MemoryOrder order = MemoryOrder::SequentiallyConsistent) const
+		{
+			return PlatformAtomics::load(&value, order);
+		}
+
+		/**
+		 * @brief Atomically store a new value.
+		 *
+		 * @param newValue value to store
+		 * @param order memory ordering
+		 */
+		FORCE_INLINE void store(T newValue, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+		{
+			PlatformAtomics::store(&value, newValue, order);
+		}
+
+		/**
+		 * @brief Atomically replace the value.
+		 * @see PlatformAtomics::exchange
+		 */
+		FORCE_INLINE T exchange(T newValue, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+		{
+			return PlatformAtomics::exchange(&value, newValue, order);
+		}
+
+		/**
+		 * @brief Atomically compare and replace the
+		 * value.
+		 * @see PlatformAtomics::compareExchange
+		 * @{
+		 */
+		FORCE_INLINE bool compareExchange(T& expected, T desired, MemoryOrder success = MemoryOrder::SequentiallyConsistent, MemoryOrder failure = MemoryOrder::SequentiallyConsistent)
+		{
+			return PlatformAtomics::compareExchange(&value, expected, desired, success, failure);
+		}
+
+		FORCE_INLINE bool compareExchangeWeak(T& expected, T desired, MemoryOrder success = MemoryOrder::SequentiallyConsistent, MemoryOrder failure = MemoryOrder::SequentiallyConsistent)
+		{
+			return PlatformAtomics::compareExchangeWeak(&value, expected, desired, success, failure);
+		}
+		/** @} */
+
+		/**
+		 * @brief Atomically add to the value and
+		 * return the previous value.
+		 */
+		FORCE_INLINE T fetchAdd(auto delta, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+		{
+			return PlatformAtomics::fetchAdd(&value, delta, order);
+		}
+
+		/**
+		 * @brief Atomically subtract from the value
+		 * and return the previous value.
+		 */
+		FORCE_INLINE T fetchSub(auto delta, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+		{
+			return PlatformAtomics::fetchSub(&value, delta, order);
+		}
+
+		/**
+		 * @brief Block the calling thread while
+		 * the value is equal to the expected value.
+		 * May return spuriously.
+		 * @see PlatformAtomics::wait
+		 *
+		 * @param expected expected value
+		 */
+		FORCE_INLINE void wait(T expected) const
+		{
+			static_assert(sizeof(T) == sizeof(uint32), "Only 32-bit values can be waited on");
+			PlatformAtomics::wait(reinterpret_cast<uint32 const*>(&value), static_cast<uint32>(expected));
+		}
+
+		/**
+		 * @brief Wake one or all threads waiting
+		 * on this value.
+		 * @{
+		 */
+		FORCE_INLINE void wakeOne() const
+		{
+			static_assert(sizeof(T) == sizeof(uint32), "Only 32-bit values can be waited on");
+			PlatformAtomics::wakeOne(reinterpret_cast<uint32 const*>(&value));
+		}
+
+		FORCE_INLINE void wakeAll() const
+		{
+			static_assert(sizeof(T) == sizeof(uint32), "Only 32-bit values can be waited on");
+			PlatformAtomics::wakeAll(reinterpret_cast<uint32 const*>(&value));
+		}
+		/** @} */
+
+	protected:
+		/* The underlying value. */
+		T value;
+	};
+} // namespace Korin
@@ -32,6 +32,18 @@
 # define RESTRICT restrict
 #endif
 
+#ifndef PLATFORM_CPU_X86_SSE2
+# define PLATFORM_CPU_X86_SSE2 0
+#endif
+
+#ifndef PLATFORM_LITTLE_ENDIAN
+# define PLATFORM_LITTLE_ENDIAN 0
+#endif
+
+#ifndef PLATFORM_CACHE_LINE_SIZE
+# define PLATFORM_CACHE_LINE_SIZE 64
+#endif
+
 #ifndef LOAD_DEBUG_SCRIPT
 # define LOAD_DEBUG_SCRIPT
 #endif
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "core_types.h"
+
+#if PLATFORM_WINDOWS
+#	include "windows/platform_atomics.h"
+#elif PLATFORM_APPLE
+#	include "apple/platform_atomics.h"
+#elif PLATFORM_LINUX
+#	include "linux/platform_atomics.h"
+#else
+#	warning "Unknown platform"
+#endif
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "unix/platform_atomics.h"
+
+/**
+ * @brief Linux atomics abstraction layer.
+ *
+ * Wait and wake operations are backed by
+ * futexes.
+ */
+struct LinuxPlatformAtomics : public UnixPlatformAtomics
+{
+	static void wait(uint32 const* addr, uint32 expected);
+	static void wakeOne(uint32 const* addr);
+	static void wakeAll(uint32 const* addr);
+};
+
+using PlatformAtomics = LinuxPlatformAtomics;
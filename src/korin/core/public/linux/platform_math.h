@@ -0,0 +1,90 @@
+#pragma once
+
+#include "unix/platform_math.h"
+
+/**
+ * @brief Linux math abstraction layer.
+ *
+ * On x86 CPUs the functions on arrays of
+ * words use the popcnt instruction and AVX2
+ * if the CPU supports them, SSE2 otherwise.
+ * The choice is made at runtime, the first
+ * time a function is called.
+ * Constant-evaluated calls use the generic
+ * implementation.
+ */
+struct LinuxPlatformMath : public UnixPlatformMath
+{
+#if PLATFORM_CPU_X86_SSE2
+	static constexpr FORCE_INLINE sizet countBits(uint64 const* src, sizet n)
+	{
+		if (!__builtin_is_constant_evaluated())
+		{
+			return countBitsWords(src, n);
+		}
+
+		return UnixPlatformMath::countBits(src, n);
+	}
+
+	static constexpr FORCE_INLINE void andBits(uint64* RESTRICT dst, uint64 const* RESTRICT src, sizet n)
+	{
+		if (!__builtin_is_constant_evaluated())
+		{
+			andBitsWords(dst, src, n);
+			return;
+		}
+
+		UnixPlatformMath::andBits(dst, src, n);
+	}
+
+	static constexpr FORCE_INLINE void orBits(uint64* RESTRICT dst, uint64 const* RESTRICT src, sizet n)
+	{
+		if (!__builtin_is_constant_evaluated())
+		{
+			orBitsWords(dst, src, n);
+			return;
+		}
+
+		UnixPlatformMath::orBits(dst, src, n);
+	}
+
+	static constexpr FORCE_INLINE void xorBits(uint64* RESTRICT dst, uint64 const* RESTRICT src, sizet n)
+	{
+		if (!__builtin_is_constant_evaluated())
+		{
+			xorBitsWords(dst, src, n);
+			return;
+		}
+
+		UnixPlatformMath::xorBits(dst, src, n);
+	}
+
+	static constexpr FORCE_INLINE void andNotBits(uint64* RESTRICT dst, uint64 const* RESTRICT src, sizet n)
+	{
+		if (!__builtin_is_constant_evaluated())
+		{
+			andNotBitsWords(dst, src, n);
+			return;
+		}
+
+		UnixPlatformMath::andNotBits(dst, src, n);
+	}
+
+protected:
+	/**
+	 * @brief Vectorized kernels.
+	 * @{
+	 */
+	/* Returns the number of set bits of n words. */
+	static sizet countBitsWords(uint64 const* src, sizet n);
+
+	/* Bitwise operations of n words, written in dst. */
+	static void andBitsWords(uint64* dst, uint64 const* src, sizet n);
+	static void orBitsWords(uint64* dst, uint64 const* src, sizet n);
+	static void xorBitsWords(uint64* dst, uint64 const* src, sizet n);
+	static void andNotBitsWords(uint64* dst, uint64 const* src, sizet n);
+	/** @} */
+#endif
+};
+
+using PlatformMath = LinuxPlatformMath;
@@ -2,9 +2,351 @@
 
 #include "unix/platform_string.h"
 
+/**
+ * @brief Linux string abstraction layer.
+ *
+ * On x86 CPUs the functions on single-Byte
+ * characters are vectorized with SSE2, or
+ * AVX2 if the CPU supports it. The choice is
+ * made at runtime, the first time a function
+ * is called. Constant-evaluated calls and
+ * wider characters use the generic
+ * implementation.
+ */
 struct LinuxPlatformString : public UnixPlatformString
 {
-	//
+#if PLATFORM_CPU_X86_SSE2
+	template<typename CharT>
+	static constexpr FORCE_INLINE sizet len(CharT* cstr)
+	{
+		if constexpr (sizeof(CharT) == 1)
+		{
+			if (!__builtin_is_constant_evaluated())
+			{
+				return lenAnsi(reinterpret_cast<ansichar const*>(cstr));
+			}
+		}
+
+		return UnixPlatformString::len(cstr);
+	}
+
+	template<typename CharT>
+	static constexpr FORCE_INLINE int32 cmp(CharT* lhs, CharT* rhs)
+	{
+		if constexpr (sizeof(CharT) == 1)
+		{
+			if (!__builtin_is_constant_evaluated())
+			{
+				sizet const i = mismatchAnsi(reinterpret_cast<ansichar const*>(lhs), reinterpret_cast<ansichar const*>(rhs), -1);
+				return charDiff(lhs[i], rhs[i]);
+			}
+		}
+
+		return UnixPlatformString::cmp(lhs, rhs);
+	}
+
+	template<typename CharT>
+	static constexpr FORCE_INLINE int32 cmpn(CharT* lhs, CharT* rhs, sizet n)
+	{
+		if constexpr (sizeof(CharT) == 1)
+		{
+			if (!__builtin_is_constant_evaluated())
+			{
+				sizet const i = mismatchAnsi(reinterpret_cast<ansichar const*>(lhs), reinterpret_cast<ansichar const*>(rhs), n);
+				return i < n ? charDiff(lhs[i], rhs[i]) : 0;
+			}
+		}
+
+		return UnixPlatformString::cmpn(lhs, rhs, n);
+	}
+
+	template<typename CharT>
+	static constexpr FORCE_INLINE int32 icmp(CharT* lhs, CharT* rhs)
+	{
+		if constexpr (sizeof(CharT) == 1)
+		{
+			if (!__builtin_is_constant_evaluated())
+			{
+				sizet const i = imismatchAnsi(reinterpret_cast<ansichar const*>(lhs), reinterpret_cast<ansichar const*>(rhs), -1);
+				return charDiff(toLower(lhs[i]), toLower(rhs[i]));
+			}
+		}
+
+		return UnixPlatformString::icmp(lhs, rhs);
+	}
+
+	template<typename CharT>
+	static constexpr FORCE_INLINE int32 icmpn(CharT* lhs, CharT* rhs, sizet n)
+	{
+		if constexpr (sizeof(CharT) == 1)
+		{
+			if (!__builtin_is_constant_evaluated())
+			{
+				sizet const i = imismatchAnsi(reinterpret_cast<ansichar const*>(lhs), reinterpret_cast<ansichar const*>(rhs), n);
+				return i < n ? charDiff(toLower(lhs[i]), toLower(rhs[i])) : 0;
+			}
+		}
+
+		return UnixPlatformString::icmpn(lhs, rhs, n);
+	}
+
+	template<typename CharT>
+	static constexpr FORCE_INLINE CharT* chr(CharT* cstr, typename RemoveCV<CharT>::Type c)
+	{
+		if constexpr (sizeof(CharT) == 1)
+		{
+			if (!__builtin_is_constant_evaluated())
+			{
+				CharT* it = cstr + chrAnsi(reinterpret_cast<ansichar const*>(cstr), static_cast<ansichar>(c));
+				return *it == c ? it : nullptr;
+			}
+		}
+
+		return UnixPlatformString::chr(cstr, c);
+	}
+
+	template<typename CharT>
+	static constexpr FORCE_INLINE CharT* chrn(CharT* src, sizet n, typename RemoveCV<CharT>::Type c)
+	{
+		if constexpr (sizeof(CharT) == 1)
+		{
+			if (!__builtin_is_constant_evaluated())
+			{
+				sizet const i = chrnAnsi(reinterpret_cast<ansichar const*>(src), n, static_cast<ansichar>(c));
+				return i < n ? src + i : nullptr;
+			}
+		}
+
+		return UnixPlatformString::chrn(src, n, c);
+	}
+
+	template<typename CharT>
+	static constexpr FORCE_INLINE CharT* rchrn(CharT* src, sizet n, typename RemoveCV<CharT>::Type c)
+	{
+		if constexpr (sizeof(CharT) == 1)
+		{
+			if (!__builtin_is_constant_evaluated())
+			{
+				sizet const i = rchrnAnsi(reinterpret_cast<ansichar const*>(src), n, static_cast<ansichar>(c));
+				return i < n ? src + i : nullptr;
+			}
+		}
+
+		return UnixPlatformString::rchrn(src, n, c);
+	}
+
+	template<typename CharT>
+	static constexpr FORCE_INLINE sizet spn(CharT* src, sizet n, typename RemoveCV<CharT>::Type const* set, sizet setLen)
+	{
+		if constexpr (sizeof(CharT) == 1)
+		{
+			if (!__builtin_is_constant_evaluated())
+			{
+				return spnAnsi(reinterpret_cast<ansichar const*>(src), n, reinterpret_cast<ansichar const*>(set), setLen, false);
+			}
+		}
+
+		return UnixPlatformString::spn(src, n, set, setLen);
+	}
+
+	template<typename CharT>
+	static constexpr FORCE_INLINE sizet cspn(CharT* src, sizet n, typename RemoveCV<CharT>::Type const* set, sizet setLen)
+	{
+		if constexpr (sizeof(CharT) == 1)
+		{
+			if (!__builtin_is_constant_evaluated())
+			{
+				return spnAnsi(reinterpret_cast<ansichar const*>(src), n, reinterpret_cast<ansichar const*>(set), setLen, true);
+			}
+		}
+
+		return UnixPlatformString::cspn(src, n, set, setLen);
+	}
+
+	template<typename CharT>
+	static constexpr FORCE_INLINE uint64 setMask(CharT* src, sizet n, typename RemoveCV<CharT>::Type const* set, sizet setLen)
+	{
+		if constexpr (sizeof(CharT) == 1)
+		{
+			if (!__builtin_is_constant_evaluated())
+			{
+				return setMaskAnsi(reinterpret_cast<ansichar const*>(src), n, reinterpret_cast<ansichar const*>(set), setLen);
+			}
+		}
+
+		return UnixPlatformString::setMask(src, n, set, setLen);
+	}
+
+	/**
+	 * @brief Needles are found by filtering the
+	 * positions where their first and last
+	 * characters match. Long needles switch to
+	 * the Two-Way algorithm when the filter
+	 * lets through too many positions, so that
+	 * the search stays linear.
+	 * @{
+	 */
+	template<typename CharT>
+	static constexpr FORCE_INLINE CharT* findn(CharT* src, sizet n, typename RemoveCV<CharT>::Type const* needle, sizet m)
+	{
+		if constexpr (sizeof(CharT) == 1)
+		{
+			if (!__builtin_is_constant_evaluated() && m <= n)
+			{
+				if (m == 1)
+				{
+					return chrn(src, n, *needle);
+				}
+
+				if (m >= 2)
+				{
+					sizet const i = findAnsi(reinterpret_cast<ansichar const*>(src), n, reinterpret_cast<ansichar const*>(needle), m);
+					return i < n ? src + i : nullptr;
+				}
+			}
+		}
+
+		return UnixPlatformString::findn(src, n, needle, m);
+	}
+
+	template<typename CharT>
+	static constexpr FORCE_INLINE CharT* rfindn(CharT* src, sizet n, typename RemoveCV<CharT>::Type const* needle, sizet m)
+	{
+		if constexpr (sizeof(CharT) == 1)
+		{
+			if (!__builtin_is_constant_evaluated() && m <= n)
+			{
+				if (m == 1)
+				{
+					return rchrn(src, n, *needle);
+				}
+
+				if (m >= 2)
+				{
+					sizet const i = rfindAnsi(reinterpret_cast<ansichar const*>(src), n, reinterpret_cast<ansichar const*>(needle), m);
+					return i < n ? src + i : nullptr;
+				}
+			}
+		}
+
+		return UnixPlatformString::rfindn(src, n, needle, m);
+	}
+	/** @} */
+
+	static constexpr FORCE_INLINE sizet validateUtf8(ansichar const* src, sizet n)
+	{
+		if (!__builtin_is_constant_evaluated())
+		{
+			return validateUtf8Ansi(src, n);
+		}
+
+		return UnixPlatformString::validateUtf8(src, n);
+	}
+
+	/**
+	 * @brief Hex and base64 are encoded and
+	 * decoded with vectors. Tails, and vectors
+	 * with invalid characters, are processed
+	 * one character at a time.
+	 * @{
+	 */
+	static constexpr FORCE_INLINE void encodeHex(ubyte const* src, sizet n, ansichar* dst, bool upperCase)
+	{
+		if (!__builtin_is_constant_evaluated())
+		{
+			encodeHexAnsi(src, n, dst, upperCase);
+			return;
+		}
+
+		UnixPlatformString::encodeHex(src, n, dst, upperCase);
+	}
+
+	static constexpr FORCE_INLINE sizet decodeHex(ansichar const* src, sizet n, ubyte* dst)
+	{
+		if (!__builtin_is_constant_evaluated())
+		{
+			return decodeHexAnsi(src, n, dst);
+		}
+
+		return UnixPlatformString::decodeHex(src, n, dst);
+	}
+
+	static constexpr FORCE_INLINE void encodeBase64(ubyte const* src, sizet n, ansichar* dst, bool urlSafe)
+	{
+		if (!__builtin_is_constant_evaluated())
+		{
+			encodeBase64Ansi(src, n, dst, urlSafe);
+			return;
+		}
+
+		UnixPlatformString::encodeBase64(src, n, dst, urlSafe);
+	}
+
+	static constexpr FORCE_INLINE sizet decodeBase64(ansichar const* src, sizet n, ubyte* dst, bool urlSafe)
+	{
+		if (!__builtin_is_constant_evaluated())
+		{
+			return decodeBase64Ansi(src, n, dst, urlSafe);
+		}
+
+		return UnixPlatformString::decodeBase64(src, n, dst, urlSafe);
+	}
+	/** @} */
+
+protected:
+	/**
+	 * @brief Vectorized kernels. They work on
+	 * indices so that the templates above can
+	 * compute the results with the right
+	 * character type.
+	 * @{
+	 */
+	/* Returns the length of a null-terminated string. */
+	static sizet lenAnsi(ansichar const* cstr);
+
+	/* Returns the index of the first different or null character, or n if none within n characters. */
+	static sizet mismatchAnsi(ansichar const* lhs, ansichar const* rhs, sizet n);
+
+	/* Like mismatchAnsi but ignores case. */
+	static sizet imismatchAnsi(ansichar const* lhs, ansichar const* rhs, sizet n);
+
+	/* Returns the index of the first occurrence of c or of the null character. */
+	static sizet chrAnsi(ansichar const* cstr, ansichar c);
+
+	/* Returns the index of the first occurrence of c, or n if not found. */
+	static sizet chrnAnsi(ansichar const* src, sizet n, ansichar c);
+
+	/* Returns the index of the last occurrence of c, or n if not found. */
+	static sizet rchrnAnsi(ansichar const* src, sizet n, ansichar c);
+
+	/* Returns the index of the first occurrence of a needle with 2 to n characters, or n if not found. */
+	static sizet findAnsi(ansichar const* src, sizet n, ansichar const* needle, sizet m);
+
+	/* Like findAnsi but returns the index of the last occurrence. */
+	static sizet rfindAnsi(ansichar const* src, sizet n, ansichar const* needle, sizet m);
+
+	/* Returns the length of the leading span of characters in the set, or not in the set if invert is true. */
+	static sizet spnAnsi(ansichar const* src, sizet n, ansichar const* set, sizet setLen, bool invert);
+
+	/* Returns the mask of the first min(n, 64) characters that are in the set. */
+	static uint64 setMaskAnsi(ansichar const* src, sizet n, ansichar const* set, sizet setLen);
+
+	/* Returns the index of the first invalid UTF-8 sequence, or n if none. */
+	static sizet validateUtf8Ansi(ansichar const* src, sizet n);
+
+	/* Writes the hex digits of n Bytes. */
+	static void encodeHexAnsi(ubyte const* src, sizet n, ansichar* dst, bool upperCase);
+
+	/* Reads n hex digits, returns the index of the first invalid digit, or n if none. */
+	static sizet decodeHexAnsi(ansichar const* src, sizet n, ubyte* dst);
+
+	/* Writes the unpadded base64 encoding of n Bytes. */
+	static void encodeBase64Ansi(ubyte const* src, sizet n, ansichar* dst, bool urlSafe);
+
+	/* Reads n unpadded base64 characters, returns the index of the first invalid character, or n if none. */
+	static sizet decodeBase64Ansi(ansichar const* src, sizet n, ubyte* dst, bool urlSafe);
+	/** @} */
+#endif
 };
 
 using PlatformString = LinuxPlatformString;
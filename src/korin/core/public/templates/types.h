@@ -36,6 +36,23 @@ template<> struct IsIntegral<int16>  { enum { value = true }; };
 template<> struct IsIntegral<int32>  { enum { value = true }; };
 template<> struct IsIntegral<int64>  { enum { value = true }; };
 template<> struct IsIntegral<char>   { enum { value = true }; };
+template<> struct IsIntegral<wchar_t> { enum { value = true }; };
+
+/**
+ * @brief Check if type is a pointer type.
+ *
+ * @tparam T type to test
+ */
+template<typename T>
+struct IsPointer
+{
+	enum { value = false };
+};
+
+template<typename T> struct IsPointer<T*>                { enum { value = true }; };
+template<typename T> struct IsPointer<T* const>          { enum { value = true }; };
+template<typename T> struct IsPointer<T* volatile>       { enum { value = true }; };
+template<typename T> struct IsPointer<T* const volatile> { enum { value = true }; };
 
 /**
  * @brief Return true if type is a cv POD type.
@@ -131,6 +148,19 @@ template<typename T> struct RemoveCV<T const>          { using Type = T; };
 template<typename T> struct RemoveCV<T volatile>       { using Type = T; };
 template<typename T> struct RemoveCV<T const volatile> { using Type = T; };
 
+/**
+ * @brief Returns the type as is. Can be used
+ * to exclude a parameter from template
+ * argument deduction.
+ *
+ * @tparam T the type
+ */
+template<typename T>
+struct TypeIdentity
+{
+	using Type = T;
+};
+
 /**
  * @brief Strip type from references and
  * qualifiers.
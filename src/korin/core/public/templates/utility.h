@@ -41,7 +41,7 @@ constexpr FORCE_INLINE T&& forward(typename RemoveReference<T>::Type&& x)
 }
 /** @} */
 
-#define FORWARD(x) forward<decltype(x)>(x)
+#define FORWARD(x) ::forward<decltype(x)>(x)
 
 /**
  * @brief Swap two values of the same type.
@@ -14,6 +14,14 @@ struct UnixPlatformTypes : GenericPlatformTypes
 
 #define PLATFORM_POSIX 1
 
+#if defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+# define PLATFORM_CPU_X86_SSE2 1
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+# define PLATFORM_LITTLE_ENDIAN 1
+#endif
+
 #if BUILD_RELEASE && defined(__GNUC__)
 # define FORCE_INLINE inline __attribute__((always_inline))
 #endif
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "generic/platform_atomics.h"
+
+/**
+ * @brief Unix atomics abstraction layer.
+ */
+struct UnixPlatformAtomics : public GenericPlatformAtomics
+{
+	static FORCE_INLINE void yieldProcessor()
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+		asm volatile("yield");
+#endif
+	}
+};
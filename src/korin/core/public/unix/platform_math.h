@@ -0,0 +1,52 @@
+#pragma once
+
+#include "generic/platform_math.h"
+
+/**
+ * @brief Unix math abstraction layer.
+ */
+struct UnixPlatformMath : public GenericPlatformMath
+{
+#ifdef __GNUC__
+	static constexpr FORCE_INLINE uint32 countLeadingZeros(uint64 x)
+	{
+		return x ? __builtin_clzll(x) : 64;
+	}
+
+	static constexpr FORCE_INLINE uint32 countTrailingZeros(uint64 x)
+	{
+		return x ? __builtin_ctzll(x) : 64;
+	}
+
+	/**
+	 * @brief Without the popcnt instruction
+	 * the builtin is a call to libgcc, the
+	 * generic implementation is inlined.
+	 */
+	static constexpr FORCE_INLINE uint32 popCount(uint64 x)
+	{
+#if PLATFORM_CPU_X86_SSE2 && !defined(__POPCNT__)
+		return GenericPlatformMath::popCount(x);
+#else
+		return __builtin_popcountll(x);
+#endif
+	}
+
+	static constexpr FORCE_INLINE uint32 floorLog2(uint64 x)
+	{
+		return 63 - countLeadingZeros(x);
+	}
+
+	static constexpr FORCE_INLINE uint64 roundUpToPowerOfTwo(uint64 x)
+	{
+		return x <= 1 ? 1 : 1ull << (64 - countLeadingZeros(x - 1));
+	}
+
+	static constexpr FORCE_INLINE uint64 mulHigh(uint64 a, uint64 b, uint64& low)
+	{
+		unsigned __int128 const product = static_cast<unsigned __int128>(a) * b;
+		low = static_cast<uint64>(product);
+		return static_cast<uint64>(product >> 64);
+	}
+#endif
+};
@@ -0,0 +1,3 @@
+#include "bench_concurrency.h"
+
+BENCHMARK_MAIN();
@@ -0,0 +1,319 @@
+#pragma once
+
+#include "benchmark/benchmark.h"
+#include "testing.h"
+
+#include "containers/containers.h"
+#include "hal/atomic.h"
+
+using namespace Korin;
+
+// STL includes
+#include <thread>
+
+/**
+ * @brief Spin until the condition is true,
+ * yielding the thread so that benchmarks also
+ * make progress on machines with few cores.
+ */
+static void spinUntil(auto&& condition)
+{
+	for (int32 numSpins = 0; !condition(); ++numSpins)
+	{
+		if (numSpins < 64)
+		{
+			PlatformAtomics::yieldProcessor();
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+static void BM_concurrency_SpscQueue_throughput(benchmark::State& state)
+{
+	constexpr sizet numItems = 1 << 14;
+	sizet const batchSize = state.range(0);
+
+	SpscQueue<uint64> queue{1024};
+	Atomic<uint64> numPopped{0};
+	Atomic<bool> done{false};
+
+	std::thread consumer{[&]() {
+
+		uint64 buffer[256];
+		Span<uint64> batch{buffer, batchSize};
+		while (!done.load(MemoryOrder::Relaxed))
+		{
+			if (sizet n = queue.tryPopBatch(batch))
+			{
+				benchmark::DoNotOptimize(buffer[n - 1]);
+				numPopped.fetchAdd(n, MemoryOrder::Release);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}};
+
+	uint64 buffer[256] = {};
+	uint64 numPushed = 0;
+
+	for (auto _ : state)
+	{
+		for (sizet i = 0; i < numItems; i += batchSize)
+		{
+			Span<uint64 const> batch{buffer, batchSize};
+			spinUntil([&]() {
+
+				batch = batch.subspan(queue.tryPushBatch(batch));
+				return batch.isEmpty();
+			});
+		}
+
+		// Wait for consumer to drain the queue
+		numPushed += numItems;
+		spinUntil([&]() { return numPopped.load(MemoryOrder::Acquire) == numPushed; });
+	}
+
+	done.store(true);
+	consumer.join();
+
+	state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK(BM_concurrency_SpscQueue_throughput)->RangeMultiplier(4)->Range(1, 256)->UseRealTime();
+
+static void BM_concurrency_SpscQueue_latency(benchmark::State& state)
+{
+	SpscQueue<uint64> ping{16};
+	SpscQueue<uint64> pong{16};
+
+	std::thread echo{[&]() {
+
+		for (uint64 item = 0; item != ~0ull;)
+		{
+			spinUntil([&]() { return ping.tryPop(item); });
+			spinUntil([&]() { return pong.tryPush(item); });
+		}
+	}};
+
+	uint64 item = 0;
+	for (auto _ : state)
+	{
+		// Measure a round trip
+		spinUntil([&]() { return ping.tryPush(item); });
+		spinUntil([&]() { return pong.tryPop(item); });
+	}
+
+	spinUntil([&]() { return ping.tryPush(~0ull); });
+	echo.join();
+}
+BENCHMARK(BM_concurrency_SpscQueue_latency)->UseRealTime();
+
+/**
+ * @brief Generate producer and consumer counts,
+ * in powers of two, from one up to the number
+ * of cores (at least two).
+ */
+static void MpmcQueueThreadCounts(benchmark::internal::Benchmark* bench)
+{
+	int32 const maxThreads = PlatformMath::max(int32(std::thread::hardware_concurrency()), 2);
+	for (int32 numProducers = 1; numProducers <= maxThreads; numProducers *= 2)
+	{
+		for (int32 numConsumers = 1; numConsumers <= maxThreads; numConsumers *= 2)
+		{
+			bench->Args({numProducers, numConsumers});
+		}
+	}
+}
+
+static void BM_concurrency_MpmcQueue(benchmark::State& state)
+{
+	constexpr uint64 numItems = 1 << 16;
+	int32 const numProducers = state.range(0);
+	int32 const numConsumers = state.range(1);
+
+	MpmcQueue<uint64> queue{1024};
+
+	for (auto _ : state)
+	{
+		SegmentedArray<std::thread> threads;
+
+		for (int32 i = 0; i < numProducers; ++i)
+		{
+			threads.emplaceLast([&queue, numProducers]() {
+
+				for (uint64 j = 0; j < numItems / numProducers; ++j)
+				{
+					queue.push(j);
+				}
+			});
+		}
+
+		for (int32 i = 0; i < numConsumers; ++i)
+		{
+			threads.emplaceLast([&queue, numConsumers]() {
+
+				for (uint64 j = 0; j < numItems / numConsumers; ++j)
+				{
+					uint64 item;
+					queue.pop(item);
+					benchmark::DoNotOptimize(item);
+				}
+			});
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK(BM_concurrency_MpmcQueue)->Apply(MpmcQueueThreadCounts)->UseRealTime();
+
+static void BM_concurrency_MpmcQueue_batch(benchmark::State& state)
+{
+	constexpr uint64 numItems = 1 << 16;
+	constexpr sizet batchSize = 16;
+	int32 const numProducers = state.range(0);
+	int32 const numConsumers = state.range(1);
+
+	MpmcQueue<uint64> queue{1024};
+
+	for (auto _ : state)
+	{
+		SegmentedArray<std::thread> threads;
+		Atomic<uint64> numPopped{0};
+
+		for (int32 i = 0; i < numProducers; ++i)
+		{
+			threads.emplaceLast([&queue, numProducers]() {
+
+				uint64 buffer[batchSize] = {};
+				for (uint64 j = 0; j < numItems / numProducers; j += batchSize)
+				{
+					Span<uint64 const> batch = buffer;
+					spinUntil([&]() {
+
+						batch = batch.subspan(queue.tryPushBatch(batch));
+						return batch.isEmpty();
+					});
+				}
+			});
+		}
+
+		for (int32 i = 0; i < numConsumers; ++i)
+		{
+			threads.emplaceLast([&queue, &numPopped]() {
+
+				uint64 buffer[batchSize];
+				while (numPopped.load(MemoryOrder::Relaxed) < numItems)
+				{
+					if (sizet n = queue.tryPopBatch(buffer))
+					{
+						numPopped.fetchAdd(n, MemoryOrder::Relaxed);
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK(BM_concurrency_MpmcQueue_batch)->Apply(MpmcQueueThreadCounts)->UseRealTime();
+
+/**
+ * @brief Generate thread counts, in powers of
+ * two, from one up to the number of cores (at
+ * least two).
+ */
+static void WorkStealingThreadCounts(benchmark::internal::Benchmark* bench)
+{
+	int32 const maxThreads = PlatformMath::max(int32(std::thread::hardware_concurrency()), 2);
+	for (int32 numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+	{
+		bench->Arg(numThreads);
+	}
+}
+
+static void BM_concurrency_WorkStealingDeque_forkJoin(benchmark::State& state)
+{
+	// Each task is the depth of a node of a binary tree
+	constexpr uint64 treeDepth = 16;
+	constexpr uint64 numLeaves = 1ull << treeDepth;
+	int32 const numThreads = state.range(0);
+
+	for (auto _ : state)
+	{
+		SegmentedArray<WorkStealingDeque<uint64>> deques;
+		for (int32 i = 0; i < numThreads; ++i)
+		{
+			deques.emplaceLast();
+		}
+
+		Atomic<uint64> numLeavesDone{0};
+		deques[0].push(treeDepth);
+
+		auto worker = [&](int32 workerIdx) {
+
+			WorkStealingDeque<uint64>& deque = deques[workerIdx];
+			uint32 victimIdx = workerIdx;
+			uint64 numLocalLeaves = 0;
+
+			while (numLeavesDone.load(MemoryOrder::Relaxed) < numLeaves)
+			{
+				uint64 depth;
+				if (deque.tryPop(depth) || deques[victimIdx = (victimIdx + 1) % numThreads].trySteal(depth))
+				{
+					// Fork until we reach a leaf
+					for (; depth > 0; --depth)
+					{
+						deque.push(depth - 1);
+					}
+
+					if (++numLocalLeaves == 64)
+					{
+						numLeavesDone.fetchAdd(numLocalLeaves, MemoryOrder::Relaxed);
+						numLocalLeaves = 0;
+					}
+				}
+				else
+				{
+					// Flush work done before going idle
+					numLeavesDone.fetchAdd(numLocalLeaves, MemoryOrder::Relaxed);
+					numLocalLeaves = 0;
+					std::this_thread::yield();
+				}
+			}
+		};
+
+		SegmentedArray<std::thread> threads;
+		for (int32 i = 1; i < numThreads; ++i)
+		{
+			threads.emplaceLast(worker, i);
+		}
+
+		worker(0);
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * numLeaves);
+}
+BENCHMARK(BM_concurrency_WorkStealingDeque_forkJoin)->Apply(WorkStealingThreadCounts)->UseRealTime();
@@ -10,6 +10,10 @@ using namespace Korin;
 // STL includes
 #include <map>
 #include <unordered_map>
+#include <deque>
+#include <string>
+#include <charconv>
+#include <vector>
 
 static char const* names[16] = {
 	"sneppy",
@@ -175,3 +179,1478 @@ static void BM_containers_std_unordered_map(benchmark::State& state)
 	}
 }
 BENCHMARK(BM_containers_std_unordered_map)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_SegmentedArray(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	for (auto _ : state)
+	{
+		SegmentedArray<int64> arr;
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			arr.emplaceLast(i);
+		}
+
+		int64 acc = 0;
+		arr.forEachChunk([&acc](Span<int64> chunk) {
+
+			for (int64 item : chunk)
+			{
+				acc += item;
+			}
+		});
+		benchmark::DoNotOptimize(acc);
+	}
+}
+BENCHMARK(BM_containers_Korin_SegmentedArray)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_List(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	for (auto _ : state)
+	{
+		List<int64> list;
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			list.pushBack(i);
+		}
+
+		int64 acc = 0;
+		for (int64 item : list)
+		{
+			acc += item;
+		}
+		benchmark::DoNotOptimize(acc);
+	}
+}
+BENCHMARK(BM_containers_Korin_List)->Range(8, 8 << 10);
+
+using ParticleTuple = Tuple<float32, float32, float32, float32, float32, float32, uint64>;
+
+static void BM_containers_Korin_Array_Tuple_fieldSum(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	Array<ParticleTuple> particles;
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		particles.append(ParticleTuple{float32(i), 0.f, 0.f, 1.f, 1.f, 1.f, uint64(i)});
+	}
+
+	for (auto _ : state)
+	{
+		float32 acc = 0.f;
+		for (ParticleTuple const& particle : particles)
+		{
+			acc += particle.get<0>();
+		}
+		benchmark::DoNotOptimize(acc);
+	}
+
+	state.SetBytesProcessed(state.iterations() * numItems * sizeof(float32));
+}
+BENCHMARK(BM_containers_Korin_Array_Tuple_fieldSum)->Range(1 << 10, 1 << 18);
+
+static void BM_containers_Korin_SoAArray_fieldSum(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	SoAArray<float32, float32, float32, float32, float32, float32, uint64> particles;
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		particles.append(float32(i), 0.f, 0.f, 1.f, 1.f, 1.f, uint64(i));
+	}
+
+	for (auto _ : state)
+	{
+		float32 acc = 0.f;
+		for (float32 x : particles.getColumn<0>())
+		{
+			acc += x;
+		}
+		benchmark::DoNotOptimize(acc);
+	}
+
+	state.SetBytesProcessed(state.iterations() * numItems * sizeof(float32));
+}
+BENCHMARK(BM_containers_Korin_SoAArray_fieldSum)->Range(1 << 10, 1 << 18);
+
+static void BM_containers_Korin_BitArray_membership(benchmark::State& state)
+{
+	const int32 numIds = state.range(0);
+
+	BitArray ids{sizet(numIds)};
+	for (int32 id = 0; id < numIds; id += 3)
+	{
+		ids.set(id);
+	}
+
+	for (auto _ : state)
+	{
+		int32 numFound = 0;
+		for (int32 i = 0; i < numIds; ++i)
+		{
+			numFound += ids[(i * 7919) % numIds];
+		}
+		benchmark::DoNotOptimize(numFound);
+	}
+
+	state.counters["bytes"] = ids.getNumWords() * sizeof(uint64);
+}
+BENCHMARK(BM_containers_Korin_BitArray_membership)->Range(1 << 10, 1 << 16);
+
+static void BM_containers_Korin_HashSet_membership(benchmark::State& state)
+{
+	const int32 numIds = state.range(0);
+
+	HashSet<int32> ids;
+	for (int32 id = 0; id < numIds; id += 3)
+	{
+		ids.insert(id);
+	}
+
+	for (auto _ : state)
+	{
+		int32 numFound = 0;
+		for (int32 i = 0; i < numIds; ++i)
+		{
+			numFound += ids.find((i * 7919) % numIds) != ids.end();
+		}
+		benchmark::DoNotOptimize(numFound);
+	}
+}
+BENCHMARK(BM_containers_Korin_HashSet_membership)->Range(1 << 10, 1 << 16);
+
+static void BM_containers_Korin_BitArray_intersectCount(benchmark::State& state)
+{
+	const int32 numIds = state.range(0);
+
+	BitArray a{sizet(numIds)};
+	BitArray b{sizet(numIds)};
+	a.setRange(0, numIds / 2);
+	b.setRange(numIds / 4, numIds);
+
+	for (auto _ : state)
+	{
+		BitArray c = a;
+		c &= b;
+		benchmark::DoNotOptimize(c.count());
+	}
+}
+BENCHMARK(BM_containers_Korin_BitArray_intersectCount)->Range(1 << 10, 1 << 20);
+
+static void BM_containers_Korin_Deque(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	for (auto _ : state)
+	{
+		Deque<int64> deque;
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			deque.pushBack(i);
+			deque.pushFront(i);
+		}
+
+		int64 acc = 0;
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			acc += deque.popFront();
+			acc -= deque.popBack();
+		}
+		benchmark::DoNotOptimize(acc);
+	}
+}
+BENCHMARK(BM_containers_Korin_Deque)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_List_deque(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	for (auto _ : state)
+	{
+		List<int64> list;
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			list.pushBack(i);
+			list.pushFront(i);
+		}
+
+		int64 acc = 0;
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			acc += list.popFront();
+			acc -= list.popBack();
+		}
+		benchmark::DoNotOptimize(acc);
+	}
+}
+BENCHMARK(BM_containers_Korin_List_deque)->Range(8, 8 << 10);
+
+static void BM_containers_std_deque(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	for (auto _ : state)
+	{
+		std::deque<int64> deque;
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			deque.push_back(i);
+			deque.push_front(i);
+		}
+
+		int64 acc = 0;
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			acc += deque.front();
+			deque.pop_front();
+			acc -= deque.back();
+			deque.pop_back();
+		}
+		benchmark::DoNotOptimize(acc);
+	}
+}
+BENCHMARK(BM_containers_std_deque)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_Deque_index(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	Deque<int64> deque;
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		deque.pushBack(i);
+	}
+
+	for (auto _ : state)
+	{
+		int64 acc = 0;
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			acc += deque[(i * 7919) % numItems];
+		}
+		benchmark::DoNotOptimize(acc);
+	}
+}
+BENCHMARK(BM_containers_Korin_Deque_index)->Range(8, 8 << 10);
+
+static void BM_containers_std_deque_index(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	std::deque<int64> deque;
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		deque.push_back(i);
+	}
+
+	for (auto _ : state)
+	{
+		int64 acc = 0;
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			acc += deque[(i * 7919) % numItems];
+		}
+		benchmark::DoNotOptimize(acc);
+	}
+}
+BENCHMARK(BM_containers_std_deque_index)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_String_fanOut(benchmark::State& state)
+{
+	const int32 numCopies = state.range(0);
+
+	String const blob{'x', 16 << 10};
+
+	for (auto _ : state)
+	{
+		Array<String> copies{sizet(numCopies)};
+		for (int32 i = 0; i < numCopies; ++i)
+		{
+			copies.append(blob);
+		}
+		benchmark::DoNotOptimize(*copies);
+	}
+}
+BENCHMARK(BM_containers_Korin_String_fanOut)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_SharedString_fanOut(benchmark::State& state)
+{
+	const int32 numCopies = state.range(0);
+
+	SharedString const blob{String{'x', 16 << 10}};
+
+	for (auto _ : state)
+	{
+		Array<SharedString> copies{sizet(numCopies)};
+		for (int32 i = 0; i < numCopies; ++i)
+		{
+			copies.append(blob);
+		}
+		benchmark::DoNotOptimize(*copies);
+	}
+}
+BENCHMARK(BM_containers_Korin_SharedString_fanOut)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_String_short(benchmark::State& state)
+{
+	const int32 numStrings = state.range(0);
+
+	for (auto _ : state)
+	{
+		Array<String> strings{sizet(numStrings)};
+		for (int32 i = 0; i < numStrings; ++i)
+		{
+			String name = names[i & 0xf];
+			strings.append(name);
+		}
+		benchmark::DoNotOptimize(*strings);
+	}
+}
+BENCHMARK(BM_containers_Korin_String_short)->Range(8, 8 << 10);
+
+static void BM_containers_std_string_short(benchmark::State& state)
+{
+	const int32 numStrings = state.range(0);
+
+	for (auto _ : state)
+	{
+		std::vector<std::string> strings;
+		strings.reserve(numStrings);
+		for (int32 i = 0; i < numStrings; ++i)
+		{
+			std::string name = names[i & 0xf];
+			strings.push_back(name);
+		}
+		benchmark::DoNotOptimize(strings.data());
+	}
+}
+BENCHMARK(BM_containers_std_string_short)->Range(8, 8 << 10);
+
+template<typename PlatformStringT>
+static void BM_containers_PlatformString_len(benchmark::State& state)
+{
+	const int32 len = state.range(0);
+
+	Array<ansichar> str{sizet(len + 1)};
+	for (int32 i = 0; i < len; ++i)
+	{
+		str.append(ansichar('a' + i % 26));
+	}
+	str.append('\0');
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(PlatformStringT::len(*str));
+	}
+
+	state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK_TEMPLATE(BM_containers_PlatformString_len, GenericPlatformString)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(BM_containers_PlatformString_len, PlatformString)->Range(8, 8 << 10);
+
+template<typename PlatformStringT>
+static void BM_containers_PlatformString_icmp(benchmark::State& state)
+{
+	const int32 len = state.range(0);
+
+	Array<ansichar> lhs{sizet(len + 1)}, rhs{sizet(len + 1)};
+	for (int32 i = 0; i < len; ++i)
+	{
+		lhs.append(ansichar('a' + i % 26));
+		rhs.append(ansichar('A' + i % 26));
+	}
+	lhs.append('\0');
+	rhs.append('\0');
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(PlatformStringT::icmp(*lhs, *rhs));
+	}
+
+	state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK_TEMPLATE(BM_containers_PlatformString_icmp, GenericPlatformString)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(BM_containers_PlatformString_icmp, PlatformString)->Range(8, 8 << 10);
+
+/**
+ * @brief Returns a log-like text of about
+ * the given size. The needles never occur
+ * before the last line.
+ */
+static String makeLog(sizet size)
+{
+	static char const* levels[4] = {"INFO", "DEBUG", "WARN", "TRACE"};
+
+	String log;
+	for (int32 i = 0; log.getLength() < size; ++i)
+	{
+		log += String{"2024-01-01 12:00:%02d.%03d [%s] worker-%d: request from user %s completed in %d ms\n"}.format(
+			i % 60, i % 1000, levels[i & 3], i % 16, names[i & 0xf], i % 997);
+	}
+	log += "2024-01-01 12:00:00.000 [ERROR] worker-0: connection reset by peer while reading request body\n";
+
+	return log;
+}
+
+static char const* shortNeedle = "[ERROR]";
+static char const* longNeedle = "connection reset by peer while reading request body";
+
+static void BM_containers_Korin_String_find_short(benchmark::State& state)
+{
+	String log = makeLog(state.range(0));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(log.find(shortNeedle));
+	}
+
+	state.SetBytesProcessed(state.iterations() * log.getLength());
+}
+BENCHMARK(BM_containers_Korin_String_find_short)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_std_string_find_short(benchmark::State& state)
+{
+	String log = makeLog(state.range(0));
+	std::string stdLog{*log, log.getLength()};
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(stdLog.find(shortNeedle));
+	}
+
+	state.SetBytesProcessed(state.iterations() * stdLog.size());
+}
+BENCHMARK(BM_containers_std_string_find_short)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_Korin_String_find_long(benchmark::State& state)
+{
+	String log = makeLog(state.range(0));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(log.find(longNeedle));
+	}
+
+	state.SetBytesProcessed(state.iterations() * log.getLength());
+}
+BENCHMARK(BM_containers_Korin_String_find_long)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_std_string_find_long(benchmark::State& state)
+{
+	String log = makeLog(state.range(0));
+	std::string stdLog{*log, log.getLength()};
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(stdLog.find(longNeedle));
+	}
+
+	state.SetBytesProcessed(state.iterations() * stdLog.size());
+}
+BENCHMARK(BM_containers_std_string_find_long)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_Korin_String_rfind_short(benchmark::State& state)
+{
+	String log = makeLog(state.range(0));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(log.rfind("worker-99"));
+	}
+
+	state.SetBytesProcessed(state.iterations() * log.getLength());
+}
+BENCHMARK(BM_containers_Korin_String_rfind_short)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_std_string_rfind_short(benchmark::State& state)
+{
+	String log = makeLog(state.range(0));
+	std::string stdLog{*log, log.getLength()};
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(stdLog.rfind("worker-99"));
+	}
+
+	state.SetBytesProcessed(state.iterations() * stdLog.size());
+}
+BENCHMARK(BM_containers_std_string_rfind_short)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_Korin_String_replace(benchmark::State& state)
+{
+	String log = makeLog(state.range(0));
+
+	for (auto _ : state)
+	{
+		String copy = log;
+		copy.replace("worker", "thread");
+		benchmark::DoNotOptimize(*copy);
+	}
+
+	state.SetBytesProcessed(state.iterations() * log.getLength());
+}
+BENCHMARK(BM_containers_Korin_String_replace)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_std_string_replace(benchmark::State& state)
+{
+	String log = makeLog(state.range(0));
+	std::string stdLog{*log, log.getLength()};
+
+	for (auto _ : state)
+	{
+		std::string copy = stdLog;
+		for (sizet pos = copy.find("worker"); pos != std::string::npos; pos = copy.find("worker", pos + 6))
+		{
+			copy.replace(pos, 6, "thread");
+		}
+		benchmark::DoNotOptimize(copy.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * stdLog.size());
+}
+BENCHMARK(BM_containers_std_string_replace)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_Korin_format(benchmark::State& state)
+{
+	int32 i = 0;
+	for (auto _ : state)
+	{
+		String line = format("2024-01-01 12:00:{:02}.{:03} [{}] worker-{}: request from user {} completed in {} ms",
+			i % 60, i % 1000, "INFO", i % 16, names[i & 0xf], i % 997);
+		benchmark::DoNotOptimize(*line);
+		++i;
+	}
+}
+BENCHMARK(BM_containers_Korin_format);
+
+static void BM_containers_Korin_String_format(benchmark::State& state)
+{
+	int32 i = 0;
+	for (auto _ : state)
+	{
+		String line = String{"2024-01-01 12:00:%02d.%03d [%s] worker-%d: request from user %s completed in %d ms"}.format(
+			i % 60, i % 1000, "INFO", i % 16, names[i & 0xf], i % 997);
+		benchmark::DoNotOptimize(*line);
+		++i;
+	}
+}
+BENCHMARK(BM_containers_Korin_String_format);
+
+static void BM_containers_Korin_formatTo(benchmark::State& state)
+{
+	ansichar buffer[128];
+	int32 i = 0;
+	for (auto _ : state)
+	{
+		formatTo(buffer, sizeof(buffer), "2024-01-01 12:00:{:02}.{:03} [{}] worker-{}: request from user {} completed in {} ms",
+			i % 60, i % 1000, "INFO", i % 16, names[i & 0xf], i % 997);
+		benchmark::DoNotOptimize(buffer);
+		++i;
+	}
+}
+BENCHMARK(BM_containers_Korin_formatTo);
+
+static void BM_containers_std_snprintf(benchmark::State& state)
+{
+	ansichar buffer[128];
+	int32 i = 0;
+	for (auto _ : state)
+	{
+		snprintf(buffer, sizeof(buffer), "2024-01-01 12:00:%02d.%03d [%s] worker-%d: request from user %s completed in %d ms",
+			i % 60, i % 1000, "INFO", i % 16, names[i & 0xf], i % 997);
+		benchmark::DoNotOptimize(buffer);
+		++i;
+	}
+}
+BENCHMARK(BM_containers_std_snprintf);
+
+static void BM_containers_Korin_format_float(benchmark::State& state)
+{
+	float64 x = 0.1;
+	for (auto _ : state)
+	{
+		String str = format("{} {:.3f}", x, x);
+		benchmark::DoNotOptimize(*str);
+		x += 1.37;
+	}
+}
+BENCHMARK(BM_containers_Korin_format_float);
+
+static void BM_containers_Korin_String_appendInt(benchmark::State& state)
+{
+	std::vector<int64> values(1024);
+	for (int64& value : values)
+	{
+		value = ((static_cast<int64>(rand()) * rand()) >> (rand() % 62)) * (rand() % 2 ? 1 : -1);
+	}
+
+	for (auto _ : state)
+	{
+		String str;
+		for (int64 value : values)
+		{
+			str.appendInt(value) += ',';
+		}
+		benchmark::DoNotOptimize(*str);
+	}
+
+	state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_containers_Korin_String_appendInt);
+
+static void BM_containers_std_snprintf_int(benchmark::State& state)
+{
+	std::vector<int64> values(1024);
+	for (int64& value : values)
+	{
+		value = ((static_cast<int64>(rand()) * rand()) >> (rand() % 62)) * (rand() % 2 ? 1 : -1);
+	}
+
+	for (auto _ : state)
+	{
+		std::string str;
+		for (int64 value : values)
+		{
+			ansichar buffer[32];
+			str.append(buffer, snprintf(buffer, sizeof(buffer), "%lld,", static_cast<long long>(value)));
+		}
+		benchmark::DoNotOptimize(str.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_containers_std_snprintf_int);
+
+static void BM_containers_Korin_String_appendFloat(benchmark::State& state)
+{
+	std::vector<float64> values(1024);
+	for (float64& value : values)
+	{
+		value = static_cast<float64>(rand() % 1000000) / static_cast<float64>(rand() % 1000 + 1);
+	}
+
+	for (auto _ : state)
+	{
+		String str;
+		for (float64 value : values)
+		{
+			str.appendFloat(value) += ',';
+		}
+		benchmark::DoNotOptimize(*str);
+	}
+
+	state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_containers_Korin_String_appendFloat);
+
+static void BM_containers_std_snprintf_float(benchmark::State& state)
+{
+	std::vector<float64> values(1024);
+	for (float64& value : values)
+	{
+		value = static_cast<float64>(rand() % 1000000) / static_cast<float64>(rand() % 1000 + 1);
+	}
+
+	for (auto _ : state)
+	{
+		std::string str;
+		for (float64 value : values)
+		{
+			ansichar buffer[32];
+			str.append(buffer, snprintf(buffer, sizeof(buffer), "%.17g,", value));
+		}
+		benchmark::DoNotOptimize(str.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_containers_std_snprintf_float);
+
+static void BM_containers_std_to_chars_float(benchmark::State& state)
+{
+	std::vector<float64> values(1024);
+	for (float64& value : values)
+	{
+		value = static_cast<float64>(rand() % 1000000) / static_cast<float64>(rand() % 1000 + 1);
+	}
+
+	for (auto _ : state)
+	{
+		std::string str;
+		for (float64 value : values)
+		{
+			ansichar buffer[32];
+			ansichar* const end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+			*end = ',';
+			str.append(buffer, end + 1 - buffer);
+		}
+		benchmark::DoNotOptimize(str.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_containers_std_to_chars_float);
+
+static void BM_containers_Korin_parseInt(benchmark::State& state)
+{
+	std::vector<String> tokens(1024);
+	for (String& token : tokens)
+	{
+		token = String{}.appendInt(((static_cast<int64>(rand()) * rand()) >> (rand() % 62)) * (rand() % 2 ? 1 : -1));
+	}
+
+	for (auto _ : state)
+	{
+		int64 sum = 0;
+		for (String const& token : tokens)
+		{
+			sum += *parseInt<int64>(token);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * tokens.size());
+}
+BENCHMARK(BM_containers_Korin_parseInt);
+
+static void BM_containers_std_strtoll(benchmark::State& state)
+{
+	std::vector<String> tokens(1024);
+	for (String& token : tokens)
+	{
+		token = String{}.appendInt(((static_cast<int64>(rand()) * rand()) >> (rand() % 62)) * (rand() % 2 ? 1 : -1));
+	}
+
+	for (auto _ : state)
+	{
+		int64 sum = 0;
+		for (String const& token : tokens)
+		{
+			sum += strtoll(*token, nullptr, 10);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * tokens.size());
+}
+BENCHMARK(BM_containers_std_strtoll);
+
+static void BM_containers_Korin_parseFloat(benchmark::State& state)
+{
+	std::vector<String> tokens(1024);
+	for (String& token : tokens)
+	{
+		token = String{}.appendFloat(static_cast<float64>(rand()) / static_cast<float64>(rand() % 1000 + 1));
+	}
+
+	for (auto _ : state)
+	{
+		float64 sum = 0;
+		for (String const& token : tokens)
+		{
+			sum += *parseFloat<float64>(token);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * tokens.size());
+}
+BENCHMARK(BM_containers_Korin_parseFloat);
+
+static void BM_containers_std_strtod(benchmark::State& state)
+{
+	std::vector<String> tokens(1024);
+	for (String& token : tokens)
+	{
+		token = String{}.appendFloat(static_cast<float64>(rand()) / static_cast<float64>(rand() % 1000 + 1));
+	}
+
+	for (auto _ : state)
+	{
+		float64 sum = 0;
+		for (String const& token : tokens)
+		{
+			sum += strtod(*token, nullptr);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * tokens.size());
+}
+BENCHMARK(BM_containers_std_strtod);
+
+/**
+ * @brief Returns random UTF-8 text, with the
+ * given percentage of non-ASCII characters.
+ */
+static String makeUtf8Text(sizet len, int32 nonAscii)
+{
+	static ansichar const* const symbols[] = {"\xc3\xa9", "\xd0\x96", "\xe2\x82\xac", "\xe6\x97\xa5", "\xf0\x9f\x98\x80"};
+
+	String text;
+	while (text.getLength() < len)
+	{
+		if (rand() % 100 < nonAscii) text += symbols[rand() % 5];
+		else text += ansichar('a' + rand() % 26);
+	}
+
+	return text;
+}
+
+static void BM_containers_Korin_isValidUtf8(benchmark::State& state)
+{
+	String text = makeUtf8Text(64 << 10, state.range(0));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(isValidUtf8(text));
+	}
+
+	state.SetBytesProcessed(state.iterations() * text.getLength());
+}
+BENCHMARK(BM_containers_Korin_isValidUtf8)->Arg(0)->Arg(1)->Arg(50);
+
+static void BM_containers_Generic_validateUtf8(benchmark::State& state)
+{
+	String text = makeUtf8Text(64 << 10, state.range(0));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(GenericPlatformString::validateUtf8(*text, text.getLength()));
+	}
+
+	state.SetBytesProcessed(state.iterations() * text.getLength());
+}
+BENCHMARK(BM_containers_Generic_validateUtf8)->Arg(0)->Arg(1)->Arg(50);
+
+static void BM_containers_std_memcpy_text(benchmark::State& state)
+{
+	String text = makeUtf8Text(64 << 10, 0);
+	std::vector<ansichar> buffer(text.getLength());
+
+	for (auto _ : state)
+	{
+		memcpy(buffer.data(), *text, text.getLength());
+		benchmark::DoNotOptimize(buffer.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * text.getLength());
+}
+BENCHMARK(BM_containers_std_memcpy_text);
+
+static void BM_containers_Korin_transcode_toWide(benchmark::State& state)
+{
+	String text = makeUtf8Text(64 << 10, state.range(0));
+	std::vector<widechar> buffer(maxTranscodedLength<widechar, ansichar>(text.getLength()));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(transcode(*text, text.getLength(), buffer.data()));
+	}
+
+	state.SetBytesProcessed(state.iterations() * text.getLength());
+}
+BENCHMARK(BM_containers_Korin_transcode_toWide)->Arg(0)->Arg(50);
+
+static void BM_containers_Korin_transcode_toUtf8(benchmark::State& state)
+{
+	WideString text = WideString::transcode(makeUtf8Text(64 << 10, state.range(0)));
+	std::vector<ansichar> buffer(maxTranscodedLength<ansichar, widechar>(text.getLength()));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(transcode(*text, text.getLength(), buffer.data()));
+	}
+
+	state.SetBytesProcessed(state.iterations() * text.getLength() * sizeof(widechar));
+}
+BENCHMARK(BM_containers_Korin_transcode_toUtf8)->Arg(0)->Arg(50);
+
+static void BM_containers_Korin_String_splitLines(benchmark::State& state)
+{
+	String log = makeLog(state.range(0));
+
+	for (auto _ : state)
+	{
+		sizet numWords = 0;
+		for (StringView line : log.splitLines())
+		{
+			for (StringView word : line.split(' '))
+			{
+				numWords += !word.isEmpty();
+			}
+		}
+		benchmark::DoNotOptimize(numWords);
+	}
+
+	state.SetBytesProcessed(state.iterations() * log.getLength());
+}
+BENCHMARK(BM_containers_Korin_String_splitLines)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_std_string_splitLines(benchmark::State& state)
+{
+	String log = makeLog(state.range(0));
+	std::string_view stdLog{*log, log.getLength()};
+
+	for (auto _ : state)
+	{
+		sizet numWords = 0;
+		for (sizet start = 0, end; start < stdLog.size(); start = end + 1)
+		{
+			end = PlatformMath::min(stdLog.find('\n', start), stdLog.size());
+			std::string_view const line = stdLog.substr(start, end - start);
+			for (sizet wordStart = 0, wordEnd; wordStart <= line.size(); wordStart = wordEnd + 1)
+			{
+				wordEnd = PlatformMath::min(line.find(' ', wordStart), line.size());
+				numWords += wordEnd > wordStart;
+			}
+		}
+		benchmark::DoNotOptimize(numWords);
+	}
+
+	state.SetBytesProcessed(state.iterations() * stdLog.size());
+}
+BENCHMARK(BM_containers_std_string_splitLines)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_Korin_String_tokenize(benchmark::State& state)
+{
+	String log = makeLog(state.range(0));
+
+	for (auto _ : state)
+	{
+		sizet numTokens = 0;
+		for (StringView token : log.tokenize(" []:\n"))
+		{
+			numTokens += token.getLength();
+		}
+		benchmark::DoNotOptimize(numTokens);
+	}
+
+	state.SetBytesProcessed(state.iterations() * log.getLength());
+}
+BENCHMARK(BM_containers_Korin_String_tokenize)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_std_string_tokenize(benchmark::State& state)
+{
+	String log = makeLog(state.range(0));
+	std::string_view stdLog{*log, log.getLength()};
+
+	for (auto _ : state)
+	{
+		sizet numTokens = 0;
+		for (sizet start = stdLog.find_first_not_of(" []:\n"), end; start < stdLog.size(); start = stdLog.find_first_not_of(" []:\n", end))
+		{
+			end = PlatformMath::min(stdLog.find_first_of(" []:\n", start), stdLog.size());
+			numTokens += end - start;
+		}
+		benchmark::DoNotOptimize(numTokens);
+	}
+
+	state.SetBytesProcessed(state.iterations() * stdLog.size());
+}
+BENCHMARK(BM_containers_std_string_tokenize)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_Korin_HashMap_String_find(benchmark::State& state)
+{
+	HashMap<String, int32> map;
+	const int32 numItems = state.range(0);
+
+	Array<String> keys{sizet(numItems)};
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		keys.append(String{"%s_%d"}.format(names[i & 0xf], i));
+		map.emplace(keys[i], i);
+	}
+
+	for (auto _ : state)
+	{
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			benchmark::DoNotOptimize(map.find(keys[i]));
+		}
+	}
+}
+BENCHMARK(BM_containers_Korin_HashMap_String_find)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_HashMap_Name_find(benchmark::State& state)
+{
+	HashMap<Name, int32> map;
+	const int32 numItems = state.range(0);
+
+	Array<Name> keys{sizet(numItems)};
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		keys.append(Name{String{"%s_%d"}.format(names[i & 0xf], i)});
+		map.emplace(keys[i], i);
+	}
+
+	for (auto _ : state)
+	{
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			benchmark::DoNotOptimize(map.find(keys[i]));
+		}
+	}
+}
+BENCHMARK(BM_containers_Korin_HashMap_Name_find)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_HashMap_LongString_find(benchmark::State& state)
+{
+	HashMap<String, int32> map;
+	const int32 numItems = 1024;
+
+	Array<String> keys{sizet(numItems)};
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		keys.append(String{'k', sizet(state.range(0))}.appendInt(i));
+		map.emplace(keys[i], i);
+	}
+
+	for (auto _ : state)
+	{
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			benchmark::DoNotOptimize(map.find(keys[i]));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK(BM_containers_Korin_HashMap_LongString_find)->Arg(16)->Arg(256)->Arg(4096);
+
+static void BM_containers_Korin_HashMap_HashedString_find(benchmark::State& state)
+{
+	HashMap<HashedString, int32> map;
+	const int32 numItems = 1024;
+
+	Array<HashedString> keys{sizet(numItems)};
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		keys.append(HashedString{String{'k', sizet(state.range(0))}.appendInt(i)});
+		map.emplace(keys[i], i);
+	}
+
+	for (auto _ : state)
+	{
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			benchmark::DoNotOptimize(map.find(keys[i]));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK(BM_containers_Korin_HashMap_HashedString_find)->Arg(16)->Arg(256)->Arg(4096);
+
+static void BM_containers_Korin_String_concat(benchmark::State& state)
+{
+	String scheme = "https";
+	String host{'h', sizet(state.range(0))};
+	StringView path = "index.html";
+
+	for (auto _ : state)
+	{
+		String url = scheme + "://" + host + '/' + path;
+		benchmark::DoNotOptimize(*url);
+	}
+}
+BENCHMARK(BM_containers_Korin_String_concat)->Arg(8)->Arg(64)->Arg(1024);
+
+static void BM_containers_std_string_concat(benchmark::State& state)
+{
+	std::string scheme = "https";
+	std::string host(state.range(0), 'h');
+	std::string_view path = "index.html";
+
+	for (auto _ : state)
+	{
+		std::string url = scheme + "://" + host + '/' + std::string{path};
+		benchmark::DoNotOptimize(url.data());
+	}
+}
+BENCHMARK(BM_containers_std_string_concat)->Arg(8)->Arg(64)->Arg(1024);
+
+static void BM_containers_Korin_String_join(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	Array<String> items{sizet(numItems)};
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		items.append(String{}.appendInt(rand()));
+	}
+
+	for (auto _ : state)
+	{
+		String str = String::join(items, ", ");
+		benchmark::DoNotOptimize(*str);
+	}
+
+	state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK(BM_containers_Korin_String_join)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_String_appendJoin(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	Array<String> items{sizet(numItems)};
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		items.append(String{}.appendInt(rand()));
+	}
+
+	for (auto _ : state)
+	{
+		String str;
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			if (i > 0) str += ", ";
+			str += items[i];
+		}
+		benchmark::DoNotOptimize(*str);
+	}
+
+	state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK(BM_containers_Korin_String_appendJoin)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_Rope_insert(benchmark::State& state)
+{
+	const sizet length = state.range(0);
+
+	Rope rope{String{'a', length}};
+	for (auto _ : state)
+	{
+		rope.insert(rand() % rope.getLength(), "korin");
+		benchmark::DoNotOptimize(rope.getLength());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_containers_Korin_Rope_insert)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_Korin_String_insert(benchmark::State& state)
+{
+	const sizet length = state.range(0);
+
+	String str{'a', length};
+	for (auto _ : state)
+	{
+		const sizet pos = rand() % str.getLength();
+		str = StringView{str}.substr(0, pos) + "korin" + StringView{str}.substr(pos);
+		benchmark::DoNotOptimize(*str);
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_containers_Korin_String_insert)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_Korin_Rope_remove(benchmark::State& state)
+{
+	const sizet length = state.range(0);
+
+	Rope rope{String{'a', length}};
+	for (auto _ : state)
+	{
+		rope.remove(rand() % (rope.getLength() - 8), 8);
+		rope.insert(rand() % rope.getLength(), "sneppy!!");
+		benchmark::DoNotOptimize(rope.getLength());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_containers_Korin_Rope_remove)->Range(64 << 10, 4 << 20);
+
+static void BM_containers_Korin_Rope_toString(benchmark::State& state)
+{
+	const sizet length = state.range(0);
+
+	Rope rope{String{'a', length}};
+	for (int32 i = 0; i < 1024; ++i)
+	{
+		rope.insert(rand() % rope.getLength(), String{'b', sizet(2048)});
+	}
+
+	for (auto _ : state)
+	{
+		String str = rope.toString();
+		benchmark::DoNotOptimize(*str);
+	}
+
+	state.SetBytesProcessed(state.iterations() * rope.getLength());
+}
+BENCHMARK(BM_containers_Korin_Rope_toString)->Range(64 << 10, 4 << 20);
+
+template<typename PlatformStringT>
+static void BM_containers_PlatformString_encodeHex(benchmark::State& state)
+{
+	const sizet n = state.range(0);
+
+	Array<ubyte> data(n, ubyte(0));
+	for (sizet i = 0; i < n; ++i)
+	{
+		data[i] = ubyte(rand());
+	}
+
+	Array<ansichar> text(2 * n, ansichar(0));
+	for (auto _ : state)
+	{
+		PlatformStringT::encodeHex(*data, n, *text, false);
+		benchmark::DoNotOptimize(*text);
+	}
+
+	state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_containers_PlatformString_encodeHex, GenericPlatformString)->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_containers_PlatformString_encodeHex, PlatformString)->Range(64, 64 << 10);
+
+template<typename PlatformStringT>
+static void BM_containers_PlatformString_decodeHex(benchmark::State& state)
+{
+	const sizet n = state.range(0);
+
+	Array<ubyte> data(n, ubyte(0));
+	for (sizet i = 0; i < n; ++i)
+	{
+		data[i] = ubyte(rand());
+	}
+
+	Array<ansichar> text(2 * n, ansichar(0));
+	PlatformString::encodeHex(*data, n, *text, rand() % 2);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(PlatformStringT::decodeHex(*text, 2 * n, *data));
+	}
+
+	state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_containers_PlatformString_decodeHex, GenericPlatformString)->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_containers_PlatformString_decodeHex, PlatformString)->Range(64, 64 << 10);
+
+template<typename PlatformStringT>
+static void BM_containers_PlatformString_encodeBase64(benchmark::State& state)
+{
+	const sizet n = state.range(0);
+
+	Array<ubyte> data(n, ubyte(0));
+	for (sizet i = 0; i < n; ++i)
+	{
+		data[i] = ubyte(rand());
+	}
+
+	Array<ansichar> text((4 * n + 2) / 3, ansichar(0));
+	for (auto _ : state)
+	{
+		PlatformStringT::encodeBase64(*data, n, *text, false);
+		benchmark::DoNotOptimize(*text);
+	}
+
+	state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_containers_PlatformString_encodeBase64, GenericPlatformString)->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_containers_PlatformString_encodeBase64, PlatformString)->Range(64, 64 << 10);
+
+template<typename PlatformStringT>
+static void BM_containers_PlatformString_decodeBase64(benchmark::State& state)
+{
+	const sizet n = state.range(0);
+
+	Array<ubyte> data(n, ubyte(0));
+	for (sizet i = 0; i < n; ++i)
+	{
+		data[i] = ubyte(rand());
+	}
+
+	Array<ansichar> text((4 * n + 2) / 3, ansichar(0));
+	PlatformString::encodeBase64(*data, n, *text, false);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(PlatformStringT::decodeBase64(*text, text.getNumItems(), *data, false));
+	}
+
+	state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_containers_PlatformString_decodeBase64, GenericPlatformString)->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_containers_PlatformString_decodeBase64, PlatformString)->Range(64, 64 << 10);
+
+static void BM_containers_Korin_toBase64(benchmark::State& state)
+{
+	const sizet n = state.range(0);
+
+	Array<ubyte> data(n, ubyte(0));
+	for (sizet i = 0; i < n; ++i)
+	{
+		data[i] = ubyte(rand());
+	}
+
+	for (auto _ : state)
+	{
+		String text = toBase64(*data, n);
+		benchmark::DoNotOptimize(*text);
+	}
+
+	state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_containers_Korin_toBase64)->Range(64, 64 << 10);
+
+static void BM_containers_Korin_murmur(benchmark::State& state)
+{
+	const sizet len = state.range(0);
+
+	Array<ubyte> data(len, ubyte(0));
+	for (sizet i = 0; i < len; ++i)
+	{
+		data[i] = ubyte(rand());
+	}
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(murmur(*data, len));
+	}
+
+	state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK(BM_containers_Korin_murmur)->Range(8, 64 << 10);
+
+static void BM_containers_Korin_hashBytes(benchmark::State& state)
+{
+	const sizet len = state.range(0);
+
+	Array<ubyte> data(len, ubyte(0));
+	for (sizet i = 0; i < len; ++i)
+	{
+		data[i] = ubyte(rand());
+	}
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(hashBytes(*data, len));
+	}
+
+	state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK(BM_containers_Korin_hashBytes)->Range(8, 64 << 10);
+
+static void BM_containers_Korin_Array_insert(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	Array<int32> items{sizet(numItems)};
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		items.append(i);
+	}
+
+	for (auto _ : state)
+	{
+		Array<int32> array;
+		array.append(-1, -2);
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			array.insert(1 + i, items[i]);
+		}
+		benchmark::DoNotOptimize(*array);
+	}
+}
+BENCHMARK(BM_containers_Korin_Array_insert)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_Array_insertRange(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	Array<int32> items{sizet(numItems)};
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		items.append(i);
+	}
+
+	for (auto _ : state)
+	{
+		Array<int32> array;
+		array.append(-1, -2);
+		array.insertRange(1, items.begin(), items.end());
+		benchmark::DoNotOptimize(*array);
+	}
+}
+BENCHMARK(BM_containers_Korin_Array_insertRange)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_HashMap_insert(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	Array<Pair<int32, int32>> pairs{sizet(numItems)};
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		pairs.append(Pair<int32, int32>{i, i});
+	}
+
+	for (auto _ : state)
+	{
+		HashMap<int32, int32> map;
+		for (auto const& pair : pairs)
+		{
+			map.insert(pair);
+		}
+		benchmark::DoNotOptimize(map.getSize());
+	}
+}
+BENCHMARK(BM_containers_Korin_HashMap_insert)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_HashMap_insertRange(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	Array<Pair<int32, int32>> pairs{sizet(numItems)};
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		pairs.append(Pair<int32, int32>{i, i});
+	}
+
+	for (auto _ : state)
+	{
+		HashMap<int32, int32> map;
+		map.insert(pairs.begin(), pairs.end());
+		benchmark::DoNotOptimize(map.getSize());
+	}
+}
+BENCHMARK(BM_containers_Korin_HashMap_insertRange)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_Set_insert(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	for (auto _ : state)
+	{
+		Set<int32> set;
+		for (int32 i = 0; i < numItems; ++i)
+		{
+			set.insert(i);
+		}
+		benchmark::DoNotOptimize(set.getSize());
+	}
+}
+BENCHMARK(BM_containers_Korin_Set_insert)->Range(8, 8 << 10);
+
+static void BM_containers_Korin_Set_insertRange(benchmark::State& state)
+{
+	const int32 numItems = state.range(0);
+
+	Array<int32> items{sizet(numItems)};
+	for (int32 i = 0; i < numItems; ++i)
+	{
+		items.append(i);
+	}
+
+	for (auto _ : state)
+	{
+		Set<int32> set;
+		set.insert(items.begin(), items.end());
+		benchmark::DoNotOptimize(set.getSize());
+	}
+}
+BENCHMARK(BM_containers_Korin_Set_insertRange)->Range(8, 8 << 10);
@@ -7,6 +7,14 @@ using namespace Korin;
 
 #include "hal/platform_crt.h"
 #include "containers/containers.h"
+#include "hal/atomic.h"
+
+// Linux includes
+#include <sys/mman.h>
+#include <unistd.h>
+
+// STL includes
+#include <thread>
 
 #define ARRAY_LEN(x) (sizeof(x) / sizeof(*x))
 
@@ -138,6 +146,483 @@ TEST(containers, Array)
 	ASSERT_EQ(z[3], 76);
 	ASSERT_EQ(z[2], x[2]);
 
+	{
+		int32 const items[] = {1, 2, 3, 4, 5};
+		Array<int32> w;
+
+		w.appendRange(items, items + 3);
+
+		ASSERT_EQ(w.getNumItems(), 3ull);
+		ASSERT_EQ(w[2], 3);
+
+		w.insertRange(1, items + 3, items + 5);
+
+		ASSERT_EQ(w.getNumItems(), 5ull);
+		ASSERT_EQ(w[0], 1);
+		ASSERT_EQ(w[1], 4);
+		ASSERT_EQ(w[2], 5);
+		ASSERT_EQ(w[3], 2);
+		ASSERT_EQ(w[4], 3);
+
+		w.assign(items + 1, items + 3);
+
+		ASSERT_EQ(w.getNumItems(), 2ull);
+		ASSERT_EQ(w[0], 2);
+		ASSERT_EQ(w[1], 3);
+
+		// Non-trivial items, shorter and longer than the tail
+		Array<String> u;
+		u.append(String{"sneppy"}, String{"korin"}, String{"lpraat"});
+
+		String const strs[] = {"a", "b", "c", "d"};
+		u.insertRange(2, strs, strs + 1);
+		u.insertRange(1, strs + 1, strs + 4);
+
+		ASSERT_EQ(u.getNumItems(), 7ull);
+		ASSERT_EQ(u[0], "sneppy");
+		ASSERT_EQ(u[1], "b");
+		ASSERT_EQ(u[2], "c");
+		ASSERT_EQ(u[3], "d");
+		ASSERT_EQ(u[4], "korin");
+		ASSERT_EQ(u[5], "a");
+		ASSERT_EQ(u[6], "lpraat");
+
+		List<int32> l;
+		l.pushBack(7);
+		l.pushBack(8);
+		w.insertRange(0, l.begin(), l.end());
+
+		ASSERT_EQ(w.getNumItems(), 4ull);
+		ASSERT_EQ(w[0], 7);
+		ASSERT_EQ(w[1], 8);
+		ASSERT_EQ(w[2], 2);
+	}
+
+	SUCCEED();
+}
+
+TEST(containers, Span)
+{
+	Array<int32> x;
+	for (int32 i = 0; i < 16; ++i)
+	{
+		x.append(i * i);
+	}
+
+	auto sum = [](Span<int32 const> items) {
+
+		int32 total = 0;
+		for (int32 item : items) total += item;
+		return total;
+	};
+
+	// Arrays convert implicitly, no copy involved
+	Span<int32> y = x;
+
+	ASSERT_EQ(*y, *x);
+	ASSERT_EQ(y.getNumItems(), x.getNumItems());
+	ASSERT_EQ(len(y), len(x));
+	ASSERT_EQ(sum(x), 1240);
+	ASSERT_EQ(sum(y), 1240);
+
+	Span<int32> z = x.view(4, 8);
+
+	ASSERT_EQ(z.getNumItems(), 4ull);
+	ASSERT_EQ(*z, *x + 4);
+	ASSERT_EQ(z[0], 16);
+	ASSERT_EQ(z.getLast(), 49);
+	ASSERT_EQ(sum(z), 16 + 25 + 36 + 49);
+
+	z[1] = -1;
+
+	ASSERT_EQ(x[5], -1);
+
+	auto w = y.subspan(10);
+
+	ASSERT_EQ(w.getNumItems(), 6ull);
+	ASSERT_EQ(w.getFirst(), 100);
+	ASSERT_EQ(w.subspan(1, 2)[1], 144);
+	ASSERT_EQ(w.slice(2, 4).getNumItems(), 2ull);
+	ASSERT_EQ(find(w.begin(), w.end(), 196), w.begin() + 4);
+	ASSERT_EQ(findIf(y.begin(), y.end(), [](int32 item) { return item < 0; }), y.begin() + 5);
+
+	int32 buffer[] = {3, 1, 4, 1, 5};
+	Span<int32 const> v = buffer;
+
+	ASSERT_EQ(v.getNumItems(), 5ull);
+	ASSERT_EQ(sum(buffer), 14);
+	ASSERT_EQ(sum({buffer + 1, buffer + 3}), 5);
+	ASSERT_EQ(v.asBytes().getNumItems(), sizeof(buffer));
+
+	Span<int32> u;
+
+	ASSERT_TRUE(u.isEmpty());
+	ASSERT_EQ(sum(u), 0);
+
+	// A literal zero is a count, not an end
+	Span<int32> t{buffer, 0};
+
+	ASSERT_TRUE(t.isEmpty());
+	ASSERT_EQ(*t, buffer);
+
+	SUCCEED();
+}
+
+TEST(containers, SharedArray)
+{
+	SharedArray<int32> x;
+
+	ASSERT_EQ(x.getNumItems(), 0ull);
+	ASSERT_EQ(x.getRefCount(), 0ull);
+	ASSERT_FALSE(x.isShared());
+
+	x.append(5, 1, 76);
+
+	ASSERT_EQ(x.getNumItems(), 3ull);
+	ASSERT_EQ(x.getRefCount(), 1ull);
+	ASSERT_EQ(x[2], 76);
+
+	{
+		SharedArray<int32> const y = x;
+
+		// Copies share the buffer
+		ASSERT_TRUE(x.isShared());
+		ASSERT_EQ(x.getRefCount(), 2ull);
+		ASSERT_EQ(*y, static_cast<SharedArray<int32> const&>(x).begin());
+
+		// Mutation detaches the copy
+		x[0] = 6;
+
+		ASSERT_FALSE(x.isShared());
+		ASSERT_EQ(y.getRefCount(), 1ull);
+		ASSERT_NE(*y, static_cast<SharedArray<int32> const&>(x).begin());
+		ASSERT_EQ(x[0], 6);
+		ASSERT_EQ(y[0], 5);
+		ASSERT_EQ(y[2], 76);
+
+		SharedArray<int32> z = y;
+		z.append(3);
+
+		ASSERT_EQ(y.getNumItems(), 3ull);
+		ASSERT_EQ(z.getNumItems(), 4ull);
+		ASSERT_EQ(z[3], 3);
+		ASSERT_FALSE(y.isShared());
+
+		z = y;
+		z.pop();
+
+		ASSERT_EQ(y.getNumItems(), 3ull);
+		ASSERT_EQ(z.getNumItems(), 2ull);
+	}
+
+	ASSERT_EQ(x.getRefCount(), 1ull);
+
+	{
+		Array<String> a;
+		a.append(String{"sneppy"}, String{"korin"});
+
+		SharedArray<String> b{move(a)};
+		SharedArray<String> c = b;
+
+		ASSERT_EQ(a.getNumItems(), 0ull);
+		ASSERT_EQ(b.getNumItems(), 2ull);
+		ASSERT_EQ(static_cast<SharedArray<String> const&>(c)[1], "korin");
+
+		c[1] += "rulez";
+
+		ASSERT_EQ(c[1], "korinrulez");
+		ASSERT_EQ(static_cast<SharedArray<String> const&>(b)[1], "korin");
+
+		Array<String> d = b.toArray();
+
+		ASSERT_EQ(d.getNumItems(), 2ull);
+		ASSERT_EQ(d[0], "sneppy");
+	}
+
+	{
+		SharedArray<int32> const src = x;
+		SegmentedArray<std::thread> threads;
+
+		// Copy and release concurrently
+		for (int32 i = 0; i < 4; ++i)
+		{
+			threads.append(std::thread{[&src]() {
+
+				for (int32 j = 0; j < 1000; ++j)
+				{
+					SharedArray<int32> copy = src;
+					ASSERT_EQ(copy.getNumItems(), 3ull);
+				}
+			}});
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		ASSERT_EQ(src.getRefCount(), 2ull);
+	}
+
+	SUCCEED();
+}
+
+TEST(containers, SegmentedArray)
+{
+	SegmentedArray<int32, 4> x;
+
+	ASSERT_EQ(x.getNumItems(), 0ull);
+	ASSERT_EQ(x.getNumChunks(), 0ull);
+	ASSERT_EQ(x.begin(), x.end());
+
+	x.append(0, 1, 2);
+
+	ASSERT_EQ(x.getNumItems(), 3ull);
+	ASSERT_EQ(x.getNumChunks(), 1ull);
+
+	int32* first = &x[0];
+
+	for (int32 i = 3; i < 18; ++i)
+	{
+		x.emplaceLast(i);
+	}
+
+	ASSERT_EQ(x.getNumItems(), 18ull);
+	ASSERT_EQ(x.getNumChunks(), 5ull);
+	ASSERT_EQ(len(x), 18ull);
+	ASSERT_EQ(&x[0], first);
+	ASSERT_EQ(x[17], 17);
+	ASSERT_EQ(&x[4], *x.getChunk(1));
+
+	int32 i = 0;
+	for (int32 item : x)
+	{
+		ASSERT_EQ(item, i++);
+	}
+
+	ASSERT_EQ(i, 18);
+
+	sizet numChunks = 0;
+	sizet numItems = 0;
+	x.forEachChunk([&](Span<int32> chunk) {
+
+		ASSERT_EQ(chunk.getFirst(), int32(numItems));
+		numChunks++;
+		numItems += chunk.getNumItems();
+	});
+
+	ASSERT_EQ(numChunks, 5ull);
+	ASSERT_EQ(numItems, 18ull);
+	ASSERT_EQ(x.getChunk(4).getNumItems(), 2ull);
+	ASSERT_EQ(x.getChunk(1).getLast(), 7);
+
+	for (int32 i = 0; i < 10; ++i)
+	{
+		x.pop();
+	}
+
+	ASSERT_EQ(x.getNumItems(), 8ull);
+	ASSERT_EQ(x.getNumChunks(), 3ull);
+	ASSERT_EQ(&x[0], first);
+
+	SegmentedArray<int32, 4> y = x;
+
+	ASSERT_EQ(y.getNumItems(), 8ull);
+	ASSERT_NE(&y[0], first);
+	ASSERT_EQ(y[7], 7);
+
+	SegmentedArray<int32, 4> z = move(x);
+
+	ASSERT_EQ(x.getNumItems(), 0ull);
+	ASSERT_EQ(z.getNumItems(), 8ull);
+	ASSERT_EQ(&z[0], first);
+
+	SegmentedArray<Testing::Object> w;
+
+	for (int32 i = 0; i < 200; ++i)
+	{
+		w.emplaceLast(sizet(i + 1));
+	}
+
+	ASSERT_EQ(w.getNumItems(), 200ull);
+	ASSERT_EQ(w[150].getSize(), 151ull);
+
+	w.reset();
+
+	ASSERT_EQ(w.getNumItems(), 0ull);
+	ASSERT_EQ(w.getNumChunks(), 0ull);
+
+	SUCCEED();
+}
+
+TEST(containers, SoAArray)
+{
+	SoAArray<float32, int64, Testing::Object> x;
+
+	ASSERT_EQ(x.getNumItems(), 0ull);
+	ASSERT_EQ(x.getNumColumns(), 3ull);
+	ASSERT_TRUE(x.getColumn<0>().isEmpty());
+
+	for (int32 i = 0; i < 100; ++i)
+	{
+		ASSERT_EQ(x.append(float32(i) * 0.5f, int64(i * i), sizet(i + 1)), sizet(i));
+	}
+
+	ASSERT_EQ(x.getNumItems(), 100ull);
+	ASSERT_EQ(len(x), 100ull);
+	ASSERT_GE(x.getCapacity(), 100ull);
+
+	// Columns are aligned to a cache line
+	ASSERT_EQ(uintp(*x.getColumn<0>()) % PLATFORM_CACHE_LINE_SIZE, 0ull);
+	ASSERT_EQ(uintp(*x.getColumn<1>()) % PLATFORM_CACHE_LINE_SIZE, 0ull);
+	ASSERT_EQ(uintp(*x.getColumn<2>()) % PLATFORM_CACHE_LINE_SIZE, 0ull);
+
+	auto row = x[10];
+
+	ASSERT_EQ(row.get<0>(), 5.f);
+	ASSERT_EQ(row.get<1>(), 100);
+	ASSERT_EQ(row.get<2>().getSize(), 11ull);
+
+	row.get<1>() = -1;
+
+	ASSERT_EQ(x.getColumn<1>()[10], -1);
+
+	int64 sum = 0;
+	for (int64 value : x.getColumn<1>())
+	{
+		sum += value;
+	}
+
+	ASSERT_EQ(sum, 328350 - 100 - 1);
+
+	x.pop();
+
+	ASSERT_EQ(x.getNumItems(), 99ull);
+	ASSERT_EQ(x.getColumn<2>().getLast().getSize(), 99ull);
+
+	SoAArray<float32, int64, Testing::Object> y = x;
+
+	ASSERT_EQ(y.getNumItems(), 99ull);
+	ASSERT_NE(*y.getColumn<0>(), *x.getColumn<0>());
+	ASSERT_EQ(y[98].get<1>(), 98 * 98);
+
+	SoAArray<float32, int64, Testing::Object> const z = move(x);
+
+	ASSERT_EQ(x.getNumItems(), 0ull);
+	ASSERT_EQ(z.getNumItems(), 99ull);
+	ASSERT_EQ(z[0].get<2>().getSize(), 1ull);
+
+	y.reset();
+
+	ASSERT_EQ(y.getNumItems(), 0ull);
+	ASSERT_EQ(y.getCapacity(), 0ull);
+
+	SUCCEED();
+}
+
+TEST(containers, BitArray)
+{
+	BitArray x{200};
+
+	ASSERT_EQ(x.getNumBits(), 200ull);
+	ASSERT_EQ(x.getNumWords(), 4ull);
+	ASSERT_EQ(x.count(), 0ull);
+	ASSERT_FALSE(x.any());
+	ASSERT_EQ(x.findFirstSet(), -1);
+
+	x.set(3);
+	x.set(64);
+	x.set(199);
+
+	ASSERT_TRUE(x[3]);
+	ASSERT_FALSE(x[4]);
+	ASSERT_EQ(x.count(), 3ull);
+	ASSERT_EQ(x.findFirstSet(), 3);
+	ASSERT_EQ(x.findNextSet(4), 64);
+	ASSERT_EQ(x.findNextSet(65), 199);
+	ASSERT_EQ(x.findNextSet(200), -1);
+
+	x.toggle(3);
+	x.clear(64);
+
+	ASSERT_EQ(x.count(), 1ull);
+
+	x.setRange(10, 140);
+
+	ASSERT_EQ(x.count(), 131ull);
+	ASSERT_FALSE(x[9]);
+	ASSERT_TRUE(x[10]);
+	ASSERT_TRUE(x[139]);
+	ASSERT_FALSE(x[140]);
+
+	x.clearRange(20, 30);
+	x.clearRange(60, 61);
+
+	ASSERT_EQ(x.count(), 120ull);
+
+	Array<sizet> setBits;
+	x.forEachSetBit([&setBits](sizet idx) { setBits.append(idx); });
+
+	ASSERT_EQ(setBits.getNumItems(), 120ull);
+	ASSERT_EQ(setBits[0], 10ull);
+	ASSERT_EQ(setBits[10], 30ull);
+	ASSERT_EQ(setBits[119], 199ull);
+
+	BitArray y{200, true};
+
+	ASSERT_EQ(y.count(), 200ull);
+	ASSERT_EQ(y.getWords()[3], 0xffull);
+
+	y.clearRange(0, 100);
+
+	ASSERT_EQ((x & y).count(), 41ull);
+	ASSERT_EQ((x | y).count(), 179ull);
+	ASSERT_EQ((x ^ y).count(), 138ull);
+	ASSERT_EQ(BitArray{x}.andNot(y).count(), 79ull);
+	ASSERT_EQ(BitArray{y}.flip().count(), 100ull);
+	ASSERT_TRUE(x == BitArray{x});
+	ASSERT_TRUE(x != y);
+
+	BitArray z;
+
+	for (int32 i = 0; i < 130; ++i)
+	{
+		z.append(i % 3 == 0);
+	}
+
+	ASSERT_EQ(z.getNumBits(), 130ull);
+	ASSERT_EQ(z.count(), 44ull);
+
+	z.resize(300, true);
+
+	ASSERT_EQ(z.count(), 44ull + 170ull);
+
+	z.resize(10);
+
+	ASSERT_EQ(z.getNumWords(), 1ull);
+	ASSERT_EQ(z.count(), 4ull);
+
+	// Long enough for the vector loops and their tails
+	BitArray a{1100}, b{1100};
+	sizet numA = 0, numB = 0, numBoth = 0;
+	for (sizet i = 0; i < 1100; ++i)
+	{
+		bool const bitA = i % 3 == 0, bitB = i % 7 < 3;
+		a.set(i, bitA);
+		b.set(i, bitB);
+		numA += bitA;
+		numB += bitB;
+		numBoth += bitA && bitB;
+	}
+
+	ASSERT_EQ(a.count(), numA);
+	ASSERT_EQ(b.count(), numB);
+	ASSERT_EQ((a & b).count(), numBoth);
+	ASSERT_EQ((a | b).count(), numA + numB - numBoth);
+	ASSERT_EQ((a ^ b).count(), numA + numB - 2 * numBoth);
+	ASSERT_EQ(BitArray{a}.andNot(b).count(), numA - numBoth);
+	ASSERT_TRUE(((a & b) | BitArray{a}.andNot(b)) == a);
+
 	SUCCEED();
 }
 
@@ -269,110 +754,557 @@ TEST(containers, List)
 	SUCCEED();
 }
 
-TEST(containers, TreeNode)
+TEST(containers, SpscQueue)
 {
-	struct NodeData
-	{
-		int32 value;
-	};
+	SpscQueue<int32> x{5};
 
-	using Node = BinaryNodeBase<NodeData>;
+	ASSERT_EQ(x.getCapacity(), 8ull);
+	ASSERT_TRUE(x.isEmpty());
+	ASSERT_EQ(x.peek(), nullptr);
 
-	constexpr uint32 numNodes = 1024;
-	Node* nodes[numNodes] = {};
-	Node* root = nullptr;
+	int32 item = -1;
 
-	for (int32 i = 0; i < numNodes; ++i)
-	{
-		auto* node = new Node{};
-		node->value = i;
-		root = TreeNode::insert(root, node, [node](auto const* other) {
+	ASSERT_FALSE(x.tryPop(item));
+	ASSERT_EQ(item, -1);
 
-			return GreaterThan{}(node->value, other->value);
-		});
+	for (int32 i = 0; i < 8; ++i)
+	{
+		ASSERT_TRUE(x.tryPush(i));
 	}
 
-	for (int32 i = 0; i < numNodes; ++i)
-	{
-		auto* node = TreeNode::find(root, [i](auto const* node) {
+	ASSERT_FALSE(x.tryPush(8));
+	ASSERT_EQ(x.getNumItems(), 8ull);
+	ASSERT_EQ(*x.peek(), 0);
 
-			return GreaterThan{}(i, node->value);
-		});
-		ASSERT_EQ(node->value, i);
-	}
+	ASSERT_TRUE(x.tryPop(item));
+	ASSERT_EQ(item, 0);
+	ASSERT_TRUE(x.tryPop(item));
+	ASSERT_EQ(item, 1);
 
-	for (int32 i = 0; i < numNodes; ++i)
-	{
-		auto* node = TreeNode::find(root, [i](auto const* node) {
+	// Batch push wraps around the end of the buffer
+	int32 batch[] = {8, 9, 10, 11};
 
-			return GreaterThan{}(i, node->value);
-		});
-		root = TreeNode::remove(node);
-		delete node;
-	}
+	ASSERT_EQ(x.tryPushBatch(batch), 2ull);
+	ASSERT_EQ(x.getNumItems(), 8ull);
 
-	int32 values[numNodes] = {};
-	for (int32 i = 0; i < numNodes; ++i)
+	int32 out[16] = {};
+
+	ASSERT_EQ(x.tryPopBatch(out), 8ull);
+	for (int32 i = 0; i < 8; ++i)
 	{
-		// Generate some collisions
-		values[i] = rand() % (numNodes << 4);
+		ASSERT_EQ(out[i], i + 2);
 	}
 
-	for (int32 i = 0; i < numNodes; ++i)
-	{
-		auto* node = new Node{};
-		node->value = values[i];
-		root = TreeNode::insert(root, node, [node](auto const* other) {
+	ASSERT_TRUE(x.isEmpty());
+	ASSERT_EQ(x.tryPopBatch(out), 0ull);
 
-			return GreaterThan{}(node->value, other->value);
-		});
-	}
+	SpscQueue<Testing::Object> y{4};
 
-	for (int32 i = 0; i < numNodes; ++i)
-	{
-		auto const value = values[i];
-		auto* node = TreeNode::find(root, [value](auto const* node) {
+	ASSERT_TRUE(y.tryEmplace(sizet(10)));
+	ASSERT_TRUE(y.tryPush(Testing::Object{20}));
+	ASSERT_TRUE(y.tryEmplace(sizet(30)));
 
-			return GreaterThan{}(value, node->value);
-		});
-		ASSERT_NE(node, nullptr);
-		ASSERT_EQ(node->value, value);
-	}
+	Testing::Object obj;
 
-	for (int32 i = 0; i < numNodes; ++i)
-	{
-		auto const value = values[i];
-		auto* node = TreeNode::find(root, [value](auto const* node) {
+	ASSERT_TRUE(y.tryPop(obj));
+	ASSERT_EQ(obj.getSize(), 10ull);
 
-			return GreaterThan{}(value, node->value);
-		});
-		root = TreeNode::remove(node);
-		delete node;
-	}
+	// Remaining items are destroyed with the queue
 
-	for (int32 i = 0; i < numNodes; ++i)
-	{
-		auto const value = values[i];
-		auto* node = TreeNode::find(root, [value](auto const* node) {
+	SpscQueue<uint64> z{64};
+	constexpr uint64 numItems = 100000;
 
-			return GreaterThan{}(value, node->value);
-		});
-		ASSERT_EQ(node, nullptr);
-	}
+	std::thread producer{[&z]() {
 
-	SUCCEED();
-}
+		uint64 buffer[7];
+		for (uint64 i = 0; i < numItems;)
+		{
+			uint64 numBatch = PlatformMath::min(numItems - i, uint64(ARRAY_LEN(buffer)));
+			for (uint64 j = 0; j < numBatch; ++j)
+			{
+				buffer[j] = i + j;
+			}
+
+			Span<uint64 const> batch{buffer, numBatch};
+			while (!batch.isEmpty())
+			{
+				sizet numPushed = z.tryPushBatch(batch);
+				if (numPushed == 0)
+				{
+					std::this_thread::yield();
+				}
+
+				batch = batch.subspan(numPushed);
+			}
+
+			i += numBatch;
+		}
+	}};
 
-TEST(containers, Tree)
-{
-	struct FindObject
+	uint64 next = 0;
+	bool ordered = true;
+	while (next < numItems)
 	{
-		int32 operator()(Testing::Object const& lhs, Testing::Object const& rhs) const
+		uint64 popped;
+		if (z.tryPop(popped))
 		{
-			return GreaterThan{}(lhs.getSize(), rhs.getSize());
+			ordered &= popped == next;
+			next++;
 		}
-	};
-
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	producer.join();
+
+	ASSERT_TRUE(ordered);
+	ASSERT_TRUE(z.isEmpty());
+
+	SUCCEED();
+}
+
+TEST(containers, MpmcQueue)
+{
+	MpmcQueue<int32> x{3};
+
+	ASSERT_EQ(x.getCapacity(), 4ull);
+	ASSERT_TRUE(x.isEmpty());
+
+	int32 item = -1;
+
+	ASSERT_FALSE(x.tryPop(item));
+	ASSERT_TRUE(x.tryPush(0));
+	ASSERT_TRUE(x.tryEmplace(1));
+
+	int32 batch[] = {2, 3, 4};
+
+	ASSERT_EQ(x.tryPushBatch(batch), 2ull);
+	ASSERT_FALSE(x.tryPush(5));
+	ASSERT_EQ(x.getNumItems(), 4ull);
+
+	ASSERT_TRUE(x.tryPop(item));
+	ASSERT_EQ(item, 0);
+
+	int32 out[8] = {};
+
+	ASSERT_EQ(x.tryPopBatch(out), 3ull);
+	ASSERT_EQ(out[0], 1);
+	ASSERT_EQ(out[2], 3);
+	ASSERT_TRUE(x.isEmpty());
+
+	// Wrap around a few laps
+	for (int32 i = 0; i < 10; ++i)
+	{
+		ASSERT_EQ(x.tryPushBatch(batch), 3ull);
+		ASSERT_EQ(x.tryPopBatch(out), 3ull);
+		ASSERT_EQ(out[1], 3);
+	}
+
+	MpmcQueue<Testing::Object> y{4};
+
+	ASSERT_TRUE(y.tryEmplace(sizet(10)));
+	ASSERT_TRUE(y.tryEmplace(sizet(20)));
+
+	Testing::Object obj;
+	y.pop(obj);
+
+	ASSERT_EQ(obj.getSize(), 10ull);
+
+	// Blocking push and pop with many threads
+	MpmcQueue<uint64> z{4};
+	constexpr uint64 numItems = 10000;
+	constexpr int32 numThreads = 3;
+
+	std::thread producers[numThreads];
+	std::thread consumers[numThreads];
+	Atomic<uint64> total{0};
+
+	for (int32 i = 0; i < numThreads; ++i)
+	{
+		producers[i] = std::thread{[&z, i]() {
+
+			for (uint64 j = 0; j < numItems; ++j)
+			{
+				z.push(j * numThreads + i);
+			}
+		}};
+
+		consumers[i] = std::thread{[&z, &total]() {
+
+			uint64 sum = 0;
+			for (uint64 j = 0; j < numItems; ++j)
+			{
+				uint64 popped;
+				z.pop(popped);
+				sum += popped;
+			}
+
+			total.fetchAdd(sum);
+		}};
+	}
+
+	for (int32 i = 0; i < numThreads; ++i)
+	{
+		producers[i].join();
+		consumers[i].join();
+	}
+
+	uint64 const n = numItems * numThreads;
+
+	ASSERT_EQ(total.load(), n * (n - 1) / 2);
+	ASSERT_TRUE(z.isEmpty());
+
+	SUCCEED();
+}
+
+TEST(containers, WorkStealingDeque)
+{
+	WorkStealingDeque<int64> x{2};
+
+	ASSERT_EQ(x.getCapacity(), 2ull);
+	ASSERT_TRUE(x.isEmpty());
+
+	int64 item = -1;
+
+	ASSERT_FALSE(x.tryPop(item));
+	ASSERT_FALSE(x.trySteal(item));
+
+	for (int64 i = 0; i < 10; ++i)
+	{
+		x.push(i);
+	}
+
+	ASSERT_EQ(x.getNumItems(), 10ull);
+	ASSERT_EQ(x.getCapacity(), 16ull);
+
+	// Owner pops from the bottom, thieves steal from the top
+	ASSERT_TRUE(x.tryPop(item));
+	ASSERT_EQ(item, 9);
+	ASSERT_TRUE(x.trySteal(item));
+	ASSERT_EQ(item, 0);
+	ASSERT_TRUE(x.trySteal(item));
+	ASSERT_EQ(item, 1);
+
+	for (int64 i = 8; i >= 2; --i)
+	{
+		ASSERT_TRUE(x.tryPop(item));
+		ASSERT_EQ(item, i);
+	}
+
+	ASSERT_FALSE(x.tryPop(item));
+	ASSERT_FALSE(x.trySteal(item));
+	ASSERT_TRUE(x.isEmpty());
+
+	// Every item is taken exactly once by the owner or a thief
+	WorkStealingDeque<int64> y;
+	constexpr int64 numItems = 100000;
+	constexpr int32 numThieves = 3;
+
+	Atomic<int64> total{0};
+	Atomic<bool> done{false};
+	std::thread thieves[numThieves];
+
+	for (int32 i = 0; i < numThieves; ++i)
+	{
+		thieves[i] = std::thread{[&y, &total, &done]() {
+
+			int64 sum = 0;
+			int64 stolen;
+			while (!done.load())
+			{
+				if (y.trySteal(stolen))
+				{
+					sum += stolen;
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+
+			total.fetchAdd(sum);
+		}};
+	}
+
+	int64 sum = 0;
+	for (int64 i = 1; i <= numItems; ++i)
+	{
+		y.push(i);
+		if (i % 3 == 0 && y.tryPop(item))
+		{
+			sum += item;
+		}
+	}
+
+	while (y.tryPop(item))
+	{
+		sum += item;
+	}
+
+	done.store(true);
+	for (int32 i = 0; i < numThieves; ++i)
+	{
+		thieves[i].join();
+	}
+
+	ASSERT_EQ(total.load() + sum, numItems * (numItems + 1) / 2);
+
+	SUCCEED();
+}
+
+TEST(containers, Deque)
+{
+	Deque<int32> x;
+
+	ASSERT_EQ(x.getNumItems(), 0ull);
+	ASSERT_TRUE(x.isEmpty());
+	ASSERT_EQ(x.begin(), x.end());
+
+	x.pushBack(1);
+	x.pushFront(0);
+	x.emplaceBack(2);
+
+	ASSERT_EQ(x.getNumItems(), 3ull);
+	ASSERT_EQ(x.getFirst(), 0);
+	ASSERT_EQ(x.getLast(), 2);
+	ASSERT_EQ(x[1], 1);
+
+	// Cross many chunks at both ends
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		x.pushBack(3 + i);
+		x.pushFront(-1 - i);
+	}
+
+	ASSERT_EQ(x.getNumItems(), 2003ull);
+	ASSERT_EQ(len(x), 2003ull);
+	ASSERT_EQ(x.getFirst(), -1000);
+	ASSERT_EQ(x.getLast(), 1002);
+
+	int32* item = &x[1000];
+
+	ASSERT_EQ(*item, 0);
+
+	int32 i = -1000;
+	for (int32 value : x)
+	{
+		ASSERT_EQ(value, i++);
+	}
+
+	for (int32 j = 0; j < 500; ++j)
+	{
+		ASSERT_EQ(x.popFront(), -1000 + j);
+		ASSERT_EQ(x.popBack(), 1002 - j);
+	}
+
+	// Items are never moved
+	ASSERT_EQ(&x[500], item);
+	ASSERT_EQ(x.getNumItems(), 1003ull);
+
+	int32 value;
+	while (x.popBack(value));
+
+	ASSERT_TRUE(x.isEmpty());
+	ASSERT_FALSE(x.popFront(value));
+
+	// FIFO usage does not grow memory indefinitely
+	for (int32 j = 0; j < 100000; ++j)
+	{
+		x.pushBack(j);
+		ASSERT_EQ(x.popFront(), j);
+	}
+
+	// Emptied from the front, the head ends up past the
+	// last chunk of the map for some numbers of items
+	for (int32 n = 1; n <= 1100; ++n)
+	{
+		Deque<int32> q;
+		for (int32 j = 0; j < n; ++j)
+		{
+			q.pushBack(j);
+		}
+
+		for (int32 j = 0; j < n; ++j)
+		{
+			ASSERT_EQ(q.popFront(), j);
+		}
+
+		q.pushBack(n);
+		q.pushFront(-n);
+
+		ASSERT_EQ(q.getNumItems(), 2ull);
+		ASSERT_EQ(q.popFront(), -n);
+		ASSERT_EQ(q.popFront(), n);
+	}
+
+	Deque<Testing::Object> y;
+
+	for (int32 j = 0; j < 100; ++j)
+	{
+		y.emplaceBack(sizet(j + 1));
+		y.emplaceFront(sizet(j + 1));
+	}
+
+	Deque<Testing::Object> z = y;
+
+	ASSERT_EQ(z.getNumItems(), 200ull);
+	ASSERT_EQ(z[0].getSize(), 100ull);
+	ASSERT_EQ(z[199].getSize(), 100ull);
+	ASSERT_EQ(z.popFront().getSize(), 100ull);
+
+	Deque<Testing::Object> w = move(y);
+
+	ASSERT_EQ(y.getNumItems(), 0ull);
+	ASSERT_EQ(w.getNumItems(), 200ull);
+
+	w = move(z);
+
+	ASSERT_EQ(w.getNumItems(), 199ull);
+
+	SUCCEED();
+}
+
+TEST(containers, Queue)
+{
+	Queue<int32> x;
+
+	ASSERT_TRUE(x.isEmpty());
+
+	for (int32 i = 0; i < 100; ++i)
+	{
+		x.push(i);
+	}
+
+	ASSERT_EQ(x.getNumItems(), 100ull);
+	ASSERT_EQ(x.getFront(), 0);
+	ASSERT_EQ(x.getBack(), 99);
+
+	for (int32 i = 0; i < 50; ++i)
+	{
+		ASSERT_EQ(x.pop(), i);
+	}
+
+	x.emplace(100);
+
+	int32 value;
+	int32 expected = 50;
+	while (x.pop(value))
+	{
+		ASSERT_EQ(value, expected++);
+	}
+
+	ASSERT_EQ(expected, 101);
+	ASSERT_TRUE(x.isEmpty());
+
+	SUCCEED();
+}
+
+TEST(containers, TreeNode)
+{
+	struct NodeData
+	{
+		int32 value;
+	};
+
+	using Node = BinaryNodeBase<NodeData>;
+
+	constexpr uint32 numNodes = 1024;
+	Node* nodes[numNodes] = {};
+	Node* root = nullptr;
+
+	for (int32 i = 0; i < numNodes; ++i)
+	{
+		auto* node = new Node{};
+		node->value = i;
+		root = TreeNode::insert(root, node, [node](auto const* other) {
+
+			return GreaterThan{}(node->value, other->value);
+		});
+	}
+
+	for (int32 i = 0; i < numNodes; ++i)
+	{
+		auto* node = TreeNode::find(root, [i](auto const* node) {
+
+			return GreaterThan{}(i, node->value);
+		});
+		ASSERT_EQ(node->value, i);
+	}
+
+	for (int32 i = 0; i < numNodes; ++i)
+	{
+		auto* node = TreeNode::find(root, [i](auto const* node) {
+
+			return GreaterThan{}(i, node->value);
+		});
+		root = TreeNode::remove(node);
+		delete node;
+	}
+
+	int32 values[numNodes] = {};
+	for (int32 i = 0; i < numNodes; ++i)
+	{
+		// Generate some collisions
+		values[i] = rand() % (numNodes << 4);
+	}
+
+	for (int32 i = 0; i < numNodes; ++i)
+	{
+		auto* node = new Node{};
+		node->value = values[i];
+		root = TreeNode::insert(root, node, [node](auto const* other) {
+
+			return GreaterThan{}(node->value, other->value);
+		});
+	}
+
+	for (int32 i = 0; i < numNodes; ++i)
+	{
+		auto const value = values[i];
+		auto* node = TreeNode::find(root, [value](auto const* node) {
+
+			return GreaterThan{}(value, node->value);
+		});
+		ASSERT_NE(node, nullptr);
+		ASSERT_EQ(node->value, value);
+	}
+
+	for (int32 i = 0; i < numNodes; ++i)
+	{
+		auto const value = values[i];
+		auto* node = TreeNode::find(root, [value](auto const* node) {
+
+			return GreaterThan{}(value, node->value);
+		});
+		root = TreeNode::remove(node);
+		delete node;
+	}
+
+	for (int32 i = 0; i < numNodes; ++i)
+	{
+		auto const value = values[i];
+		auto* node = TreeNode::find(root, [value](auto const* node) {
+
+			return GreaterThan{}(value, node->value);
+		});
+		ASSERT_EQ(node, nullptr);
+	}
+
+	SUCCEED();
+}
+
+TEST(containers, Tree)
+{
+	struct FindObject
+	{
+		int32 operator()(Testing::Object const& lhs, Testing::Object const& rhs) const
+		{
+			return GreaterThan{}(lhs.getSize(), rhs.getSize());
+		}
+	};
+
 	Tree<Testing::Object, FindObject> x, y, z;
 
 	static constexpr int32 numValues = 1 << 10;
@@ -582,14 +1514,34 @@ TEST(containers, Set)
 	ASSERT_TRUE((i & k).isDisjoint(i ^ k));
 	ASSERT_TRUE((j & k).isDisjoint(j ^ k));
 
-	SUCCEED();
-}
+	{
+		int32 const items[] = {0, 2, 4, 6, 8, 1, 3, 4, 5, 10};
+		Set<int32> w;
 
-TEST(containers, Map)
-{
-	Map<String, Testing::Object> x, y, z;
+		w.insert(items, items + ARRAY_LEN(items));
 
-	ASSERT_EQ(x.getSize(), 0);
+		ASSERT_EQ(w.getSize(), 9ull);
+
+		int32 prev = -1;
+		for (int32 v : w)
+		{
+			ASSERT_LT(prev, v);
+			prev = v;
+		}
+
+		ASSERT_EQ(prev, 10);
+		ASSERT_TRUE(w.contains(5));
+		ASSERT_FALSE(w.contains(7));
+	}
+
+	SUCCEED();
+}
+
+TEST(containers, Map)
+{
+	Map<String, Testing::Object> x, y, z;
+
+	ASSERT_EQ(x.getSize(), 0);
 	ASSERT_EQ(x.begin(), x.end());
 	ASSERT_EQ(x.find("sneppy"), x.end());
 
@@ -664,6 +1616,18 @@ TEST(containers, Map)
 
 	for (auto it = x.begin(); it != x.end(); it = x.remove(it));
 
+	{
+		Map<int32, int32> w;
+		Pair<int32, int32> const pairs[] = {{1, 1}, {2, 2}, {3, 3}, {2, 4}, {0, 5}};
+
+		w.insert(pairs, pairs + ARRAY_LEN(pairs));
+
+		ASSERT_EQ(w.getSize(), 4ull);
+		ASSERT_EQ(w.find(2)->second, 4);
+		ASSERT_EQ(w.find(0)->second, 5);
+		ASSERT_EQ(w.begin()->first, 0);
+	}
+
 	SUCCEED();
 }
 
@@ -806,11 +1770,1369 @@ TEST(containers, HashMap)
 		ASSERT_TRUE((i & 0x1 && it != o.end()) || (!(i & 0x1) && it == o.end()));
 	}
 
+	{
+		HashMap<int32, int32> w;
+		Array<Pair<int32, int32>> pairs;
+		for (int32 i = 0; i < 1000; ++i)
+		{
+			pairs.append(Pair<int32, int32>{i, i * 2});
+		}
+
+		w.insert(pairs.begin(), pairs.end());
+
+		ASSERT_EQ(w.getSize(), 1000ull);
+		ASSERT_EQ(w.find(500)->second, 1000);
+
+		// Duplicates are skipped
+		w.insert(pairs.begin(), pairs.begin() + 10);
+
+		ASSERT_EQ(w.getSize(), 1000ull);
+		ASSERT_GE(w.getNumBuckets() * HASH_BUCKET_LOAD_FACTOR, 1000.f);
+	}
+
 	SUCCEED();
 }
 
 TEST(containers, HashSet)
 {
-	// TODO
+	HashSet<int32> x;
+	for (int32 i = 0; i < 100; ++i)
+	{
+		x.insert(i);
+	}
+
+	// A moved-from set has no buckets
+	HashSet<int32> y = move(x);
+	ASSERT_EQ(y.getSize(), 100ull);
+	ASSERT_TRUE(y.contains(99));
+
+	x.insert(42);
+	ASSERT_EQ(x.getSize(), 1ull);
+	ASSERT_TRUE(x.contains(42));
+	ASSERT_FALSE(x.contains(41));
+}
+
+TEST(containers, Hash)
+{
+	srand(42);
+
+	Array<ubyte> data(8192 + 8, ubyte(0));
+	for (sizet i = 0; i < data.getNumItems(); ++i)
+	{
+		data[i] = ubyte(rand());
+	}
+
+	ASSERT_EQ(hashBytes("sneppy", 6), hashBytes(*String{"sneppy"}, 6));
+	ASSERT_EQ(StringView{"sneppy"}.toHashKey(), hashBytes("sneppy", 6));
+	ASSERT_NE(hashBytes("sneppy", 6), hashBytes("sneppy", 6, 1));
+	ASSERT_NE(hashBytes("", 0), hashBytes("", 0, 1));
+
+	// Prefixes of all lengths, unaligned, and
+	// one bit flips have distinct hashes
+	HashSet<HashKey> hashes;
+	for (sizet len = 0; len <= 8192; len += len < 300 ? 1 : 61)
+	{
+		HashKey const hkey = hashBytes(*data, len);
+		ASSERT_FALSE(hashes.contains(hkey));
+		hashes.insert(hkey);
+
+		PlatformMemory::memmove(*data + 3, *data, len);
+		ASSERT_EQ(hashBytes(*data + 3, len), hkey);
+		PlatformMemory::memmove(*data, *data + 3, len);
+
+		if (len > 0)
+		{
+			sizet const bit = rand() % (len * 8);
+			data[bit / 8] ^= 1 << (bit % 8);
+			ASSERT_NE(hashBytes(*data, len), hkey);
+			data[bit / 8] ^= 1 << (bit % 8);
+		}
+	}
+
+	// Integers spread over the low bits
+	for (uint64 stride : {1ull, 16ull, 1ull << 32})
+	{
+		HashSet<HashKey> buckets;
+		for (uint64 i = 0; i < 1024; ++i)
+		{
+			ASSERT_NE(hashInt(i * stride), hashInt((i + 1) * stride));
+			buckets.insert(hashInt(i * stride) & 1023);
+		}
+
+		ASSERT_GT(buckets.getSize(), 600ull);
+	}
+
+	HashSet<int64> keys;
+	for (int64 i = 0; i < 4096; ++i)
+	{
+		keys.insert(i << 16);
+	}
+
+	ASSERT_EQ(keys.getSize(), 4096ull);
+	ASSERT_TRUE(keys.contains(int64(4095) << 16));
+	ASSERT_FALSE(keys.contains(int64(4096) << 16));
+}
+
+TEST(containers, PlatformString)
+{
+	ASSERT_EQ(PlatformString::len(""), 0ull);
+	ASSERT_EQ(PlatformString::len("sneppy"), 6ull);
+	ASSERT_EQ(PlatformString::cmp("sneppy", "sneppy"), 0);
+	ASSERT_LT(PlatformString::cmp("snep", "sneppy"), 0);
+	ASSERT_GT(PlatformString::cmp("sneppz", "sneppy"), 0);
+	ASSERT_EQ(PlatformString::cmpn("sneppy", "sneppz", 5), 0);
+	ASSERT_LT(PlatformString::cmpn("sneppy", "sneppz", 6), 0);
+	ASSERT_EQ(PlatformString::cmpn("snep", "snep\0x", 6), 0);
+	ASSERT_EQ(PlatformString::icmp("SnEpPy", "sneppy"), 0);
+	ASSERT_NE(PlatformString::icmp("@", "`"), 0);
+	ASSERT_NE(PlatformString::icmp("[", "{"), 0);
+	ASSERT_LT(PlatformString::icmpn("SNEPPY", "sneppz", 6), 0);
+	ASSERT_EQ(PlatformString::icmpn("SNEPPY", "sneppz", 5), 0);
+
+	// High Bytes order as unsigned values,
+	// like in StringView::compare()
+	ASSERT_GT(PlatformString::cmp("sn\xe9ppy", "snappy"), 0);
+	ASSERT_GT(PlatformString::cmpn("sn\xe9ppy", "snappy", 6), 0);
+	ASSERT_GT(PlatformString::icmp("SN\xe9PPY", "snappy"), 0);
+	ASSERT_GT(PlatformString::icmpn("SN\xe9PPY", "snappy", 6), 0);
+	ASSERT_GT(StringView{"sn\xe9ppy"}.compare(StringView{"snappy"}), 0);
+	static_assert(PlatformString::cmp("\xff", "a") > 0);
+	ASSERT_STREQ(PlatformString::chr("sneppy", 'p'), "ppy");
+	ASSERT_EQ(PlatformString::chr("sneppy", 'x'), nullptr);
+	ASSERT_EQ(*PlatformString::chr("sneppy", '\0'), '\0');
+	ASSERT_EQ(PlatformString::spn("  \t sneppy", 10, " \t", 2), 4ull);
+	ASSERT_EQ(PlatformString::cspn("sneppy,rulez", 12, ",;", 2), 6ull);
+	ASSERT_EQ(PlatformString::cspn("sneppy", 6, ",;", 2), 6ull);
+	ASSERT_EQ(PlatformString::setMask("a,b;c", 5, ",;", 2), 0b1010ull);
+	ASSERT_EQ(PlatformString::setMask("a,b;c", 3, ",;", 2), 0b10ull);
+
+	static_assert(PlatformString::len("sneppy") == 6);
+	static_assert(PlatformString::cmp("sneppy", "sneppz") < 0);
+
+	// Place strings right before a protected
+	// page, reading past it would crash
+	sizet const pageSize = sysconf(_SC_PAGESIZE);
+	ubyte* pages = reinterpret_cast<ubyte*>(mmap(nullptr, 2 * pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+	ASSERT_NE(pages, MAP_FAILED);
+	ASSERT_EQ(mprotect(pages + pageSize, pageSize, PROT_NONE), 0);
+
+	ansichar* end = reinterpret_cast<ansichar*>(pages + pageSize);
+	ansichar other[256];
+	ansichar const set[] = "abcdefghijklmnopqrstuvwxyz";
+
+	for (sizet len = 0; len < 100; ++len)
+	{
+		ansichar* str = end - len - 1;
+		for (sizet i = 0; i < len; ++i)
+		{
+			str[i] = 'a' + (i * 7) % 26;
+			other[i] = str[i] - 'a' + 'A';
+		}
+
+		str[len] = other[len] = '\0';
+
+		ASSERT_EQ(PlatformString::len(str), len);
+		ASSERT_EQ(PlatformString::cmp(str, str), 0);
+		ASSERT_EQ(PlatformString::cmpn(str, str, len + 1), 0);
+		ASSERT_EQ(PlatformString::icmp(str, other), 0);
+		ASSERT_EQ(PlatformString::icmp(other, str), 0);
+		ASSERT_EQ(PlatformString::chr(str, '\0'), str + len);
+		ASSERT_EQ(PlatformString::chrn(str, len, '#'), nullptr);
+		ASSERT_EQ(PlatformString::spn(str, len, set, 26), len);
+		ASSERT_EQ(PlatformString::spn(str, len + 1, set, 10), GenericPlatformString::spn(str, len + 1, set, 10));
+		ASSERT_EQ(PlatformString::cspn(str, len, "#", 1), len);
+		ASSERT_EQ(PlatformString::setMask(str, len, "aeiou", 5), GenericPlatformString::setMask(str, len, "aeiou", 5));
+		ASSERT_EQ(PlatformString::setMask(str, len, set, 20), GenericPlatformString::setMask(str, len, set, 20));
+
+		// Mismatch at every position
+		for (sizet i = 0; i < len; ++i)
+		{
+			ansichar const c = str[i];
+			str[i] = '#';
+
+			ASSERT_EQ(PlatformString::cmp(str, other), GenericPlatformString::cmp(str, other));
+			ASSERT_EQ(PlatformString::icmp(other, str), GenericPlatformString::icmp(other, str));
+			ASSERT_EQ(PlatformString::icmpn(str, other, i), 0);
+			ASSERT_EQ(PlatformString::chrn(str, len, '#'), str + i);
+			ASSERT_EQ(PlatformString::chr(str, '#'), str + i);
+			ASSERT_EQ(PlatformString::spn(str, len, set, 26), i);
+			ASSERT_EQ(PlatformString::cspn(str, len, "#", 1), i);
+
+			str[i] = c;
+		}
+	}
+
+	// Compare with a naive search over strings
+	// with few distinct characters, which have
+	// many partial matches
+	auto const naiveFind = [](StringView hay, StringView needle, bool reverse) -> ssizet {
+
+		ssizet found = -1;
+		for (sizet i = 0; i + needle.getLength() <= hay.getLength(); ++i)
+		{
+			if (hay.substr(i, needle.getLength()) == needle)
+			{
+				found = i;
+				if (!reverse) break;
+			}
+		}
+
+		return found;
+	};
+
+	uint32 seed = 1;
+	auto const random = [&seed]() {
+
+		seed = seed * 1103515245 + 12345;
+		return seed >> 16;
+	};
+
+	for (int32 round = 0; round < 2000; ++round)
+	{
+		sizet const hayLen = random() % 300;
+		sizet const needleLen = 1 + random() % (round & 1 ? 8 : 48);
+		ansichar const numChars = 1 + random() % 3;
+
+		String hay, needle;
+		for (sizet i = 0; i < hayLen; ++i) hay += ansichar('a' + random() % numChars);
+		for (sizet i = 0; i < needleLen; ++i) needle += ansichar('a' + random() % numChars);
+
+		// Place the haystack right before the
+		// protected page
+		ansichar* src = end - hayLen;
+		PlatformMemory::memcpy(src, *hay, hayLen);
+
+		ansichar const* first = PlatformString::findn(src, hayLen, *needle, needleLen);
+		ansichar const* last = PlatformString::rfindn(src, hayLen, *needle, needleLen);
+		ssizet const firstIdx = naiveFind(hay, needle, false);
+		ssizet const lastIdx = naiveFind(hay, needle, true);
+
+		ASSERT_EQ(first ? first - src : -1, firstIdx);
+		ASSERT_EQ(last ? last - src : -1, lastIdx);
+
+		first = GenericPlatformString::findn(src, hayLen, *needle, needleLen);
+		last = GenericPlatformString::rfindn(src, hayLen, *needle, needleLen);
+
+		ASSERT_EQ(first ? first - src : -1, firstIdx);
+		ASSERT_EQ(last ? last - src : -1, lastIdx);
+	}
+
+	static_assert(GenericPlatformString::findn("abaabaabb", 9, "aabb", 4) - "abaabaabb" == 5);
+
+	// Long needles whose first and last
+	// characters match everywhere
+	String hay = String{"a"} * 50000;
+	hay += "b";
+	hay += String{"a"} * 40;
+	String needle = String{"a"} * 40;
+	needle += "ba";
+
+	ASSERT_EQ(PlatformString::findn(*hay, hay.getLength(), *needle, needle.getLength()) - *hay, 49960);
+	ASSERT_EQ(PlatformString::rfindn(*hay, hay.getLength(), *needle, needle.getLength()) - *hay, 49960);
+	ASSERT_EQ(PlatformString::findn(*hay, 50000, *needle, needle.getLength()), nullptr);
+	ASSERT_EQ(PlatformString::rfindn(*hay + 50001, 40, *needle, needle.getLength()), nullptr);
+
+	needle = String{"a"} * 35;
+	needle += "b";
+	needle += String{"a"} * 5;
+
+	ASSERT_EQ(PlatformString::findn(*hay, hay.getLength(), *needle, needle.getLength()) - *hay, 49965);
+	ASSERT_EQ(PlatformString::rfindn(*hay, hay.getLength(), *needle, needle.getLength()) - *hay, 49965);
+
+	munmap(pages, 2 * pageSize);
+}
+
+TEST(containers, String)
+{
+	String a;
+
+	ASSERT_TRUE(a.isInline());
+	ASSERT_EQ(a.getLength(), 0ull);
+	ASSERT_EQ(**a, '\0');
+	ASSERT_EQ(sizeof(String), 3 * sizeof(void*));
+
+	// Longest inline string
+	a = String{'a', 22};
+
+	ASSERT_TRUE(a.isInline());
+	ASSERT_EQ(a.getLength(), 22ull);
+	ASSERT_EQ(a.getCapacity(), 22ull);
+	ASSERT_EQ((*a)[22], '\0');
+
+	// Spills to the heap
+	a += 'b';
+
+	ASSERT_FALSE(a.isInline());
+	ASSERT_EQ(a.getLength(), 23ull);
+	ASSERT_GE(a.getCapacity(), 23ull);
+	ASSERT_EQ(a, "aaaaaaaaaaaaaaaaaaaaaab");
+
+	String b = "sneppy";
+
+	ASSERT_TRUE(b.isInline());
+	ASSERT_EQ(b, "sneppy");
+
+	String c = b;
+	c += "rulez";
+
+	ASSERT_EQ(b, "sneppy");
+	ASSERT_EQ(c, "sneppyrulez");
+
+	// Append to itself
+	c += c;
+
+	ASSERT_EQ(c, "sneppyrulezsneppyrulez");
+	ASSERT_TRUE(c.isInline());
+
+	c += c;
+
+	ASSERT_EQ(c.getLength(), 44ull);
+	ASSERT_FALSE(c.isInline());
+	ASSERT_EQ(c, "sneppyrulezsneppyrulezsneppyrulezsneppyrulez");
+
+	// Moved heap strings keep the buffer
+	ansichar const* data = *c;
+	String d = move(c);
+
+	ASSERT_EQ(*d, data);
+	ASSERT_TRUE(c.isInline());
+	ASSERT_EQ(c.getLength(), 0ull);
+
+	// Copy assignment reuses the heap buffer
+	d = b;
+
+	ASSERT_EQ(*d, data);
+	ASSERT_EQ(d, "sneppy");
+	ASSERT_EQ(d.getLength(), 6ull);
+
+	String e = "korin" + move(b);
+
+	ASSERT_EQ(e, "korinsneppy");
+	ASSERT_EQ(String{"ab"} * 3, "ababab");
+	ASSERT_EQ(String{"ab"} * 20, "abababababababababababababababababababab");
+
+	e *= 3;
+
+	ASSERT_EQ(e, "korinsneppykorinsneppykorinsneppy");
+	ASSERT_EQ(String{"%s-%d"}.format(e, 1), "korinsneppykorinsneppykorinsneppy-1");
+
+	// Hashes only depend on the characters
+	String f = String{"korinsneppy"} * 3;
+	String g = String{"korin"} + "sneppy";
+
+	ASSERT_EQ(ChooseHashPolicy<String>::Type{}(e), ChooseHashPolicy<String>::Type{}(f));
+	ASSERT_EQ(ChooseHashPolicy<String>::Type{}(g), ChooseHashPolicy<String>::Type{}(String{"korinsneppy"}));
+
+	// Search
+	String h = "korin sneppy korin sneppy";
+
+	ASSERT_EQ(h.find("sneppy"), 6);
+	ASSERT_EQ(h.find("sneppy", 7), 19);
+	ASSERT_EQ(h.find("sneppy", 20), -1);
+	ASSERT_EQ(h.find(""), 0);
+	ASSERT_EQ(h.find("", 25), 25);
+	ASSERT_EQ(h.find("", 26), -1);
+	ASSERT_EQ(h.rfind("korin"), 13);
+	ASSERT_EQ(h.rfind("korin", 12), 0);
+	ASSERT_EQ(h.rfind('y'), 24);
+	ASSERT_EQ(h.rfind('y', 23), 11);
+	ASSERT_EQ(h.rfind("rulez"), -1);
+	ASSERT_TRUE(h.contains("in sn"));
+	ASSERT_TRUE(h.contains(' '));
+	ASSERT_FALSE(h.contains("korinsneppy"));
+
+	Array<sizet> matches;
+	for (sizet idx : String{"aaaaa"}.findAll("aa"))
+	{
+		matches.append(idx);
+	}
+
+	ASSERT_EQ(matches.getNumItems(), 2ull);
+	ASSERT_EQ(matches[0], 0ull);
+	ASSERT_EQ(matches[1], 2ull);
+
+	// Temporary strings are kept alive by their ranges
+	Array<String> tokens;
+	for (StringView token : String{"a,b,c"}.split(','))
+	{
+		tokens.append(token);
+	}
+
+	for (StringView token : (String{"korin "} * 8).tokenize(" "))
+	{
+		tokens.append(token);
+	}
+
+	ASSERT_EQ(tokens.getNumItems(), 11ull);
+	ASSERT_EQ(tokens[2], "c");
+	ASSERT_EQ(tokens[10], "korin");
+
+	// Replace
+	h.replace("sneppy", "rulez");
+
+	ASSERT_EQ(h, "korin rulez korin rulez");
+
+	h.replace("korin", "korin-core");
+
+	ASSERT_EQ(h, "korin-core rulez korin-core rulez");
+
+	h.replace(" ", "");
+
+	ASSERT_EQ(h, "korin-corerulezkorin-corerulez");
+
+	h.replace("rulez", StringView{h}.substr(0, 5));
+
+	ASSERT_EQ(h, "korin-corekorinkorin-corekorin");
+	ASSERT_EQ(String{"aaa"}.replace("a", "aa"), "aaaaaa");
+	ASSERT_EQ(String{"aaa"}.replace("aa", "b"), "ba");
+	ASSERT_EQ(String{"abc"}.replace("", "x"), "abc");
+
+	SUCCEED();
+}
+
+TEST(containers, StringConcat)
+{
+	String a = "korin";
+	StringView b = "sneppy";
+	ansichar const* c = "rulez";
+
+	// Mixed operands
+	String d = a + ' ' + b + " " + c + '!';
+
+	ASSERT_EQ(d, "korin sneppy rulez!");
+	ASSERT_EQ(d.getLength(), 19ull);
+	ASSERT_EQ(String{b + a}, "sneppykorin");
+	ASSERT_EQ(String{"<" + a + ">"}, "<korin>");
+	ASSERT_EQ(String{'<' + a}, "<korin");
+	ASSERT_EQ((a + b + c).getLength(), 16ull);
+	ASSERT_EQ((a + b).toString(), "korinsneppy");
+	ASSERT_EQ(String{(a + "-") + (b + "-" + c)}, "korin-sneppy-rulez");
+	ASSERT_EQ(String{a + SharedString{"shared"} + HashedString{"hashed"}}, "korinsharedhashed");
+
+	// Rvalue strings are appended to
+	String e = move(d) + " " + a;
+
+	ASSERT_EQ(e, "korin sneppy rulez! korin");
+	ASSERT_EQ(String{String{"a"} + String{"b"}}, "ab");
+	ASSERT_EQ(String{String{"a"} + 'b'}, "ab");
+	ASSERT_EQ(String{"korin" + String{"sneppy"}}, "korinsneppy");
+
+	// Expressions can refer to the string they
+	// are appended to
+	String f = "ab";
+	f += f + f;
+
+	ASSERT_EQ(f, "ababab");
+
+	f += f + "cdefghijklmnopqrstuvwxyz";
+
+	ASSERT_EQ(f, "ababababababcdefghijklmnopqrstuvwxyz");
+
+	f = f + f;
+
+	ASSERT_EQ(f.getLength(), 72ull);
+
+	// Join
+	Array<String> items;
+
+	ASSERT_EQ(String::join(items, ", "), "");
+
+	items.append("korin");
+
+	ASSERT_EQ(String::join(items, ", "), "korin");
+
+	items.append("");
+	items.append("sneppy");
+
+	ASSERT_EQ(String::join(items, ", "), "korin, , sneppy");
+	ASSERT_EQ(String::join(items, ""), "korinsneppy");
+
+	StringView views[] = {"a", "b", "c"};
+
+	ASSERT_EQ(String::join(views, "/"), "a/b/c");
+}
+
+TEST(containers, Rope)
+{
+	Rope a;
+
+	ASSERT_TRUE(a.isEmpty());
+	ASSERT_EQ(a.getLength(), 0ull);
+	ASSERT_EQ(a.toString(), "");
+
+	a += "korin";
+	a += " rulez";
+	a.insert(5, " sneppy");
+	a.insert(0, "<");
+	a += ">";
+
+	ASSERT_EQ(a, "<korin sneppy rulez>");
+	ASSERT_EQ(a.getLength(), 20ull);
+	ASSERT_EQ(a.getNumChunks(), 1ull);
+	ASSERT_EQ(a[1], 'k');
+	ASSERT_EQ(a[19], '>');
+
+	a.remove(0, 1);
+	a.remove(a.getLength() - 1, 1);
+	a.remove(5, 7);
+
+	ASSERT_EQ(a, "korin rulez");
+	ASSERT_EQ(a.substr(6), "rulez");
+	ASSERT_EQ(a.substr(0, 5), "korin");
+	ASSERT_EQ(a.substr(11), "");
+
+	// Long texts get chunks of their own
+	String text{'a', Rope::maxMergedLength * 4};
+	Rope b{text};
+	b.insert(Rope::maxMergedLength, text);
+	b.insert(0, "x");
+
+	ASSERT_EQ(b.getLength(), text.getLength() * 2 + 1);
+	ASSERT_EQ(b.getNumChunks(), 4ull);
+	ASSERT_EQ(b[0], 'x');
+	ASSERT_EQ(b.toString(), String{"x" + text + text});
+
+	sizet length = 0;
+	for (StringView chunk : b.chunks())
+	{
+		length += chunk.getLength();
+	}
+
+	ASSERT_EQ(length, b.getLength());
+
+	// Copies share the chunks
+	Rope c = b;
+	c.remove(1, text.getLength());
+
+	ASSERT_EQ(c.toString(), String{"x" + text});
+	ASSERT_EQ(b.toString(), String{"x" + text + text});
+
+	c += c;
+
+	ASSERT_EQ(c.getLength(), text.getLength() * 2 + 2);
+	ASSERT_EQ(c.toString(), String{"x" + text + "x" + text});
+	ASSERT_EQ(c.substr(text.getLength() - 1, 4), "aaxa");
+
+	// Random edits
+	srand(42);
+
+	Rope rope;
+	String model;
+	for (int32 i = 0; i < 2000; ++i)
+	{
+		sizet const pos = model.getLength() ? rand() % (model.getLength() + 1) : 0;
+		if (rand() % 3 && model.getLength() < 64 << 10)
+		{
+			String insert{ansichar('a' + rand() % 26), sizet(rand() % 4 ? rand() % 16 : rand() % 4096)};
+			rope.insert(pos, insert);
+			model = StringView{model}.substr(0, pos) + insert + StringView{model}.substr(pos);
+		}
+		else
+		{
+			sizet const count = rand() % (model.getLength() - pos + 1);
+			rope.remove(pos, count);
+			model = StringView{model}.substr(0, pos) + StringView{model}.substr(pos + count);
+		}
+
+		ASSERT_EQ(rope.getLength(), model.getLength());
+	}
+
+	ASSERT_EQ(rope, model);
+	ASSERT_EQ(rope.toString(), model);
+	ASSERT_EQ(rope.substr(model.getLength() / 3, 1000), StringView{model}.substr(model.getLength() / 3, 1000));
+
+	for (sizet i = 0; i < model.getLength(); i += 97)
+	{
+		ASSERT_EQ(rope[i], model[i]);
+	}
+}
+
+TEST(containers, DataEncoding)
+{
+	sizet errorPos = 0;
+
+	// Test vectors of RFC 4648
+	ASSERT_EQ(toBase64("", 0), "");
+	ASSERT_EQ(toBase64("f", 1), "Zg==");
+	ASSERT_EQ(toBase64("fo", 2), "Zm8=");
+	ASSERT_EQ(toBase64("foo", 3), "Zm9v");
+	ASSERT_EQ(toBase64("foob", 4), "Zm9vYg==");
+	ASSERT_EQ(toBase64("fooba", 5), "Zm9vYmE=");
+	ASSERT_EQ(toBase64("foobar", 6), "Zm9vYmFy");
+	ASSERT_EQ(toBase64("fooba", 5, {.padding = false}), "Zm9vYmE");
+	ASSERT_EQ(toHex("foobar", 6), "666f6f626172");
+
+	ubyte const bytes[] = {0xfb, 0xff, 0xbf, 0x00, 0x9a};
+	ASSERT_EQ(toBase64(bytes, 5), "+/+/AJo=");
+	ASSERT_EQ(toBase64(bytes, 5, {.urlSafe = true}), "-_-_AJo=");
+	ASSERT_EQ(toHex(bytes, 5), "fbffbf009a");
+	ASSERT_EQ(toHex(bytes, 5, true), "FBFFBF009A");
+	ASSERT_EQ(base64EncodedLength(5), 8ull);
+	ASSERT_EQ(base64EncodedLength(5, {.padding = false}), 7ull);
+	ASSERT_EQ(base64DecodedLength("Zm9vYmE="), 5ull);
+	ASSERT_EQ(base64DecodedLength("Zm9vYmE"), 5ull);
+
+	ansichar buffer[16];
+	ASSERT_EQ(encodeBase64("fo", 2, buffer) - buffer, 4);
+	ASSERT_EQ(encodeHex("fo", 2, buffer) - buffer, 4);
+	ASSERT_EQ(StringView(buffer, 4), "666f");
+
+	// Decoding
+	ASSERT_EQ(fromHex("")->getNumItems(), 0ull);
+	ASSERT_EQ(fromBase64("")->getNumItems(), 0ull);
+	ASSERT_EQ(String(reinterpret_cast<ansichar const*>(**fromBase64("Zm9vYmFy")), 6), "foobar");
+	ASSERT_EQ(String(reinterpret_cast<ansichar const*>(**fromBase64("Zm9vYmE")), 5), "fooba");
+	ASSERT_EQ(String(reinterpret_cast<ansichar const*>(**fromHex("666F6f626172")), 6), "foobar");
+	ASSERT_EQ(fromBase64("-_-_AJo=", {.urlSafe = true})->getNumItems(), 5ull);
+
+	ubyte decoded[8]{};
+	ASSERT_EQ(*decodeBase64("+/+/AJo", decoded) - decoded, 5);
+	ASSERT_EQ(decoded[0], 0xfb);
+	ASSERT_EQ(decoded[4], 0x9a);
+	ASSERT_EQ(*decodeHex("fbff", decoded) - decoded, 2);
+
+	// Empty input succeeds even without a buffer
+	ASSERT_TRUE(decodeHex("", nullptr).hasValue());
+	ASSERT_EQ(*decodeBase64("", decoded), decoded);
+	ASSERT_FALSE(decodeHex("f", decoded).hasValue());
+
+	// Errors
+	ASSERT_FALSE(fromHex("abc", &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 3);
+	ASSERT_FALSE(fromHex("ab0g", &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 3);
+	ASSERT_FALSE(fromBase64("Zm9vY", {}, &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 5);
+	ASSERT_FALSE(fromBase64("Zm9=Yg==", {}, &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 3);
+	ASSERT_FALSE(fromBase64("Zg=", {}, &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 2);
+	ASSERT_FALSE(fromBase64("-_-_", {}, &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 0);
+	ASSERT_FALSE(fromBase64("+/+/", {.urlSafe = true}, &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 0);
+	ASSERT_FALSE(fromBase64("Zh==", {}, &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 1);
+
+	// Long buffers use the vector paths
+	srand(42);
+
+	Array<ubyte> data(1000, ubyte(0));
+	for (sizet i = 0; i < 1000; ++i)
+	{
+		data[i] = ubyte(rand());
+	}
+
+	for (sizet n : {31ull, 32ull, 100ull, 1000ull})
+	{
+		String const hex = toHex(*data, n);
+		String const base64 = toBase64(*data, n, {.urlSafe = n % 2 == 0});
+		ASSERT_EQ(hex.getLength(), 2 * n);
+
+		Optional<Array<ubyte>> fromHexData = fromHex(hex);
+		Optional<Array<ubyte>> fromBase64Data = fromBase64(base64, {.urlSafe = n % 2 == 0});
+		ASSERT_TRUE(fromHexData.hasValue());
+		ASSERT_TRUE(fromBase64Data.hasValue());
+		ASSERT_EQ(fromHexData->getNumItems(), n);
+		ASSERT_EQ(fromBase64Data->getNumItems(), n);
+		ASSERT_EQ(PlatformMemory::memcmp(**fromHexData, *data, n), 0);
+		ASSERT_EQ(PlatformMemory::memcmp(**fromBase64Data, *data, n), 0);
+
+		String invalid = base64;
+		invalid[n / 2] = '.';
+		ASSERT_FALSE(fromBase64(invalid, {.urlSafe = n % 2 == 0}, &errorPos).hasValue());
+		ASSERT_EQ(errorPos, n / 2);
+		invalid = hex;
+		invalid[n + 1] = 'x';
+		ASSERT_FALSE(fromHex(invalid, &errorPos).hasValue());
+		ASSERT_EQ(errorPos, n + 1);
+	}
+}
+
+TEST(containers, StringView)
+{
+	StringView a;
+
+	ASSERT_TRUE(a.isEmpty());
+	ASSERT_EQ(a, "");
+
+	String b = "sneppyrulez";
+	StringView c = b;
+
+	ASSERT_EQ(c.getLength(), 11ull);
+	ASSERT_EQ(*c, *b);
+	ASSERT_EQ(c, "sneppyrulez");
+	ASSERT_EQ(c, b);
+	ASSERT_EQ(b, c);
+
+	// Views are not null-terminated
+	StringView d = c.substr(0, 6);
+
+	ASSERT_EQ(d, "sneppy");
+	ASSERT_NE(d, "sneppyrulez");
+	ASSERT_NE(d, "snep");
+	ASSERT_EQ(c.substr(6), "rulez");
+	ASSERT_EQ(c.substr(6, 100), "rulez");
+	ASSERT_TRUE(c.substr(20).isEmpty());
+	ASSERT_EQ(String{d}, "sneppy");
+	ASSERT_FALSE(b == d);
+
+	ASSERT_EQ(c.find("rulez"), 6);
+	ASSERT_EQ(c.find('p'), 3);
+	ASSERT_EQ(c.find('p', 4), 4);
+	ASSERT_EQ(c.find("rulez!"), -1);
+	ASSERT_EQ(c.find('x'), -1);
+
+	ASSERT_LT(d.compare("sneppz"), 0);
+	ASSERT_GT(d.compare("snep"), 0);
+	ASSERT_EQ(d.compare("sneppy"), 0);
+	ASSERT_TRUE(d < c);
+	ASSERT_TRUE(String{"ab"} < String{"abc"});
+	ASSERT_TRUE(String{"abc"} > String{"ab"});
+
+	// Hashes match strings with the same characters
+	ASSERT_EQ(ChooseHashPolicy<StringView>::Type{}(d), ChooseHashPolicy<String>::Type{}(String{"sneppy"}));
+
+	// Lookups by view or C string
+	Map<String, int32> map;
+	map.emplace("sneppy", 1);
+	map.emplace("snep", 2);
+	map.emplace("sneppyrulez", 3);
+
+	ASSERT_EQ(map.find(d)->second, 1);
+	ASSERT_EQ(map.find("snep")->second, 2);
+	ASSERT_EQ(map.find(c)->second, 3);
+	ASSERT_FALSE(map.contains(c.substr(0, 5)));
+
+	HashMap<String, int32> hashMap;
+	hashMap.emplace("sneppy", 1);
+	hashMap.emplace("sneppyrulez", 3);
+
+	ASSERT_EQ(hashMap.find(d)->second, 1);
+	ASSERT_EQ(hashMap.find("sneppyrulez")->second, 3);
+	ASSERT_FALSE(hashMap.contains(c.substr(0, 5)));
+
+	Set<String> set;
+	set.insert("sneppy");
+
+	ASSERT_TRUE(set.contains(d));
+	ASSERT_FALSE(set.contains(c));
+
+	HashSet<String> hashSet;
+	hashSet.insert("sneppy");
+
+	ASSERT_TRUE(hashSet.contains(d));
+	ASSERT_FALSE(hashSet.contains(c));
+
+	// Split
+	auto const tokens = [](auto&& range) {
+
+		Array<StringView> out;
+		for (StringView token : range)
+		{
+			out.append(token);
+		}
+
+		return out;
+	};
+
+	auto const expectTokens = [](Array<StringView> const& actual, std::initializer_list<StringView> expected) {
+
+		ASSERT_EQ(actual.getNumItems(), expected.size());
+
+		sizet idx = 0;
+		for (StringView token : expected)
+		{
+			ASSERT_EQ(actual[idx++], token);
+		}
+	};
+
+	StringView const e = "a,b,,c,";
+	expectTokens(tokens(e.split(',')), {"a", "b", "", "c", ""});
+	expectTokens(tokens(e.split(',', {.skipEmpty = true})), {"a", "b", "c"});
+	expectTokens(tokens(StringView{}.split(',')), {""});
+	expectTokens(tokens(StringView{}.split(',', {.skipEmpty = true})), {});
+	expectTokens(tokens(StringView{"abc"}.split(',')), {"abc"});
+	expectTokens(tokens(StringView{"a::b::"}.split("::")), {"a", "b", ""});
+	expectTokens(tokens(StringView{"a::b"}.split("")), {"a::b"});
+	expectTokens(tokens(StringView{"  hello \t world\n"}.tokenize(" \t\n")), {"hello", "world"});
+	expectTokens(tokens(StringView{" a b"}.tokenize(" ", {})), {"", "a", "b"});
+	expectTokens(tokens(StringView{"one\ntwo\r\n\nthree\n"}.splitLines()), {"one", "two", "", "three"});
+	expectTokens(tokens(StringView{"one\n\n"}.splitLines()), {"one", ""});
+	expectTokens(tokens(StringView{"one\n\n"}.splitLines({.skipEmpty = true})), {"one"});
+	expectTokens(tokens(StringView{"\n"}.splitLines()), {""});
+	expectTokens(tokens(StringView{}.splitLines()), {});
+
+	// Quoted fields
+	StringView const f = "1,\"a,b\",\"say \"\"hi\"\"\",\"\",x\"y,\"q\"z,\"open,end";
+	expectTokens(tokens(f.split(',')), {"1", "\"a", "b\"", "\"say \"\"hi\"\"\"", "\"\"", "x\"y", "\"q\"z", "\"open", "end"});
+	expectTokens(tokens(f.split(',', {.quoted = true})), {"1", "a,b", "say \"\"hi\"\"", "", "x\"y", "\"q\"z", "\"open,end"});
+	expectTokens(tokens(f.split(',', {.skipEmpty = true, .quoted = true})), {"1", "a,b", "say \"\"hi\"\"", "x\"y", "\"q\"z", "\"open,end"});
+	expectTokens(tokens(StringView{"\"a\nb\"\nc"}.splitLines({.quoted = true})), {"a\nb", "c"});
+	expectTokens(tokens(StringView{"\"\"\"\""}.split(',', {.quoted = true})), {"\"\""});
+
+	String const g = "x y  z";
+	expectTokens(tokens(g.tokenize(" ")), {"x", "y", "z"});
+	expectTokens(tokens(g.split(' ')), {"x", "y", "", "z"});
+
+	static_assert([]() {
+
+		sizet numTokens = 0;
+		for (StringView token : StringView{"a,b,c"}.split(','))
+		{
+			numTokens += token.getLength();
+		}
+
+		return numTokens;
+	}() == 3);
+
+	SUCCEED();
+}
+
+TEST(containers, Format)
+{
+	ASSERT_EQ(format("sneppy"), "sneppy");
+	ASSERT_EQ(format("{} {}", "korin", String{"sneppy"}), "korin sneppy");
+	ASSERT_EQ(format("{1}-{0}-{1}", 1, 2), "2-1-2");
+	ASSERT_EQ(format("{{}} {{{}}}", 3), "{} {3}");
+	ASSERT_EQ(format("{}", StringView{"korinsneppy"}.substr(5)), "sneppy");
+
+	// Integers
+	ASSERT_EQ(format("{} {} {}", 0, -42, 18446744073709551615ull), "0 -42 18446744073709551615");
+	ASSERT_EQ(format("{}", int64(-9223372036854775807ll - 1)), "-9223372036854775808");
+	ASSERT_EQ(format("{:x} {:X} {:#x} {:o} {:#o} {:b} {:#B}", 255, 255, 255, 8, 8, 5, 5), "ff FF 0xff 10 010 101 0B101");
+	ASSERT_EQ(format("{:+} {:+} {: }", 1, -1, 1), "+1 -1  1");
+	ASSERT_EQ(format("{:5}|{:<5}|{:^5}|{:*>5}", 42, 42, 42, 42), "   42|42   | 42  |***42");
+	ASSERT_EQ(format("{:05} {:+06} {:#010x}", -42, 42, 255), "-0042 +00042 0x000000ff");
+	ASSERT_EQ(format("{:c}{:c}", 75, uint8('o')), "Ko");
+	ASSERT_EQ(format("{}", uint8(200)), "200");
+	ASSERT_EQ(format("{}", int8(-100)), "-100");
+
+	// Characters and booleans
+	ASSERT_EQ(format("{}{:d}{:>3}", 'a', 'a', 'b'), "a97  b");
+	ASSERT_EQ(format("{} {:d} {:>6}", true, false, false), "true 0  false");
+
+	// Floating-point numbers
+	ASSERT_EQ(format("{} {} {} {}", 0.1, 1.0, 1.5f, 0.1f), "0.1 1 1.5 0.1");
+	ASSERT_EQ(format("{} {}", 1e100, -2.5e-10), "1e+100 -2.5e-10");
+	ASSERT_EQ(format("{}", 0.30000000000000004), "0.30000000000000004");
+	ASSERT_EQ(format("{:.2f} {:.3e} {:f}", 3.14159, 1234.5, 2.0), "3.14 1.234e+03 2.000000");
+	ASSERT_EQ(format("{:8.2f}|{:<8.2f}|{:08.2f}|{:+.1f}", -3.14159, 3.14159, -3.14159, 2.0), "   -3.14|3.14    |-0003.14|+2.0");
+	ASSERT_EQ(format("{} {}", 1.0 / 0.0, -1.0 / 0.0), "inf -inf");
+	ASSERT_EQ(format("{:+} {:#} {:#} {:08}", 1.5, 2.0, 1e20, -1.5), "+1.5 2. 1.e+20 -00001.5");
+
+	// Strings and pointers
+	ASSERT_EQ(format("{:>8}|{:<8}|{:^8}|{:.3}", "abc", "abc", "abc", "abcdef"), "     abc|abc     |  abc   |abc");
+	ASSERT_EQ(format("{:-^10}", String{"snep"}), "---snep---");
+	ansichar const* nullStr = nullptr;
+	ASSERT_EQ(format("{}", nullStr), "(null)");
+	ASSERT_EQ(format("{}", reinterpret_cast<void*>(0xbeef)), "0xbeef");
+
+	// Containers
+	Array<int32> arr;
+	ASSERT_EQ(format("{}", arr), "[]");
+	arr.append(1);
+	arr.append(2);
+	arr.append(3);
+	ASSERT_EQ(format("{}", arr), "[1, 2, 3]");
+	ASSERT_EQ(format("{:02x}", arr), "[01, 02, 03]");
+	ASSERT_EQ(format("{}", tup(1, String{"a"}, 2.5)), "(1, a, 2.5)");
+	ASSERT_EQ(format("{} {}", Optional<int32>{}, Optional<int32>{3}), "none 3");
+
+	// Long output moves to the heap
+	String const longStr{'x', 1000};
+	String expected = "<";
+	expected += longStr;
+	expected += ">1";
+	ASSERT_EQ(format("<{}>{}", longStr, 1), expected);
+
+	// Append to a string
+	String log = "log:";
+	formatTo(log, " {}={}", "a", 1);
+	formatTo(log, " {}={}", "b", 2.5);
+	ASSERT_EQ(log, "log: a=1 b=2.5");
+
+	// Fixed buffers are truncated and
+	// null-terminated
+	ansichar buffer[8];
+	ASSERT_EQ(formatTo(buffer, sizeof(buffer), "{}-{}", 12, 34), 5ull);
+	ASSERT_EQ(StringView{buffer}, "12-34");
+	ASSERT_EQ(formatTo(buffer, sizeof(buffer), "{}", "korinsneppy"), 11ull);
+	ASSERT_EQ(StringView{buffer}, "korinsn");
+	ASSERT_EQ(formatTo(buffer, sizet(0), "{}", 1), 1ull);
+
+	SUCCEED();
+}
+
+TEST(containers, NumberToString)
+{
+	ansichar buffer[maxFloatLength];
+	auto const toString = [&](auto value) -> StringView {
+
+		if constexpr (SameType<decltype(value), float64>::value || SameType<decltype(value), float32>::value)
+		{
+			return {buffer, sizet(floatToChars(buffer, value) - buffer)};
+		}
+		else
+		{
+			return {buffer, sizet(intToChars(buffer, value) - buffer)};
+		}
+	};
+
+	// Integers
+	ASSERT_EQ(toString(0), "0");
+	ASSERT_EQ(toString(7), "7");
+	ASSERT_EQ(toString(-42), "-42");
+	ASSERT_EQ(toString(1000000), "1000000");
+	ASSERT_EQ(toString(uint8(255)), "255");
+	ASSERT_EQ(toString(int8(-128)), "-128");
+	ASSERT_EQ(toString(int32(-2147483647 - 1)), "-2147483648");
+	ASSERT_EQ(toString(uint64(4294967296ull)), "4294967296");
+	ASSERT_EQ(toString(uint64(18446744073709551615ull)), "18446744073709551615");
+	ASSERT_EQ(toString(int64(-9223372036854775807ll - 1)), "-9223372036854775808");
+	for (uint64 x = 1, n = 1; n < 20; x *= 10, ++n)
+	{
+		ASSERT_EQ(toString(x).getLength(), n);
+		ASSERT_EQ(toString(x - 1).getLength(), n == 1 ? 1 : n - 1);
+	}
+
+	// Shortest round-trip floats
+	ASSERT_EQ(toString(0.0), "0");
+	ASSERT_EQ(toString(-0.0), "-0");
+	ASSERT_EQ(toString(1.0), "1");
+	ASSERT_EQ(toString(0.1), "0.1");
+	ASSERT_EQ(toString(0.1 + 0.2), "0.30000000000000004");
+	ASSERT_EQ(toString(-123.456), "-123.456");
+	ASSERT_EQ(toString(0.001), "0.001");
+	ASSERT_EQ(toString(1e-5), "1e-05");
+	ASSERT_EQ(toString(1e15), "1000000000000000");
+	ASSERT_EQ(toString(1e16), "1e+16");
+	ASSERT_EQ(toString(1e23), "1e+23");
+	ASSERT_EQ(toString(9007199254740993.0), "9007199254740992");
+	ASSERT_EQ(toString(5e-324), "5e-324");
+	ASSERT_EQ(toString(2.2250738585072014e-308), "2.2250738585072014e-308");
+	ASSERT_EQ(toString(1.7976931348623157e308), "1.7976931348623157e+308");
+	ASSERT_EQ(toString(0.1f), "0.1");
+	ASSERT_EQ(toString(16777216.f), "16777216");
+	ASSERT_EQ(toString(3.4028235e38f), "3.4028235e+38");
+	ASSERT_EQ(toString(1e-45f), "1e-45");
+	ASSERT_EQ(toString(1.0 / 0.0), "inf");
+	ASSERT_EQ(toString(-1.0 / 0.0), "-inf");
+	ASSERT_EQ(toString(0.0 / 0.0), "nan");
+
+	// Append to strings
+	String str = "values:", expected = "values:";
+	for (int32 i = 0; i < 100; ++i)
+	{
+		str.appendInt(i - 50) += ',';
+		formatTo(expected, "{},", i - 50);
+	}
+
+	ASSERT_EQ(str, expected);
+	ASSERT_EQ(String{"x="}.appendFloat(0.5).appendInt(uint64(7)), "x=0.57");
+	ASSERT_EQ(String{}.appendFloat(2.5f), "2.5");
+}
+
+TEST(containers, StringToNumber)
+{
+	sizet errorPos = 0;
+
+	// Integers
+	ASSERT_EQ(*parseInt<int32>("0"), 0);
+	ASSERT_EQ(*parseInt<int32>("-42"), -42);
+	ASSERT_EQ(*parseInt<int32>("+42"), 42);
+	ASSERT_EQ(*parseInt<int32>("000123"), 123);
+	ASSERT_EQ(*parseInt<int32>("1234567890"), 1234567890);
+	ASSERT_EQ(*parseInt<int32>("-2147483648"), -2147483647 - 1);
+	ASSERT_EQ(*parseInt<uint8>("255"), 255);
+	ASSERT_EQ(*parseInt<int8>("-128"), -128);
+	ASSERT_EQ(*parseInt<int64>("-9223372036854775808"), -9223372036854775807ll - 1);
+	ASSERT_EQ(*parseInt<uint64>("18446744073709551615"), 18446744073709551615ull);
+	ASSERT_EQ(*parseInt<uint64>("0000000000000000000000000001"), 1);
+	ASSERT_EQ(*parseInt<int32>(String{"31415926"}), 31415926);
+	ASSERT_FALSE(parseInt<int32>("", &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 0);
+	ASSERT_FALSE(parseInt<int32>("-", &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 1);
+	ASSERT_FALSE(parseInt<int32>("12a4", &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 2);
+	ASSERT_FALSE(parseInt<int32>(" 1", &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 0);
+	ASSERT_FALSE(parseInt<uint32>("-1", &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 0);
+	ASSERT_FALSE(parseInt<int32>("-2147483649", &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 1);
+	ASSERT_FALSE(parseInt<uint8>("256").hasValue());
+	ASSERT_FALSE(parseInt<uint64>("18446744073709551616").hasValue());
+	ASSERT_FALSE(parseInt<uint64>("100000000000000000000").hasValue());
+
+	// Floating-point numbers. Zeros, subnormals,
+	// infinities and NaN are compared by their
+	// bits, which fast-math flags don't change
+	auto const bits = [](auto value) { return StringConvert_Impl::toBits(value); };
+
+	ASSERT_EQ(bits(*parseFloat<float64>("0")), bits(0.0));
+	ASSERT_EQ(bits(*parseFloat<float64>("-0")), bits(-0.0));
+	ASSERT_EQ(*parseFloat<float64>("1.5"), 1.5);
+	ASSERT_EQ(*parseFloat<float64>("-0.1"), -0.1);
+	ASSERT_EQ(*parseFloat<float64>(".5"), 0.5);
+	ASSERT_EQ(*parseFloat<float64>("5."), 5.0);
+	ASSERT_EQ(*parseFloat<float64>("1e10"), 1e10);
+	ASSERT_EQ(*parseFloat<float64>("+2.5E-3"), 2.5e-3);
+	ASSERT_EQ(*parseFloat<float64>("0.30000000000000004"), 0.30000000000000004);
+	ASSERT_EQ(*parseFloat<float64>("1.7976931348623157e308"), 1.7976931348623157e308);
+	ASSERT_EQ(bits(*parseFloat<float64>("4.9406564584124654e-324")), 1ull);
+	ASSERT_EQ(bits(*parseFloat<float64>("-4.9406564584124654e-324")), (1ull << 63) | 1ull);
+	ASSERT_EQ(bits(*parseFloat<float64>("2.2250738585072011e-308")), (1ull << 52) - 1);
+	ASSERT_EQ(*parseFloat<float64>("9007199254740993"), 9007199254740992.0);
+	ASSERT_EQ(*parseFloat<float64>("123456789012345678901234567890"), 123456789012345678901234567890.0);
+	ASSERT_EQ(*parseFloat<float64>("0.000000000000000000000000000000000000000000001"), 1e-45);
+	ASSERT_EQ(bits(*parseFloat<float64>("1e-400")), 0ull);
+	ASSERT_EQ(bits(*parseFloat<float64>("1e400")), 0x7ffull << 52);
+	ASSERT_EQ(bits(*parseFloat<float64>("-Infinity")), 0xfffull << 52);
+	ASSERT_EQ(bits(*parseFloat<float64>("inf")), 0x7ffull << 52);
+	ASSERT_TRUE(StringConvert_Impl::isNaN(*parseFloat<float64>("NaN")));
+	ASSERT_TRUE(StringConvert_Impl::isNaN(*parseFloat<float32>("nan")));
+	ASSERT_EQ(*parseFloat<float32>("0.1"), 0.1f);
+	ASSERT_EQ(*parseFloat<float32>("3.4028235e38"), 3.4028235e38f);
+	ASSERT_EQ(bits(*parseFloat<float32>("1e39")), 0xffu << 23);
+	ASSERT_EQ(bits(*parseFloat<float32>("1e-45")), 1u);
+	ASSERT_FALSE(parseFloat<float64>("", &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 0);
+	ASSERT_FALSE(parseFloat<float64>(".", &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 1);
+	ASSERT_FALSE(parseFloat<float64>("1.5x", &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 3);
+	ASSERT_FALSE(parseFloat<float64>("1e", &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 2);
+	ASSERT_FALSE(parseFloat<float64>("1,5", &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 1);
+	ASSERT_FALSE(parseFloat<float64>("infinite", &errorPos).hasValue());
+	ASSERT_EQ(errorPos, 3);
+
+	// Round trip
+	ansichar buffer[maxFloatLength];
+	for (float64 x = 1e-300; x < 1e300; x *= 3.3)
+	{
+		sizet const len = floatToChars(buffer, x) - buffer;
+		ASSERT_EQ(*parseFloat<float64>(StringView{buffer, len}), x);
+	}
+
+	for (auto token : StringView{"1,-2,3.5,oops"}.split(','))
+	{
+		ASSERT_EQ(parseFloat<float64>(token).hasValue(), token != "oops");
+	}
+}
+
+TEST(containers, Utf8)
+{
+	sizet errorPos = 0;
+
+	// Validation
+	ASSERT_TRUE(isValidUtf8(""));
+	ASSERT_TRUE(isValidUtf8("hello"));
+	ASSERT_TRUE(isValidUtf8("\xc3\xa9t\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80"));
+	ASSERT_TRUE(isValidUtf8("\xed\x9f\xbf\xee\x80\x80\xf4\x8f\xbf\xbf"));
+	ASSERT_FALSE(isValidUtf8("ab\x80", &errorPos));
+	ASSERT_EQ(errorPos, 2);
+	ASSERT_FALSE(isValidUtf8("a\xc0\xaf", &errorPos));
+	ASSERT_EQ(errorPos, 1);
+	ASSERT_FALSE(isValidUtf8("\xe0\x80\xaf", &errorPos));
+	ASSERT_EQ(errorPos, 0);
+	ASSERT_FALSE(isValidUtf8("\xed\xa0\x80"));
+	ASSERT_FALSE(isValidUtf8("\xf4\x90\x80\x80"));
+	ASSERT_FALSE(isValidUtf8("\xf5\x80\x80\x80"));
+	ASSERT_FALSE(isValidUtf8("abc\xe2\x82", &errorPos));
+	ASSERT_EQ(errorPos, 3);
+
+	// Long buffers take the vectorized path,
+	// errors must be found at every position
+	ansichar buffer[200];
+	for (sizet i = 0; i < 200; ++i) buffer[i] = ansichar('a' + i % 26);
+	ASSERT_TRUE(isValidUtf8({buffer, 200}));
+	for (sizet i = 0; i + 4 <= 200; ++i)
+	{
+		ansichar copy[200];
+		PlatformMemory::memcpy(copy, buffer, sizeof(copy));
+		PlatformMemory::memcpy(copy + i, "\xf0\x9f\x98\x80", 4);
+		ASSERT_TRUE(isValidUtf8({copy, 200}));
+		ASSERT_FALSE(isValidUtf8({copy, i + 3}, &errorPos));
+		ASSERT_EQ(errorPos, i);
+
+		copy[i + 2] = 'x';
+		ASSERT_FALSE(isValidUtf8({copy, 200}, &errorPos));
+		ASSERT_EQ(errorPos, i);
+
+		copy[i] = '\x80';
+		ASSERT_FALSE(isValidUtf8({copy, 200}, &errorPos));
+		ASSERT_EQ(errorPos, i);
+	}
+
+	// Transcoding
+	WideString wide = WideString::transcode(StringView{"a\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80"});
+	if constexpr (sizeof(widechar) == 2)
+	{
+		ASSERT_EQ(wide.getLength(), 5);
+		ASSERT_EQ(wide[3], 0xd83d);
+		ASSERT_EQ(wide[4], 0xde00);
+	}
+	else
+	{
+		ASSERT_EQ(wide.getLength(), 4);
+		ASSERT_EQ(wide[3], 0x1f600);
+	}
+	ASSERT_EQ(wide[0], L'a');
+	ASSERT_EQ(wide[1], 0xe9);
+	ASSERT_EQ(wide[2], 0x20ac);
+	ASSERT_EQ(String::transcode(wide), "a\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80");
+	ASSERT_EQ(WideString::transcode(StringView{"plain ascii text, longer than a block"}), L"plain ascii text, longer than a block");
+	ASSERT_EQ(String::transcode(WideString{L"plain ascii text"}), "plain ascii text");
+
+	// Invalid sequences become U+FFFD, one
+	// for each maximal subpart
+	ASSERT_EQ(String::transcode(StringView{"a\xe2\x82z\x80\xf0\x9f"}), "a\xef\xbf\xbdz\xef\xbf\xbd\xef\xbf\xbd");
+	ASSERT_EQ(WideString::transcode(StringView{"\xe2\x82z"}), L"\xfffdz");
+	widechar const lone[] = {L'a', widechar(0xd800), L'b'};
+	ASSERT_EQ(String::transcode(WideStringView{lone, 3}), "a\xef\xbf\xbd""b");
+
+	// Code points
+	uint32 codePoints[8]{};
+	sizet numCodePoints = 0;
+	for (uint32 codePoint : StringView{"a\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\xff"}.codePoints())
+	{
+		codePoints[numCodePoints++] = codePoint;
+	}
+	ASSERT_EQ(numCodePoints, 5);
+	ASSERT_EQ(codePoints[0], 'a');
+	ASSERT_EQ(codePoints[1], 0xe9);
+	ASSERT_EQ(codePoints[2], 0x20ac);
+	ASSERT_EQ(codePoints[3], 0x1f600);
+	ASSERT_EQ(codePoints[4], replacementChar);
+
+	numCodePoints = 0;
+	for (uint32 codePoint : wide.codePoints())
+	{
+		codePoints[numCodePoints++] = codePoint;
+	}
+	ASSERT_EQ(numCodePoints, 4);
+	ASSERT_EQ(codePoints[3], 0x1f600);
+}
+
+TEST(containers, SharedString)
+{
+	SharedString a;
+
+	ASSERT_EQ(a.getLength(), 0ull);
+	ASSERT_EQ(a, "");
+	ASSERT_EQ(**a, '\0');
+
+	a = "sneppy";
+
+	ASSERT_EQ(a.getLength(), 6ull);
+	ASSERT_EQ(a, "sneppy");
+	ASSERT_NE(a, "snep");
+	ASSERT_NE(a, "sneppyrulez");
+
+	SharedString b = a;
+
+	ASSERT_TRUE(a.isShared());
+	ASSERT_EQ(*a, *b);
+
+	b += "rulez";
+
+	ASSERT_FALSE(a.isShared());
+	ASSERT_EQ(a, "sneppy");
+	ASSERT_EQ(b, "sneppyrulez");
+	ASSERT_EQ(b.getLength(), 11ull);
+
+	b += '!';
+	b += StringView{};
+
+	ASSERT_EQ(b, "sneppyrulez!");
+	ASSERT_EQ(b[b.getLength() - 1], '!');
+	ASSERT_TRUE(a < b);
+	ASSERT_TRUE(b > a);
+
+	// Views need not be null-terminated
+	StringView const prefix = StringView{"abc"}.substr(0, 2);
+
+	ASSERT_FALSE(SharedString{"ab"} < prefix);
+	ASSERT_FALSE(SharedString{"ab"} > prefix);
+	ASSERT_TRUE(SharedString{"a"} < prefix);
+	ASSERT_TRUE(SharedString{"abc"} > prefix);
+	ASSERT_TRUE(SharedString{"ab"} == prefix);
+	ASSERT_TRUE(prefix == SharedString{"ab"});
+	ASSERT_TRUE(SharedString{"abc"} != prefix);
+
+	String c = b.toString();
+
+	ASSERT_EQ(c, *b);
+	ASSERT_EQ(c.getLength(), b.getLength());
+
+	// Hashes match unshared strings
+	ASSERT_EQ(ChooseHashPolicy<SharedString>::Type{}(a), ChooseHashPolicy<String>::Type{}(String{"sneppy"}));
+
+	HashMap<SharedString, int32> map;
+	map[a] = 1;
+	map[b] = 2;
+
+	ASSERT_EQ(a.getRefCount(), 2ull);
+	ASSERT_TRUE(map.contains(SharedString{"sneppy"}));
+	ASSERT_EQ(map[b], 2);
+
+	SUCCEED();
+}
+
+TEST(containers, HashedString)
+{
+	HashedString a;
+
+	ASSERT_EQ(a.getLength(), 0ull);
+	ASSERT_TRUE(a.isEmpty());
+	ASSERT_EQ(a, "");
+
+	a = "sneppy";
+
+	ASSERT_EQ(a.getLength(), 6ull);
+	ASSERT_EQ(a, "sneppy");
+	ASSERT_NE(a, "snep");
+	ASSERT_EQ(a.toHashKey(), StringView{"sneppy"}.toHashKey());
+
+	HashedString b = a;
+
+	ASSERT_EQ(a, b);
+	ASSERT_EQ(a.toHashKey(), b.toHashKey());
+
+	b += "rulez";
+
+	ASSERT_NE(a, b);
+	ASSERT_EQ(b, "sneppyrulez");
+	ASSERT_EQ(b.toHashKey(), StringView{"sneppyrulez"}.toHashKey());
+
+	b += '!';
+
+	ASSERT_EQ(b, "sneppyrulez!");
+	ASSERT_EQ(b.toHashKey(), StringView{"sneppyrulez!"}.toHashKey());
+	ASSERT_TRUE(a < b);
+	ASSERT_TRUE(b > a);
+
+	HashedString c{String{"sneppyrulez!"}};
+
+	ASSERT_EQ(b, c);
+	ASSERT_EQ(c.getString(), "sneppyrulez!");
+	ASSERT_EQ(String{c}, *c);
+
+	// Hashes match the other string types
+	ASSERT_EQ(ChooseHashPolicy<HashedString>::Type{}(a), ChooseHashPolicy<String>::Type{}(String{"sneppy"}));
+	ASSERT_EQ(ChooseHashPolicy<HashedString>::Type{}("sneppy"), ChooseHashPolicy<HashedString>::Type{}(a));
+
+	HashMap<HashedString, int32> map;
+	map[a] = 1;
+	map[b] = 2;
+
+	ASSERT_TRUE(map.contains(HashedString{"sneppy"}));
+	ASSERT_TRUE(map.contains("sneppy"));
+	ASSERT_TRUE(map.contains(StringView{"sneppyrulez!"}));
+	ASSERT_FALSE(map.contains("sneppyrulez"));
+	ASSERT_EQ(map[b], 2);
+
+	Set<HashedString> set;
+	set.insert(b);
+	set.insert(a);
+
+	ASSERT_EQ(set.getSize(), 2);
+	ASSERT_EQ(*set.begin(), a);
+
+	SUCCEED();
+}
+
+TEST(containers, Name)
+{
+	Name a;
+
+	ASSERT_TRUE(a.isEmpty());
+	ASSERT_EQ(a.getLength(), 0ull);
+	ASSERT_EQ(a, Name{""});
+	ASSERT_EQ(**a, '\0');
+
+	Name b{"sneppy"};
+	Name c{String{"sneppy"}};
+	Name d{StringView{"sneppyrulez"}.substr(0, 6)};
+
+	ASSERT_FALSE(b.isEmpty());
+	ASSERT_EQ(b, c);
+	ASSERT_EQ(b, d);
+	ASSERT_EQ(b.getId(), d.getId());
+	ASSERT_EQ(b.toView(), "sneppy");
+	ASSERT_EQ(b.toString(), "sneppy");
+	ASSERT_EQ(b.getLength(), 6ull);
+	ASSERT_EQ(PlatformString::cmp(*b, "sneppy"), 0);
+
+	Name e{"Sneppy"};
+
+	ASSERT_NE(b, e);
+	ASSERT_TRUE(b.equalsNoCase(e));
+	ASSERT_FALSE(b.equalsNoCase(Name{"korin"}));
+
+	ASSERT_TRUE(Name::find("sneppy").hasValue());
+	ASSERT_EQ(*Name::find("sneppy"), b);
+	ASSERT_FALSE(Name::find("neverinterned").hasValue());
+
+	// Case-insensitive names keep the first spelling
+	NameNoCase f{"SNEPPY"};
+	NameNoCase g{e};
+
+	ASSERT_EQ(f, g);
+	ASSERT_EQ(f.toName(), b);
+	ASSERT_EQ(f.toView(), "sneppy");
+	ASSERT_EQ(*NameNoCase::find("sNePpY"), f);
+	ASSERT_FALSE(NameNoCase::find("neverinterned").hasValue());
+
+	HashMap<Name, int32> map;
+	for (int32 i = 0; i < ARRAY_LEN(names); ++i)
+	{
+		map.emplace(Name{names[i]}, i);
+	}
+
+	for (int32 i = 0; i < ARRAY_LEN(names); ++i)
+	{
+		ASSERT_EQ(map[Name{names[i]}], i);
+	}
+
+	// Concurrent interning yields the same ids
+	{
+		constexpr int32 numThreads = 4;
+		constexpr int32 numNames = 1000;
+
+		Array<uint32> ids[numThreads];
+		std::thread threads[numThreads];
+		for (int32 i = 0; i < numThreads; ++i)
+		{
+			threads[i] = std::thread{[&ids, i]() {
+
+				for (int32 j = 0; j < numNames; ++j)
+				{
+					ids[i].append(Name{String{"name%d"}.format(j)}.getId());
+				}
+			}};
+		}
+
+		for (int32 i = 0; i < numThreads; ++i)
+		{
+			threads[i].join();
+		}
+
+		for (int32 i = 1; i < numThreads; ++i)
+		{
+			for (int32 j = 0; j < numNames; ++j)
+			{
+				ASSERT_EQ(ids[i][j], ids[0][j]);
+			}
+		}
+
+		ASSERT_EQ(Name{"name42"}.getId(), ids[0][42]);
+		ASSERT_EQ(Name{"name42"}.toView(), "name42");
+	}
+
 	SUCCEED();
 }